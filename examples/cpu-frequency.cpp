@@ -58,7 +58,7 @@ int main(int argc, char *argv[])
     }
 
     cout << "-- Refresh frequency on all cores of Node 1(and store the timestamp). " << endl;
-    //Frequency gets stored in attrib freq_history (value of type std::vector<std::tuple<long long=timestamp,double=frequency in MHz>>)
+    //Frequency gets stored in attrib freq_history (value of type TimeSeries*, with the channel "frequency" in MHz and timestamps in ns; by default the last 10000 samples are kept)
     int repeat = 10;
     for(int i = 0; i<repeat; i++)
     {
@@ -67,10 +67,10 @@ int main(int argc, char *argv[])
     }
 
     cout << "-- Print out frequency history on core 1 of Node 1. " << endl;
-    std::vector<std::tuple<long long,double>>* fh = (std::vector<std::tuple<long long,double>>*)c1->attrib["freq_history"];
-    for(auto [ ts,freq ] : *fh)
+    TimeSeries* fh = (TimeSeries*)c1->attrib["freq_history"];
+    for(size_t i = 0; i < fh->Size(); i++)
     {
-        cout << "    ts: " << ts << " frequency[MHz]: " << freq << endl;
+        cout << "    ts: " << fh->GetTimestamp(i) << " frequency[MHz]: " << fh->GetValue(i) << endl;
     }
 
     cout << "-- Export all information to xml " << output_name << endl;
@@ -42,7 +42,7 @@ if __name__ == "__main__":
         print("Frequency:", c1.freq)
 
     print("-- Refresh frequency on all cores of Node 1(and store the timestamp). ")
-    # Frequency gets stored in attrib freq_history (value of type std::vector<std::tuple<long long=timestamp,double=frequency in MHz>>)
+    # Frequency gets stored in attrib freq_history (a bounded time series of timestamp -> frequency in MHz; read as a dict)
     repeat = 10
     for i in range(repeat):
         n.RefreshCpuCoreFrequency(True)
@@ -25,11 +25,8 @@ int main(int argc, char *argv[])
     path_prefix=path_prefix.substr(0,found) + "/";
     std::string xmlPath = "example_data/skylake_hwloc.xml";
     std::string bwPath = "example_data/skylake_caps_numa_benchmark.csv";
-    for(int n_idx=0; n_idx<tot_nodes; n_idx++)
+    for(Node* n : topo->CreateChildren<Node>(tot_nodes, 0))
     {
-        Node* n = new Node(n_idx);
-        n->SetParent((Component*)topo);
-        topo->InsertChild((Component*)n);
         if(parseHwlocOutput(n, path_prefix+xmlPath) != 0)
         {
             cout << "error parsing hwloc in path " << path_prefix+xmlPath << endl;
@@ -84,7 +84,9 @@ int main(int argc, char *argv[])
     path_prefix=path_prefix.substr(0,found) + "/";
     std::string xmlPath = path_prefix + "example_data/skylake_hwloc.xml";
     std::string bwPath = path_prefix + "example_data/skylake_caps_numa_benchmark.csv";
-    std::string mt4gPath = path_prefix + "example_data/pascal_gpu_topo.csv";
+    std::string mt4gPath = path_prefix + "example_data/ampere_gpu_topo.csv";
+    if (argc > 1) //e.g. the output of mt4g on the local GPU
+        mt4gPath = argv[1];
 
     high_resolution_clock::time_point t_start, t_end;
     uint64_t timer_overhead = get_timer_overhead(TIMER_REPEATS, TIMER_WARMUP);
@@ -120,6 +122,43 @@ int main(int argc, char *argv[])
         time_createNewComponent = time;
         }
     }
+    // time building and freeing a subtree with new/Delete, compared to allocating it from the Topology's Arena and releasing the Arena
+    uint64_t time_buildAndDeleteSubtree = UINT64_MAX;
+    uint64_t time_buildAndReleaseArena = UINT64_MAX;
+    for (int i = 0; i < 10; i++) {
+        Topology* heapTopo = new Topology();
+        t_start = high_resolution_clock::now();
+        for (int c = 0; c < 4096; c++) {
+            Core* core = new Core(heapTopo, c);
+            new Thread(core, 2*c);
+            new Thread(core, 2*c+1);
+        }
+        heapTopo->Delete(true);
+        t_end = high_resolution_clock::now();
+        uint64_t time = t_end.time_since_epoch().count() -
+                        t_start.time_since_epoch().count() - timer_overhead;
+        if (time < time_buildAndDeleteSubtree) {
+        time_buildAndDeleteSubtree = time;
+        }
+
+        Topology* arenaTopo = new Topology();
+        Arena* arena = arenaTopo->CreateArena();
+        t_start = high_resolution_clock::now();
+        for (int c = 0; c < 4096; c++) {
+            Core* core = arena->New<Core>(arenaTopo, c);
+            arena->New<Thread>(core, 2*c);
+            arena->New<Thread>(core, 2*c+1);
+        }
+        arenaTopo->ReleaseArena();
+        t_end = high_resolution_clock::now();
+        arenaTopo->Delete(true);
+        time = t_end.time_since_epoch().count() -
+               t_start.time_since_epoch().count() - timer_overhead;
+        if (time < time_buildAndReleaseArena) {
+        time_buildAndReleaseArena = time;
+        }
+    }
+
     //time importFromXml
     uint64_t time_importFromXml = UINT64_MAX;
     for (int i = 0; i < 1000; i++) {
@@ -169,6 +208,37 @@ int main(int argc, char *argv[])
 
     uint64_t avg_time_readAttribute = total_time_readAttribute / 1000000;
 
+    //time update a typed attribute (interned key, value stored inline)
+
+    AttribId testAttr = InternAttribKey("test_typed");
+    uint64_t total_time_updateTypedAttribute = 0;
+
+    for (int i = 0; i < 1000000; i++) {
+        t_start = high_resolution_clock::now();
+        n->SetAttr(testAttr, i);
+        t_end = high_resolution_clock::now();
+        uint64_t time = t_end.time_since_epoch().count() -
+                        t_start.time_since_epoch().count() - timer_overhead;
+        total_time_updateTypedAttribute += time;
+    }
+
+    uint64_t avg_time_updateTypedAttribute = total_time_updateTypedAttribute / 1000000;
+
+    //time read a typed attribute
+
+    uint64_t total_time_readTypedAttribute = 0;
+
+    for (int i = 0; i < 1000000; i++) {
+        t_start = high_resolution_clock::now();
+        [[ maybe_unused ]] int* l = n->GetAttr<int>(testAttr);
+        t_end = high_resolution_clock::now();
+        uint64_t time = t_end.time_since_epoch().count() -
+                        t_start.time_since_epoch().count() - timer_overhead;
+        total_time_readTypedAttribute += time;
+    }
+
+    uint64_t avg_time_readTypedAttribute = total_time_readTypedAttribute / 1000000;
+
     // time hwloc_parser
 
     uint64_t time_parseHwlocOutput = UINT64_MAX;
@@ -198,6 +268,57 @@ int main(int argc, char *argv[])
         }
     }
 
+    //time updating a typed attribute of all hwloc components without and with an index (AttribIndex) of its key,
+    //and finding the components with a given value by scanning vs. by the index
+    AttribId jobAttr = InternAttribKey("job_id");
+    t_start = high_resolution_clock::now();
+    for (size_t i = 0; i < hwlocComponentList.size(); i++)
+        hwlocComponentList[i]->SetAttr(jobAttr, static_cast<int>(i % 16));
+    t_end = high_resolution_clock::now();
+    uint64_t avg_time_updateUnindexedAttribute = (t_end.time_since_epoch().count() - t_start.time_since_epoch().count() - timer_overhead) / hwlocComponentList.size();
+
+    uint64_t time_findAttributeByScan = UINT64_MAX;
+    size_t num_found = 0;
+    for (int i = 0; i < 1000; i++) {
+        std::vector<Component*> found;
+        t_start = high_resolution_clock::now();
+        for (Component* c : hwlocComponentList) {
+            int* job = c->GetAttr<int>(jobAttr);
+            if (job != nullptr && *job == 3)
+                found.push_back(c);
+        }
+        t_end = high_resolution_clock::now();
+        uint64_t time = t_end.time_since_epoch().count() -
+                        t_start.time_since_epoch().count() - timer_overhead;
+        if (time < time_findAttributeByScan)
+            time_findAttributeByScan = time;
+        num_found = found.size();
+    }
+
+    ComponentAttribIndex jobIndex(jobAttr);
+    t_start = high_resolution_clock::now();
+    jobIndex.AddSubtree(n);
+    t_end = high_resolution_clock::now();
+    uint64_t time_buildAttribIndex = t_end.time_since_epoch().count() - t_start.time_since_epoch().count() - timer_overhead;
+
+    t_start = high_resolution_clock::now();
+    for (size_t i = 0; i < hwlocComponentList.size(); i++)
+        hwlocComponentList[i]->SetAttr(jobAttr, static_cast<int>((i + 1) % 16));
+    t_end = high_resolution_clock::now();
+    uint64_t avg_time_updateIndexedAttribute = (t_end.time_since_epoch().count() - t_start.time_since_epoch().count() - timer_overhead) / hwlocComponentList.size();
+
+    uint64_t time_findAttributeByIndex = UINT64_MAX;
+    for (int i = 0; i < 1000; i++) {
+        t_start = high_resolution_clock::now();
+        std::vector<Component*> found = jobIndex.Find(3);
+        t_end = high_resolution_clock::now();
+        uint64_t time = t_end.time_since_epoch().count() -
+                        t_start.time_since_epoch().count() - timer_overhead;
+        if (time < time_findAttributeByIndex)
+            time_findAttributeByIndex = time;
+        num_found = found.size();
+    }
+
     // time caps-numa-benchmark parser
     uint64_t time_parseCapsNumaBenchmark = UINT64_MAX;
     t_start = high_resolution_clock::now();
@@ -237,20 +358,55 @@ int main(int argc, char *argv[])
     if(numa==NULL){ std::cerr << "numa 0 not found in sys-sage" << endl; return 1;}
     unsigned int max_bw = 0;
     Component* max_bw_component = NULL;
-    t_start = high_resolution_clock::now();
-    std::vector<DataPath*> dp_vec = numa->FindDataPaths(sys_sage::DataPathType::Any, sys_sage::DataPathDirection::Outgoing);
-    // vector<DataPath*>* dp = numa->GetDataPaths(SYS_SAGE_DATAPATH_OUTGOING);
-    for(DataPath* dp : dp_vec)
-    {
-        if( dp->GetBandwidth() > max_bw ){
-            max_bw = dp->GetBandwidth();
-            max_bw_component = dp->GetTarget();
-        }        
+    //repeated, as in a placement loop; with the caps-numa data, NUMA 0 has too few DataPaths to get a DataPathIndex, so every lookup scans them
+    for (int i = 0; i < 1000; i++) {
+        max_bw = 0;
+        t_start = high_resolution_clock::now();
+        std::vector<DataPath*> dp_vec = numa->FindDataPaths(sys_sage::DataPathType::Any, sys_sage::DataPathDirection::Outgoing);
+        // vector<DataPath*>* dp = numa->GetDataPaths(SYS_SAGE_DATAPATH_OUTGOING);
+        for(DataPath* dp : dp_vec)
+        {
+            if( dp->GetBandwidth() > max_bw ){
+                max_bw = dp->GetBandwidth();
+                max_bw_component = dp->GetTarget();
+            }        
+        }
+        t_end = high_resolution_clock::now();
+        time = t_end.time_since_epoch().count() -  t_start.time_since_epoch().count() - timer_overhead;
+        if (time < time_getNumaMaxBw) {
+            time_getNumaMaxBw = time;
+        }
     }
-    t_end = high_resolution_clock::now();
-    time = t_end.time_since_epoch().count() -  t_start.time_since_epoch().count() - timer_overhead;
-    if (time < time_getNumaMaxBw) {
-        time_getNumaMaxBw = time;
+
+    //the same lookup on a NUMA node with as many DataPaths as cccbench produces (one C2C DataPath to each hwloc component): the first lookups scan them, the next ones use its DataPathIndex
+    std::vector<DataPath*> c2cDataPaths;
+    for (size_t i = 0; i < hwlocComponentList.size(); i++)
+        c2cDataPaths.push_back(new DataPath(numa, hwlocComponentList[i], DataPathOrientation::Oriented, DataPathType::C2C, static_cast<double>(i % 97), 1.0));
+    uint64_t time_getNumaMaxBw_dense = UINT64_MAX;
+    for (int i = 0; i < 1000; i++) {
+        double max_c2c_bw = 0;
+        t_start = high_resolution_clock::now();
+        std::vector<DataPath*> dp_vec = numa->FindDataPaths(sys_sage::DataPathType::Any, sys_sage::DataPathDirection::Outgoing);
+        for(DataPath* dp : dp_vec)
+            max_c2c_bw = std::max(max_c2c_bw, dp->GetBandwidth());
+        t_end = high_resolution_clock::now();
+        time = t_end.time_since_epoch().count() -  t_start.time_since_epoch().count() - timer_overhead;
+        if (time < time_getNumaMaxBw_dense)
+            time_getNumaMaxBw_dense = time;
+    }
+    for (DataPath* dp : c2cDataPaths)
+        dp->Delete();
+
+    //DataPath from NUMA 0 to the component with the maximal bandwidth
+    uint64_t time_findNumaDataPath = UINT64_MAX;
+    for (int i = 0; i < 1000 && max_bw_component != NULL; i++) {
+        t_start = high_resolution_clock::now();
+        DataPath* dp = numa->FindDataPath(max_bw_component);
+        t_end = high_resolution_clock::now();
+        time = t_end.time_since_epoch().count() -  t_start.time_since_epoch().count() - timer_overhead;
+        if (time < time_findNumaDataPath)
+            time_findNumaDataPath = time;
+        if (dp == NULL) { std::cerr << "DataPath from numa 0 not found" << endl; return 1; }
     }
 
 
@@ -263,10 +419,9 @@ int main(int argc, char *argv[])
     t_end = high_resolution_clock::now();
     time_parseMt4g = t_end.time_since_epoch().count() -
                     t_start.time_since_epoch().count() - timer_overhead;
-    if (ret != 0) {
-        cout << "failed parsing mt4g" << endl;
-        return 1;
-    }
+    //the mt4g measurements are optional: without the GPU topology, they run on an empty GPU and the other measurements are still reported
+    if (ret != 0)
+        std::cerr << "failed parsing mt4g (" << mt4gPath << "), continuing without the GPU topology" << endl;
 
     // time get a vector with all Components (of mt4g parser)
     uint64_t time_GetMt4gSubtreeNodeList = UINT64_MAX;
@@ -297,6 +452,234 @@ int main(int argc, char *argv[])
             [[ maybe_unused ]] uint64_t time_GetAllComponentsList = t_end.time_since_epoch().count()-t_start.time_since_epoch().count()-timer_overhead;
         }
     }
+    // time counting all Threads (recursive traversal)
+    uint64_t time_CountAllThreads = UINT64_MAX;
+    for (int i = 0; i < 1000; i++) {
+        t_start = high_resolution_clock::now();
+        [[ maybe_unused ]] int numThreads = t->CountDescendantsByType(ComponentType::Thread);
+        t_end = high_resolution_clock::now();
+        uint64_t time = t_end.time_since_epoch().count() - t_start.time_since_epoch().count() - timer_overhead;
+        if (time < time_CountAllThreads) {
+            time_CountAllThreads = time;
+        }
+    }
+
+    // same queries, answered from a SubtreeIndex on the Topology (the first query builds the index)
+    t->EnableSubtreeIndex();
+    uint64_t time_GetAllComponentsList_indexed = UINT64_MAX;
+    for (int i = 0; i < 1000; i++) {
+        allComponentList.clear();
+        t_start = high_resolution_clock::now();
+        t->FindDescendantsByType(&allComponentList, ComponentType::Any);
+        t_end = high_resolution_clock::now();
+        uint64_t time = t_end.time_since_epoch().count() - t_start.time_since_epoch().count() - timer_overhead;
+        if (time < time_GetAllComponentsList_indexed) {
+            time_GetAllComponentsList_indexed = time;
+        }
+    }
+    uint64_t time_CountAllThreads_indexed = UINT64_MAX;
+    for (int i = 0; i < 1000; i++) {
+        t_start = high_resolution_clock::now();
+        [[ maybe_unused ]] int numThreads = t->CountDescendantsByType(ComponentType::Thread);
+        t_end = high_resolution_clock::now();
+        uint64_t time = t_end.time_since_epoch().count() - t_start.time_since_epoch().count() - timer_overhead;
+        if (time < time_CountAllThreads_indexed) {
+            time_CountAllThreads_indexed = time;
+        }
+    }
+    t->DisableSubtreeIndex();
+
+    // same count, answered from a FrozenTopology snapshot
+    uint64_t time_Freeze = UINT64_MAX;
+    for (int i = 0; i < 100; i++) {
+        t_start = high_resolution_clock::now();
+        [[ maybe_unused ]] FrozenTopology frozen = t->Freeze();
+        t_end = high_resolution_clock::now();
+        uint64_t time = t_end.time_since_epoch().count() - t_start.time_since_epoch().count() - timer_overhead;
+        if (time < time_Freeze) {
+            time_Freeze = time;
+        }
+    }
+    FrozenTopology frozen = t->Freeze();
+    uint64_t time_CountAllThreads_frozen = UINT64_MAX;
+    for (int i = 0; i < 1000; i++) {
+        t_start = high_resolution_clock::now();
+        [[ maybe_unused ]] uint32_t numThreads = frozen.CountDescendantsByType(0, ComponentType::Thread);
+        t_end = high_resolution_clock::now();
+        uint64_t time = t_end.time_since_epoch().count() - t_start.time_since_epoch().count() - timer_overhead;
+        if (time < time_CountAllThreads_frozen) {
+            time_CountAllThreads_frozen = time;
+        }
+    }
+
+    // whole-subtree functions (explicit-stack traversal)
+    uint64_t time_CalcSubtreeDepth = UINT64_MAX;
+    uint64_t time_CheckSubtreeConsistency = UINT64_MAX;
+    uint64_t time_CalcSubtreeSize = UINT64_MAX;
+    for (int i = 0; i < 100; i++) {
+        t_start = high_resolution_clock::now();
+        [[ maybe_unused ]] int subtreeDepth = t->CalcSubtreeDepth();
+        t_end = high_resolution_clock::now();
+        uint64_t time = t_end.time_since_epoch().count() - t_start.time_since_epoch().count() - timer_overhead;
+        if (time < time_CalcSubtreeDepth) {
+            time_CalcSubtreeDepth = time;
+        }
+
+        t_start = high_resolution_clock::now();
+        [[ maybe_unused ]] int errors = t->CheckSubtreeConsistency();
+        t_end = high_resolution_clock::now();
+        time = t_end.time_since_epoch().count() - t_start.time_since_epoch().count() - timer_overhead;
+        if (time < time_CheckSubtreeConsistency) {
+            time_CheckSubtreeConsistency = time;
+        }
+
+        unsigned componentSize = 0, relationSize = 0;
+        t_start = high_resolution_clock::now();
+        t->CalcSubtreeSize(&componentSize, &relationSize);
+        t_end = high_resolution_clock::now();
+        time = t_end.time_since_epoch().count() - t_start.time_since_epoch().count() - timer_overhead;
+        if (time < time_CalcSubtreeSize) {
+            time_CalcSubtreeSize = time;
+        }
+    }
+
+    // nearest shared Cache of all pairs of Threads, by walking the ancestors and with interval labels
+    std::vector<Component*> threads;
+    t->FindDescendantsByType(&threads, ComponentType::Thread);
+    uint64_t time_sharedCache = UINT64_MAX;
+    uint64_t time_sharedCache_labels = UINT64_MAX;
+    for (int i = 0; i < 10; i++) {
+        if (i == 5)
+            t->EnableSubtreeIndex()->UpdateIntervalLabels();
+        t_start = high_resolution_clock::now();
+        for (Component* a : threads)
+            for (Component* b : threads)
+                a->FindLowestCommonAncestor(b, ComponentType::Cache);
+        t_end = high_resolution_clock::now();
+        uint64_t time = t_end.time_since_epoch().count() - t_start.time_since_epoch().count() - timer_overhead;
+        uint64_t& best = (i < 5 ? time_sharedCache : time_sharedCache_labels);
+        if (time < best) {
+            best = time;
+        }
+    }
+    t->DisableSubtreeIndex();
+
+    // a synthetic cluster (512 Nodes), traversed serially and in parallel
+    Topology* cluster = new Topology();
+    for (int n = 0; n < 512; n++) {
+        Node* node = new Node(cluster, n);
+        for (int c = 0; c < 2; c++) {
+            Cache* l3 = new Cache(new Chip(node, c), c, 3);
+            for (int k = 0; k < 32; k++) {
+                Core* core = new Core(new Cache(l3, k, 2), k);
+                new Thread(core, 2 * k);
+                new Thread(core, 2 * k + 1);
+            }
+        }
+    }
+    ParallelTraversal parallel;
+    std::vector<Component*> clusterComponents;
+    uint64_t time_clusterGetAllComponentsList = UINT64_MAX;
+    uint64_t time_clusterGetAllComponentsList_parallel = UINT64_MAX;
+    uint64_t time_clusterCalcSubtreeSize = UINT64_MAX;
+    uint64_t time_clusterCalcSubtreeSize_parallel = UINT64_MAX;
+    for (int i = 0; i < 10; i++) {
+        clusterComponents.clear();
+        t_start = high_resolution_clock::now();
+        cluster->FindDescendantsByType(&clusterComponents, ComponentType::Any);
+        t_end = high_resolution_clock::now();
+        uint64_t time = t_end.time_since_epoch().count() - t_start.time_since_epoch().count() - timer_overhead;
+        if (time < time_clusterGetAllComponentsList) {
+            time_clusterGetAllComponentsList = time;
+        }
+
+        clusterComponents.clear();
+        t_start = high_resolution_clock::now();
+        cluster->FindDescendantsByType(&clusterComponents, ComponentType::Any, parallel);
+        t_end = high_resolution_clock::now();
+        time = t_end.time_since_epoch().count() - t_start.time_since_epoch().count() - timer_overhead;
+        if (time < time_clusterGetAllComponentsList_parallel) {
+            time_clusterGetAllComponentsList_parallel = time;
+        }
+
+        unsigned componentSize = 0, relationSize = 0;
+        t_start = high_resolution_clock::now();
+        cluster->CalcSubtreeSize(&componentSize, &relationSize);
+        t_end = high_resolution_clock::now();
+        time = t_end.time_since_epoch().count() - t_start.time_since_epoch().count() - timer_overhead;
+        if (time < time_clusterCalcSubtreeSize) {
+            time_clusterCalcSubtreeSize = time;
+        }
+
+        t_start = high_resolution_clock::now();
+        cluster->CalcSubtreeSize(&componentSize, &relationSize, parallel);
+        t_end = high_resolution_clock::now();
+        time = t_end.time_since_epoch().count() - t_start.time_since_epoch().count() - timer_overhead;
+        if (time < time_clusterCalcSubtreeSize_parallel) {
+            time_clusterCalcSubtreeSize_parallel = time;
+        }
+    }
+    cluster->Delete(true);
+
+    // a long chain of Generic components (too deep for recursive traversal)
+    const int deepChainLength = 1000000;
+    Component* deepRoot = new Component(0);
+    Component* deepLeaf = deepRoot;
+    for (int i = 1; i <= deepChainLength; i++)
+        deepLeaf = new Component(deepLeaf, i);
+    t_start = high_resolution_clock::now();
+    [[ maybe_unused ]] int deepChainDepth = deepRoot->CalcSubtreeDepth();
+    t_end = high_resolution_clock::now();
+    uint64_t time_deepChainCalcSubtreeDepth = t_end.time_since_epoch().count() - t_start.time_since_epoch().count() - timer_overhead;
+    t_start = high_resolution_clock::now();
+    deepRoot->Delete(true);
+    t_end = high_resolution_clock::now();
+    uint64_t time_deepChainDelete = t_end.time_since_epoch().count() - t_start.time_since_epoch().count() - timer_overhead;
+
+    // a wide Node (4096 Threads), whose Threads are moved below Cores of 8 Threads each
+    Node* wideNode = new Node(0);
+    wideNode->SetStableChildrenOrder(false);
+    std::vector<Component*> wideThreads;
+    for (int i = 0; i < 4096; i++)
+        wideThreads.push_back(new Thread(wideNode, i));
+    t_start = high_resolution_clock::now();
+    for (int i = 0; i < 4096; i += 8) {
+        Core* core = new Core(i / 8);
+        core->InsertBetweenParentAndChildren(wideNode, std::vector<Component*>(wideThreads.begin() + i, wideThreads.begin() + i + 8), false);
+    }
+    t_end = high_resolution_clock::now();
+    uint64_t time_wideNodeRegroupChildren = t_end.time_since_epoch().count() - t_start.time_since_epoch().count() - timer_overhead;
+    wideNode->Delete(true);
+
+    // a hub with 100k DataPaths to 1000 Memories: deleted one by one in creation order, and half of them at once with a predicate
+    const int hubDataPaths = 100000;
+    Node* hub = new Node(0);
+    std::vector<Component*> hubTargets;
+    for (int i = 0; i < 1000; i++)
+        hubTargets.push_back(new Memory(hub, i));
+    std::vector<DataPath*> hubPaths;
+    for (int i = 0; i < hubDataPaths; i++)
+        hubPaths.push_back(new DataPath(hub, hubTargets[i % 1000], DataPathOrientation::Oriented, DataPathType::Physical, i, 1));
+    //memory per DataPath (measured): the endpoints are stored inline
+    MemoryFootprint hubFootprint;
+    hub->CalcFootprint(&hubFootprint);
+    size_t dataPathSize = hubFootprint.relationTypes[RelationType::DataPath] / hubDataPaths;
+    //not measured: the same DataPath with a std::vector for the endpoints and for their slots (two more heap blocks), computed from the sizes of the members (without allocator overhead)
+    size_t dataPathSize_vectors_estimate = dataPathSize - sizeof(RelationComponents) - sizeof(InlineVector<uint32_t, 2>)
+        + sizeof(std::vector<Component*>) + 2 * sizeof(Component*) + sizeof(std::vector<uint32_t>) + 2 * sizeof(uint32_t);
+    t_start = high_resolution_clock::now();
+    for (DataPath* dp : hubPaths)
+        dp->Delete();
+    t_end = high_resolution_clock::now();
+    uint64_t time_deleteDataPaths = t_end.time_since_epoch().count() - t_start.time_since_epoch().count() - timer_overhead;
+    for (int i = 0; i < hubDataPaths; i++)
+        new DataPath(hub, hubTargets[i % 1000], DataPathOrientation::Oriented, DataPathType::Physical, i, 1);
+    t_start = high_resolution_clock::now();
+    hub->DeleteRelations(RelationType::DataPath, [](Relation* r){ return static_cast<DataPath*>(r)->GetBandwidth() < hubDataPaths / 2; });
+    t_end = high_resolution_clock::now();
+    uint64_t time_bulkDeleteDataPaths = t_end.time_since_epoch().count() - t_start.time_since_epoch().count() - timer_overhead;
+    hub->Delete(true);
+
     //get num mt4g DataPaths
     int mt4g_dataPaths = 0;
     std::vector<DataPath*> componentDataPaths;
@@ -321,6 +704,26 @@ int main(int argc, char *argv[])
     cout << "time_avg_readAttribute, "
         << duration_cast<nanoseconds>(nanoseconds(avg_time_readAttribute)).count()
         << " ns" << endl;
+    cout << "time_avg_updateTypedAttribute, "
+        << duration_cast<nanoseconds>(nanoseconds(avg_time_updateTypedAttribute)).count()
+        << " ns" << endl;
+    cout << "time_avg_readTypedAttribute, "
+        << duration_cast<nanoseconds>(nanoseconds(avg_time_readTypedAttribute)).count()
+        << " ns" << endl;
+    cout << "time_avg_updateUnindexedAttribute, "
+        << duration_cast<nanoseconds>(nanoseconds(avg_time_updateUnindexedAttribute)).count()
+        << " ns" << endl;
+    cout << "time_avg_updateIndexedAttribute, "
+        << duration_cast<nanoseconds>(nanoseconds(avg_time_updateIndexedAttribute)).count()
+        << " ns" << endl;
+    cout << "time_buildAttribIndex, "
+        << duration_cast<nanoseconds>(nanoseconds(time_buildAttribIndex)).count()
+        << " ns" << endl;
+    cout << "time_findAttributeByScan, "
+        << duration_cast<nanoseconds>(nanoseconds(time_findAttributeByScan)).count()
+        << " ns, time_findAttributeByIndex, "
+        << duration_cast<nanoseconds>(nanoseconds(time_findAttributeByIndex)).count()
+        << " ns, found, " << num_found << endl;
     cout << "time_parseHwlocOutput, "
         << duration_cast<nanoseconds>(nanoseconds(time_parseHwlocOutput)).count()
         << " ns" << endl;
@@ -343,6 +746,83 @@ int main(int argc, char *argv[])
         << duration_cast<nanoseconds>(nanoseconds(time_GetAllComponentsList))
                 .count()
         << " ns" << endl;
+    cout << ", time_GetAllComponentsList_indexed, "
+        << duration_cast<nanoseconds>(nanoseconds(time_GetAllComponentsList_indexed))
+                .count()
+        << " ns" << endl;
+    cout << ", time_CountAllThreads, "
+        << duration_cast<nanoseconds>(nanoseconds(time_CountAllThreads))
+                .count()
+        << " ns" << endl;
+    cout << ", time_CountAllThreads_indexed, "
+        << duration_cast<nanoseconds>(nanoseconds(time_CountAllThreads_indexed))
+                .count()
+        << " ns" << endl;
+    cout << ", time_Freeze, "
+        << duration_cast<nanoseconds>(nanoseconds(time_Freeze))
+                .count()
+        << " ns" << endl;
+    cout << ", time_CountAllThreads_frozen, "
+        << duration_cast<nanoseconds>(nanoseconds(time_CountAllThreads_frozen))
+                .count()
+        << " ns" << endl;
+
+    cout << ", time_CalcSubtreeDepth, "
+        << duration_cast<nanoseconds>(nanoseconds(time_CalcSubtreeDepth))
+                .count()
+        << " ns" << endl;
+    cout << ", time_CheckSubtreeConsistency, "
+        << duration_cast<nanoseconds>(nanoseconds(time_CheckSubtreeConsistency))
+                .count()
+        << " ns" << endl;
+    cout << ", time_CalcSubtreeSize, "
+        << duration_cast<nanoseconds>(nanoseconds(time_CalcSubtreeSize))
+                .count()
+        << " ns" << endl;
+    cout << ", time_sharedCache, "
+        << duration_cast<nanoseconds>(nanoseconds(time_sharedCache))
+                .count()
+        << " ns" << endl;
+    cout << ", time_sharedCache_labels, "
+        << duration_cast<nanoseconds>(nanoseconds(time_sharedCache_labels))
+                .count()
+        << " ns" << endl;
+    cout << ", time_clusterGetAllComponentsList, "
+        << duration_cast<nanoseconds>(nanoseconds(time_clusterGetAllComponentsList))
+                .count()
+        << " ns" << endl;
+    cout << ", time_clusterGetAllComponentsList_parallel, "
+        << duration_cast<nanoseconds>(nanoseconds(time_clusterGetAllComponentsList_parallel))
+                .count()
+        << " ns" << endl;
+    cout << ", time_clusterCalcSubtreeSize, "
+        << duration_cast<nanoseconds>(nanoseconds(time_clusterCalcSubtreeSize))
+                .count()
+        << " ns" << endl;
+    cout << ", time_clusterCalcSubtreeSize_parallel, "
+        << duration_cast<nanoseconds>(nanoseconds(time_clusterCalcSubtreeSize_parallel))
+                .count()
+        << " ns" << endl;
+    cout << ", time_deepChainCalcSubtreeDepth, "
+        << duration_cast<nanoseconds>(nanoseconds(time_deepChainCalcSubtreeDepth))
+                .count()
+        << " ns" << endl;
+    cout << ", time_deepChainDelete, "
+        << duration_cast<nanoseconds>(nanoseconds(time_deepChainDelete))
+                .count()
+        << " ns" << endl;
+    cout << ", time_wideNodeRegroupChildren, "
+        << duration_cast<nanoseconds>(nanoseconds(time_wideNodeRegroupChildren))
+                .count()
+        << " ns" << endl;
+    cout << ", time_deleteDataPaths, "
+        << duration_cast<nanoseconds>(nanoseconds(time_deleteDataPaths))
+                .count()
+        << " ns" << endl;
+    cout << ", time_bulkDeleteDataPaths, "
+        << duration_cast<nanoseconds>(nanoseconds(time_bulkDeleteDataPaths))
+                .count()
+        << " ns" << endl;
 
     cout << ", hwloc_components, " << hwlocComponentList.size() << endl;
     cout << ", caps_dataPaths, " << caps_dataPaths << endl;
@@ -353,6 +833,12 @@ int main(int argc, char *argv[])
     cout << ", time_getNumaMaxBw, "
         << duration_cast<nanoseconds>(nanoseconds(time_getNumaMaxBw)).count()
         << " ns" << endl;
+    cout << ", time_getNumaMaxBw_dense, "
+        << duration_cast<nanoseconds>(nanoseconds(time_getNumaMaxBw_dense)).count()
+        << " ns" << endl;
+    cout << ", time_findNumaDataPath, "
+        << duration_cast<nanoseconds>(nanoseconds(time_findNumaDataPath)).count()
+        << " ns" << endl;
     if (false)
         cout << "; bw; " << max_bw << "; ComponentId; " << max_bw_component->GetId()
             << endl;
@@ -361,9 +847,21 @@ int main(int argc, char *argv[])
                 .count()
         << " ns" << endl;
 
+    cout << ", time_buildAndDeleteSubtree, "
+        << duration_cast<nanoseconds>(nanoseconds(time_buildAndDeleteSubtree))
+                .count()
+        << " ns" << endl;
+    cout << ", time_buildAndReleaseArena, "
+        << duration_cast<nanoseconds>(nanoseconds(time_buildAndReleaseArena))
+                .count()
+        << " ns" << endl;
+
     cout << ", hwloc_component_size[B], " << hwloc_component_size << endl;
     cout << ", caps_numa_dataPathSize[B], " << caps_numa_dataPathSize << endl;
+    cout << ", dataPathSize[B], " << dataPathSize << endl;
     cout << ", total_size, " << total_size << endl;
+    //computed, not measured (see above)
+    cout << ", dataPathSize_vectors_estimate[B], " << dataPathSize_vectors_estimate << endl;
 
     cout << endl;
 
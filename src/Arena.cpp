@@ -0,0 +1,139 @@
+#include "Arena.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <iostream>
+
+namespace {
+    constexpr size_t slabBytes = 64 * 1024; /**< target size of one slab */
+    constexpr size_t minSlotsPerSlab = 16;
+
+    size_t alignUp(size_t size, size_t alignment) { return (size + alignment - 1) / alignment * alignment; }
+}
+
+sys_sage::SlabPool::SlabPool(size_t _objectSize, void (*_destroy)(void*)) : objectSize(_objectSize), destroy(_destroy)
+{
+    slotSize = sizeof(SlotHeader) + alignUp(std::max(objectSize, sizeof(void*)), alignof(std::max_align_t));
+    slotsPerSlab = std::max(minSlotsPerSlab, slabBytes / slotSize);
+}
+
+sys_sage::SlabPool::~SlabPool() { Release(); }
+
+void* sys_sage::SlabPool::Allocate()
+{
+    char* slot;
+    if(freeList != nullptr)
+    {
+        void* obj = freeList;
+        freeList = *reinterpret_cast<void**>(obj);
+        slot = static_cast<char*>(obj) - sizeof(SlotHeader);
+    }
+    else
+    {
+        if(slabs.empty() || slotsUsedInLastSlab == slotsPerSlab)
+        {
+            slabs.push_back(static_cast<char*>(::operator new(slotsPerSlab * slotSize)));
+            slotsUsedInLastSlab = 0;
+        }
+        slot = slabs.back() + slotsUsedInLastSlab * slotSize;
+        slotsUsedInLastSlab++;
+    }
+    reinterpret_cast<SlotHeader*>(slot)->live = true;
+    numObjects++;
+    return slot + sizeof(SlotHeader);
+}
+
+void sys_sage::SlabPool::Free(void* obj)
+{
+    SlotHeader* header = reinterpret_cast<SlotHeader*>(static_cast<char*>(obj) - sizeof(SlotHeader));
+    header->live = false;
+    *reinterpret_cast<void**>(obj) = freeList;
+    freeList = obj;
+    numObjects--;
+}
+
+void sys_sage::SlabPool::Release()
+{
+    for(size_t s = 0; s < slabs.size(); s++)
+    {
+        size_t slotsInSlab = (s + 1 == slabs.size()) ? slotsUsedInLastSlab : slotsPerSlab;
+        for(size_t i = 0; i < slotsInSlab; i++)
+        {
+            char* slot = slabs[s] + i * slotSize;
+            if(reinterpret_cast<SlotHeader*>(slot)->live)
+                destroy(slot + sizeof(SlotHeader));
+        }
+        ::operator delete(slabs[s]);
+    }
+    slabs.clear();
+    slotsUsedInLastSlab = 0;
+    freeList = nullptr;
+    numObjects = 0;
+}
+
+size_t sys_sage::SlabPool::GetObjectSize() const { return objectSize; }
+size_t sys_sage::SlabPool::GetNumObjects() const { return numObjects; }
+size_t sys_sage::SlabPool::GetBytesReserved() const { return slabs.size() * slotsPerSlab * slotSize; }
+size_t sys_sage::SlabPool::GetBytesUsed() const { return numObjects * slotSize; }
+
+sys_sage::Arena::~Arena()
+{
+    Release();
+    for(SlabPool* pool : pools)
+        delete pool;
+}
+
+size_t sys_sage::Arena::_NextTypeId()
+{
+    static std::atomic<size_t> nextId { 0 };
+    return nextId++;
+}
+
+sys_sage::SlabPool* sys_sage::Arena::_GetPool(size_t typeId, size_t objectSize, size_t objectAlignment, void (*destroy)(void*))
+{
+    if(typeId >= pools.size())
+        pools.resize(typeId + 1, nullptr);
+    if(pools[typeId] == nullptr)
+    {
+        if(objectAlignment > alignof(std::max_align_t))
+            std::cerr << "WARNING: sys_sage::Arena: over-aligned types are not supported; alignment " << objectAlignment << " is reduced to " << alignof(std::max_align_t) << std::endl;
+        pools[typeId] = new SlabPool(objectSize, destroy);
+    }
+    return pools[typeId];
+}
+
+void sys_sage::Arena::Release()
+{
+    for(SlabPool* pool : pools)
+    {
+        if(pool != nullptr)
+            pool->Release();
+    }
+}
+
+size_t sys_sage::Arena::GetNumObjects() const
+{
+    size_t ret = 0;
+    for(SlabPool* pool : pools)
+        if(pool != nullptr)
+            ret += pool->GetNumObjects();
+    return ret;
+}
+
+size_t sys_sage::Arena::GetBytesReserved() const
+{
+    size_t ret = 0;
+    for(SlabPool* pool : pools)
+        if(pool != nullptr)
+            ret += pool->GetBytesReserved();
+    return ret;
+}
+
+size_t sys_sage::Arena::GetBytesUsed() const
+{
+    size_t ret = 0;
+    for(SlabPool* pool : pools)
+        if(pool != nullptr)
+            ret += pool->GetBytesUsed();
+    return ret;
+}
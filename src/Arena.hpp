@@ -0,0 +1,185 @@
+#ifndef ARENA_HPP
+#define ARENA_HPP
+
+#include <cstddef>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace sys_sage { //forward declaration
+    class Component;
+    class Relation;
+}
+
+namespace sys_sage {
+
+    /**
+     * @class SlabPool
+     * @brief Fixed-size object pool backing one concrete class (e.g. Thread, Cache, DataPath) of an Arena.
+     *
+     * Memory is reserved in slabs holding many objects at once. Freed slots are kept in an intrusive free list and reused by later allocations.
+     * Each slot is preceded by a small header marking whether it holds a live object, so that the whole pool can be destroyed by a linear scan over its slabs.
+     * \n Normally, SlabPools are not used directly, but through Arena::New().
+     */
+    class SlabPool {
+    public:
+        /**
+         * @brief SlabPool constructor.
+         * @param _objectSize Size of one object (in bytes).
+         * @param _destroy Function calling the destructor of one object stored in the pool.
+         */
+        SlabPool(size_t _objectSize, void (*_destroy)(void*));
+        /**
+         * @brief Destroys all live objects and frees all slabs.
+         */
+        ~SlabPool();
+        SlabPool(const SlabPool&) = delete;
+        SlabPool& operator=(const SlabPool&) = delete;
+
+        /**
+         * @brief Returns uninitialized memory for one object. A new slab is reserved only when there is no free slot left.
+         * @return Pointer to the memory of size GetObjectSize()
+         */
+        void* Allocate();
+        /**
+         * @brief Returns the memory of an (already destructed) object to the pool.
+         * @param obj Pointer previously obtained from Allocate()
+         */
+        void Free(void* obj);
+        /**
+         * @brief Calls the destructor of every live object in the pool and frees all slabs at once.
+         * The cost is one linear scan over the slabs, independent of how the objects are connected to each other.
+         */
+        void Release();
+
+        /**
+         * @brief Returns the size of one object in the pool (in bytes).
+         */
+        size_t GetObjectSize() const;
+        /**
+         * @brief Returns the number of live objects in the pool.
+         */
+        size_t GetNumObjects() const;
+        /**
+         * @brief Returns the number of bytes reserved by the slabs of the pool.
+         */
+        size_t GetBytesReserved() const;
+        /**
+         * @brief Returns the number of bytes occupied by live objects (including the slot headers).
+         */
+        size_t GetBytesUsed() const;
+
+    private:
+        struct SlotHeader {
+            alignas(std::max_align_t) bool live; /**< true if the slot holds a constructed object */
+        };
+
+        size_t objectSize; /**< size of the object itself */
+        size_t slotSize; /**< size of the slot (header + object, aligned) */
+        size_t slotsPerSlab; /**< number of slots in each slab */
+        void (*destroy)(void*); /**< calls the destructor of one object */
+
+        std::vector<char*> slabs; /**< all reserved slabs */
+        size_t slotsUsedInLastSlab { 0 }; /**< bump pointer within the last slab */
+        void* freeList { nullptr }; /**< singly-linked list of freed slots (points to the object part of the slot) */
+        size_t numObjects { 0 }; /**< number of live objects */
+    };
+
+    /**
+     * @class Arena
+     * @brief Per-Topology memory arena with one SlabPool per concrete class.
+     *
+     * Components, Relations (e.g. DataPaths) and attribute values allocated via New() are placed in the slabs of their class' pool instead of being allocated separately with new.
+     * Objects allocated from an Arena can still be deleted individually through the usual API (Component::Delete(), Relation::Delete()); their slots are then reused.
+     * Release() drops all objects of the Arena at once, without walking the Component Tree or unlinking Components from each other.
+     * \n The Arena of a Topology is obtained via Topology::GetArena().
+     * @see Topology::GetArena()
+     * @see Topology::ReleaseArena()
+     */
+    class Arena {
+    public:
+        Arena() = default;
+        /**
+         * @brief Destroys all objects still allocated in the Arena and frees its memory.
+         */
+        ~Arena();
+        Arena(const Arena&) = delete;
+        Arena& operator=(const Arena&) = delete;
+
+        /**
+         * @brief Allocates and constructs an object of class T in the SlabPool of T.
+         * Works for Components (e.g. arena.New<Thread>(core, 0)), Relations (e.g. arena.New<DataPath>(src, dst, DataPathOrientation::Oriented)) as well as for attribute values (e.g. arena.New<uint64_t>(42)).
+         * \n Components and Relations remember their pool, so Delete() returns them to the Arena instead of calling delete.
+         * @param args Arguments forwarded to the constructor of T
+         * @return Pointer to the newly constructed object
+         */
+        template <class T, class... Args>
+        T* New(Args&&... args)
+        {
+            SlabPool* pool = _GetPool(_TypeId<T>(), sizeof(T), alignof(T), [](void* p){ static_cast<T*>(p)->~T(); });
+            void* mem = pool->Allocate();
+            T* obj;
+            try {
+                obj = new (mem) T(std::forward<Args>(args)...);
+            } catch (...) {
+                pool->Free(mem);
+                throw;
+            }
+            if constexpr (std::is_base_of_v<Component, T> || std::is_base_of_v<Relation, T>)
+                obj->_SetSlabPool(pool);
+            return obj;
+        }
+
+        /**
+         * @brief Destructs and frees a single object previously allocated with New<T>().
+         * For Components and Relations, use their Delete() methods instead, which also unlink them from the Component Tree.
+         * @param obj Pointer to the object
+         */
+        template <class T>
+        void Delete(T* obj)
+        {
+            if(obj == nullptr)
+                return;
+            obj->~T();
+            _GetPool(_TypeId<T>(), sizeof(T), alignof(T), [](void* p){ static_cast<T*>(p)->~T(); })->Free(obj);
+        }
+
+        /**
+         * @brief Destroys all objects allocated in the Arena at once and frees its memory.
+         * The Component Tree is not traversed -- the caller is responsible for not using any pointer to an object of the Arena afterwards.
+         */
+        void Release();
+
+        /**
+         * @brief Returns the number of live objects in the Arena.
+         */
+        size_t GetNumObjects() const;
+        /**
+         * @brief Returns the number of bytes reserved by all slabs of the Arena.
+         */
+        size_t GetBytesReserved() const;
+        /**
+         * @brief Returns the number of bytes occupied by live objects of the Arena.
+         */
+        size_t GetBytesUsed() const;
+
+    private:
+        /**
+         * @private
+         * @brief Returns a process-wide unique small integer for each class used with New().
+         */
+        template <class T>
+        static size_t _TypeId()
+        {
+            static const size_t id = _NextTypeId();
+            return id;
+        }
+        static size_t _NextTypeId();
+        SlabPool* _GetPool(size_t typeId, size_t objectSize, size_t objectAlignment, void (*destroy)(void*));
+
+        std::vector<SlabPool*> pools; /**< SlabPools indexed by _TypeId<T>(); nullptr for classes never allocated in this Arena */
+    };
+}
+
+#endif
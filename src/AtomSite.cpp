@@ -1 +1,12 @@
 #include "AtomSite.hpp"
+#include "Footprint.hpp"
+
+size_t sys_sage::AtomSite::_GetMembersHeapSize() const
+{
+    size_t size = QuantumBackend::_GetMembersHeapSize() + _MapHeapSize(shuttlingTimes) + _MapHeapSize(shuttlingAverageFidelities);
+    for(const auto& [key, value] : shuttlingTimes)
+        size += _StringHeapSize(key);
+    for(const auto& [key, value] : shuttlingAverageFidelities)
+        size += _StringHeapSize(key);
+    return size;
+}
@@ -0,0 +1,144 @@
+#include "Attrib.hpp"
+
+#include <algorithm>
+#include <deque>
+#include <mutex>
+#include <shared_mutex>
+#include <unordered_map>
+
+#include "Footprint.hpp"
+
+namespace {
+    //process-wide table of interned attribute keys; names are never removed, so the references into the deque stay valid
+    struct AttribKeyTable {
+        std::shared_mutex mutex;
+        std::deque<std::string> names;
+        std::unordered_map<std::string, sys_sage::AttribId> ids;
+    };
+
+    AttribKeyTable& GetAttribKeyTable()
+    {
+        static AttribKeyTable table;
+        return table;
+    }
+}
+
+sys_sage::AttribId sys_sage::InternAttribKey(const std::string& key)
+{
+    AttribKeyTable& table = GetAttribKeyTable();
+    {
+        std::shared_lock lock(table.mutex);
+        auto it = table.ids.find(key);
+        if(it != table.ids.end())
+            return it->second;
+    }
+    std::unique_lock lock(table.mutex);
+    auto [it, inserted] = table.ids.try_emplace(key, static_cast<AttribId>(table.names.size()));
+    if(inserted)
+        table.names.push_back(key);
+    return it->second;
+}
+
+sys_sage::AttribId sys_sage::FindAttribKey(const std::string& key)
+{
+    AttribKeyTable& table = GetAttribKeyTable();
+    std::shared_lock lock(table.mutex);
+    auto it = table.ids.find(key);
+    return (it != table.ids.end()) ? it->second : invalidAttribId;
+}
+
+const std::string& sys_sage::GetAttribKeyName(AttribId id)
+{
+    AttribKeyTable& table = GetAttribKeyTable();
+    std::shared_lock lock(table.mutex);
+    return table.names.at(id);
+}
+
+std::vector<sys_sage::AttribStore::Entry>::const_iterator sys_sage::AttribStore::_LowerBound(AttribId id) const
+{
+    return std::lower_bound(entries.begin(), entries.end(), id, [](const Entry& e, AttribId i){ return e.first < i; });
+}
+
+const sys_sage::AttribValue* sys_sage::AttribStore::Find(AttribId id) const
+{
+    auto it = _LowerBound(id);
+    return (it != entries.end() && it->first == id) ? &it->second : nullptr;
+}
+
+sys_sage::AttribValue* sys_sage::AttribStore::Find(AttribId id)
+{
+    return const_cast<AttribValue*>(std::as_const(*this).Find(id));
+}
+
+void sys_sage::AttribStore::Set(AttribId id, AttribValue value)
+{
+    auto it = entries.begin() + (_LowerBound(id) - entries.cbegin());
+    if(it != entries.end() && it->first == id)
+        it->second = std::move(value);
+    else
+        entries.emplace(it, id, std::move(value));
+}
+
+bool sys_sage::AttribStore::Erase(AttribId id)
+{
+    auto it = _LowerBound(id);
+    if(it == entries.end() || it->first != id)
+        return false;
+    entries.erase(it);
+    return true;
+}
+
+bool sys_sage::_AttribMapEquals(const std::map<std::string, void*>& attrib, const std::string& key, const AttribValue& value)
+{
+    auto it = attrib.find(key);
+    if(it == attrib.end() || it->second == nullptr)
+        return false;
+    return std::visit([&](const auto& v){
+        using V = std::decay_t<decltype(v)>;
+        if constexpr (std::is_same_v<V, AttribPtr>)
+            return v.get() == it->second;
+        else
+            return *static_cast<const V*>(it->second) == v;
+    }, value);
+}
+
+void sys_sage::_SetOwnedAttrib(std::map<std::string, void*>& attrib, AttribStore& owners, const std::string& key, void* value, void (*deleter)(void*))
+{
+    attrib[key] = value;
+    AttribId id = InternAttribKey(key);
+    //setting the owned value again must not free it
+    if(const AttribValue* owner = owners.Find(id); owner != nullptr && std::get<AttribPtr>(*owner).get() == value)
+        return;
+    owners.Set(id, AttribPtr(value, deleter));
+}
+
+bool sys_sage::_EraseOwnedAttrib(std::map<std::string, void*>& attrib, AttribStore& owners, const std::string& key)
+{
+    auto it = attrib.find(key);
+    if(it == attrib.end())
+        return false;
+    attrib.erase(it);
+    AttribId id = FindAttribKey(key);
+    if(id != invalidAttribId)
+        owners.Erase(id);
+    return true;
+}
+
+bool sys_sage::_OwnsAttrib(const std::map<std::string, void*>& attrib, const AttribStore& owners, const std::string& key)
+{
+    auto it = attrib.find(key);
+    AttribId id = FindAttribKey(key);
+    if(it == attrib.end() || id == invalidAttribId)
+        return false;
+    const AttribValue* owner = owners.Find(id);
+    return owner != nullptr && std::get<AttribPtr>(*owner).get() == it->second;
+}
+
+size_t sys_sage::_AttribValueHeapSize(const AttribValue& value)
+{
+    if(const std::string* s = std::get_if<std::string>(&value))
+        return _StringHeapSize(*s);
+    if(const std::vector<double>* v = std::get_if<std::vector<double>>(&value))
+        return _VectorHeapSize(*v);
+    return 0;
+}
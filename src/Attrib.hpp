@@ -0,0 +1,153 @@
+#ifndef ATTRIB_HPP
+#define ATTRIB_HPP
+
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <variant>
+#include <vector>
+
+namespace sys_sage {
+
+    /**
+     * @brief Interned attribute key: a small integer standing for an attribute name (see InternAttribKey()).
+     * The same name is always mapped to the same AttribId, for all components and Relations of the process.
+     */
+    using AttribId = uint32_t;
+    /**
+     * @brief AttribId of no attribute key (returned by FindAttribKey() for names that were never interned).
+     */
+    constexpr AttribId invalidAttribId = UINT32_MAX;
+
+    /**
+     * @brief Returns the AttribId of an attribute name, interning the name on its first use. Thread-safe.
+     * @param key Name of the attribute
+     */
+    AttribId InternAttribKey(const std::string& key);
+    /**
+     * @brief Returns the AttribId of an attribute name, or invalidAttribId if the name was never interned. Thread-safe.
+     * @param key Name of the attribute
+     */
+    AttribId FindAttribKey(const std::string& key);
+    /**
+     * @brief Returns the name of an interned attribute key. Thread-safe; the returned reference stays valid for the lifetime of the process.
+     * @param id AttribId returned by InternAttribKey()
+     */
+    const std::string& GetAttribKeyName(AttribId id);
+
+    /**
+     * @brief Opaque attribute value of any other type, freed by its deleter when the last AttribStore holding it releases it.
+     */
+    using AttribPtr = std::shared_ptr<void>;
+    /**
+     * @brief Value of a typed attribute. The alternatives are stored inline in the AttribStore; only strings, vectors and opaque values own heap memory.
+     */
+    using AttribValue = std::variant<int, int64_t, double, std::string, std::vector<double>, AttribPtr>;
+
+    /**
+     * @class AttribStore
+     * @brief Typed attributes of a component or Relation, kept in a flat vector sorted by AttribId.
+     *
+     * Compared to the attrib map (std::map<std::string, void*>), a lookup by AttribId is a binary search over a few integers in one contiguous block, values are stored inline (no allocation per value), and the type of each value is known.
+     * \n Copies of an AttribStore share the opaque values (AttribPtr) and copy all other values.
+     * @see Component::GetAttr(), Component::SetAttr()
+     */
+    class AttribStore {
+    public:
+        using Entry = std::pair<AttribId, AttribValue>;
+
+        /**
+         * @brief Returns the value of the attribute, or nullptr if it is not set.
+         */
+        const AttribValue* Find(AttribId id) const;
+        /**
+         * @brief Returns the value of the attribute, or nullptr if it is not set.
+         */
+        AttribValue* Find(AttribId id);
+        /**
+         * @brief Sets the value of the attribute (replacing the old one, if any).
+         */
+        void Set(AttribId id, AttribValue value);
+        /**
+         * @brief Removes the attribute (releasing its value).
+         * @return Whether the attribute was set
+         */
+        bool Erase(AttribId id);
+        /**
+         * @brief Removes all attributes.
+         */
+        void Clear() { entries.clear(); }
+
+        size_t Size() const { return entries.size(); }
+        bool Empty() const { return entries.empty(); }
+        /**
+         * @brief Returns the entries (AttribId and value), sorted by AttribId.
+         */
+        const std::vector<Entry>& GetEntries() const { return entries; }
+
+    private:
+        std::vector<Entry>::const_iterator _LowerBound(AttribId id) const;
+
+        std::vector<Entry> entries; /**< Sorted by AttribId */
+    };
+
+    /**
+     * @private
+     * @brief Returns a pointer to the value of an attribute as T, looking up the typed attributes first and the attrib map second (shared implementation of Component::GetAttr() and Relation::GetAttr()).
+     * If T is one of the alternatives of AttribValue, a typed value of another alternative yields nullptr. Opaque values (AttribPtr) and values of the attrib map are cast to T without a check, like the attrib map itself.
+     */
+    template <class T>
+    T* _GetAttr(const AttribStore& attrs, const std::map<std::string, void*>& attrib, AttribId id, const std::string* key)
+    {
+        const AttribValue* value = (id != invalidAttribId) ? attrs.Find(id) : nullptr;
+        if(value != nullptr)
+        {
+            if constexpr (std::is_same_v<T, int> || std::is_same_v<T, int64_t> || std::is_same_v<T, double> || std::is_same_v<T, std::string> || std::is_same_v<T, std::vector<double>>)
+            {
+                if(const T* v = std::get_if<T>(value))
+                    return const_cast<T*>(v);
+            }
+            if(const AttribPtr* p = std::get_if<AttribPtr>(value))
+                return static_cast<T*>(p->get());
+            return nullptr;
+        }
+        if(attrib.empty())
+            return nullptr;
+        auto it = (key != nullptr) ? attrib.find(*key) : attrib.find(GetAttribKeyName(id));
+        return (it != attrib.end()) ? static_cast<T*>(it->second) : nullptr;
+    }
+    /**
+     * @private
+     * @brief Returns whether attrib[key] exists and equals value, reading it as the alternative that value holds (the fallback of typed lookups such as Component::UpsertDataPath(), see _GetAttr()).
+     * Like the attrib map itself, the type of attrib[key] is not checked; an opaque value (AttribPtr) equals it if it points to the same object.
+     */
+    bool _AttribMapEquals(const std::map<std::string, void*>& attrib, const std::string& key, const AttribValue& value);
+
+    /**
+     * @private
+     * @brief Sets attrib[key] to value and records its ownership in owners, releasing the previously owned value of key (shared implementation of Component::SetAttrib() and Relation::SetAttrib()).
+     */
+    void _SetOwnedAttrib(std::map<std::string, void*>& attrib, AttribStore& owners, const std::string& key, void* value, void (*deleter)(void*));
+    /**
+     * @private
+     * @brief Removes attrib[key] and releases its owned value, if any (shared implementation of Component::EraseAttrib() and Relation::EraseAttrib()).
+     * @return Whether attrib contained key
+     */
+    bool _EraseOwnedAttrib(std::map<std::string, void*>& attrib, AttribStore& owners, const std::string& key);
+    /**
+     * @private
+     * @brief Returns whether attrib[key] is owned, i.e. was set with SetAttrib() and not replaced since.
+     */
+    bool _OwnsAttrib(const std::map<std::string, void*>& attrib, const AttribStore& owners, const std::string& key);
+
+    /**
+     * @private
+     * @brief Returns the heap memory owned by a typed attribute value (0 for opaque values, whose size is not known).
+     */
+    size_t _AttribValueHeapSize(const AttribValue& value);
+}
+
+#endif
@@ -0,0 +1,276 @@
+#include "AttribIndex.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <mutex>
+#include <shared_mutex>
+
+#include "Component.hpp"
+#include "Relation.hpp"
+#include "Footprint.hpp"
+
+namespace {
+    //process-wide registry of the indices of objects of type T, by attribute key
+    template <class T>
+    struct AttribIndexRegistry {
+        std::shared_mutex mutex;
+        std::unordered_map<sys_sage::AttribId, std::vector<sys_sage::AttribIndex<T>*>> indices;
+        std::atomic<size_t> numIndices { 0 }; /**< Checked without the lock, so that SetAttr() is not slowed down while no index exists */
+    };
+
+    //never destroyed, so that components deleted during static destruction can still unregister
+    template <class T>
+    AttribIndexRegistry<T>& GetAttribIndexRegistry()
+    {
+        static AttribIndexRegistry<T>* registry = new AttribIndexRegistry<T>();
+        return *registry;
+    }
+
+    //compares an integer and a (non-NaN) double exactly: -1, 0 or 1
+    int CompareNumeric(int64_t i, double d)
+    {
+        //doubles outside of [-2^63, 2^63) are beyond every int64_t
+        if(d >= 9223372036854775808.0)
+            return -1;
+        if(d < -9223372036854775808.0)
+            return 1;
+        double whole = std::trunc(d);
+        int64_t wholeInt = static_cast<int64_t>(whole);
+        if(i != wholeInt)
+            return i < wholeInt ? -1 : 1;
+        return whole < d ? -1 : (whole > d ? 1 : 0);
+    }
+}
+
+template <class T>
+bool sys_sage::AttribIndex<T>::KeyLess::operator()(const Key& a, const Key& b) const
+{
+    if(const std::string* sa = std::get_if<std::string>(&a))
+    {
+        const std::string* sb = std::get_if<std::string>(&b);
+        return sb != nullptr && *sa < *sb;
+    }
+    if(std::holds_alternative<std::string>(b))
+        return true;
+    if(const int64_t* ia = std::get_if<int64_t>(&a))
+    {
+        if(const int64_t* ib = std::get_if<int64_t>(&b))
+            return *ia < *ib;
+        return CompareNumeric(*ia, std::get<double>(b)) < 0;
+    }
+    double da = std::get<double>(a);
+    if(const int64_t* ib = std::get_if<int64_t>(&b))
+        return CompareNumeric(*ib, da) > 0;
+    return da < std::get<double>(b);
+}
+
+template <class T>
+sys_sage::AttribIndex<T>::AttribIndex(const std::string& _key) : AttribIndex(InternAttribKey(_key)) {}
+
+template <class T>
+sys_sage::AttribIndex<T>::AttribIndex(AttribId _key) : key(_key)
+{
+    AttribIndexRegistry<T>& registry = GetAttribIndexRegistry<T>();
+    std::unique_lock lock(registry.mutex);
+    registry.indices[key].push_back(this);
+    registry.numIndices++;
+}
+
+template <class T>
+sys_sage::AttribIndex<T>::~AttribIndex()
+{
+    AttribIndexRegistry<T>& registry = GetAttribIndexRegistry<T>();
+    std::unique_lock lock(registry.mutex);
+    auto it = registry.indices.find(key);
+    if(it == registry.indices.end())
+        return;
+    std::erase(it->second, this);
+    if(it->second.empty())
+        registry.indices.erase(it);
+    registry.numIndices--;
+}
+
+template <class T>
+sys_sage::AttribId sys_sage::AttribIndex<T>::GetKey() const { return key; }
+
+template <class T>
+size_t sys_sage::AttribIndex<T>::AddSubtree(Component* root)
+{
+    size_t numIndexed = Size();
+    Component::WalkSubtree(root, [this](Component* c, int){
+        if constexpr (std::is_same_v<T, Component>)
+        {
+            if(const AttribValue* value = c->GetAttribStore().Find(key))
+                _Update(c, value);
+        }
+        else
+        {
+            c->ForEachRelation([this](Relation* r){
+                if(const AttribValue* value = r->GetAttribStore().Find(key))
+                    _Update(r, value);
+            });
+        }
+    }, [](Component*, int){});
+    return Size() - numIndexed;
+}
+
+template <class T>
+size_t sys_sage::AttribIndex<T>::Size() const
+{
+    std::shared_lock lock(mutex);
+    return positions.size();
+}
+
+template <class T>
+std::vector<T*> sys_sage::AttribIndex<T>::Find(const AttribValue& value) const
+{
+    std::vector<T*> found;
+    std::optional<Key> k = _ToKey(value);
+    if(!k)
+        return found;
+    std::shared_lock lock(mutex);
+    auto [first, last] = entries.equal_range(*k);
+    for(auto it = first; it != last; ++it)
+        found.push_back(it->second);
+    return found;
+}
+
+template <class T>
+size_t sys_sage::AttribIndex<T>::Count(const AttribValue& value) const
+{
+    std::optional<Key> k = _ToKey(value);
+    if(!k)
+        return 0;
+    std::shared_lock lock(mutex);
+    return entries.count(*k);
+}
+
+template <class T>
+std::vector<T*> sys_sage::AttribIndex<T>::FindRange(const AttribValue& from, const AttribValue& to) const
+{
+    std::vector<T*> found;
+    std::optional<Key> kFrom = _ToKey(from), kTo = _ToKey(to);
+    if(!kFrom || !kTo || !KeyLess()(*kFrom, *kTo))
+        return found;
+    std::shared_lock lock(mutex);
+    for(auto it = entries.lower_bound(*kFrom), last = entries.lower_bound(*kTo); it != last; ++it)
+        found.push_back(it->second);
+    return found;
+}
+
+template <class T>
+size_t sys_sage::AttribIndex<T>::GetFootprint() const
+{
+    std::shared_lock lock(mutex);
+    size_t size = sizeof(AttribIndex) + _MapHeapSize(entries) + _UnorderedMapHeapSize(positions);
+    for(const auto& [k, t] : entries)
+        if(const std::string* s = std::get_if<std::string>(&k))
+            size += _StringHeapSize(*s);
+    return size;
+}
+
+template <class T>
+sys_sage::AttribIndex<T>* sys_sage::AttribIndex<T>::Get(AttribId key)
+{
+    AttribIndexRegistry<T>& registry = GetAttribIndexRegistry<T>();
+    if(registry.numIndices.load(std::memory_order_relaxed) == 0)
+        return nullptr;
+    std::shared_lock lock(registry.mutex);
+    auto it = registry.indices.find(key);
+    return (it != registry.indices.end()) ? it->second.front() : nullptr;
+}
+
+template <class T>
+void sys_sage::AttribIndex<T>::_Update(T* t, const AttribValue* value)
+{
+    std::optional<Key> k;
+    if(value != nullptr)
+        k = _ToKey(*value);
+    std::unique_lock lock(mutex);
+    auto pos = positions.find(t);
+    if(pos == positions.end())
+    {
+        if(k)
+            positions.emplace(t, entries.emplace(std::move(*k), t));
+        return;
+    }
+    //unchanged value: keep the position among equal values
+    if(k && pos->second->first == *k)
+        return;
+    entries.erase(pos->second);
+    if(k)
+        pos->second = entries.emplace(std::move(*k), t);
+    else
+        positions.erase(pos);
+}
+
+template <class T>
+std::optional<typename sys_sage::AttribIndex<T>::Key> sys_sage::AttribIndex<T>::_ToKey(const AttribValue& value)
+{
+    if(const int* i = std::get_if<int>(&value))
+        return Key(static_cast<int64_t>(*i));
+    if(const int64_t* i = std::get_if<int64_t>(&value))
+        return Key(*i);
+    if(const double* d = std::get_if<double>(&value))
+        return std::isnan(*d) ? std::nullopt : std::optional<Key>(Key(*d));
+    if(const std::string* s = std::get_if<std::string>(&value))
+        return Key(*s);
+    return std::nullopt;
+}
+
+template <class T>
+void sys_sage::_UpdateAttribIndices(T* t, AttribId key)
+{
+    AttribIndexRegistry<T>& registry = GetAttribIndexRegistry<T>();
+    if(registry.numIndices.load(std::memory_order_relaxed) == 0)
+        return;
+    std::shared_lock lock(registry.mutex);
+    auto it = registry.indices.find(key);
+    if(it == registry.indices.end())
+        return;
+    const AttribValue* value = t->GetAttribStore().Find(key);
+    for(AttribIndex<T>* index : it->second)
+        index->_Update(t, value);
+}
+
+template <class T>
+void sys_sage::_AddToAttribIndices(T* t)
+{
+    AttribIndexRegistry<T>& registry = GetAttribIndexRegistry<T>();
+    if(registry.numIndices.load(std::memory_order_relaxed) == 0)
+        return;
+    std::shared_lock lock(registry.mutex);
+    for(const auto& [key, value] : t->GetAttribStore().GetEntries())
+    {
+        auto it = registry.indices.find(key);
+        if(it != registry.indices.end())
+            for(AttribIndex<T>* index : it->second)
+                index->_Update(t, &value);
+    }
+}
+
+template <class T>
+void sys_sage::_RemoveFromAttribIndices(T* t)
+{
+    AttribIndexRegistry<T>& registry = GetAttribIndexRegistry<T>();
+    if(registry.numIndices.load(std::memory_order_relaxed) == 0)
+        return;
+    std::shared_lock lock(registry.mutex);
+    for(const auto& [key, value] : t->GetAttribStore().GetEntries())
+    {
+        auto it = registry.indices.find(key);
+        if(it != registry.indices.end())
+            for(AttribIndex<T>* index : it->second)
+                index->_Update(t, nullptr);
+    }
+}
+
+template class sys_sage::AttribIndex<sys_sage::Component>;
+template class sys_sage::AttribIndex<sys_sage::Relation>;
+template void sys_sage::_UpdateAttribIndices(Component*, AttribId);
+template void sys_sage::_UpdateAttribIndices(Relation*, AttribId);
+template void sys_sage::_AddToAttribIndices(Component*);
+template void sys_sage::_AddToAttribIndices(Relation*);
+template void sys_sage::_RemoveFromAttribIndices(Component*);
+template void sys_sage::_RemoveFromAttribIndices(Relation*);
@@ -0,0 +1,147 @@
+#ifndef ATTRIB_INDEX_HPP
+#define ATTRIB_INDEX_HPP
+
+#include <cstddef>
+#include <map>
+#include <optional>
+#include <shared_mutex>
+#include <string>
+#include <unordered_map>
+#include <variant>
+#include <vector>
+
+#include "Attrib.hpp"
+
+namespace sys_sage { //forward declaration
+    class Component;
+    class Relation;
+}
+
+namespace sys_sage {
+
+    /**
+     * @class AttribIndex
+     * @brief Opt-in secondary index over the values of one typed attribute, for exact-match and range lookups (e.g. the DataPaths of a MIG instance by "mig_uuid", the Cores with "freq" below a threshold, the components of a job by its ID).
+     *
+     * T is Component or Relation (see ComponentAttribIndex, RelationAttribIndex).
+     * While the index exists, it is kept up to date by SetAttr() and EraseAttr() of all objects of type T of the process, and by their deletion; values set before its creation are added with AddSubtree().
+     * Only typed attributes (see Component::SetAttr()) are indexed -- entries of the attrib map are not.
+     * \n Integers (int, int64_t) are indexed as int64_t, doubles as double (NaN is not indexed), strings as strings. Integers and doubles order by their exact numeric value, e.g. 3 and 3.0 are equal, and int64_t values beyond 2^53 stay distinct; all numbers order before all strings. Other values (std::vector<double>, opaque values) are not indexed.
+     * \n Lookups are O(log n + k) for k results. Each indexed SetAttr() adds an O(log n) update; SetAttr() of keys without an index only checks an atomic counter.
+     * \n Creating and destroying indices is thread-safe. Each index has its own lock: updates from concurrent SetAttr() calls are serialized, and lookups see the index either before or after each update.
+     * The returned objects are not protected from deletion, however (see EpochManager).
+     */
+    template <class T>
+    class AttribIndex {
+    public:
+        /**
+         * @brief Indexed value: integers as int64_t, doubles as double, strings as strings.
+         */
+        using Key = std::variant<int64_t, double, std::string>;
+        /**
+         * @brief Order of the keys: numbers by their exact value, then strings.
+         */
+        struct KeyLess {
+            bool operator()(const Key& a, const Key& b) const;
+        };
+
+        /**
+         * @brief Creates an (empty) index of the attribute key and registers it, so that it is updated from now on.
+         * @param key Name of the attribute
+         */
+        explicit AttribIndex(const std::string& key);
+        /**
+         * @brief Creates an (empty) index of the attribute with the interned key (see AttribIndex(const std::string&)).
+         * @param key AttribId returned by InternAttribKey()
+         */
+        explicit AttribIndex(AttribId key);
+        /**
+         * @brief Unregisters the index.
+         */
+        ~AttribIndex();
+        AttribIndex(const AttribIndex&) = delete;
+        AttribIndex& operator=(const AttribIndex&) = delete;
+
+        /**
+         * @brief Returns the interned key of the indexed attribute.
+         */
+        AttribId GetKey() const;
+        /**
+         * @brief Adds the current values of the attribute in the subtree of root (including root): of the components, or of the Relations of the components, depending on T.
+         * @return Number of objects added to the index
+         */
+        size_t AddSubtree(Component* root);
+        /**
+         * @brief Returns the number of indexed objects.
+         */
+        size_t Size() const;
+
+        /**
+         * @brief Returns the objects whose attribute equals value, in the order in which they were indexed.
+         * @param value The value to look up (int and int64_t match numerically equal doubles)
+         */
+        std::vector<T*> Find(const AttribValue& value) const;
+        /**
+         * @brief Returns the number of objects whose attribute equals value.
+         */
+        size_t Count(const AttribValue& value) const;
+        /**
+         * @brief Returns the objects whose attribute lies in [from, to), ordered by the value.
+         * For example, FindRange(-INFINITY, 2000.0) returns the objects with a value below 2000.
+         * @param from Lower bound (inclusive)
+         * @param to Upper bound (exclusive)
+         */
+        std::vector<T*> FindRange(const AttribValue& from, const AttribValue& to) const;
+
+        /**
+         * @brief Returns the memory of the index (the entries and the reverse map).
+         */
+        size_t GetFootprint() const;
+
+        /**
+         * @brief Returns an index of the attribute key, or nullptr if there is none. If there are several, the one registered first is returned.
+         */
+        static AttribIndex* Get(AttribId key);
+
+        /**
+         * @private
+         * @brief Updates the entry of t to the new value of the attribute (nullptr if it was erased).
+         */
+        void _Update(T* t, const AttribValue* value);
+
+    private:
+        static std::optional<Key> _ToKey(const AttribValue& value);
+
+        AttribId key;
+        mutable std::shared_mutex mutex; /**< Guards entries and positions: exclusive for _Update(), shared for lookups */
+        std::multimap<Key, T*, KeyLess> entries;
+        std::unordered_map<const T*, typename std::multimap<Key, T*, KeyLess>::iterator> positions; /**< Entry of each indexed object */
+    };
+
+    using ComponentAttribIndex = AttribIndex<Component>;
+    using RelationAttribIndex = AttribIndex<Relation>;
+
+    extern template class AttribIndex<Component>;
+    extern template class AttribIndex<Relation>;
+
+    /**
+     * @private
+     * @brief Updates the indices of the attribute key after SetAttr() or EraseAttr() of t.
+     */
+    template <class T>
+    void _UpdateAttribIndices(T* t, AttribId key);
+    /**
+     * @private
+     * @brief Adds all typed attributes of t to the indices of their keys (e.g. after t was copied).
+     */
+    template <class T>
+    void _AddToAttribIndices(T* t);
+    /**
+     * @private
+     * @brief Removes t from the indices of all its typed attributes (before t is destroyed).
+     */
+    template <class T>
+    void _RemoveFromAttribIndices(T* t);
+}
+
+#endif
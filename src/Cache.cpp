@@ -1,4 +1,5 @@
 #include "Cache.hpp"
+#include "Footprint.hpp"
 
 
 sys_sage::Cache::Cache(int _id, int  _cache_level, long long _cache_size, int _associativity, int _cache_line_size): Component(_id, "Cache", sys_sage::ComponentType::Cache), cache_type(std::to_string(_cache_level)), cache_size(_cache_size), cache_associativity_ways(_associativity), cache_line_size(_cache_line_size){}
@@ -36,3 +37,4 @@ void sys_sage::Cache::SetCacheLineSize(int _cache_line_size){cache_line_size = _
 int sys_sage::Cache::GetCacheAssociativityWays() const {return cache_associativity_ways;}
 void sys_sage::Cache::SetCacheAssociativityWays(int _associativity) { cache_associativity_ways = _associativity;}
 
+size_t sys_sage::Cache::_GetMembersHeapSize() const { return Component::_GetMembersHeapSize() + _StringHeapSize(cache_type); }
@@ -1,4 +1,5 @@
 #include "Chip.hpp"
+#include "Footprint.hpp"
 
 
 sys_sage::Chip::Chip(int _id, std::string _name, int _type, std::string _vendor, std::string _model):Component(_id, _name, sys_sage::ComponentType::Chip), vendor(_vendor), model(_model), type(_type) {}
@@ -11,3 +12,5 @@ const std::string& sys_sage::Chip::GetModel() const{return model;}
 void sys_sage::Chip::SetModel(std::string _model){model = _model;}
 void sys_sage::Chip::SetChipType(sys_sage::ChipType::type chipType){type = chipType;}
 sys_sage::ChipType::type sys_sage::Chip::GetChipType() const{return type;}
+
+size_t sys_sage::Chip::_GetMembersHeapSize() const { return Component::_GetMembersHeapSize() + _StringHeapSize(vendor) + _StringHeapSize(model); }
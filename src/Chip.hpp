@@ -90,9 +90,14 @@ namespace sys_sage {
          *
          * Should normally not be used directly. Used internally for exporting the topology to XML.
          * @see exportToXml(Component* root, string path = "", std::function<int(string,void*,string*)> custom_search_attrib_key_fcn = NULL);
-         * @return Pointer to the created XML subtree node.
+         * @return Pointer to the created XML node (without the children of the component).
          */
-        xmlNodePtr _CreateXmlSubtree() override;
+        xmlNodePtr _CreateXmlNode() override;
+        /**
+         * @private
+         * @brief Returns the heap memory owned by the members of this component (see Component::_GetMembersHeapSize()).
+         */
+        size_t _GetMembersHeapSize() const override;
     private:
         std::string vendor; /**< Vendor of the chip */
         std::string model; /**< Model of the chip */
@@ -101,6 +106,7 @@ namespace sys_sage {
     public:
         /**
          * @brief Updates the MIG settings for the chip (NVIDIA-specific).
+         * Creates the MIG DataPaths of the MIG instance uuid (to the Memory, the L2 caches and the SMs of the partition) on the first call, and updates them in place on later calls (see Component::UpsertDataPath()).
          * @param uuid The UUID of the chip, default is an empty string.
          * @return Status of the update operation.
          */
@@ -0,0 +1,280 @@
+#include "ColumnStore.hpp"
+
+#include <cmath>
+#include <limits>
+
+#include "Component.hpp"
+#include "Relation.hpp"
+#include "Footprint.hpp"
+
+namespace {
+    constexpr double unset = std::numeric_limits<double>::quiet_NaN();
+}
+
+template <class T>
+size_t sys_sage::BasicColumnStore<T>::Register(T* c)
+{
+    auto [it, inserted] = indexOf.try_emplace(c, 0);
+    if(!inserted)
+        return it->second;
+    TypeColumns& tc = types[_GetType(c)];
+    it->second = static_cast<uint32_t>(tc.components.size());
+    tc.components.push_back(c);
+    for(auto& [key, column] : tc.columns)
+        column.push_back(unset);
+    return it->second;
+}
+
+template <class T>
+size_t sys_sage::BasicColumnStore<T>::RegisterSubtree(Component* root, Type type)
+{
+    size_t numRegistered = indexOf.size();
+    Component::WalkSubtree(root, [this, type](Component* c, int){
+        if constexpr (std::is_same_v<T, Component>)
+        {
+            if(type == ComponentType::Any || c->GetComponentType() == type)
+                Register(c);
+        }
+        else
+        {
+            //a Relation of several components of the subtree is registered once
+            c->ForEachRelation([this](Relation* r){ Register(r); }, type);
+        }
+    }, [](Component*, int){});
+    return indexOf.size() - numRegistered;
+}
+
+template <class T>
+typename sys_sage::BasicColumnStore<T>::Type sys_sage::BasicColumnStore<T>::_GetType(const T* t)
+{
+    if constexpr (std::is_same_v<T, Component>)
+        return t->GetComponentType();
+    else
+        return t->GetType();
+}
+
+template <class T>
+bool sys_sage::BasicColumnStore<T>::Remove(T* c)
+{
+    auto it = indexOf.find(c);
+    if(it == indexOf.end())
+        return false;
+    uint32_t index = it->second;
+    indexOf.erase(it);
+
+    //the last component of the type moves to the freed index
+    TypeColumns& tc = types[_GetType(c)];
+    T* last = tc.components.back();
+    tc.components[index] = last;
+    tc.components.pop_back();
+    for(auto& [key, column] : tc.columns)
+    {
+        column[index] = column.back();
+        column.pop_back();
+    }
+    if(last != c)
+        indexOf[last] = index;
+    return true;
+}
+
+template <class T>
+void sys_sage::BasicColumnStore<T>::Clear()
+{
+    types.clear();
+    indexOf.clear();
+}
+
+template <class T>
+int64_t sys_sage::BasicColumnStore<T>::GetIndex(const T* c) const
+{
+    auto it = indexOf.find(c);
+    return (it != indexOf.end()) ? static_cast<int64_t>(it->second) : -1;
+}
+
+template <class T>
+const std::vector<T*>& sys_sage::BasicColumnStore<T>::GetComponents(Type type) const
+{
+    static const std::vector<T*> noComponents;
+    auto it = types.find(type);
+    return (it != types.end()) ? it->second.components : noComponents;
+}
+
+template <class T>
+void sys_sage::BasicColumnStore<T>::Set(T* c, AttribId key, double value)
+{
+    size_t index = Register(c);
+    GetColumn(_GetType(c), key)[index] = value;
+}
+
+template <class T>
+void sys_sage::BasicColumnStore<T>::Set(T* c, const std::string& key, double value) { Set(c, InternAttribKey(key), value); }
+
+template <class T>
+double sys_sage::BasicColumnStore<T>::Get(const T* c, AttribId key) const
+{
+    auto it = indexOf.find(c);
+    if(it == indexOf.end())
+        return unset;
+    const std::vector<double>* column = _FindColumn(_GetType(c), key);
+    return (column != nullptr) ? (*column)[it->second] : unset;
+}
+
+template <class T>
+int sys_sage::BasicColumnStore<T>::Set(const std::vector<T*>& components, AttribId key, const std::vector<double>& values)
+{
+    if(components.size() != values.size())
+        return 1;
+    for(T* c : components)
+        Register(c);
+    //one column lookup per run of components of the same type
+    double* column = nullptr;
+    Type columnType = ComponentType::Any;
+    for(size_t i = 0; i < components.size(); i++)
+    {
+        if(column == nullptr || _GetType(components[i]) != columnType)
+        {
+            columnType = _GetType(components[i]);
+            column = GetColumn(columnType, key);
+        }
+        column[indexOf[components[i]]] = values[i];
+    }
+    return 0;
+}
+
+template <class T>
+double* sys_sage::BasicColumnStore<T>::GetColumn(Type type, AttribId key)
+{
+    auto it = types.find(type);
+    if(it == types.end() || it->second.components.empty())
+        return nullptr;
+    std::vector<double>& column = it->second.columns[key];
+    column.resize(it->second.components.size(), unset);
+    return column.data();
+}
+
+template <class T>
+const double* sys_sage::BasicColumnStore<T>::FindColumn(Type type, AttribId key) const
+{
+    const std::vector<double>* column = _FindColumn(type, key);
+    return (column != nullptr) ? column->data() : nullptr;
+}
+
+template <class T>
+const std::vector<double>* sys_sage::BasicColumnStore<T>::_FindColumn(Type type, AttribId key) const
+{
+    auto it = types.find(type);
+    if(it == types.end())
+        return nullptr;
+    auto col = it->second.columns.find(key);
+    return (col != it->second.columns.end()) ? &col->second : nullptr;
+}
+
+//the reductions are written as branch-free loops over the contiguous column (NaN compares false), so that the compiler can vectorize them
+
+template <class T>
+double sys_sage::BasicColumnStore<T>::Sum(Type type, AttribId key) const
+{
+    const std::vector<double>* column = _FindColumn(type, key);
+    if(column == nullptr)
+        return 0;
+    const double* v = column->data();
+    double sum = 0;
+    for(size_t i = 0, n = column->size(); i < n; i++)
+        sum += (v[i] == v[i]) ? v[i] : 0.0;
+    return sum;
+}
+
+template <class T>
+double sys_sage::BasicColumnStore<T>::Mean(Type type, AttribId key) const
+{
+    const std::vector<double>* column = _FindColumn(type, key);
+    if(column == nullptr)
+        return unset;
+    const double* v = column->data();
+    double sum = 0;
+    size_t count = 0;
+    for(size_t i = 0, n = column->size(); i < n; i++)
+    {
+        sum += (v[i] == v[i]) ? v[i] : 0.0;
+        count += (v[i] == v[i]);
+    }
+    return (count > 0) ? sum / count : unset;
+}
+
+template <class T>
+double sys_sage::BasicColumnStore<T>::Min(Type type, AttribId key) const
+{
+    const std::vector<double>* column = _FindColumn(type, key);
+    if(column == nullptr)
+        return unset;
+    const double* v = column->data();
+    double min = std::numeric_limits<double>::infinity();
+    size_t count = 0;
+    for(size_t i = 0, n = column->size(); i < n; i++)
+    {
+        min = (v[i] < min) ? v[i] : min;
+        count += (v[i] == v[i]);
+    }
+    return (count > 0) ? min : unset;
+}
+
+template <class T>
+double sys_sage::BasicColumnStore<T>::Max(Type type, AttribId key) const
+{
+    const std::vector<double>* column = _FindColumn(type, key);
+    if(column == nullptr)
+        return unset;
+    const double* v = column->data();
+    double max = -std::numeric_limits<double>::infinity();
+    size_t count = 0;
+    for(size_t i = 0, n = column->size(); i < n; i++)
+    {
+        max = (v[i] > max) ? v[i] : max;
+        count += (v[i] == v[i]);
+    }
+    return (count > 0) ? max : unset;
+}
+
+template <class T>
+T* sys_sage::BasicColumnStore<T>::ArgMin(Type type, AttribId key) const
+{
+    const std::vector<double>* column = _FindColumn(type, key);
+    if(column == nullptr)
+        return nullptr;
+    const double* v = column->data();
+    size_t best = column->size();
+    for(size_t i = 0, n = column->size(); i < n; i++)
+        if(v[i] == v[i] && (best == n || v[i] < v[best]))
+            best = i;
+    return (best < column->size()) ? types.at(type).components[best] : nullptr;
+}
+
+template <class T>
+T* sys_sage::BasicColumnStore<T>::ArgMax(Type type, AttribId key) const
+{
+    const std::vector<double>* column = _FindColumn(type, key);
+    if(column == nullptr)
+        return nullptr;
+    const double* v = column->data();
+    size_t best = column->size();
+    for(size_t i = 0, n = column->size(); i < n; i++)
+        if(v[i] == v[i] && (best == n || v[i] > v[best]))
+            best = i;
+    return (best < column->size()) ? types.at(type).components[best] : nullptr;
+}
+
+template <class T>
+size_t sys_sage::BasicColumnStore<T>::GetFootprint() const
+{
+    size_t size = sizeof(ColumnStore) + _UnorderedMapHeapSize(types) + _UnorderedMapHeapSize(indexOf);
+    for(const auto& [type, tc] : types)
+    {
+        size += _VectorHeapSize(tc.components) + _UnorderedMapHeapSize(tc.columns);
+        for(const auto& [key, column] : tc.columns)
+            size += _VectorHeapSize(column);
+    }
+    return size;
+}
+
+template class sys_sage::BasicColumnStore<sys_sage::Component>;
+template class sys_sage::BasicColumnStore<sys_sage::Relation>;
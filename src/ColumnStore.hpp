@@ -0,0 +1,154 @@
+#ifndef COLUMN_STORE_HPP
+#define COLUMN_STORE_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "enums.hpp"
+#include "Attrib.hpp"
+
+namespace sys_sage { //forward declaration
+    class Component;
+    class Relation;
+}
+
+namespace sys_sage {
+
+    /**
+     * @class BasicColumnStore
+     * @brief Opt-in columnar side store of numeric attributes, for scans and reductions over all objects of one type (e.g. the average frequency of all Cores, the maximal T1 of all Qubits, the summed mig_size of all DataPaths).
+     *
+     * T is Component or Relation (see ColumnStore, RelationColumnStore); objects are grouped by their ComponentType or RelationType, respectively.
+     * Objects are registered per type and get a dense index within their type (0, 1, 2, ... in the order of registration).
+     * For each (type, attribute key), the values are held in one contiguous array of doubles indexed by that dense index, so that reductions run over consecutive memory and can be vectorized by the compiler.
+     * Values that were never set are NaN and are skipped by the reductions.
+     * \n The store is independent of the Component Tree: it is not updated by Delete() -- call Remove() before deleting a registered object.
+     * Samplers and parsers write into it directly (see Core::RefreshFreq(), Node::RefreshCpuCoreFrequency() and parseIQM()).
+     */
+    template <class T>
+    class BasicColumnStore {
+    public:
+        /**
+         * @brief ComponentType::type for Components, RelationType::type for Relations.
+         */
+        using Type = int32_t;
+
+        /**
+         * @brief Registers an object (if not registered yet); all its columns are NaN until set.
+         * @return Dense index of the object within its type
+         */
+        size_t Register(T* t);
+        /**
+         * @brief Registers all objects of the given type in the subtree of root, in pre-order: the components (including root), or the Relations of the components, depending on T.
+         * @param root Root of the subtree
+         * @param type Required ComponentType (RelationType for Relations), or ComponentType::Any (equal to RelationType::Any) for all objects
+         * @return Number of newly registered objects
+         */
+        size_t RegisterSubtree(Component* root, Type type = ComponentType::Any);
+        /**
+         * @brief Removes an object from the store. The last object of its type takes over its dense index (and its values).
+         * @return Whether the object was registered
+         */
+        bool Remove(T* t);
+        /**
+         * @brief Removes all objects and columns.
+         */
+        void Clear();
+
+        /**
+         * @brief Returns the dense index of an object within its type, or -1 if it is not registered.
+         */
+        int64_t GetIndex(const T* t) const;
+        /**
+         * @brief Returns the registered objects of a type, ordered by their dense index.
+         */
+        const std::vector<T*>& GetComponents(Type type) const;
+
+        /**
+         * @brief Sets the value of attribute key of a registered object (registers it if needed).
+         */
+        void Set(T* t, AttribId key, double value);
+        /**
+         * @brief Sets the value of attribute key of a registered object (see Set(T*, AttribId, double)).
+         */
+        void Set(T* t, const std::string& key, double value);
+        /**
+         * @brief Returns the value of attribute key of an object, or NaN if it is not registered or the value was not set.
+         */
+        double Get(const T* t, AttribId key) const;
+        /**
+         * @brief Bulk update: sets the values of attribute key of the given objects (registering them if needed); values[i] belongs to objects[i].
+         * @return 0 on success, 1 if the sizes of objects and values differ
+         */
+        int Set(const std::vector<T*>& objects, AttribId key, const std::vector<double>& values);
+        /**
+         * @brief Returns the column of attribute key of a type, creating it (filled with NaN) if it does not exist.
+         * The column holds one value per registered object of the type, indexed by the dense index; it can be written directly, e.g. by a sampler.
+         * @return Pointer to the first value (valid until the next registration of an object of this type), or nullptr if no object of this type is registered
+         */
+        double* GetColumn(Type type, AttribId key);
+        /**
+         * @brief Returns the column of attribute key of a type, or nullptr if it does not exist.
+         */
+        const double* FindColumn(Type type, AttribId key) const;
+
+        /**
+         * @brief Returns the sum of the set values of attribute key over all registered objects of the type (0 if there are none).
+         */
+        double Sum(Type type, AttribId key) const;
+        /**
+         * @brief Returns the mean of the set values of attribute key over all registered objects of the type (NaN if there are none).
+         */
+        double Mean(Type type, AttribId key) const;
+        /**
+         * @brief Returns the minimum of the set values of attribute key over all registered objects of the type (NaN if there are none).
+         */
+        double Min(Type type, AttribId key) const;
+        /**
+         * @brief Returns the maximum of the set values of attribute key over all registered objects of the type (NaN if there are none).
+         */
+        double Max(Type type, AttribId key) const;
+        /**
+         * @brief Returns the object with the minimal value of attribute key among the registered objects of the type (the first one on ties), or nullptr if no value is set.
+         */
+        T* ArgMin(Type type, AttribId key) const;
+        /**
+         * @brief Returns the object with the maximal value of attribute key among the registered objects of the type (the first one on ties), or nullptr if no value is set.
+         */
+        T* ArgMax(Type type, AttribId key) const;
+
+        /**
+         * @brief Returns the heap memory of the store (the object lists, the index and the columns).
+         */
+        size_t GetFootprint() const;
+
+    private:
+        struct TypeColumns {
+            std::vector<T*> components; /**< Registered objects of the type, by dense index */
+            std::unordered_map<AttribId, std::vector<double>> columns; /**< One value per registered object */
+        };
+
+        static Type _GetType(const T* t);
+        const std::vector<double>* _FindColumn(Type type, AttribId key) const;
+
+        std::unordered_map<Type, TypeColumns> types;
+        std::unordered_map<const T*, uint32_t> indexOf; /**< Dense index of each registered object within its type */
+    };
+
+    /**
+     * @brief Columns of the attributes of Components, by ComponentType.
+     */
+    using ColumnStore = BasicColumnStore<Component>;
+    /**
+     * @brief Columns of the attributes of Relations (e.g. mig_size of DataPaths), by RelationType.
+     */
+    using RelationColumnStore = BasicColumnStore<Relation>;
+
+    extern template class BasicColumnStore<Component>;
+    extern template class BasicColumnStore<Relation>;
+}
+
+#endif
@@ -13,13 +13,25 @@
 #include "Node.hpp"
 #include "QuantumBackend.hpp"
 #include "Qubit.hpp"
+#include "AtomSite.hpp"
 #include "Relation.hpp"
 #include "DataPath.hpp"
 #include "QuantumGate.hpp"
 #include "CouplingMap.hpp"
+#include "DataPathMatrix.hpp"
+#include "Arena.hpp"
+#include "SubtreeIndex.hpp"
+#include "ParallelTraversal.hpp"
+#include "Epoch.hpp"
+#include "Footprint.hpp"
+#include "AttribIndex.hpp"
+#include "external_interfaces/ss_papi.hpp"
 
 #include <algorithm>
+#include <atomic>
 #include <csignal>
+#include <unordered_map>
+#include <unordered_set>
 
 // Component::~Component() { 
 //     DeleteAllDataPaths();
@@ -32,9 +44,6 @@
 //             children[0]->SetParent(NULL);
 //         }
 //     }
-//     for(auto& pair : this->attrib){
-//         //TODO: delete attribs somehow
-//     }
 //  }
 
 using std::string;
@@ -42,6 +51,55 @@ using std::vector;
 using std::cout;
 using std::endl;
 
+namespace {
+    //interval labels are read by concurrent queries while one of them relabels the subtree (see SubtreeIndex); whether they are current is decided by the acquire on the generation of their stamp
+    template <class T>
+    T LoadLabel(const T& label) { return std::atomic_ref<T>(const_cast<T&>(label)).load(std::memory_order_relaxed); }
+    template <class T>
+    void StoreLabel(T& label, T value) { std::atomic_ref<T>(label).store(value, std::memory_order_relaxed); }
+
+    //calls visitor(c, depth) on the components of one piece of a parallel traversal, in pre-order
+    template <class Visitor>
+    void VisitPiece(const sys_sage::ParallelTraversal::Piece& piece, Visitor&& visitor)
+    {
+        if(piece.wholeSubtree)
+            sys_sage::Component::WalkSubtree(piece.root, visitor, [](sys_sage::Component*, int){});
+        else
+            visitor(piece.root, 0);
+    }
+
+    //calls visitor(c, depth) in post-order on the components of the subtree of root that the subtree owns:
+    //children shared with the original by a copy-on-write copy (their parent is not the walked component, see Component::Clone()) are skipped with their subtrees
+    template <class ComponentT, class Visitor>
+    void WalkOwnedSubtree(ComponentT* root, Visitor&& visitor)
+    {
+        std::vector<ComponentT*> path; //nullptr for a skipped component
+        sys_sage::Component::WalkSubtree(root, [&path](ComponentT* c, int){
+            bool owned = path.empty() || c->GetParent() == path.back();
+            path.push_back(owned ? c : nullptr);
+            return owned;
+        }, [&path, &visitor](ComponentT* c, int depth){
+            bool owned = path.back() != nullptr;
+            path.pop_back();
+            if(owned)
+                visitor(c, depth);
+        });
+    }
+
+    using RelationLists = std::array<std::vector<sys_sage::Relation*>*, sys_sage::RelationType::_num_relation_types>;
+    //copies the Relation vectors of a component (the Relations themselves are shared)
+    RelationLists* CopyRelationLists(const RelationLists* relations)
+    {
+        if(relations == nullptr)
+            return nullptr;
+        RelationLists* copy = new RelationLists();
+        for(size_t i = 0; i < relations->size(); i++)
+            if((*relations)[i] != nullptr)
+                (*copy)[i] = new std::vector<sys_sage::Relation*>(*(*relations)[i]);
+        return copy;
+    }
+}
+
 void sys_sage::Component::PrintSubtree() const { _PrintSubtree(0); }
 void sys_sage::Component::_PrintSubtree(int level) const
 {
@@ -73,50 +131,99 @@ void sys_sage::Component::PrintRelationsInSubtree(RelationType::type relationTyp
     vector<Component*> subtreeList;
     FindDescendantsByType(&subtreeList, ComponentType::Any);
     for(Component * c : subtreeList)
-    {   
-        for(RelationType::type rt : RelationType::RelationTypeList)
+        c->_PrintRelations(relationType);
+}
+
+void sys_sage::Component::PrintRelationsInSubtree(RelationType::type relationType, const ParallelTraversal& parallel)
+{
+    vector<vector<Component*>> pieces = parallel.MapPieces<vector<Component*>>(this, [relationType](const ParallelTraversal::Piece& piece){
+        vector<Component*> withRelations;
+        VisitPiece(piece, [&withRelations, relationType](Component* c, int){
+            if(c->_HasRelations(relationType))
+                withRelations.push_back(c);
+        });
+        return withRelations;
+    });
+    for(const vector<Component*>& piece : pieces)
+        for(Component* c : piece)
+            c->_PrintRelations(relationType);
+}
+
+bool sys_sage::Component::_HasRelations(RelationType::type relationType) const
+{
+    if(relations == nullptr)
+        return false;
+    for(RelationType::type rt : RelationType::RelationTypeList)
+        if((relationType == rt || relationType == RelationType::Any) && (*relations)[rt] != nullptr && !(*relations)[rt]->empty())
+            return true;
+    return false;
+}
+
+void sys_sage::Component::_PrintRelations(RelationType::type relationType) const
+{
+    for(RelationType::type rt : RelationType::RelationTypeList)
+    {
+        if (relationType == rt || relationType == RelationType::Any)
         {
-            if (relationType == rt || relationType == RelationType::Any)
+            const vector<Relation*>& c_relations = GetRelationsByType(rt);
+            if(c_relations.size() > 0)
             {
-                vector<Relation*> c_relations = c->GetRelationsByType(rt);
-                if(c_relations.size() > 0)
+                std::cout << RelationType::ToString(rt) << "s regarding Component (" << GetComponentTypeStr() << ") id " << GetId() << std::endl;
+                for(Relation * r : c_relations )
                 {
-                    std::cout << RelationType::ToString(rt) << "s regarding Component (" << c->GetComponentTypeStr() << ") id " << c->GetId() << std::endl;
-                    for(Relation * r : c_relations )
-                    {
-                        cout << "    ";
-                        r->Print();
-                    }
+                    cout << "    ";
+                    r->Print();
                 }
             }
         }
-
-
     }
 }
 
 void sys_sage::Component::InsertChild(Component * child)
 {
     child->SetParent(this);
+    child->indexInParent = children.size();
+    if(firstStaleChildIndex == children.size())
+        firstStaleChildIndex++;
     children.push_back(child);
+    _NotifySubtreeInserted(child);
+}
+void sys_sage::Component::InsertChildren(const std::vector<Component*>& newChildren)
+{
+    _GrowChildren(newChildren.size());
+    for(Component* child : newChildren)
+        InsertChild(child);
+}
+void sys_sage::Component::ReserveChildren(size_t numChildren)
+{
+    children.reserve(numChildren);
+}
+void sys_sage::Component::_GrowChildren(size_t numNewChildren)
+{
+    //grow at least geometrically, so that repeated batches do not reallocate on every call
+    size_t required = children.size() + numNewChildren;
+    if(required > children.capacity())
+        children.reserve(std::max(required, 2 * children.capacity()));
 }
 int sys_sage::Component::InsertBetweenParentAndChild(Component* parent, Component* child, bool alreadyParentsChild)
 {
     //consistency check
-    vector<Component*>& p_children = parent->_GetChildren();
+    size_t index = parent->_FindChild(child);
+    bool listed = (index < parent->children.size());
     if(child->GetParent() != parent){
-        if(std::find(p_children.begin(), p_children.end(), child) != p_children.end())
+        if(listed)
             return 1; //child and parent are not child and parent in the component tree
         else
             return 2; //corrupt component tree -> bad thing
     }
     else{
-        if(std::find(p_children.begin(), p_children.end(), child) == p_children.end())
+        if(!listed)
             return 3; //corrupt component tree -> bad thing
     }
 
     //remove from grandparent's list; set new parent; insert child into the new component's list
-    p_children.erase(std::remove(p_children.begin(), p_children.end(), child), p_children.end());
+    parent->_EraseChildAt(index);
+    parent->_NotifySubtreeRemoved(child);
     child->SetParent(this);
     this->InsertChild(child);
 
@@ -131,11 +238,10 @@ int sys_sage::Component::InsertBetweenParentAndChild(Component* parent, Componen
 }
 int sys_sage::Component::InsertBetweenParentAndChildren(Component* parent, std::vector<Component*> children, bool alreadyParentsChild)
 {
-    vector<Component*>& p_children = parent->_GetChildren();
     for(Component* child: children) //first just check for consistency
     {
         bool isParent = (child->GetParent() == parent);      
-        if(std::find(p_children.begin(), p_children.end(), child) == p_children.end()){  //child not listed as parent's child
+        if(parent->_FindChild(child) == parent->children.size()){  //child not listed as parent's child
             if(isParent)
                 return 2; //corrupt component tree -> bad thing
             else
@@ -145,10 +251,12 @@ int sys_sage::Component::InsertBetweenParentAndChildren(Component* parent, std::
             return 3; //corrupt component tree -> bad thing
     }
 
-    for(Component* child: children) //second time do the actual inserting
+    //remove all from grandparent's list at once (the SubtreeIndexes are invalidated by any removal, so one notification suffices)
+    parent->_EraseChildren(children);
+    if(!children.empty())
+        parent->_NotifySubtreeRemoved(children.front());
+    for(Component* child: children) //set new parent; insert child into the new component's list
     {
-        //remove from grandparent's list; set new parent; insert child into the new component's list
-        p_children.erase(std::remove(p_children.begin(), p_children.end(), child), p_children.end());
         child->SetParent(this);
         this->InsertChild(child);
     }
@@ -164,10 +272,335 @@ int sys_sage::Component::InsertBetweenParentAndChildren(Component* parent, std::
 }
 int sys_sage::Component::RemoveChild(Component * child)
 {
-    int orig_size = children.size();
-    children.erase(std::remove(children.begin(), children.end(), child), children.end());
-    return orig_size - children.size();
-    //return std::erase(children, child); -- not supported in some compilers
+    size_t index = _FindChild(child);
+    if(index == children.size())
+        return 0;
+    _EraseChildAt(index);
+    _NotifySubtreeRemoved(child);
+    return 1;
+}
+
+void* sys_sage::Component::ReadAttrib(const std::string& key) const
+{
+    auto it = attrib.find(key);
+    if(it == attrib.end())
+        return nullptr;
+    return std::atomic_ref<void*>(const_cast<void*&>(it->second)).load(std::memory_order_acquire);
+}
+
+void sys_sage::Component::PublishAttrib(const std::string& key, void* value, void (*deleter)(void*), EpochManager& epochs) { _PublishAttrib(key, value, deleter, false, epochs); }
+void sys_sage::Component::PublishOwnedAttrib(const std::string& key, void* value, void (*deleter)(void*), EpochManager& epochs) { _PublishAttrib(key, value, deleter, true, epochs); }
+
+void sys_sage::Component::_PublishAttrib(const std::string& key, void* value, void (*deleter)(void*), bool owned, EpochManager& epochs)
+{
+    //the read section keeps writers from changing the attrib map while the key is looked up
+    EpochManager::ReadGuard reader(epochs);
+    auto it = attrib.find(key);
+    if(it == attrib.end())
+    {
+        EpochManager::WriteGuard writer(epochs);
+        //another writer may have inserted the key meanwhile
+        auto [inserted, isNew] = attrib.emplace(key, value);
+        if(isNew)
+        {
+            if(owned)
+                attribOwners.Set(InternAttribKey(key), AttribPtr(value, deleter));
+            return;
+        }
+        it = inserted;
+    }
+
+    AttribPtr oldOwner;
+    void* old;
+    {
+        //other publishers may change attribOwners as well; readers do not access it
+        std::lock_guard<std::mutex> lock(epochs._GetPublishMutex());
+        AttribId id = owned ? InternAttribKey(key) : FindAttribKey(key);
+        AttribValue* owner = (id != invalidAttribId) ? attribOwners.Find(id) : nullptr;
+        bool oldOwned = owner != nullptr && std::get<AttribPtr>(*owner).get() == it->second;
+        old = std::atomic_ref<void*>(it->second).exchange(value, std::memory_order_acq_rel);
+        if(old == value)
+        {
+            //publishing the current value again changes at most its ownership
+            if(owned && !oldOwned)
+                attribOwners.Set(id, AttribPtr(value, deleter));
+            return;
+        }
+        //a value owned through SetAttrib() or PublishOwnedAttrib() is released by its owner, once it is retired
+        if(oldOwned)
+            oldOwner = std::move(std::get<AttribPtr>(*owner));
+        if(owned)
+            attribOwners.Set(id, AttribPtr(value, deleter));
+        else if(oldOwned)
+            attribOwners.Erase(id);
+    }
+    if(oldOwner != nullptr)
+        epochs.Retire(new AttribPtr(std::move(oldOwner)));
+    else
+        epochs.Retire(old, deleter);
+}
+
+void sys_sage::Component::SetAttr(const std::string& key, AttribValue value) { SetAttr(InternAttribKey(key), std::move(value)); }
+void sys_sage::Component::SetAttr(AttribId key, AttribValue value)
+{
+    attrs.Set(key, std::move(value));
+    _UpdateAttribIndices(this, key);
+}
+void sys_sage::Component::SetAttrPtr(const std::string& key, void* value, void (*deleter)(void*)) { SetAttr(InternAttribKey(key), AttribPtr(value, deleter)); }
+
+bool sys_sage::Component::HasAttr(const std::string& key) const
+{
+    AttribId id = FindAttribKey(key);
+    if(id != invalidAttribId && attrs.Find(id) != nullptr)
+        return true;
+    return attrib.find(key) != attrib.end();
+}
+
+bool sys_sage::Component::EraseAttr(const std::string& key)
+{
+    AttribId id = FindAttribKey(key);
+    if(id == invalidAttribId || !attrs.Erase(id))
+        return false;
+    _UpdateAttribIndices(this, id);
+    return true;
+}
+
+const sys_sage::AttribStore& sys_sage::Component::GetAttribStore() const { return attrs; }
+void sys_sage::Component::SetAttrib(const std::string& key, void* value, void (*deleter)(void*)) { _SetOwnedAttrib(attrib, attribOwners, key, value, deleter); }
+bool sys_sage::Component::EraseAttrib(const std::string& key) { return _EraseOwnedAttrib(attrib, attribOwners, key); }
+bool sys_sage::Component::OwnsAttrib(const std::string& key) const { return _OwnsAttrib(attrib, attribOwners, key); }
+
+void sys_sage::Component::SetStableChildrenOrder(bool stable) { stableChildrenOrder = stable; }
+bool sys_sage::Component::GetStableChildrenOrder() const { return stableChildrenOrder; }
+
+int sys_sage::Component::GetIndexInParent() const
+{
+    if(parent == NULL)
+        return -1;
+    size_t index = parent->_FindChildReadOnly(this);
+    return index == parent->children.size() ? -1 : static_cast<int>(index);
+}
+
+size_t sys_sage::Component::_FindChildReadOnly(const Component* child) const
+{
+    size_t index = child->indexInParent;
+    if(index < children.size() && children[index] == child)
+        return index;
+    //a stale index is not refreshed here (concurrent readers may call this); children listed below firstStaleChildIndex have up-to-date indices
+    size_t first = (child->parent == this) ? std::min(firstStaleChildIndex, children.size()) : 0;
+    return std::find(children.begin() + first, children.end(), child) - children.begin();
+}
+
+size_t sys_sage::Component::_FindChild(Component* child)
+{
+    size_t index = child->indexInParent;
+    if(index < children.size() && children[index] == child)
+        return index;
+    if(child->parent != this) //e.g. a child shared by a copy-on-write copy (see Clone()): its index belongs to its own parent
+        return std::find(children.begin(), children.end(), child) - children.begin();
+    if(firstStaleChildIndex >= children.size()) //all indices are up to date -> child is not listed
+        return children.size();
+    for(size_t i = firstStaleChildIndex; i < children.size(); i++)
+        if(children[i]->parent == this)
+            children[i]->indexInParent = i;
+    firstStaleChildIndex = children.size();
+    index = child->indexInParent;
+    return (index < children.size() && children[index] == child) ? index : children.size();
+}
+
+void sys_sage::Component::_EraseChildAt(size_t index)
+{
+    if(stableChildrenOrder)
+    {
+        //the indices of the following children are refreshed lazily by _FindChild()
+        children.erase(children.begin() + index);
+        firstStaleChildIndex = std::min(firstStaleChildIndex, index);
+    }
+    else
+    {
+        children[index] = children.back();
+        if(children[index]->parent == this)
+            children[index]->indexInParent = index;
+        children.pop_back();
+        firstStaleChildIndex = std::min(firstStaleChildIndex, children.size());
+    }
+}
+
+void sys_sage::Component::_EraseChildren(const std::vector<Component*>& toErase)
+{
+    if(!stableChildrenOrder)
+    {
+        for(Component* child : toErase)
+        {
+            size_t index = _FindChild(child);
+            if(index < children.size())
+                _EraseChildAt(index);
+        }
+        return;
+    }
+
+    //stable order: look up all positions first (no holes yet), leave holes, then close them in a single pass starting at the first hole
+    std::vector<size_t> indices;
+    indices.reserve(toErase.size());
+    for(Component* child : toErase)
+        indices.push_back(_FindChild(child));
+    size_t firstHole = children.size();
+    for(size_t index : indices)
+    {
+        if(index < children.size())
+        {
+            children[index] = nullptr;
+            firstHole = std::min(firstHole, index);
+        }
+    }
+    if(firstHole == children.size())
+        return;
+    size_t out = firstHole;
+    for(size_t i = firstHole; i < children.size(); i++)
+    {
+        if(children[i] == nullptr)
+            continue;
+        children[i]->indexInParent = out;
+        children[out++] = children[i];
+    }
+    children.resize(out);
+    firstStaleChildIndex = (firstStaleChildIndex >= firstHole) ? children.size() : firstStaleChildIndex;
+}
+
+void sys_sage::Component::_NotifySubtreeInserted(Component* child)
+{
+    if(SubtreeIndex::_GetNumInstances() == 0) //nothing to notify; avoids walking up long chains of ancestors
+        return;
+    //the new subtree is appended at the end of an ancestor's pre-order iff child and all components between child and the ancestor are last children
+    bool appendedInPreOrder = (!children.empty() && children.back() == child);
+    for(Component* ancestor = this; ancestor != NULL; ancestor = ancestor->parent)
+    {
+        if(ancestor->subtreeIndex != nullptr)
+            ancestor->subtreeIndex->_OnSubtreeInserted(child, appendedInPreOrder);
+        if(ancestor->parent == ancestor) //guard against self-loops in corrupt trees
+            break;
+        if(ancestor->parent != NULL && (ancestor->parent->children.empty() || ancestor->parent->children.back() != ancestor))
+            appendedInPreOrder = false;
+    }
+}
+
+void sys_sage::Component::_NotifySubtreeRemoved(Component* child)
+{
+    if(SubtreeIndex::_GetNumInstances() == 0)
+        return;
+    for(Component* ancestor = this; ancestor != NULL; ancestor = ancestor->parent)
+    {
+        if(ancestor->subtreeIndex != nullptr)
+            ancestor->subtreeIndex->_OnSubtreeRemoved(child);
+        if(ancestor->parent == ancestor) //guard against self-loops in corrupt trees
+            break;
+    }
+}
+
+sys_sage::SubtreeIndex* sys_sage::Component::EnableSubtreeIndex()
+{
+    if(subtreeIndex == nullptr)
+        subtreeIndex = new SubtreeIndex(this);
+    return subtreeIndex;
+}
+
+void sys_sage::Component::DisableSubtreeIndex()
+{
+    delete subtreeIndex;
+    subtreeIndex = nullptr;
+}
+
+sys_sage::SubtreeIndex* sys_sage::Component::GetSubtreeIndex() const { return subtreeIndex; }
+
+void sys_sage::Component::_SetIntervalLabel(uint64_t stamp, uint32_t first, uint32_t end)
+{
+    StoreLabel(labelStamp, stamp);
+    StoreLabel(labelFirst, first);
+    StoreLabel(labelEnd, end);
+}
+
+void sys_sage::Component::_SetIntervalLabelEnd(uint32_t end) { StoreLabel(labelEnd, end); }
+
+sys_sage::SubtreeIndex* sys_sage::Component::_GetLabellingIndex(const Component* other) const
+{
+    uint64_t stamp = LoadLabel(labelStamp);
+    if(stamp == LoadLabel(other->labelStamp) && SubtreeIndex::_IsLabelStampCurrent(stamp))
+        return SubtreeIndex::_GetLabelStampOwner(stamp);
+    if(SubtreeIndex::_GetNumInstances() == 0)
+        return nullptr;
+    SubtreeIndex* index = nullptr;
+    if(stamp != 0 && stamp == LoadLabel(other->labelStamp))
+        index = SubtreeIndex::_GetLabelStampOwner(stamp);
+    if(index == nullptr)
+    {
+        //not labelled together (yet): label the subtree of the outermost index above this component, if it is not up to date
+        SubtreeIndex* outermost = nullptr;
+        for(const Component* ancestor = this; ancestor != nullptr; ancestor = ancestor->parent)
+            if(ancestor->subtreeIndex != nullptr)
+                outermost = ancestor->subtreeIndex;
+        if(outermost == nullptr || outermost->AreIntervalLabelsValid())
+            return nullptr;
+        index = outermost;
+    }
+    //relabelling assigns a new stamp, so components that left the subtree no longer match
+    index->UpdateIntervalLabels();
+    if(!index->AreIntervalLabelsValid() || LoadLabel(labelStamp) != index->_GetLabelStamp() || LoadLabel(other->labelStamp) != index->_GetLabelStamp())
+        return nullptr;
+    return index;
+}
+
+bool sys_sage::Component::IsAncestorOf(const Component* other) const
+{
+    if(other == nullptr)
+        return false;
+    if(_GetLabellingIndex(other) != nullptr)
+        return LoadLabel(labelFirst) <= LoadLabel(other->labelFirst) && LoadLabel(other->labelFirst) < LoadLabel(labelEnd);
+    for(const Component* ancestor = other; ancestor != nullptr; ancestor = ancestor->parent)
+        if(ancestor == this)
+            return true;
+    return false;
+}
+
+sys_sage::Component* sys_sage::Component::FindLowestCommonAncestor(Component* other)
+{
+    if(other == nullptr)
+        return nullptr;
+    if(SubtreeIndex* index = _GetLabellingIndex(other))
+    {
+        uint32_t first = LoadLabel(labelFirst), otherFirst = LoadLabel(other->labelFirst);
+        if(first <= otherFirst && otherFirst < LoadLabel(labelEnd))
+            return this;
+        if(otherFirst <= first && first < LoadLabel(other->labelEnd))
+            return other;
+        return index->_FindLowestCommonAncestor(std::min(first, otherFirst), std::max(first, otherFirst));
+    }
+
+    //no labels: bring both components to the same depth, then move up in lockstep
+    int depthDifference = 0;
+    for(Component* ancestor = parent; ancestor != nullptr; ancestor = ancestor->parent)
+        depthDifference++;
+    for(Component* ancestor = other->parent; ancestor != nullptr; ancestor = ancestor->parent)
+        depthDifference--;
+    Component* a = this;
+    Component* b = other;
+    for(; depthDifference > 0; depthDifference--)
+        a = a->parent;
+    for(; depthDifference < 0; depthDifference++)
+        b = b->parent;
+    while(a != b)
+    {
+        a = a->parent;
+        b = b->parent;
+    }
+    return a;
+}
+
+sys_sage::Component* sys_sage::Component::FindLowestCommonAncestor(Component* other, ComponentType::type _componentType)
+{
+    Component* lowestCommonAncestor = FindLowestCommonAncestor(other);
+    if(lowestCommonAncestor == nullptr)
+        return nullptr;
+    return lowestCommonAncestor->GetAncestorByType(_componentType);
 }
 sys_sage::Component* sys_sage::Component::GetChild(int _id) const
 {
@@ -229,16 +662,12 @@ int sys_sage::Component::GetSubtreeDepth() const
 
 int sys_sage::Component::CalcSubtreeDepth() const
 {
-    if(children.empty()) //is leaf
-        return 0;
     int maxDepth = 0;
-    for(Component* child: children)
-    {
-        int subtreeDepth = child->CalcSubtreeDepth();
-        if(subtreeDepth > maxDepth)
-            maxDepth = subtreeDepth;
-    }
-    return maxDepth + 1;
+    WalkSubtree(this, [&maxDepth](const Component*, int depth){
+        if(depth > maxDepth)
+            maxDepth = depth;
+    }, [](const Component*, int){});
+    return maxDepth;
 }
 
 sys_sage::Component* sys_sage::Component::GetNthAncestor(int n)
@@ -246,22 +675,12 @@ sys_sage::Component* sys_sage::Component::GetNthAncestor(int n)
     // For cases with incorrect inputs (0 and negative values)
     if (n < 0)
         return nullptr; // n can't be negative
-    else if(n == 0)
-        return this; // n = 0 means "this"
-    
-    Component* parent = GetParent();
-    
-    // No parent means no further ancestors, the search can be stopped here.
-    if(parent == nullptr)
-        return nullptr; 
-    
-    // base case
-    if(n == 1) 
-    {
-        return parent;
-    }
-    return parent->GetNthAncestor(n - 1);
-        
+
+    // n = 0 means "this"; no parent means no further ancestors, the search can be stopped there.
+    Component* ancestor = this;
+    for(; n > 0 && ancestor != nullptr; n--)
+        ancestor = ancestor->GetParent();
+    return ancestor;
 }
 
 void sys_sage::Component::GetNthDescendents(std::vector<Component*>* outArray, int depth)
@@ -275,14 +694,16 @@ void sys_sage::Component::FindNthDescendants(std::vector<Component*>* outArray,
     if(depth <= 0)
     {   
         outArray->push_back(this);
-        // depth++;
         return;
     }
-    for(Component* child: children)
-    {   
-        cout << GetComponentTypeStr() << " (name " << name << ") id " << id << " - children: " << children.size();
-        cout << " depth: " << depth<<"\n";
-        child->FindNthDescendants(outArray, depth - 1);
+    SubtreeRange subtree = TraversePreOrder();
+    for(auto it = subtree.begin(); it != subtree.end(); ++it)
+    {
+        if(it.GetDepth() == depth)
+        {
+            outArray->push_back(*it);
+            it.SkipChildren();
+        }
     }
     return;
 }
@@ -332,16 +753,13 @@ sys_sage::Component* sys_sage::Component::GetSubcomponentById(int _id, Component
 
 sys_sage::Component *sys_sage::Component::GetDescendantById(int _id, ComponentType::type _componentType)
 {
-    if(componentType == _componentType && id == _id){
-        return this;
-    }
-    for(Component * child : children)
+    if(subtreeIndex != nullptr)
+        return subtreeIndex->GetComponentById(_id, _componentType);
+
+    for(Component* c : TraversePreOrder(_componentType))
     {
-        Component* ret = child->GetDescendantById(_id, _componentType);
-        if(ret != NULL)
-        {
-            return ret;
-        }
+        if(c->GetId() == _id)
+            return c;
     }
     return NULL;
 }
@@ -367,16 +785,40 @@ void sys_sage::Component::GetAllSubcomponentsByType(std::vector<Component*>* out
 
 void sys_sage::Component::FindDescendantsByType(std::vector<Component*>* outArray, ComponentType::type _componentType)
 {
-    if(_componentType == ComponentType::Any || componentType == _componentType){
-        outArray->push_back(this);
-    }
-    for(Component * child : children)
+    if(subtreeIndex != nullptr)
     {
-        child->FindDescendantsByType(outArray, _componentType);
+        const vector<Component*>& indexed = subtreeIndex->GetComponentsByType(_componentType);
+        outArray->insert(outArray->end(), indexed.begin(), indexed.end());
+        return;
     }
+    for(Component* c : TraversePreOrder(_componentType))
+        outArray->push_back(c);
     return;
 }
 
+void sys_sage::Component::FindDescendantsByType(std::vector<Component*>* outArray, ComponentType::type _componentType, const ParallelTraversal& parallel)
+{
+    if(subtreeIndex != nullptr)
+    {
+        FindDescendantsByType(outArray, _componentType);
+        return;
+    }
+    vector<vector<Component*>> pieces = parallel.MapPieces<vector<Component*>>(this, [_componentType](const ParallelTraversal::Piece& piece){
+        vector<Component*> found;
+        VisitPiece(piece, [&found, _componentType](Component* c, int){
+            if(_componentType == ComponentType::Any || c->componentType == _componentType)
+                found.push_back(c);
+        });
+        return found;
+    });
+    size_t total = outArray->size();
+    for(const vector<Component*>& piece : pieces)
+        total += piece.size();
+    outArray->reserve(total);
+    for(const vector<Component*>& piece : pieces)
+        outArray->insert(outArray->end(), piece.begin(), piece.end());
+}
+
 int sys_sage::Component::CountAllSubcomponents() const
 {
     return CountDescendantsByType(ComponentType::Any);
@@ -389,19 +831,26 @@ int sys_sage::Component::CountAllSubcomponentsByType(ComponentType::type _compon
 
 int sys_sage::Component::CountDescendantsByType(ComponentType::type _componentType) const
 {
-    int cnt = 0;
-    for(Component * child : children)
-    {
-        if(_componentType == ComponentType::Any || child->GetComponentType() == _componentType)
-            cnt++;
-    }
-    for(Component * child : children)
-    {
-        cnt += child->CountDescendantsByType(_componentType);
-    }
+    if(subtreeIndex != nullptr) //the index also contains this component itself
+        return subtreeIndex->CountComponentsByType(_componentType) - ((_componentType == ComponentType::Any || componentType == _componentType) ? 1 : 0);
+
+    //the traversal includes this component itself
+    int cnt = (_componentType == ComponentType::Any || componentType == _componentType) ? -1 : 0;
+    for([[maybe_unused]] Component* c : TraversePreOrder(_componentType))
+        cnt++;
     return cnt;
 }
 
+sys_sage::SubtreeRange sys_sage::Component::TraversePreOrder(ComponentType::type _componentType) const
+{
+    return SubtreeRange(const_cast<Component*>(this), _componentType, false);
+}
+
+sys_sage::SubtreeRange sys_sage::Component::TraversePostOrder(ComponentType::type _componentType) const
+{
+    return SubtreeRange(const_cast<Component*>(this), _componentType, true);
+}
+
 int sys_sage::Component::CountAllChildrenByType(ComponentType::type _componentType) const
 {
     return CountChildrenByType(_componentType);
@@ -430,7 +879,7 @@ sys_sage::Component* sys_sage::Component::GetAncestorByType(ComponentType::type
     return NULL;
 }
 
-void sys_sage::Component::_AddRelation(RelationType::type relationType, Relation* r)
+uint32_t sys_sage::Component::_AddRelation(RelationType::type relationType, Relation* r)
 {
     if(!relations)
         relations = new std::array<std::vector<Relation*>*, RelationType::_num_relation_types>();
@@ -438,24 +887,121 @@ void sys_sage::Component::_AddRelation(RelationType::type relationType, Relation
         (*relations)[relationType] = new std::vector<Relation*>();
     
     (*relations)[relationType]->push_back(r);
+    if(relationType == RelationType::DataPath)
+        _InvalidateDataPathIndex();
+    return static_cast<uint32_t>((*relations)[relationType]->size() - 1);
+}
+
+void sys_sage::Component::_RemoveRelation(RelationType::type relationType, Relation* r, uint32_t slot)
+{
+    std::vector<Relation*>& rv = _GetRelationsByType(relationType);
+    //lists copied by Clone() do not hold the relations at their slots: fall back to a search
+    if(slot >= rv.size() || rv[slot] != r)
+    {
+        auto it = std::find(rv.begin(), rv.end(), r);
+        if(it == rv.end())
+            return;
+        slot = static_cast<uint32_t>(it - rv.begin());
+    }
+    uint32_t last = static_cast<uint32_t>(rv.size() - 1);
+    if(slot != last)
+    {
+        Relation* moved = rv[last];
+        rv[slot] = moved;
+        moved->_MoveSlot(this, last, slot);
+    }
+    rv.pop_back();
+}
+
+void sys_sage::Component::_ReindexRelations(RelationType::type relationType)
+{
+    std::vector<Relation*>& rv = _GetRelationsByType(relationType);
+    for(Relation* r : rv)
+        r->_ClearSlots(this);
+    for(uint32_t i = 0; i < rv.size(); i++)
+        rv[i]->_AssignSlot(this, i);
+}
+
+void sys_sage::Component::ReserveRelations(RelationType::type relationType, size_t numRelations)
+{
+    if(relationType < 0 || relationType >= RelationType::_num_relation_types)
+        return;
+    if(!relations)
+        relations = new std::array<std::vector<Relation*>*, RelationType::_num_relation_types>();
+    if(!(*relations)[relationType])
+        (*relations)[relationType] = new std::vector<Relation*>();
+    (*relations)[relationType]->reserve(numRelations);
 }
 
 sys_sage::DataPath* sys_sage::Component::GetDataPathByType(DataPathType::type  dp_type, DataPathDirection::type direction) const
 {
-    for(Relation* r: *(*relations)[RelationType::DataPath])
+    DataPath* ret = NULL;
+    ForEachDataPath([&ret](DataPath* dp){ ret = dp; return false; }, dp_type, direction);
+    return ret;
+}
+
+sys_sage::DataPath* sys_sage::Component::FindDataPath(const Component* target, DataPathType::type dp_type) const
+{
+    if(const DataPathIndex* index = _GetDataPathIndex(DataPathDirection::Outgoing))
+        return index->FindTo(target, dp_type);
+    //same selection as ForEachDataPath(visitor, dp_type, DataPathDirection::Outgoing)
+    for(Relation* r : GetRelationsByType(RelationType::DataPath))
     {
-        //either unordered -> check; or orientation is any -> check; or orientation is incoming & DP is incoming or the same outgoing
-        if(!r->IsOrdered() || 
-            direction == DataPathDirection::Any || 
-            (direction == DataPathDirection::Outgoing && r->GetComponent(0) == this) ||  
-            (direction == DataPathDirection::Incoming && r->GetComponent(1) == this))
-        {
-            DataPath* dp = reinterpret_cast<DataPath*>(r);
-            if(dp->GetDataPathType() == dp_type)
-                return dp;
-        }
+        const RelationComponents& components = r->GetComponents();
+        if(components.size() < 2 || (r->IsOrdered() && components[0] != this))
+            continue;
+        DataPath* dp = static_cast<DataPath*>(r);
+        if(((components[0] == this) ? components[1] : components[0]) == target && (dp_type == DataPathType::Any || dp->GetDataPathType() == dp_type))
+            return dp;
     }
-    return NULL;
+    return nullptr;
+}
+
+sys_sage::DataPath* sys_sage::Component::UpsertDataPath(Component* target, DataPathType::type dp_type, DataPathOrientation::type orientation, const std::string& key, const AttribValue& value, bool* created)
+{
+    DataPath* found = nullptr;
+    if(key.empty())
+        found = FindDataPath(target, dp_type);
+    else
+    {
+        AttribId id = FindAttribKey(key);
+        ForEachDataPath([&](DataPath* dp){
+            const RelationComponents& components = dp->GetComponents();
+            if(components.size() < 2 || ((components[0] == this) ? components[1] : components[0]) != target)
+                return true;
+            //like GetAttr(): the typed attribute first, the attrib map second (e.g. a mig_uuid loaded by importFromXml())
+            const AttribValue* v = (id != invalidAttribId) ? dp->GetAttribStore().Find(id) : nullptr;
+            if((v != nullptr) ? !(*v == value) : !_AttribMapEquals(dp->attrib, key, value))
+                return true;
+            found = dp;
+            return false;
+        }, dp_type, DataPathDirection::Outgoing);
+    }
+    if(created != nullptr)
+        *created = (found == nullptr);
+    if(found != nullptr)
+        return found;
+
+    found = new DataPath(this, target, orientation, dp_type);
+    if(!key.empty())
+        found->SetAttr(key, value);
+    return found;
+}
+
+void sys_sage::Component::_InvalidateDataPathIndex() const
+{
+    dataPathIndex.Invalidate();
+    DataPath::_NotifyChanged();
+}
+
+const sys_sage::DataPathIndex* sys_sage::Component::_GetDataPathIndex(DataPathDirection::type direction) const
+{
+    if(relations == nullptr || (*relations)[RelationType::DataPath] == nullptr)
+        return nullptr;
+    //the index only holds the three known directions
+    if(direction != DataPathDirection::Any && direction != DataPathDirection::Outgoing && direction != DataPathDirection::Incoming)
+        return nullptr;
+    return dataPathIndex.Get(this, (*relations)[RelationType::DataPath]->size());
 }
 
 std::vector<sys_sage::Relation*>& sys_sage::Component::_GetRelations(RelationType::type relationType) const
@@ -470,6 +1016,8 @@ std::vector<sys_sage::Relation*>& sys_sage::Component::_GetRelationsByType(Relat
         relationType < RelationType::_num_relation_types &&
         (*relations)[relationType]) 
     {
+        if(relationType == RelationType::DataPath)
+            _InvalidateDataPathIndex();
         return *(*relations)[relationType];
     }
 
@@ -504,19 +1052,7 @@ std::vector<sys_sage::Relation*> sys_sage::Component::GetAllRelationsBy(Relation
 std::vector<sys_sage::Relation*> sys_sage::Component::FindRelations(RelationType::type relationType, int thisComponentPosition) const
 {
     vector<Relation*> out_vector;
-    for(int curr_rt : RelationType::RelationTypeList)
-    {
-        if(relationType == RelationType::Any || relationType == curr_rt)
-        {
-            for(Relation* r : *(*relations)[curr_rt])
-            {
-                if(!r->IsOrdered() || (r->IsOrdered() && (thisComponentPosition==-1 || r->GetComponent(thisComponentPosition) == this)))
-                {
-                    out_vector.push_back(r);
-                }
-            }
-        }
-    }
+    ForEachRelation([&out_vector](Relation* r){ out_vector.push_back(r); }, relationType, thisComponentPosition);
     return out_vector;
 }
 
@@ -527,22 +1063,7 @@ void sys_sage::Component::GetAllDataPaths(std::vector<DataPath*>* outDpArr, Data
 
 void sys_sage::Component::FindDataPaths(std::vector<DataPath*>* outDpArr, DataPathType::type dp_type, DataPathDirection::type direction) const
 {
-    if (relations == nullptr || (*relations)[RelationType::DataPath] == nullptr)
-        return;
-
-    for(Relation* r: *(*relations)[RelationType::DataPath])
-    {
-        //either unordered -> check; or orientation is any -> check; or orientation is incoming & DP is incoming or the same outgoing
-        if(!r->IsOrdered() || 
-            direction == DataPathDirection::Any || 
-            (direction == DataPathDirection::Outgoing && r->GetComponent(0) == this) ||
-            (direction == DataPathDirection::Incoming && r->GetComponent(1) == this))
-        {
-            DataPath* dp = reinterpret_cast<DataPath*>(r);
-            if(dp_type == DataPathType::Any || dp->GetDataPathType() == dp_type)
-                outDpArr->push_back(dp);
-        }
-    }
+    ForEachDataPath([outDpArr](DataPath* dp){ outDpArr->push_back(dp); }, dp_type, direction);
     return;
 }
 
@@ -574,15 +1095,14 @@ int sys_sage::Component::CheckComponentTreeConsistency() const
 int sys_sage::Component::CheckSubtreeConsistency() const
 {
     int errors = 0;
-    for(Component * child : children){
-        if(child->GetParent() != this){
-            // std::cerr << "Component " << child->GetComponentTypeStr() << " id " << child->GetId() << " has wrong parent" << std::endl;
-            errors++;
+    WalkSubtree(this, [&errors](const Component* c, int){
+        for(Component * child : c->children){
+            if(child->GetParent() != c){
+                // std::cerr << "Component " << child->GetComponentTypeStr() << " id " << child->GetId() << " has wrong parent" << std::endl;
+                errors++;
+            }
         }
-    }
-    for(Component * child : children){
-        errors += child->CheckSubtreeConsistency();
-    }
+    }, [](const Component*, int){});
     return errors;
 }
 
@@ -598,6 +1118,22 @@ int sys_sage::Component::CalcSubtreeSize(unsigned * out_component_size, unsigned
     return _CalcSubtreeSize(out_component_size, out_RelationSize, &countedRelations);
 }
 
+int sys_sage::Component::CalcSubtreeSize(unsigned * out_component_size, unsigned * out_RelationSize, unsigned * out_arenaSize) const
+{
+    int ret = CalcSubtreeSize(out_component_size, out_RelationSize);
+
+    const Component* root = this;
+    while(root->GetParent() != NULL)
+        root = root->GetParent();
+    if(root->GetComponentType() == ComponentType::Topology)
+    {
+        Arena* arena = static_cast<const Topology*>(root)->GetArena();
+        if(arena != nullptr)
+            (*out_arenaSize) += arena->GetBytesReserved();
+    }
+    return ret;
+}
+
 int sys_sage::Component::_GetTopologySize(unsigned * out_component_size, unsigned * out_RelationSize, std::set<Relation*>* countedRelations) const
 {
     return _CalcSubtreeSize(out_component_size, out_RelationSize, countedRelations);
@@ -605,103 +1141,309 @@ int sys_sage::Component::_GetTopologySize(unsigned * out_component_size, unsigne
 
 int sys_sage::Component::_CalcSubtreeSize(unsigned * out_component_size, unsigned * out_RelationSize, std::set<Relation*>* countedRelations) const
 {
-    int component_size = 0;
-    switch(componentType)
+    int subtreeSize = 0;
+    //a copy-on-write copy (see Clone()) reports only the components and Relations it does not share with the original
+    WalkOwnedSubtree(this, [&](const Component* c, int)
+    {
+        int component_size = _CalcComponentSize(c);
+        (*out_component_size) += component_size;
+
+        int relationsSize = 0;
+        for(RelationType::type rt : RelationType::RelationTypeList)
+        {
+            const std::vector<Relation*>& rv = c->GetRelationsByType(rt);
+            for(Relation* r: rv)
+            {
+                if(c->cloneSource != nullptr && !r->ContainsComponent(const_cast<Component*>(c)))
+                    continue;
+                if(countedRelations->find(r) == countedRelations->end())
+                {
+                    relationsSize += _CalcRelationSize(r, rt);
+                    countedRelations->insert(r);
+                }
+            }
+        }
+        (*out_RelationSize) += relationsSize;
+        subtreeSize += component_size + relationsSize;
+    });
+
+    return subtreeSize;
+}
+
+int sys_sage::Component::CalcSubtreeSize(unsigned * out_component_size, unsigned * out_RelationSize, const ParallelTraversal& parallel) const
+{
+    struct PieceSize {
+        int componentSize = 0;
+        std::vector<std::pair<Relation*, int>> relations; /**< relations of the piece (each once, in the order of the serial traversal) and their sizes */
+    };
+    const Component* root = this;
+    std::vector<PieceSize> pieces = parallel.MapPieces<PieceSize>(const_cast<Component*>(this), [root](const ParallelTraversal::Piece& piece){
+        PieceSize size;
+        //like the serial traversal, a copy-on-write copy (see Clone()) skips the subtrees it shares with the original:
+        //their components have parents in the original, so the root is not among the ancestors of the piece
+        const Component* ancestor = piece.root;
+        while(ancestor != nullptr && ancestor != root)
+            ancestor = ancestor->GetParent();
+        if(ancestor == nullptr)
+            return size;
+
+        std::unordered_set<Relation*> seen;
+        auto visit = [&size, &seen](const Component* c, int){
+            size.componentSize += _CalcComponentSize(c);
+            for(RelationType::type rt : RelationType::RelationTypeList)
+                for(Relation* r : c->GetRelationsByType(rt))
+                {
+                    if(c->cloneSource != nullptr && !r->ContainsComponent(const_cast<Component*>(c)))
+                        continue;
+                    if(seen.insert(r).second)
+                        size.relations.emplace_back(r, _CalcRelationSize(r, rt));
+                }
+        };
+        if(piece.wholeSubtree)
+            WalkOwnedSubtree(piece.root, visit);
+        else
+            visit(piece.root, 0);
+        return size;
+    });
+
+    //a Relation shared by several pieces is counted once, like in the serial traversal
+    std::set<Relation*> countedRelations;
+    int subtreeSize = 0;
+    for(const PieceSize& piece : pieces)
+    {
+        (*out_component_size) += piece.componentSize;
+        subtreeSize += piece.componentSize;
+        for(const auto& [r, relationSize] : piece.relations)
+        {
+            if(countedRelations.insert(r).second)
+            {
+                (*out_RelationSize) += relationSize;
+                subtreeSize += relationSize;
+            }
+        }
+    }
+    return subtreeSize;
+}
+
+int sys_sage::Component::_CalcComponentSize(const Component* c)
+{
+    return static_cast<int>(_AccountComponent(c, nullptr, nullptr));
+}
+
+int sys_sage::Component::_CalcRelationSize(const Relation* r, RelationType::type)
+{
+    return static_cast<int>(_AccountRelation(r, nullptr, nullptr));
+}
+
+size_t sys_sage::Component::CalcFootprint(MemoryFootprint* out, AttribSizeFcn attribSizeFcn) const
+{
+    size_t totalBefore = out->total;
+    std::unordered_set<const Relation*> countedRelations;
+    WalkOwnedSubtree(this, [&](const Component* c, int)
+    {
+        _AccountComponent(c, out, attribSizeFcn);
+        for(RelationType::type rt : RelationType::RelationTypeList)
+        {
+            for(Relation* r : c->GetRelationsByType(rt))
+            {
+                if(c->cloneSource != nullptr && !r->ContainsComponent(const_cast<Component*>(c)))
+                    continue;
+                if(countedRelations.insert(r).second)
+                    _AccountRelation(r, out, attribSizeFcn);
+            }
+        }
+    });
+    return out->total - totalBefore;
+}
+
+//adds the footprint of c (without its Relations) to out, if out is not nullptr, and returns it
+size_t sys_sage::Component::_AccountComponent(const Component* c, MemoryFootprint* out, const AttribSizeFcn& attribSizeFcn)
+{
+    size_t objectSize = 0;
+    switch(c->componentType)
     {
-        case ComponentType::Generic:
-            component_size += sizeof(Component);
-        break;
         case ComponentType::Thread:
-            component_size += sizeof(Thread);
+            objectSize = sizeof(Thread);
         break;
         case ComponentType::Core:
-            component_size += sizeof(Core);
+            objectSize = sizeof(Core);
         break;
         case ComponentType::Cache:
-            component_size += sizeof(Cache);
+            objectSize = sizeof(Cache);
         break;
         case ComponentType::Subdivision:
-            component_size += sizeof(Subdivision);
+            objectSize = sizeof(Subdivision);
         break;
         case ComponentType::Numa:
-            component_size += sizeof(Numa);
+            objectSize = sizeof(Numa);
         break;
         case ComponentType::Chip:
-            component_size += sizeof(Chip);
+            objectSize = sizeof(Chip);
         break;
         case ComponentType::Memory:
-            component_size += sizeof(Memory);
+            objectSize = sizeof(Memory);
         break;
         case ComponentType::Storage:
-            component_size += sizeof(Storage);
+            objectSize = sizeof(Storage);
         break;
         case ComponentType::Node:
-            component_size += sizeof(Node);
+            objectSize = sizeof(Node);
+        break;
+        case ComponentType::QuantumBackend:
+            objectSize = sizeof(QuantumBackend);
+        break;
+        case ComponentType::AtomSite:
+            objectSize = sizeof(AtomSite);
+        break;
+        case ComponentType::Qubit:
+            objectSize = sizeof(Qubit);
         break;
         case ComponentType::Topology:
-            component_size += sizeof(Topology);
+            objectSize = sizeof(Topology);
+        break;
+        default: //Generic, or a user-defined component type
+            objectSize = sizeof(Component);
         break;
     }
-    component_size += attrib.size()*(sizeof(std::string)+sizeof(void*)); //TODO improve
-    component_size += children.size()*sizeof(Component*);
-    //relations -- only counting the vector/array sizes
-    if(relations)
+    objectSize += c->_GetMembersHeapSize();
+
+    size_t childrenSize = _VectorHeapSize(c->children);
+    size_t relationContainersSize = 0;
+    if(c->relations)
     {
-        component_size += sizeof(std::array<std::vector<Relation*>*, RelationType::_num_relation_types>);
-        for(int i = 0; i<RelationType::_num_relation_types; i++)
-        {
-            if((*relations)[i] != NULL)
-            {
-                component_size += sizeof(*(*relations)[i]);
-            }
-        }
+        relationContainersSize += sizeof(*c->relations);
+        for(const std::vector<Relation*>* rv : *c->relations)
+            if(rv != nullptr)
+                relationContainersSize += sizeof(*rv) + _VectorHeapSize(*rv);
+    }
+    size_t indexSize = (c->subtreeIndex != nullptr) ? c->subtreeIndex->GetFootprint() : 0;
+    if(const DataPathIndex* dataPathIndex = c->dataPathIndex.Peek())
+        indexSize += dataPathIndex->GetFootprint();
+
+    if(out != nullptr)
+    {
+        out->componentTypes[c->componentType] += objectSize;
+        out->childrenContainers += childrenSize;
+        out->relationContainers += relationContainersSize;
+        out->indexes += indexSize;
+        out->total += objectSize + childrenSize + relationContainersSize + indexSize;
     }
-    (*out_component_size) += component_size;
+    return objectSize + childrenSize + relationContainersSize + indexSize + _AccountAttribs(c->attrib, nullptr, out, attribSizeFcn) + _AccountTypedAttribs(c->attrs, out, attribSizeFcn) + _AccountAttribOwners(c->attribOwners, out);
+}
 
-    int relationsSize = 0;
+//adds the footprint of r to out, if out is not nullptr, and returns it
+size_t sys_sage::Component::_AccountRelation(const Relation* r, MemoryFootprint* out, const AttribSizeFcn& attribSizeFcn)
+{
+    size_t objectSize = 0;
+    switch(r->GetType())
+    {
+        case RelationType::DataPath:
+            objectSize = sizeof(DataPath);
+        break;
+        case RelationType::QuantumGate:
+            objectSize = sizeof(QuantumGate);
+        break;
+        case RelationType::CouplingMap:
+            objectSize = sizeof(CouplingMap);
+        break;
+        case RelationType::DataPathMatrix:
+            objectSize = sizeof(DataPathMatrix);
+        break;
+        default:
+            objectSize = sizeof(Relation);
+        break;
+    }
+    objectSize += r->_GetMembersHeapSize();
 
+    if(out != nullptr)
+    {
+        out->relationTypes[r->GetType()] += objectSize;
+        out->total += objectSize;
+    }
+    return objectSize + _AccountAttribs(r->attrib, r, out, attribSizeFcn) + _AccountTypedAttribs(r->GetAttribStore(), out, attribSizeFcn) + _AccountAttribOwners(r->_GetAttribOwners(), out);
+}
 
-    for(RelationType::type rt : RelationType::RelationTypeList)
+//adds the footprint of the attributes (map nodes, keys and known values) to out, if out is not nullptr, and returns it
+size_t sys_sage::Component::_AccountAttribs(const std::map<std::string, void*>& attrib, [[maybe_unused]] const Relation* owner, MemoryFootprint* out, const AttribSizeFcn& attribSizeFcn)
+{
+    size_t size = 0;
+    for(const auto& [key, value] : attrib)
     {
-        std::vector<Relation*> rv = GetRelationsByType(rt);
-        for(Relation* r: rv)
+        size_t valueSize = 0;
+        if(attribSizeFcn)
+            valueSize = attribSizeFcn(key, value);
+#ifdef SS_PAPI
+        if(valueSize == 0 && owner != nullptr && owner->GetCategory() == RelationCategory::PAPI_Metrics)
+            valueSize = _CalcPAPImetricsAttribSize(key, value);
+#endif
+        if(valueSize == 0)
+            valueSize = _search_default_attrib_size(key, value);
+
+        size_t attribSize = sizeof(std::pair<const std::string, void*>) + _mapNodeOverhead + _StringHeapSize(key) + valueSize;
+        if(out != nullptr)
         {
-            if(countedRelations->find(r) == countedRelations->end())
-            {
-                switch(rt)
-                {
-                    case RelationType::Relation:
-                        relationsSize += sizeof(Relation);
-                        relationsSize += r->attrib.size() * (sizeof(string)+sizeof(void*)); //TODO improve
-                        break;
-                    case RelationType::DataPath:
-                        relationsSize += sizeof(DataPath);
-                        relationsSize += r->attrib.size() * (sizeof(string)+sizeof(void*)); //TODO improve
-                        break;
-                    case RelationType::QuantumGate:
-                        relationsSize += sizeof(QuantumGate);
-                        relationsSize += r->attrib.size() * (sizeof(string)+sizeof(void*)); //TODO improve
-                        break;
-                    case RelationType::CouplingMap:
-                        relationsSize += sizeof(CouplingMap);
-                        relationsSize += r->attrib.size() * (sizeof(string)+sizeof(void*)); //TODO improve
-                        break;
-                }
-                countedRelations->insert(r);
-            }
+            out->attributes[key] += attribSize;
+            out->total += attribSize;
+            if(valueSize == 0 && value != nullptr)
+                out->numUnknownAttribs++;
         }
+        size += attribSize;
     }
-    (*out_RelationSize) += relationsSize;
+    return size;
+}
 
-    int subtreeSize = 0;
-    for(Component * c : children)
+//adds the footprint of the typed attributes (entries, unused capacity and the heap memory of the values) to out, if out is not nullptr, and returns it
+size_t sys_sage::Component::_AccountTypedAttribs(const AttribStore& attrs, MemoryFootprint* out, const AttribSizeFcn& attribSizeFcn)
+{
+    const std::vector<AttribStore::Entry>& entries = attrs.GetEntries();
+    size_t size = 0;
+    for(const auto& [id, value] : entries)
+    {
+        size_t valueSize = _AttribValueHeapSize(value);
+        bool unknown = false;
+        if(const AttribPtr* p = std::get_if<AttribPtr>(&value); p != nullptr && *p != nullptr)
+        {
+            const std::string& key = GetAttribKeyName(id);
+            if(attribSizeFcn)
+                valueSize = attribSizeFcn(key, p->get());
+            if(valueSize == 0)
+                valueSize = _search_default_attrib_size(key, p->get());
+            unknown = (valueSize == 0);
+        }
+
+        size_t attribSize = sizeof(AttribStore::Entry) + valueSize;
+        if(out != nullptr)
+        {
+            out->attributes[GetAttribKeyName(id)] += attribSize;
+            out->total += attribSize;
+            if(unknown)
+                out->numUnknownAttribs++;
+        }
+        size += attribSize;
+    }
+    size_t unusedSize = (entries.capacity() - entries.size()) * sizeof(AttribStore::Entry);
+    if(out != nullptr)
     {
-        subtreeSize += c->_CalcSubtreeSize(out_component_size, out_RelationSize, countedRelations);
+        out->attribContainers += unusedSize;
+        out->total += unusedSize;
     }
+    return size + unusedSize;
+}
 
-    return component_size + relationsSize + subtreeSize;
+//adds the footprint of the ownership records of the attrib map (see SetAttrib()) to out, if out is not nullptr, and returns it; the owned values are counted with the attrib map
+size_t sys_sage::Component::_AccountAttribOwners(const AttribStore& owners, MemoryFootprint* out)
+{
+    size_t size = _VectorHeapSize(owners.GetEntries());
+    if(out != nullptr)
+    {
+        out->attribContainers += size;
+        out->total += size;
+    }
+    return size;
 }
 
+size_t sys_sage::Component::_GetMembersHeapSize() const { return _StringHeapSize(name); }
+
 int sys_sage::Component::GetDepth(bool refresh)
 {
     return CalcDepth(refresh);
@@ -737,6 +1479,8 @@ void sys_sage::Component::DeleteRelation(Relation * r)
     } else if(rt == RelationType::CouplingMap){
         CouplingMap* cm = reinterpret_cast<CouplingMap*>(r);
         cm->Delete();
+    } else if(rt == RelationType::DataPathMatrix){
+        r->Delete();
     } else{ //this should never happen
         std::cout << "ERROR void sys_sage::Component::DeleteRelation(Relation * r)" << std::endl;
         exit(1);
@@ -750,22 +1494,63 @@ void sys_sage::Component::DeleteAllRelations(RelationType::type relationType)
 
 void sys_sage::Component::DeleteRelations(RelationType::type relationType)
 {
+    DeleteRelations(relationType, [](Relation*){ return true; });
+}
+
+size_t sys_sage::Component::DeleteRelations(RelationType::type relationType, const std::function<bool(Relation*)>& predicate)
+{
+    if(cloneSource != nullptr)
+        _DropSharedRelations();
+    size_t numDeleted = 0;
+    std::vector<Relation*> deleted;
+    std::unordered_map<Relation*, bool> decided; //relations this component takes part in more than once -> deleted or not
     for(RelationType::type rt : RelationType::RelationTypeList)
     {
-        if(relationType == RelationType::Any || relationType == rt)
+        if((relationType != RelationType::Any && relationType != rt) || relations == nullptr || (*relations)[rt] == nullptr || (*relations)[rt]->empty())
+            continue;
+        std::vector<Relation*>& rv = _GetRelationsByType(rt);
+        //compact the list in place; a relation listed more than once (this component taking part more than once) is decided at its first entry
+        deleted.clear();
+        decided.clear();
+        size_t kept = 0;
+        for(Relation* r : rv)
         {
-            while(true)
+            bool remove;
+            const RelationComponents& rc = r->GetComponents();
+            if(std::count(rc.begin(), rc.end(), this) > 1)
             {
-                vector<Relation*> vec_r = GetRelationsByType(rt);
-                if(vec_r.size() > 0)
+                auto [it, first] = decided.try_emplace(r, false);
+                if(first)
                 {
-                    DeleteRelation(vec_r[0]);
+                    it->second = predicate(r);
+                    if(it->second)
+                        deleted.push_back(r);
                 }
-                else
-                    break;
+                remove = it->second;
             }
+            else
+            {
+                remove = predicate(r);
+                if(remove)
+                    deleted.push_back(r);
+            }
+            if(!remove)
+                rv[kept++] = r;
         }
+        if(deleted.empty())
+            continue;
+        rv.resize(kept);
+        for(Relation* r : deleted)
+            r->_ClearSlots(this);
+        _ReindexRelations(rt);
+        for(Relation* r : deleted)
+        {
+            r->_Unlink(this);
+            r->_Free();
+        }
+        numDeleted += deleted.size();
     }
+    return numDeleted;
 }
 
 
@@ -781,10 +1566,22 @@ void sys_sage::Component::DeleteAllDataPaths()
 
 void sys_sage::Component::DeleteSubtree() const
 {
-    while(children.size() > 0)
-    {       
-        children[0]->Delete(true); // Recursively free children
-    }
+    if(children.empty())
+        return;
+    Component* self = const_cast<Component*>(this);
+    for(Component* child : children)
+        self->_NotifySubtreeRemoved(child);
+
+    //post-order: each component is freed after its children; it is not unlinked from its parent, which is freed later anyway
+    //(children shared by a copy-on-write copy belong to the original and are not freed)
+    WalkOwnedSubtree(self, [self](Component* c, int){
+        if(c == self)
+            return;
+        c->DeleteRelations();
+        c->_Deallocate();
+    });
+    self->children.clear();
+    self->firstStaleChildIndex = 0;
     return;
 }
 
@@ -821,9 +1618,243 @@ void sys_sage::Component::Delete(bool withSubtree)
         }
     }
     // Delete the component itself
-    delete this;
+    _Deallocate();
+}
+
+sys_sage::Component* sys_sage::Component::Clone(bool deep) const
+{
+    Component* root = _CopyComponent(this);
+    if(!deep)
+    {
+        root->cloneSource = this;
+        root->children = children;
+        root->relations = CopyRelationLists(relations);
+        return root;
+    }
+
+    //copy the components in pre-order; path holds the copies of the ancestors of the current component
+    std::vector<std::pair<const Component*, Component*>> copies { { this, root } };
+    std::unordered_map<const Component*, Component*> copyOf { { this, root } };
+    std::vector<Component*> path;
+    WalkSubtree(this, [&](const Component* c, int){
+        Component* copy = root;
+        if(c != this)
+        {
+            copy = _CopyComponent(c);
+            path.back()->InsertChild(copy);
+            copies.emplace_back(c, copy);
+            copyOf.emplace(c, copy);
+        }
+        copy->children.reserve(c->children.size());
+        path.push_back(copy);
+    }, [&path](const Component*, int){ path.pop_back(); });
+
+    //copy the Relations among the copied components
+    std::unordered_set<const Relation*> visited;
+    std::vector<Component*> components;
+    for(const auto& [c, copy] : copies)
+    {
+        for(RelationType::type rt : RelationType::RelationTypeList)
+        {
+            for(Relation* r : c->GetRelationsByType(rt))
+            {
+                if(!visited.insert(r).second)
+                    continue;
+                components.clear();
+                for(Component* rc : r->GetComponents())
+                {
+                    auto it = copyOf.find(rc);
+                    if(it == copyOf.end())
+                        break;
+                    components.push_back(it->second);
+                }
+                if(components.size() == r->GetComponents().size())
+                    r->_CloneWith(components);
+            }
+        }
+    }
+    return root;
+}
+
+sys_sage::Component* sys_sage::Component::MakeWritable(Component* c)
+{
+    //private components are linked to this component by their parent pointers
+    for(const Component* p = c; p != nullptr; p = p->parent)
+        if(p == this)
+            return c;
+    if(cloneSource == nullptr)
+        return nullptr;
+
+    //c is an original component: find the path from the original of this component down to c
+    std::vector<Component*> originals;
+    const Component* p = c;
+    for(; p != nullptr && p != cloneSource; p = p->parent)
+        originals.push_back(const_cast<Component*>(p));
+    if(p == nullptr)
+        return nullptr;
+
+    Component* copy = this;
+    for(auto it = originals.rbegin(); it != originals.rend(); ++it)
+    {
+        Component* original = *it;
+        auto matches = [original](const Component* child){ return child == original || child->cloneSource == original; };
+        //the copies keep the positions of the originals, unless the children were rearranged in the meantime
+        size_t index = original->indexInParent;
+        if(index >= copy->children.size() || !matches(copy->children[index]))
+            index = std::find_if(copy->children.begin(), copy->children.end(), matches) - copy->children.begin();
+        if(index == copy->children.size())
+            return nullptr;
+        if(copy->children[index] != original)
+        {
+            copy = copy->children[index];
+            continue;
+        }
+
+        Component* privateCopy = _CopyComponent(original);
+        privateCopy->cloneSource = original;
+        privateCopy->children = original->children;
+        privateCopy->relations = CopyRelationLists(original->relations);
+        privateCopy->parent = copy;
+        privateCopy->indexInParent = index;
+        copy->children[index] = privateCopy;
+        copy = privateCopy;
+    }
+    return copy;
+}
+
+sys_sage::Relation* sys_sage::Component::MakeWritable(Relation* r)
+{
+    std::vector<Component*> components;
+    for(Component* c : r->GetComponents())
+    {
+        Component* privateCopy = MakeWritable(c);
+        if(privateCopy == nullptr)
+            return nullptr;
+        components.push_back(privateCopy);
+    }
+    if(components == r->GetComponents())
+        return r;
+
+    //the copy takes the place of r in the Relations of the private components
+    Relation* copy = r->_CloneWith(components);
+    for(Component* c : components)
+    {
+        std::vector<Relation*>& rv = c->_GetRelationsByType(r->GetType());
+        auto it = std::find(rv.begin(), rv.end(), r);
+        if(it != rv.end())
+        {
+            *it = copy;
+            rv.pop_back();
+            copy->_MoveSlot(c, static_cast<uint32_t>(rv.size()), static_cast<uint32_t>(it - rv.begin()));
+        }
+    }
+    return copy;
+}
+
+const sys_sage::Component* sys_sage::Component::GetCloneSource() const { return cloneSource; }
+
+sys_sage::Component* sys_sage::Component::_CopyComponent(const Component* c)
+{
+    Component* copy;
+    switch(c->componentType)
+    {
+        case ComponentType::Generic:
+            copy = new Component(*c);
+        break;
+        case ComponentType::Thread:
+            copy = new Thread(*static_cast<const Thread*>(c));
+        break;
+        case ComponentType::Core:
+            copy = new Core(*static_cast<const Core*>(c));
+        break;
+        case ComponentType::Cache:
+            copy = new Cache(*static_cast<const Cache*>(c));
+        break;
+        case ComponentType::Subdivision:
+            copy = new Subdivision(*static_cast<const Subdivision*>(c));
+        break;
+        case ComponentType::Numa:
+            copy = new Numa(*static_cast<const Numa*>(c));
+        break;
+        case ComponentType::Chip:
+            copy = new Chip(*static_cast<const Chip*>(c));
+        break;
+        case ComponentType::Memory:
+            copy = new Memory(*static_cast<const Memory*>(c));
+        break;
+        case ComponentType::Storage:
+            copy = new Storage(*static_cast<const Storage*>(c));
+        break;
+        case ComponentType::Node:
+            copy = new Node(*static_cast<const Node*>(c));
+        break;
+        case ComponentType::QuantumBackend:
+            copy = new QuantumBackend(*static_cast<const QuantumBackend*>(c));
+        break;
+        case ComponentType::AtomSite:
+            copy = new AtomSite(*static_cast<const AtomSite*>(c));
+        break;
+        case ComponentType::Qubit:
+            copy = new Qubit(*static_cast<const Qubit*>(c));
+        break;
+        case ComponentType::Topology: //not copy-constructed: a Topology owns its Arena
+            copy = new Topology();
+        break;
+        default: //user-defined component type
+            copy = new Component();
+        break;
+    }
+    copy->id = c->id;
+    copy->name = c->name;
+    copy->count = c->count;
+    copy->attrib = c->attrib;
+    copy->attrs = c->attrs;
+    copy->attribOwners = c->attribOwners;
+    //the copy is not linked to the Component Tree or to Relations yet
+    copy->depth = 0;
+    copy->parent = nullptr;
+    copy->children.clear();
+    copy->indexInParent = 0;
+    copy->firstStaleChildIndex = 0;
+    copy->relations = nullptr;
+    copy->subtreeIndex = nullptr;
+    copy->slabPool = nullptr;
+    copy->labelStamp = 0;
+    copy->labelFirst = 0;
+    copy->labelEnd = 0;
+    copy->cloneSource = nullptr;
+    _AddToAttribIndices(copy);
+    return copy;
+}
+
+void sys_sage::Component::_DropSharedRelations()
+{
+    if(relations == nullptr)
+        return;
+    for(std::vector<Relation*>* rv : *relations)
+        if(rv != nullptr)
+            std::erase_if(*rv, [this](Relation* r){ return !r->ContainsComponent(this); });
+    for(RelationType::type rt : RelationType::RelationTypeList)
+        if((*relations)[rt] != nullptr)
+            _ReindexRelations(rt);
+    _InvalidateDataPathIndex();
 }
 
+void sys_sage::Component::_Deallocate()
+{
+    if(slabPool != nullptr)
+    {
+        SlabPool* pool = slabPool;
+        this->~Component();
+        pool->Free(this);
+    }
+    else
+        delete this;
+}
+
+void sys_sage::Component::_SetSlabPool(SlabPool* pool) { slabPool = pool; }
+sys_sage::SlabPool* sys_sage::Component::_GetSlabPool() const { return slabPool; }
+
 const std::string& sys_sage::Component::GetName() const {return name;}
 void sys_sage::Component::SetName(std::string _name){ name = _name; }
 sys_sage::Component* sys_sage::Component::GetParent() const {return parent;}
@@ -832,7 +1863,32 @@ const std::vector<sys_sage::Component*>& sys_sage::Component::GetChildren() cons
 std::vector<sys_sage::Component*>& sys_sage::Component::_GetChildren() {return children;}
 sys_sage::ComponentType::type sys_sage::Component::GetComponentType() const {return componentType;}
 int sys_sage::Component::GetId() const {return id;}
-void sys_sage::Component::SetId(int _id) { id = _id; }
+void sys_sage::Component::SetId(int _id)
+{
+    int oldId = id;
+    id = _id;
+    if(oldId == _id || SubtreeIndex::_GetNumInstances() == 0)
+        return;
+    for(Component* ancestor = this; ancestor != NULL; ancestor = ancestor->parent)
+    {
+        if(ancestor->subtreeIndex != nullptr)
+            ancestor->subtreeIndex->_OnIdChanged(this, oldId);
+        if(ancestor->parent == ancestor) //guard against self-loops in corrupt trees
+            break;
+    }
+}
+
+sys_sage::Component::~Component()
+{
+    _RemoveFromAttribIndices(this);
+    delete subtreeIndex;
+    if(relations != nullptr)
+    {
+        for(std::vector<Relation*>* rv : *relations)
+            delete rv;
+        delete relations;
+    }
+}
 
 sys_sage::Component::Component(int _id, std::string _name, ComponentType::type _componentType) : id(_id), name(_name), componentType(_componentType)
 {
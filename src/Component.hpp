@@ -2,6 +2,7 @@
 #define COMPONENT
 
 #include <array>
+#include <functional>
 #include <iostream>
 #include <vector>
 #include <map>
@@ -10,16 +11,28 @@
 #include "defines.hpp"
 #include "enums.hpp"
 #include "DataPath.hpp"
+#include "Traversal.hpp"
+#include "Footprint.hpp"
+#include "Attrib.hpp"
+#include "DataPathIndex.hpp"
 #include <libxml/parser.h>
 
 
 
 namespace sys_sage { //forward declaration
     class Topology;
+    class SlabPool;
+    class SubtreeIndex;
+    class ParallelTraversal;
+    class EpochManager;
 
     class Relation;
     class DataPath;
     class QuantumGate;
+
+    class Component;
+    template <class T> class BasicColumnStore;
+    using ColumnStore = BasicColumnStore<Component>;
 }
 
 
@@ -60,7 +73,7 @@ namespace sys_sage {
          * @private
          * @brief Use Delete() or DeleteSubtree() for deleting and deallocating the components.
          */
-        virtual ~Component() = default;
+        virtual ~Component();
         /**
          * @brief Inserts a child component to this component (in the Component Tree).
          * The child pointer will be inserted at the end of the children vector.
@@ -69,7 +82,44 @@ namespace sys_sage {
          * @see GetChild(int _id)
          */
         void InsertChild(Component * child);
-        
+        /**
+         * @brief Inserts several child components at once (in the given order), reserving the space in the children vector only once.
+         * @param newChildren Components to insert at the end of the children vector
+         * @see InsertChild()
+         */
+        void InsertChildren(const std::vector<Component*>& newChildren);
+        /**
+         * @brief Creates count children of class T in one pass, with the ids firstId, firstId+1, ... The children vector is grown only once.
+         * Each child is constructed as T(this, id, args...), i.e. with the constructor that inserts the new component into the Component Tree,
+         * e.g. node->CreateChildren<Thread>(64, 0, "HW_thread") or gpu->CreateChildren<Cache>(2, 0, "L2", size).
+         * @param count Number of children to create
+         * @param firstId Id of the first child
+         * @param args Further arguments passed to the constructor of each child
+         * @return The new children, in the order of their ids
+         */
+        template <class T, class... Args>
+        std::vector<T*> CreateChildren(size_t count, int firstId, const Args&... args)
+        {
+            std::vector<T*> created;
+            created.reserve(count);
+            _GrowChildren(count);
+            for(size_t i = 0; i < count; i++)
+                created.push_back(new T(this, firstId + static_cast<int>(i), args...));
+            return created;
+        }
+        /**
+         * @brief Reserves space for numChildren children, so that inserting up to that many children does not reallocate the children vector.
+         * @param numChildren Expected total number of children
+         */
+        void ReserveChildren(size_t numChildren);
+        /**
+         * @brief Reserves space for numRelations Relations of type relationType, so that adding up to that many Relations (e.g. creating DataPaths from/to this component) does not reallocate.
+         * The Relation storage of the component is allocated if needed.
+         * @param relationType Type of the Relations (e.g. RelationType::DataPath)
+         * @param numRelations Expected total number of Relations of that type
+         */
+        void ReserveRelations(RelationType::type relationType, size_t numRelations);
+
         /**
          * @brief Inserts this component between a parent and one of its children.
          * The parent component remains the parent, this Component becomes a new child of the parent, and the specified child becomes this component's child.
@@ -88,6 +138,7 @@ namespace sys_sage {
         /**
          * @brief Inserts this component between a parent and a (subset of) its children. 
          * The parent component remains parent, this Component becomes a new child, and the children become parent's grandchildren.
+         * The children are found via their index in the parent; with unordered children of the parent (SetStableChildrenOrder(false)), moving k children takes O(k), otherwise the parent's children vector is compacted once.
          * @param parent The parent component to which this component will be inserted as a child.
          * @param children A vector of child components that will become the children of this component and the grandchildren of the original parent.
          * @param alreadyParentsChild A boolean flag indicating whether this component is already a child of the parent. 
@@ -102,10 +153,30 @@ namespace sys_sage {
 
         /**
          * @brief Removes the passed component from the list of children, without completely deleting (and deallocating) the child itself
+         * The child is found in O(1) via its index in this component's children vector. With stable children order (default), the following children move one position forward and their indices are updated lazily; otherwise, the last child takes the place of the removed one (O(1)).
          * @param child Child to remove
          * @return Number of elements deleted (normally 0 or 1)
+         * @see SetStableChildrenOrder()
          */
         int RemoveChild(Component * child);
+        /**
+         * @brief Sets whether removing children (RemoveChild(), InsertBetweenParentAndChild(ren)(), Delete()) keeps the order of the remaining children of this component.
+         * \n In the stable order, the children vector is compacted eagerly: removing one child shifts the following ones (an O(n) move of pointers), several children removed at once are compacted in a single pass. Only the indices of the shifted children are refreshed lazily, on the next lookup that needs them.
+         * The children vector is never left with holes, because GetChildren() exposes it directly.
+         * @param stable true (default): the remaining children keep their order; false: a removed child is replaced by the last child, so that the removal is O(1)
+         */
+        void SetStableChildrenOrder(bool stable);
+        /**
+         * @brief Returns whether removing children keeps the order of the remaining children of this component.
+         * @see SetStableChildrenOrder()
+         */
+        bool GetStableChildrenOrder() const;
+        /**
+         * @brief Returns the position of this component in the children vector of its parent.
+         * Does not modify the tree (it can be called by concurrent readers): if the index of this component is stale after a removal, the stale part of the parent's children is searched.
+         * @return The index in GetParent()->GetChildren(), or -1 if there is no parent (or this component is not listed in its parent's children)
+         */
+        int GetIndexInParent() const;
         /**
          * @brief Set a parent to the component.
          * This is usually used when inserting a component in the tree (by calling InsertChild on the parent, and calling SetParent on the child).
@@ -130,6 +201,27 @@ namespace sys_sage {
     // TODO: search for other parts that should be private
     private:
         void _PrintSubtree(int level) const;
+        void _GrowChildren(size_t numNewChildren);
+        size_t _FindChild(Component* child);
+        //like _FindChild(), but does not refresh the stale indices of the children (a linear search over them instead)
+        size_t _FindChildReadOnly(const Component* child) const;
+        void _EraseChildAt(size_t index);
+        void _EraseChildren(const std::vector<Component*>& toErase);
+        void _PublishAttrib(const std::string& key, void* value, void (*deleter)(void*), bool owned, EpochManager& epochs);
+        void _PrintRelations(RelationType::type relationType) const;
+        bool _HasRelations(RelationType::type relationType) const;
+        static int _CalcComponentSize(const Component* c);
+        static int _CalcRelationSize(const Relation* r, RelationType::type relationType);
+        static size_t _AccountComponent(const Component* c, MemoryFootprint* out, const AttribSizeFcn& attribSizeFcn);
+        static size_t _AccountRelation(const Relation* r, MemoryFootprint* out, const AttribSizeFcn& attribSizeFcn);
+        static size_t _AccountAttribs(const std::map<std::string, void*>& attrib, const Relation* owner, MemoryFootprint* out, const AttribSizeFcn& attribSizeFcn);
+        static size_t _AccountTypedAttribs(const AttribStore& attrs, MemoryFootprint* out, const AttribSizeFcn& attribSizeFcn);
+        static size_t _AccountAttribOwners(const AttribStore& owners, MemoryFootprint* out);
+        static Component* _CopyComponent(const Component* c);
+        void _DropSharedRelations();
+        //sets the slots of this component in the relations of its list of relationType to their positions (after the list was rebuilt)
+        void _ReindexRelations(RelationType::type relationType);
+        const DataPathIndex* _GetDataPathIndex(DataPathDirection::type direction) const;
         /**
          * @deprecated Use PrintRelationsInSubtree instead. This function will be removed in the future.
          * @brief Prints all DataPaths that go from or to components in the subtree.
@@ -152,6 +244,12 @@ namespace sys_sage {
          * @param RelationType Filter by relation type (default: Any)
          */
         void PrintRelationsInSubtree(RelationType::type relationType = RelationType::Any);
+        /**
+         * @brief Prints all Relations in the subtree, searching the subtree for Components with Relations in parallel (the printing itself is serial and in the same order as PrintRelationsInSubtree(RelationType::type)).
+         * @param relationType Filter by relation type
+         * @param parallel Settings of the parallel traversal
+         */
+        void PrintRelationsInSubtree(RelationType::type relationType, const ParallelTraversal& parallel);
 
         /**
          * @brief Returns name of the component.
@@ -176,6 +274,7 @@ namespace sys_sage {
          * @brief Sets Id of the component.
          * @param _id Id of the component
          * @see id
+         * @note SubtreeIndexes of the ancestors are updated accordingly.
          */
         void SetId(int _id);
 
@@ -279,6 +378,7 @@ namespace sys_sage {
         * @param _id - the id to look for
         * @param _componentType - the component type where to look for the id
         * @return Component * matching the criteria. Returns the first match. NULL if no match found
+        * @note If a SubtreeIndex is enabled on this component, the lookup is a hash map access instead of a DFS.
         */
         Component *GetDescendantById(int _id, ComponentType::type _componentType);
 
@@ -302,6 +402,15 @@ namespace sys_sage {
             \n The method pushes back the found elements -- i.e. the elements(pointers) can be found in this array after the method returns. (If no found, nothing will be pushed into the vector.)
         */
         void FindDescendantsByType(std::vector<Component*>* outArray, ComponentType::type _componentType);
+        /**
+         * @brief Parallel version of FindDescendantsByType(std::vector<Component*>*, ComponentType::type): the subtree is split into pieces, which are searched on the pool of parallel.
+         * The elements are pushed back in the same (pre-order) order as by the serial version. If a SubtreeIndex is enabled on this component, the serial version is used.
+         * @param outArray - output parameter (vector with results), as in the serial version
+         * @param _componentType - Required type of components
+         * @param parallel - Settings of the parallel traversal (pool, threshold below which the search is serial)
+         * @note The subtree must not be modified during the call.
+        */
+        void FindDescendantsByType(std::vector<Component*>* outArray, ComponentType::type _componentType, const ParallelTraversal& parallel);
 
         /**
          * @brief Searches for all the subcomponents (children, their children and so on) matching the given component type.
@@ -339,9 +448,113 @@ namespace sys_sage {
          * @brief Counts number of descendants matching the requested component type.
          * @param _componentType - ComponentType to look for.
          * @return Returns number of descendants matching the requested component type.
+         * @note If a SubtreeIndex is enabled on this component, the count is answered from the index without traversing the subtree.
          */
         int CountDescendantsByType(ComponentType::type _componentType) const;
 
+        /**
+         * @brief Enables a SubtreeIndex on this component, which maps each ComponentType to the components of that type in the subtree (in pre-order).
+         * FindDescendantsByType() and CountDescendantsByType() called on this component are then answered from the index in O(result) instead of traversing the subtree, and GetDescendantById() becomes a hash map lookup.
+         * The index is maintained by InsertChild(), RemoveChild(), InsertBetweenParentAndChild(ren)(), Delete() and SetId() on any component of the subtree.
+         * @return Pointer to the (new or already existing) SubtreeIndex of this component
+         * @see SubtreeIndex
+         */
+        SubtreeIndex* EnableSubtreeIndex();
+        /**
+         * @brief Removes the SubtreeIndex of this component (if any).
+         */
+        void DisableSubtreeIndex();
+        /**
+         * @brief Returns the SubtreeIndex of this component, or nullptr if it is not enabled.
+         * @see EnableSubtreeIndex()
+         */
+        SubtreeIndex* GetSubtreeIndex() const;
+
+        /**
+         * @brief Returns a lazy range over the subtree of this component (including this component) in pre-order, i.e. parents before their children.
+         * The range does not allocate and can be used in range-based for loops and C++20 ranges pipelines, e.g.
+         * \n for(Component* t : node->TraversePreOrder(ComponentType::Thread)) { ... }
+         * @param _componentType Required type of components (default: Any)
+         * @return SubtreeRange over the matching components
+         * @see SubtreeIterator::SkipChildren() for pruning the traversal
+         */
+        SubtreeRange TraversePreOrder(ComponentType::type _componentType = ComponentType::Any) const;
+        /**
+         * @brief Returns a lazy range over the subtree of this component (including this component) in post-order, i.e. children before their parents.
+         * @param _componentType Required type of components (default: Any)
+         * @return SubtreeRange over the matching components
+         */
+        SubtreeRange TraversePostOrder(ComponentType::type _componentType = ComponentType::Any) const;
+        /**
+         * @brief Calls visitor for each component of the subtree (including this component) in pre-order, until the visitor returns false.
+         * @param visitor Callable taking a Component*; it returns bool (false stops the traversal) or void
+         * @param _componentType Required type of components (default: Any)
+         * @return false if the traversal was stopped by the visitor, true otherwise
+         */
+        template <class Visitor>
+        bool VisitDescendants(Visitor&& visitor, ComponentType::type _componentType = ComponentType::Any) const
+        {
+            for(Component* c : TraversePreOrder(_componentType))
+            {
+                if(!_InvokeVisitor(visitor, c))
+                    return false;
+            }
+            return true;
+        }
+
+        /**
+         * @brief Explicit-stack depth-first traversal engine calling onEnter and onExit for each Component of a subtree.
+         *
+         * The walk follows the children vectors only (it does not rely on parent pointers) and keeps its stack on the heap, so it is not limited by the depth of the tree.
+         * It is used by the functions processing whole subtrees (e.g. CalcSubtreeDepth(), DeleteSubtree(), XML export).
+         * \n A Component may be deallocated in onExit, as long as it is not removed from the children vector of its parent before the walk leaves the parent.
+         * @param root Root of the subtree (it is part of the walk); Component* or const Component*
+         * @param onEnter Called as onEnter(Component*, int depth) before the children of a Component are walked (pre-order); depth is relative to root. It returns bool (false = do not walk the children) or void.
+         * @param onExit Called as onExit(Component*, int depth) after the children of a Component were walked (post-order).
+         */
+        template <class ComponentT, class OnEnter, class OnExit>
+        static void WalkSubtree(ComponentT* root, OnEnter&& onEnter, OnExit&& onExit)
+        {
+            struct Frame {
+                ComponentT* component;
+                size_t nextChild; /**< position of the next child to enter */
+            };
+            if(root == nullptr)
+                return;
+            if(!_InvokeVisitor(onEnter, root, 0))
+            {
+                onExit(root, 0);
+                return;
+            }
+            std::vector<Frame> stack { { root, 0 } };
+            while(!stack.empty())
+            {
+                Frame& top = stack.back();
+                const std::vector<Component*>& topChildren = top.component->children;
+                int depth = static_cast<int>(stack.size());
+                size_t i = top.nextChild;
+                for(; i < topChildren.size(); i++)
+                {
+                    ComponentT* child = topChildren[i];
+                    //leaves are entered and left right away, without a stack frame
+                    if(_InvokeVisitor(onEnter, child, depth) && !child->children.empty())
+                        break;
+                    onExit(child, depth);
+                }
+                if(i < topChildren.size())
+                {
+                    top.nextChild = i + 1;
+                    stack.push_back({ topChildren[i], 0 });
+                }
+                else
+                {
+                    ComponentT* c = top.component;
+                    stack.pop_back();
+                    onExit(c, depth - 1);
+                }
+            }
+        }
+
         /**
         * @brief Counts number of children matching the requested component type.
         * @param _componentType - ComponentType to look for.
@@ -363,6 +576,30 @@ namespace sys_sage {
          * @return Pointer to the ancestor, or nullptr if not found
          */
         Component* GetAncestorByType(ComponentType::type _componentType);
+        /**
+         * @brief Checks whether this component is an ancestor of other (or other itself).
+         * If both components carry up-to-date interval labels of a SubtreeIndex (see SubtreeIndex::UpdateIntervalLabels()), this is an O(1) comparison of the labels; otherwise, the ancestors of other are walked.
+         * Stale labels are rebuilt on the first query; concurrent queries (e.g. under an EpochManager::ReadGuard) are safe, the rebuild is serialized by a mutex.
+         * @param other The potential descendant
+         * @return true if other is in the subtree of this component
+         */
+        bool IsAncestorOf(const Component* other) const;
+        /**
+         * @brief Finds the lowest common ancestor of this component and other, i.e. the deepest component whose subtree contains both.
+         * With up-to-date interval labels of a SubtreeIndex (see SubtreeIndex::UpdateIntervalLabels()), this is an O(1) range-minimum query; otherwise, the ancestors of both components are walked.
+         * Safe to call concurrently with other queries that do not modify the tree, like IsAncestorOf().
+         * @param other The other component
+         * @return The lowest common ancestor (this if this is an ancestor of other), or nullptr if the components are not in the same Component Tree
+         */
+        Component* FindLowestCommonAncestor(Component* other);
+        /**
+         * @brief Finds the closest common ancestor of the given type of this component and other, e.g. the nearest Cache shared by two Threads.
+         * Equivalent to FindLowestCommonAncestor(other)->GetAncestorByType(_componentType).
+         * @param other The other component
+         * @param _componentType Desired component type
+         * @return Pointer to the common ancestor, or nullptr if there is none
+         */
+        Component* FindLowestCommonAncestor(Component* other, ComponentType::type _componentType);
         /**
          * @brief Retrieves maximal distance to a leaf (i.e. the depth of the subtree).
          * 0=leaf, 1=children are leaves, 2=at most children's children are leaves .....
@@ -497,6 +734,7 @@ namespace sys_sage {
          * @return const std::vector<Relation*>& (reference to internal structure)
          * @note The vector is const so that the Relations of a Component cannot be manipulated this way. Use new Relation()/DeleteRelation() to modify the list of Relations, or access the Relations' API directly.
          * @see FindAllRelationsBy(RelationType::type relationType = RelationType::Any, int thisComponentPosition = -1) as an alternative offering more flexibility at the price of increased overhead through generating a new output vector.
+         * @note For RelationType::DataPath, the DataPathIndex of the component is dropped, as the caller may modify the vector.
          */
         std::vector<Relation*>& _GetRelationsByType(RelationType::type relationType) const;
 
@@ -519,13 +757,51 @@ namespace sys_sage {
          */
         std::vector<Relation*> FindRelations(RelationType::type relationType = RelationType::Any, int thisComponentPosition = -1) const;
 
+        /**
+         * @brief Calls visitor for each relation of a given type and position (same selection as FindRelations()), until the visitor returns false. No vector is allocated.
+         * @param visitor Callable taking a Relation*; it returns bool (false stops the iteration) or void
+         * @param relationType Type of relation (default: Any)
+         * @param thisComponentPosition Position of this component in the relation (default: -1 = do NOT care about position)
+         * @return false if the iteration was stopped by the visitor, true otherwise
+         */
+        template <class Visitor>
+        bool ForEachRelation(Visitor&& visitor, RelationType::type relationType = RelationType::Any, int thisComponentPosition = -1) const
+        {
+            if(relations == nullptr)
+                return true;
+            for(int curr_rt : RelationType::RelationTypeList)
+            {
+                if((relationType != RelationType::Any && relationType != curr_rt) || (*relations)[curr_rt] == nullptr)
+                    continue;
+                for(Relation* r : *(*relations)[curr_rt])
+                {
+                    if((!r->IsOrdered() || thisComponentPosition == -1 || r->GetComponent(thisComponentPosition) == this) && !_InvokeVisitor(visitor, r))
+                        return false;
+                }
+            }
+            return true;
+        }
+
         /**
          * @private
          * @brief Only called by Relation's AddComponent/UpdateComponent.
          * @param relationType Type of relation
          * @param r Pointer to the relation
+         * @return Position of r in the relation list
          */
-        void _AddRelation(RelationType::type relationType, Relation* r);
+        uint32_t _AddRelation(RelationType::type relationType, Relation* r);
+        /**
+         * @private
+         * @brief Removes r, found at position slot, from the relation list of relationType in O(1): the last entry of the list takes its place (and its slot is updated).
+         * Only called by Relation.
+         */
+        void _RemoveRelation(RelationType::type relationType, Relation* r, uint32_t slot);
+        /**
+         * @private
+         * @brief Drops the DataPathIndex of the component and advances DataPath::GetGeneration(), after its DataPaths changed.
+         * Called by _AddRelation() and _GetRelationsByType(), and directly for changes they do not see.
+         */
+        void _InvalidateDataPathIndex() const;
 
         /**
          * @brief Retrieves a DataPath* from the list of this component's data paths with matching DataPathType and DataPathDirection.
@@ -535,6 +811,28 @@ namespace sys_sage {
          * @return Pointer to the found DataPath, or nullptr if not found
          */
         DataPath* GetDataPathByType(DataPathType::type dp_type, DataPathDirection::type direction = DataPathDirection::Any) const;
+
+        /**
+         * @brief Retrieves the DataPath from this component to target with matching type: an oriented DataPath with this component as source and target as target, or a bidirectional DataPath between the two.
+         * The first match (in the order of FindDataPaths()) is returned.
+         * \n For components with many DataPaths, this is a hash lookup in their DataPathIndex (see DataPathIndexCache), otherwise a scan of the DataPaths.
+         * @param target The component at the other end of the DataPath
+         * @param dp_type DataPath type to search for (default: Any)
+         * @return Pointer to the found DataPath, or nullptr if not found
+         */
+        DataPath* FindDataPath(const Component* target, DataPathType::type dp_type = DataPathType::Any) const;
+        /**
+         * @brief Returns the DataPath from this component to target of type dp_type (as FindDataPath() does), creating it if there is none.
+         * Periodic refreshes (e.g. Node::UpdateL3CATCoreCOS(), Chip::UpdateMIGSettings()) update the attributes of the returned DataPath in place (see Relation::UpdateAttrib()), so that they keep the number of DataPaths constant.
+         * @param target The component at the other end of the DataPath
+         * @param dp_type DataPath type (not DataPathType::Any)
+         * @param orientation Orientation of a created DataPath (from this component to target if oriented)
+         * @param key Optional typed attribute (see Relation::SetAttr()): if not empty, only a DataPath whose attribute key equals value matches (the typed attribute, or attrib[key] if it has none -- as GetAttr() looks it up), and a created DataPath gets the attribute -- e.g. one DataPath per MIG instance
+         * @param value Value of the attribute key
+         * @param created Optional output: set to whether the DataPath was created
+         * @return The found or created DataPath
+         */
+        DataPath* UpsertDataPath(Component* target, DataPathType::type dp_type, DataPathOrientation::type orientation = DataPathOrientation::Oriented, const std::string& key = "", const AttribValue& value = {}, bool* created = nullptr);
         
         /**
          * @brief Retrieves all DataPath* from the list of this component's data paths with matching type and orientation.
@@ -578,6 +876,42 @@ namespace sys_sage {
          */
         std::vector<DataPath*> FindDataPaths(DataPathType::type dp_type = DataPathType::Any, DataPathDirection::type direction = DataPathDirection::Any) const;
 
+        /**
+         * @brief Calls visitor for each DataPath of this component with matching type and orientation/direction (same selection as FindDataPaths()), until the visitor returns false. No vector is allocated.
+         * @param visitor Callable taking a DataPath*; it returns bool (false stops the iteration) or void
+         * @param dp_type DataPath type to search for (default: Any)
+         * @param direction Orientation/direction of a DataPath (default: Any)
+         * @return false if the iteration was stopped by the visitor, true otherwise
+         */
+        template <class Visitor>
+        bool ForEachDataPath(Visitor&& visitor, DataPathType::type dp_type = DataPathType::Any, DataPathDirection::type direction = DataPathDirection::Any) const
+        {
+            if(relations == nullptr || (*relations)[RelationType::DataPath] == nullptr)
+                return true;
+            //components with many DataPaths answer from their DataPathIndex (same selection and order)
+            if(const DataPathIndex* index = _GetDataPathIndex(direction))
+            {
+                for(DataPath* dp : index->Find(dp_type, direction))
+                    if(!_InvokeVisitor(visitor, dp))
+                        return false;
+                return true;
+            }
+            for(Relation* r : *(*relations)[RelationType::DataPath])
+            {
+                //either unordered -> check; or orientation is any -> check; or orientation is incoming & DP is incoming or the same outgoing
+                if(!r->IsOrdered() ||
+                    direction == DataPathDirection::Any ||
+                    (direction == DataPathDirection::Outgoing && r->GetComponent(0) == this) ||
+                    (direction == DataPathDirection::Incoming && r->GetComponent(1) == this))
+                {
+                    DataPath* dp = static_cast<DataPath*>(r);
+                    if((dp_type == DataPathType::Any || dp->GetDataPathType() == dp_type) && !_InvokeVisitor(visitor, dp))
+                        return false;
+                }
+            }
+            return true;
+        }
+
         /**
         @brief Checks the consistency of the component tree starting from this component.
 
@@ -615,13 +949,44 @@ namespace sys_sage {
         int GetTopologySize(unsigned * out_component_size, unsigned * out_dataPathSize) const;
 
         /**
-         * @brief Calculates approximate memory footprint of the subtree of this element (including the relevant Relations).
+         * @brief Calculates the memory footprint of the subtree of this element (including the relevant Relations), like CalcFootprint(), but only split into components and Relations.
+         * Attribute values are counted if their keys are known to sys-sage (see _search_default_attrib_size()).
          * @param out_component_size output parameter (contains the footprint of the component tree elements); an already allocated unsigned * is the input, the value is expected to be 0 (the result is accumulated here)
          * @param out_dataPathSize output parameter (contains the footprint of the data-path graph elements); an already allocated unsigned * is the input, the value is expected to be 0 (the result is accumulated here)
          * @return The total size in bytes
          */
         int CalcSubtreeSize(unsigned * out_component_size, unsigned * out_dataPathSize) const;
 
+        /**
+         * @brief Parallel version of CalcSubtreeSize(unsigned*, unsigned*): the subtree is split into pieces, which are measured on the pool of parallel. The results are the same as those of the serial version.
+         * @param out_component_size output parameter (contains the footprint of the component tree elements); the result is accumulated here
+         * @param out_dataPathSize output parameter (contains the footprint of the data-path graph elements); the result is accumulated here
+         * @param parallel Settings of the parallel traversal
+         * @return The total size in bytes
+         */
+        int CalcSubtreeSize(unsigned * out_component_size, unsigned * out_dataPathSize, const ParallelTraversal& parallel) const;
+
+        /**
+         * @brief Calculates the memory footprint of the subtree of this element (including the relevant Relations), and reports the memory reserved by the Arena backing the subtree.
+         * @param out_component_size output parameter (contains the footprint of the component tree elements); an already allocated unsigned * is the input, the value is expected to be 0 (the result is accumulated here)
+         * @param out_dataPathSize output parameter (contains the footprint of the data-path graph elements); an already allocated unsigned * is the input, the value is expected to be 0 (the result is accumulated here)
+         * @param out_arenaSize output parameter (contains the bytes reserved by the Arena of the Topology at the root of the Component Tree, or 0 if there is none); an already allocated unsigned * is the input, the value is expected to be 0 (the result is accumulated here)
+         * @return The total size in bytes (same as CalcSubtreeSize(unsigned*, unsigned*) -- the Arena size is only reported in out_arenaSize, as the Components and Relations of the Arena are already counted in the other output parameters)
+         * @see Topology::CreateArena()
+         */
+        int CalcSubtreeSize(unsigned * out_component_size, unsigned * out_dataPathSize, unsigned * out_arenaSize) const;
+
+        /**
+         * @brief Calculates the memory footprint of the subtree of this element and of its Relations (each counted once), broken down per ComponentType, per RelationType, per attribute key, and for the children and Relation containers (in one traversal).
+         * Counted are the objects and the heap memory they own (strings, vectors, map nodes, SubtreeIndexes); see MemoryFootprint.
+         * \n Attribute values are sized by attribSizeFcn, and if it returns 0, by the default function for the attributes set by sys-sage (see _search_default_attrib_size()); the values of other attributes are not counted (see MemoryFootprint::numUnknownAttribs).
+         * On a copy-on-write copy (see Clone()), only what the copy does not share with the original is counted.
+         * @param out The footprint is accumulated here
+         * @param attribSizeFcn Optional function returning the size of an attribute value (see AttribSizeFcn)
+         * @return The footprint in bytes (the amount added to out->total)
+         */
+        size_t CalcFootprint(MemoryFootprint* out, AttribSizeFcn attribSizeFcn = nullptr) const;
+
         /**
          * @private
          * Helper function of int GetTopologySize(unsigned * out_component_size, unsigned * out_dataPathSize); -- normally you would call this one.
@@ -672,6 +1037,13 @@ namespace sys_sage {
          * @return Pointer to the created XML subtree node.
          */
         virtual xmlNodePtr _CreateXmlSubtree();
+        /**
+         * @private
+         * @brief Helper for XML dump generation: creates the XML node of this component only (without its children).
+         * Component classes with additional XML properties override this function.
+         * @return Pointer to the created XML node.
+         */
+        virtual xmlNodePtr _CreateXmlNode();
         
         /**
          * @brief Deletes a Relation from this component as well as the Relation itself.
@@ -699,6 +1071,15 @@ namespace sys_sage {
          * @param relationType Relation type to delete (default: Any)
          */
         void DeleteRelations(RelationType::type relationType = RelationType::Any);
+        /**
+         * @brief Deletes the relations of this component of the given type for which predicate returns true.
+         * Runs in time linear in the number of relations of this component (and their components): the relation lists of the other components are updated in O(1) per relation, and the list of this component is compacted once.
+         * The remaining relations of this component keep their order.
+         * @param relationType Relation type to delete (RelationType::Any for all types)
+         * @param predicate Called once for each relation of the type; returns whether to delete it
+         * @return Number of deleted relations
+         */
+        size_t DeleteRelations(RelationType::type relationType, const std::function<bool(Relation*)>& predicate);
 
         /**
          * @deprecated Use void DeleteRelations(RelationType::type relationType = sys_sage::RelationType::Any) instead.
@@ -713,10 +1094,96 @@ namespace sys_sage {
         /**
          * @brief Deletes a component, its children (if withSubtree = true), and all associated Relations.
          * If only the component itself is deleted, its children are inserted into its parent's children list.
+         * The owned attribute values (see SetAttrib()) of the deleted components and Relations are freed.
          * @param withSubtree If true, the whole subtree is deleted; otherwise only the component itself.
          */
         void Delete(bool withSubtree = true);
 
+        /**
+         * @brief Creates a copy of this component and its subtree that can be modified without changing the original, e.g. to try out a different configuration.
+         * The copy has no parent. Attribute values are shared with the original (only the attrib maps are copied); typed attributes are copied, except for opaque values, which are shared.
+         * \n deep = true: all components of the subtree are copied, together with the Relations among them (Relations to components outside of the subtree are not copied). The copy is independent of the original.
+         * \n deep = false (copy-on-write): only this component is copied; its children and its Relations are shared with the original.
+         * Before modifying a component of the copy (or a Relation), obtain its private copy with MakeWritable() -- only the components on the path to it are copied.
+         * The original subtree must not be modified or deleted while the copy-on-write copy is in use.
+         * \n CalcSubtreeSize() on the copy reports only the memory it does not share with the original.
+         * @param deep Whether the whole subtree is copied
+         * @return The copy (delete it with Delete())
+         */
+        Component* Clone(bool deep = true) const;
+        /**
+         * @brief Returns a private copy of the component c of this copy-on-write copy (see Clone()), which can be modified without changing the original.
+         * The components on the path from this component to c that are still shared are copied; each copy shares its other children and its Relations with its original.
+         * @param c A component of the copy: one shared with the original (i.e. the original component), or one that is already private
+         * @return The private copy of c (c itself if it is already private), or nullptr if c is not in the subtree of this copy
+         */
+        Component* MakeWritable(Component* c);
+        /**
+         * @brief Returns a private copy of the Relation r of this copy-on-write copy (see Clone()), which can be modified without changing the original.
+         * All components of r are made private (see MakeWritable(Component*)), and the copy of r connects the private components instead of the original ones.
+         * @param r A Relation of a component of the copy
+         * @return The private copy of r (r itself if it is already private), or nullptr if a component of r is not in the subtree of this copy
+         */
+        Relation* MakeWritable(Relation* r);
+        /**
+         * @brief Returns the component this component is a copy-on-write copy of (see Clone() and MakeWritable()), or nullptr if it is not such a copy.
+         */
+        const Component* GetCloneSource() const;
+
+        /**
+         * @private
+         * @brief Only called by Arena::New() -- marks the component as allocated from the given SlabPool (instead of with new).
+         * @param pool SlabPool holding this component
+         */
+        void _SetSlabPool(SlabPool* pool);
+        /**
+         * @private
+         * @brief Informs the SubtreeIndexes of this component and its ancestors that the subtree of child was attached to this component.
+         * @param child The newly inserted child
+         */
+        void _NotifySubtreeInserted(Component* child);
+        /**
+         * @private
+         * @brief Informs the SubtreeIndexes of this component and its ancestors that the subtree of child was detached from this component.
+         * @param child The removed child
+         */
+        void _NotifySubtreeRemoved(Component* child);
+        /**
+         * @private
+         * @brief Only called by SubtreeIndex -- sets the interval label of this component.
+         * @param stamp Stamp identifying the labelling (see SubtreeIndex::_GetLabelStampOwner())
+         * @param first Position of this component in the pre-order of the labelled subtree
+         * @param end End (exclusive) of the subtree of this component in the pre-order of the labelled subtree
+         */
+        void _SetIntervalLabel(uint64_t stamp, uint32_t first, uint32_t end);
+        /**
+         * @private
+         * @brief Only called by SubtreeIndex -- moves the end of the interval label of this component (when its subtree grows).
+         */
+        void _SetIntervalLabelEnd(uint32_t end);
+        /**
+         * @private
+         * @brief Returns the SubtreeIndex whose up-to-date interval labels cover this component and other, or nullptr if there is none.
+         * If this component is in the subtree of a SubtreeIndex whose labels are stale or were never built, they are (re)built first.
+         */
+        SubtreeIndex* _GetLabellingIndex(const Component* other) const;
+        /**
+         * @private
+         * @brief Returns the SlabPool this component was allocated from, or nullptr if it was allocated with new.
+         */
+        SlabPool* _GetSlabPool() const;
+        /**
+         * @private
+         * @brief Destroys and frees this component only (with delete, or by returning it to its SlabPool). Does not unlink it from the Component Tree or its Relations.
+         */
+        void _Deallocate();
+        /**
+         * @private
+         * @brief Returns the heap memory owned by the members of this component (its name and the members of its class), without its children, Relations and attributes.
+         * Overridden by the classes with further heap-allocated members. Used by CalcFootprint().
+         */
+        virtual size_t _GetMembersHeapSize() const;
+
 #ifdef SS_PAPI
         /**
          * @brief Prints all PAPI metrics of the given event set within the
@@ -744,6 +1211,118 @@ namespace sys_sage {
         void FindPAPIrelationsInSubtree(std::vector<Relation *> &papiRelations) const;
 #endif
 
+        /**
+         * @brief Returns the value of the attribute key, reading it atomically (for readers in an EpochManager::ReadGuard, concurrently with PublishAttrib()).
+         * @param key Name of the attribute
+         * @return The value, or nullptr if the attribute does not exist
+         */
+        void* ReadAttrib(const std::string& key) const;
+        /**
+         * @brief Sets the value of the attribute key so that concurrent readers (using ReadAttrib() in an EpochManager::ReadGuard) see either the old or the new value.
+         * The old value is retired to epochs and freed with deleter once no reader can access it any more; an old value owned through SetAttrib() (or PublishOwnedAttrib()) is freed by its owner instead, and the attribute is no longer owned.
+         * The key is looked up in an EpochManager::ReadGuard, so the caller needs no guard of its own. If the attribute does not exist yet, it is inserted in an EpochManager::WriteGuard (inserting a key changes the attrib map).
+         * Concurrent PublishAttrib() calls are serialized with a mutex of epochs while they swap the value; readers do not take it.
+         * @param key Name of the attribute
+         * @param value The new value
+         * @param deleter Function freeing the old value
+         * @param epochs EpochManager coordinating the readers of this component
+         */
+        void PublishAttrib(const std::string& key, void* value, void (*deleter)(void*), EpochManager& epochs);
+        /**
+         * @brief Sets the value of the attribute key (see PublishAttrib(const std::string&, void*, void(*)(void*), EpochManager&)); the old value must be a T allocated with new.
+         */
+        template <class T>
+        void PublishAttrib(const std::string& key, T* value, EpochManager& epochs) { PublishAttrib(key, value, [](void* p){ delete static_cast<T*>(p); }, epochs); }
+        /**
+         * @brief Like PublishAttrib(), but the component owns the new value as with SetAttrib(): it is freed with deleter when it is replaced (also by a later PublishAttrib() or SetAttrib()), erased or the component is deleted.
+         * The replaced value is retired to epochs in either case, by its owner if it was owned and with deleter otherwise.
+         * @param key Name of the attribute
+         * @param value The new value
+         * @param deleter Function freeing the new value, and the old value if it is not owned
+         * @param epochs EpochManager coordinating the readers of this component
+         */
+        void PublishOwnedAttrib(const std::string& key, void* value, void (*deleter)(void*), EpochManager& epochs);
+        /**
+         * @brief Sets and owns the value of the attribute key (see PublishOwnedAttrib(const std::string&, void*, void(*)(void*), EpochManager&)); value must be a T allocated with new.
+         */
+        template <class T>
+        void PublishOwnedAttrib(const std::string& key, T* value, EpochManager& epochs) { PublishOwnedAttrib(key, value, [](void* p){ delete static_cast<T*>(p); }, epochs); }
+
+        /**
+         * @brief Returns a pointer to the value of the attribute key, looking it up in the typed attributes first (see SetAttr()) and in the attrib map second, so that attributes stored in either way are found.
+         * \n For T being int, int64_t, double, std::string or std::vector<double>, a typed value is only returned if it holds a T. Opaque typed values (see SetAttrPtr()) and values of the attrib map are cast to T* without a check.
+         * @param key Name of the attribute
+         * @return Pointer to the value, or nullptr if the attribute does not exist
+         */
+        template <class T>
+        T* GetAttr(const std::string& key) { return _GetAttr<T>(attrs, attrib, FindAttribKey(key), &key); }
+        template <class T>
+        const T* GetAttr(const std::string& key) const { return _GetAttr<T>(attrs, attrib, FindAttribKey(key), &key); }
+        /**
+         * @brief Returns a pointer to the value of the attribute with the interned key (see GetAttr(const std::string&)); the typed attributes are searched without hashing or comparing strings.
+         * @param key AttribId returned by InternAttribKey()
+         */
+        template <class T>
+        T* GetAttr(AttribId key) { return _GetAttr<T>(attrs, attrib, key, nullptr); }
+        template <class T>
+        const T* GetAttr(AttribId key) const { return _GetAttr<T>(attrs, attrib, key, nullptr); }
+        /**
+         * @brief Sets the typed attribute key, stored inline (int, int64_t, double, std::string, std::vector<double>) or as an opaque value (AttribPtr).
+         * A typed attribute takes precedence over an entry of the attrib map with the same key, which is left untouched.
+         * @param key Name of the attribute
+         * @param value The value
+         */
+        void SetAttr(const std::string& key, AttribValue value);
+        /**
+         * @brief Sets the typed attribute with the interned key (see SetAttr(const std::string&, AttribValue)).
+         * @param key AttribId returned by InternAttribKey()
+         */
+        void SetAttr(AttribId key, AttribValue value);
+        /**
+         * @brief Sets the typed attribute key to an opaque value that is freed with deleter when the attribute is replaced or erased, or the component is deleted.
+         * Copies made by Clone() share the value; it is freed when the last of them releases it.
+         */
+        void SetAttrPtr(const std::string& key, void* value, void (*deleter)(void*));
+        /**
+         * @brief Sets the typed attribute key to an opaque value allocated with new (see SetAttrPtr(const std::string&, void*, void(*)(void*))).
+         */
+        template <class T>
+        void SetAttrPtr(const std::string& key, T* value) { SetAttrPtr(key, value, [](void* p){ delete static_cast<T*>(p); }); }
+        /**
+         * @brief Returns whether the attribute key exists, either as a typed attribute or in the attrib map.
+         */
+        bool HasAttr(const std::string& key) const;
+        /**
+         * @brief Removes the typed attribute key and releases its value. Entries of the attrib map are not affected.
+         * @return Whether the typed attribute existed
+         */
+        bool EraseAttr(const std::string& key);
+        /**
+         * @brief Returns the typed attributes of this component.
+         */
+        const AttribStore& GetAttribStore() const;
+        /**
+         * @brief Sets attrib[key] to value and takes ownership of it: the value is freed with deleter when it is replaced by SetAttrib(), removed by EraseAttrib(), or when the component is deleted.
+         * A previous value of key is freed if it is owned, and left alone otherwise (values written to attrib directly are never freed by sys-sage).
+         * Copies made by Clone() share the owned values; a value is freed with the last of them.
+         * @note Do not free an owned value yourself, and do not overwrite it by writing to attrib directly -- use SetAttrib() or EraseAttrib().
+         */
+        void SetAttrib(const std::string& key, void* value, void (*deleter)(void*));
+        /**
+         * @brief Sets attrib[key] to a value allocated with new and takes ownership of it (see SetAttrib(const std::string&, void*, void(*)(void*))).
+         */
+        template <class T>
+        void SetAttrib(const std::string& key, T* value) { SetAttrib(key, value, [](void* p){ delete static_cast<T*>(p); }); }
+        /**
+         * @brief Removes attrib[key], freeing its value if it is owned (see SetAttrib()).
+         * @return Whether attrib contained key
+         */
+        bool EraseAttrib(const std::string& key);
+        /**
+         * @brief Returns whether attrib[key] is owned by this component, i.e. was set with SetAttrib() (and not overwritten directly since).
+         */
+        bool OwnsAttrib(const std::string& key) const;
+
         /**
         * A map for storing arbitrary pieces of information or data.
         * - The `key` denotes the name of the attribute.
@@ -810,9 +1389,17 @@ namespace sys_sage {
         * }
         * ```
         * 
+        * 6. Letting the component own the value (freed on overwrite, EraseAttrib() and deletion of the component):
+        * 
+        * ```cpp
+        * SetAttrib("exampleKey", new int(42));
+        * SetAttrib("exampleKey", new int(100)); // frees the old value
+        * EraseAttrib("exampleKey"); // frees the value
+        * ```
+        * 
         * Note:
         * - Proper memory management is crucial when using `void*` pointers. Always ensure
-        *   that dynamically allocated memory is freed when no longer needed.
+        *   that dynamically allocated memory is freed when no longer needed -- or use SetAttrib().
         * - Type safety is not enforced, so it is important to cast pointers to the correct
         *   type when retrieving values from the map.
         */
@@ -847,7 +1434,13 @@ namespace sys_sage {
         const ComponentType::type componentType;
         std::vector<Component*> children; /**< Contains the list (std::vector) of pointers to children of the component in the component tree. */
         Component* parent { nullptr }; /**< Contains pointer to the parent component in the component tree. If this component is the root, parent will be nullptr.*/
-        
+        size_t indexInParent { 0 }; /**< Position of this component in parent->children; only guaranteed to be up to date below parent->firstStaleChildIndex. @see GetIndexInParent() */
+        size_t firstStaleChildIndex { 0 }; /**< children[i]->indexInParent == i holds for all i < firstStaleChildIndex; the indices from here on are refreshed on the next lookup that misses */
+        bool stableChildrenOrder { true }; /**< Whether removing children keeps the order of the remaining children. @see SetStableChildrenOrder() */
+        const Component* cloneSource { nullptr }; /**< Component this one is a copy-on-write copy of (nullptr otherwise). Children whose parent is not this component, and Relations that do not contain it, are shared with the original. @see Clone() */
+        AttribStore attrs; /**< Typed attributes of the component. @see SetAttr() */
+        AttribStore attribOwners; /**< Owners (AttribPtr) of the values of attrib set with SetAttrib(), by key; they free the values when released. @see SetAttrib() */
+
         /**
          * Contains a list (std::array) of different Relation types. 
          * Initially nullptr, it is allocated on the first call to AddRelation() or new Relation().
@@ -855,6 +1448,13 @@ namespace sys_sage {
          * Each element of the array is a pointer to a std::vector<Relation*> that contains all Relations of that type. (also lazy-allocated)
          */
         std::array<std::vector<Relation*>*, RelationType::_num_relation_types>* relations = nullptr;
+        mutable DataPathIndexCache dataPathIndex; /**< Index of the DataPaths of the component, built for components with many DataPaths and dropped when they change. @see DataPathIndexCache */
+
+        SubtreeIndex* subtreeIndex { nullptr }; /**< Optional index over the subtree of this component (nullptr if not enabled). @see EnableSubtreeIndex() */
+        SlabPool* slabPool { nullptr }; /**< SlabPool of the Arena this component was allocated from (nullptr if allocated with new). Delete() returns the memory to this pool. */
+        uint64_t labelStamp { 0 }; /**< Stamp of the interval labels of this component (0 if never labelled). @see SubtreeIndex::UpdateIntervalLabels() */
+        uint32_t labelFirst { 0 }; /**< Position of this component in the pre-order of the labelled subtree */
+        uint32_t labelEnd { 0 }; /**< End (exclusive) of the subtree of this component in the pre-order of the labelled subtree */
     };
 
 } //namespace sys_sage 
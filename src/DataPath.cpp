@@ -2,6 +2,7 @@
 
 #include <cstdint>
 #include <algorithm>
+#include <atomic>
 #include <stdexcept>
 
 #include "Component.hpp"
@@ -9,12 +10,17 @@
 using std::cout;
 using std::endl;
 
+namespace {
+    std::atomic<uint64_t> dataPathGeneration { 0 };
+}
+
 sys_sage::Component * sys_sage::DataPath::GetSource() const {return components[0];}
 sys_sage::Component * sys_sage::DataPath::GetTarget() const {return components[1];}
-double sys_sage::DataPath::GetBandwidth() const {return bw;}
-void sys_sage::DataPath::SetBandwidth(double _bandwidth) { bw = _bandwidth;}
-double sys_sage::DataPath::GetLatency() const {return latency;}
-void sys_sage::DataPath::SetLatency(double _latency) { latency = _latency; }
+//atomic accesses, so that the values can be updated while readers of an EpochManager access them
+double sys_sage::DataPath::GetBandwidth() const {return std::atomic_ref<double>(const_cast<double&>(bw)).load(std::memory_order_relaxed);}
+void sys_sage::DataPath::SetBandwidth(double _bandwidth) { std::atomic_ref<double>(bw).store(_bandwidth, std::memory_order_relaxed); _NotifyChanged(); }
+double sys_sage::DataPath::GetLatency() const {return std::atomic_ref<double>(const_cast<double&>(latency)).load(std::memory_order_relaxed);}
+void sys_sage::DataPath::SetLatency(double _latency) { std::atomic_ref<double>(latency).store(_latency, std::memory_order_relaxed); _NotifyChanged(); }
 sys_sage::DataPathType::type sys_sage::DataPath::GetDataPathType() const {return dp_type;}
 sys_sage::DataPathOrientation::type sys_sage::DataPath::GetOrientation() const {return ordered ? sys_sage::DataPathOrientation::Oriented : sys_sage::DataPathOrientation::Bidirectional;}
 
@@ -36,12 +42,16 @@ sys_sage::DataPath::DataPath(Component* _source, Component* _target, sys_sage::D
         ordered = false;
     else
         ordered = true;
-    
+
+    //both endpoints are stored inside the DataPath (see RelationComponents)
     AddComponent(_source);
     if (_source != _target)
         AddComponent(_target);
     else
+    {
         components.emplace_back(_target);
+        slots.push_back(noSlot);
+    }
 }
 
 void sys_sage::DataPath::Delete()
@@ -49,6 +59,9 @@ void sys_sage::DataPath::Delete()
     Relation::Delete();
 }
 
+uint64_t sys_sage::DataPath::GetGeneration() { return dataPathGeneration.load(std::memory_order_acquire); }
+void sys_sage::DataPath::_NotifyChanged() { dataPathGeneration.fetch_add(1, std::memory_order_acq_rel); }
+
 
 void sys_sage::DataPath::Print() const
 {
@@ -133,6 +133,17 @@ namespace sys_sage {
          */
         void Delete() override;
 
+        /**
+         * @brief Returns the generation of the DataPaths of the process: a counter advanced by every change of any DataPath (creation, deletion, new source or target, SetBandwidth(), SetLatency()).
+         * Results computed from DataPaths (e.g. by DataPathRouter) are still valid as long as the generation did not change.
+         */
+        static uint64_t GetGeneration();
+        /**
+         * @private
+         * @brief Advances the generation (see GetGeneration()).
+         */
+        static void _NotifyChanged();
+
     private:
         DataPathType::type dp_type; /**< type of the datapath */
 
@@ -0,0 +1,91 @@
+#include "DataPathIndex.hpp"
+
+#include "Component.hpp"
+#include "DataPath.hpp"
+#include "Footprint.hpp"
+
+namespace {
+    const std::vector<sys_sage::DataPath*> noDataPaths;
+}
+
+sys_sage::DataPathIndex::DataPathIndex(const Component* c)
+{
+    for(Relation* r : c->GetRelationsByType(RelationType::DataPath))
+    {
+        DataPath* dp = static_cast<DataPath*>(r);
+        const RelationComponents& components = dp->GetComponents();
+        //same selection as Component::ForEachDataPath(): unordered DataPaths match every direction
+        bool outgoing = !dp->IsOrdered() || (components.size() > 0 && components[0] == c);
+        bool incoming = !dp->IsOrdered() || (components.size() > 1 && components[1] == c);
+        _Add(dp, DataPathDirection::Any);
+        if(outgoing)
+            _Add(dp, DataPathDirection::Outgoing);
+        if(incoming)
+            _Add(dp, DataPathDirection::Incoming);
+
+        if(outgoing && components.size() > 1)
+        {
+            const Component* other = (components[0] == c) ? components[1] : components[0];
+            targets.try_emplace({ other, dp->GetDataPathType() }, dp);
+            targets.try_emplace({ other, DataPathType::Any }, dp);
+        }
+    }
+}
+
+uint64_t sys_sage::DataPathIndex::_Key(DataPathType::type dp_type, DataPathDirection::type direction)
+{
+    return (static_cast<uint64_t>(static_cast<uint32_t>(dp_type)) << 32) | static_cast<uint32_t>(direction);
+}
+
+void sys_sage::DataPathIndex::_Add(DataPath* dp, DataPathDirection::type direction)
+{
+    lists[_Key(dp->GetDataPathType(), direction)].push_back(dp);
+    lists[_Key(DataPathType::Any, direction)].push_back(dp);
+}
+
+const std::vector<sys_sage::DataPath*>& sys_sage::DataPathIndex::Find(DataPathType::type dp_type, DataPathDirection::type direction) const
+{
+    auto it = lists.find(_Key(dp_type, direction));
+    return (it != lists.end()) ? it->second : noDataPaths;
+}
+
+sys_sage::DataPath* sys_sage::DataPathIndex::FindTo(const Component* target, DataPathType::type dp_type) const
+{
+    auto it = targets.find({ target, dp_type });
+    return (it != targets.end()) ? it->second : nullptr;
+}
+
+size_t sys_sage::DataPathIndex::GetFootprint() const
+{
+    size_t size = sizeof(DataPathIndex) + _UnorderedMapHeapSize(lists) + _UnorderedMapHeapSize(targets);
+    for(const auto& [key, list] : lists)
+        size += _VectorHeapSize(list);
+    return size;
+}
+
+sys_sage::DataPathIndexCache::~DataPathIndexCache() { delete index.load(std::memory_order_relaxed); }
+
+const sys_sage::DataPathIndex* sys_sage::DataPathIndexCache::Get(const Component* c, size_t numDataPaths) const
+{
+    DataPathIndex* current = index.load(std::memory_order_acquire);
+    if(current != nullptr || numDataPaths < minDataPaths)
+        return current;
+    if(lookups.fetch_add(1, std::memory_order_relaxed) + 1 < minLookups)
+        return nullptr;
+    //concurrent lookups may build it at the same time: the first one is published, the others are discarded
+    DataPathIndex* built = new DataPathIndex(c);
+    if(index.compare_exchange_strong(current, built, std::memory_order_acq_rel))
+        return built;
+    delete built;
+    return current;
+}
+
+const sys_sage::DataPathIndex* sys_sage::DataPathIndexCache::Peek() const { return index.load(std::memory_order_acquire); }
+
+void sys_sage::DataPathIndexCache::Invalidate()
+{
+    if(index.load(std::memory_order_relaxed) != nullptr)
+        delete index.exchange(nullptr, std::memory_order_acq_rel);
+    if(lookups.load(std::memory_order_relaxed) != 0)
+        lookups.store(0, std::memory_order_relaxed);
+}
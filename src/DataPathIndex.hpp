@@ -0,0 +1,100 @@
+#ifndef DATAPATH_INDEX_HPP
+#define DATAPATH_INDEX_HPP
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "enums.hpp"
+
+namespace sys_sage { //forward declaration
+    class Component;
+    class DataPath;
+}
+
+namespace sys_sage {
+
+    /**
+     * @class DataPathIndex
+     * @brief Adjacency index over the DataPaths of one Component, by (DataPathType, DataPathDirection) and by the component at the other end.
+     *
+     * For each type (including DataPathType::Any) and direction (including DataPathDirection::Any), it holds the DataPaths that Component::FindDataPaths() returns, in the same order;
+     * it also maps (other end, type) to the first DataPath from the Component to the other end, as returned by Component::FindDataPath().
+     * \n The index is a snapshot: it is built and dropped by Component (see DataPathIndexCache) and never modified.
+     */
+    class DataPathIndex {
+    public:
+        /**
+         * @brief Builds the index of the DataPaths of c.
+         */
+        DataPathIndex(const Component* c);
+
+        /**
+         * @brief Returns the DataPaths with matching type and direction (see Component::FindDataPaths()).
+         */
+        const std::vector<DataPath*>& Find(DataPathType::type dp_type, DataPathDirection::type direction) const;
+        /**
+         * @brief Returns the first DataPath from the indexed Component to target with matching type (see Component::FindDataPath()), or nullptr.
+         */
+        DataPath* FindTo(const Component* target, DataPathType::type dp_type) const;
+
+        /**
+         * @brief Returns the memory of the index.
+         */
+        size_t GetFootprint() const;
+
+    private:
+        static uint64_t _Key(DataPathType::type dp_type, DataPathDirection::type direction);
+        void _Add(DataPath* dp, DataPathDirection::type direction);
+
+        struct TargetHash {
+            size_t operator()(const std::pair<const Component*, DataPathType::type>& k) const { return std::hash<const void*>()(k.first) ^ (static_cast<size_t>(k.second) * 0x9e3779b97f4a7c15ULL); }
+        };
+
+        std::unordered_map<uint64_t, std::vector<DataPath*>> lists; /**< DataPaths by (type, direction) */
+        std::unordered_map<std::pair<const Component*, DataPathType::type>, DataPath*, TargetHash> targets; /**< First outgoing DataPath by (other end, type) */
+    };
+
+    /**
+     * @class DataPathIndexCache
+     * @brief Holds the DataPathIndex of a Component, if there is one.
+     *
+     * Components with at least minDataPaths DataPaths get an index on the minLookups-th lookup (Component::FindDataPaths(), ForEachDataPath(), GetDataPathByType(), FindDataPath()) since their DataPaths last changed; until then, lookups scan the DataPaths, so that alternating lookups and insertions do not rebuild the index each time.
+     * Any change of the DataPaths of the Component drops the index.
+     * \n Concurrent lookups may build the index at the same time; only one of the indices is kept. Lookups concurrent with changes of the DataPaths are not synchronized (as without the index).
+     * \n Copying yields an empty cache.
+     */
+    class DataPathIndexCache {
+    public:
+        static constexpr size_t minDataPaths = 32; /**< Components with fewer DataPaths are never indexed */
+        static constexpr uint32_t minLookups = 2; /**< Number of lookups (since the last change) after which the index is built */
+
+        DataPathIndexCache() = default;
+        DataPathIndexCache(const DataPathIndexCache&) {}
+        DataPathIndexCache& operator=(const DataPathIndexCache&) { return *this; }
+        ~DataPathIndexCache();
+
+        /**
+         * @brief Returns the index of the DataPaths of c (numDataPaths of them), building it if due, or nullptr.
+         */
+        const DataPathIndex* Get(const Component* c, size_t numDataPaths) const;
+        /**
+         * @brief Returns the index if it is built, without building it.
+         */
+        const DataPathIndex* Peek() const;
+        /**
+         * @brief Drops the index (after a change of the DataPaths).
+         */
+        void Invalidate();
+
+    private:
+        mutable std::atomic<DataPathIndex*> index { nullptr };
+        mutable std::atomic<uint32_t> lookups { 0 };
+    };
+}
+
+#endif
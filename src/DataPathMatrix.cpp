@@ -0,0 +1,171 @@
+#include "DataPathMatrix.hpp"
+
+#include <cmath>
+#include <limits>
+
+#include "Component.hpp"
+#include "DataPath.hpp"
+#include "Footprint.hpp"
+
+namespace {
+    constexpr double unset = std::numeric_limits<double>::quiet_NaN();
+}
+
+sys_sage::DataPathMatrix::DataPathMatrix(const std::vector<Component*>& _components, DataPathType::type _dp_type) : DataPathMatrix(_components, _components, _dp_type) {}
+sys_sage::DataPathMatrix::DataPathMatrix(const std::vector<Component*>& sources, const std::vector<Component*>& targets, DataPathType::type _dp_type) : Relation(sys_sage::RelationType::DataPathMatrix, sys_sage::RelationCategory::Default), dp_type(_dp_type), numSources(sources.size())
+{
+    ordered = true;
+    //the components are the sources, followed by the targets that are not sources
+    std::unordered_map<const Component*, uint32_t> position;
+    components.reserve(sources.size() + targets.size());
+    for(Component* c : sources)
+    {
+        position.emplace(c, components.size());
+        AddComponent(c);
+    }
+    targetPositions.reserve(targets.size());
+    for(Component* c : targets)
+    {
+        auto [it, added] = position.emplace(c, components.size());
+        if(added)
+            AddComponent(c);
+        targetPositions.push_back(it->second);
+    }
+    components.shrink_to_fit();
+    _RebuildIndices();
+    bandwidths.assign(numSources * targetPositions.size(), unset);
+    latencies.assign(numSources * targetPositions.size(), unset);
+}
+
+void sys_sage::DataPathMatrix::_RebuildIndices()
+{
+    sourceIndex.clear();
+    targetIndex.clear();
+    sourceIndex.reserve(numSources);
+    targetIndex.reserve(targetPositions.size());
+    for(uint32_t row = 0; row < numSources; row++)
+        sourceIndex.emplace(components[row], row);
+    for(uint32_t column = 0; column < targetPositions.size(); column++)
+        targetIndex.emplace(components[targetPositions[column]], column);
+}
+
+sys_sage::DataPathType::type sys_sage::DataPathMatrix::GetDataPathType() const { return dp_type; }
+size_t sys_sage::DataPathMatrix::GetNumSources() const { return numSources; }
+size_t sys_sage::DataPathMatrix::GetNumTargets() const { return targetPositions.size(); }
+sys_sage::Component* sys_sage::DataPathMatrix::GetSource(size_t row) const { return components[row]; }
+sys_sage::Component* sys_sage::DataPathMatrix::GetTarget(size_t column) const { return components[targetPositions[column]]; }
+
+int64_t sys_sage::DataPathMatrix::GetSourceIndex(const Component* source) const
+{
+    auto it = sourceIndex.find(source);
+    return (it != sourceIndex.end()) ? static_cast<int64_t>(it->second) : -1;
+}
+
+int64_t sys_sage::DataPathMatrix::GetTargetIndex(const Component* target) const
+{
+    auto it = targetIndex.find(target);
+    return (it != targetIndex.end()) ? static_cast<int64_t>(it->second) : -1;
+}
+
+int sys_sage::DataPathMatrix::Set(const Component* source, const Component* target, double bandwidth, double latency)
+{
+    int64_t row = GetSourceIndex(source), column = GetTargetIndex(target);
+    if(row < 0 || column < 0)
+        return 1;
+    Set(row, column, bandwidth, latency);
+    return 0;
+}
+
+void sys_sage::DataPathMatrix::Set(size_t row, size_t column, double bandwidth, double latency)
+{
+    size_t i = row * targetPositions.size() + column;
+    bandwidths[i] = bandwidth;
+    latencies[i] = latency;
+}
+
+double sys_sage::DataPathMatrix::GetBandwidth(const Component* source, const Component* target) const
+{
+    int64_t row = GetSourceIndex(source), column = GetTargetIndex(target);
+    return (row >= 0 && column >= 0) ? GetBandwidth(row, column) : unset;
+}
+
+double sys_sage::DataPathMatrix::GetLatency(const Component* source, const Component* target) const
+{
+    int64_t row = GetSourceIndex(source), column = GetTargetIndex(target);
+    return (row >= 0 && column >= 0) ? GetLatency(row, column) : unset;
+}
+
+double sys_sage::DataPathMatrix::GetBandwidth(size_t row, size_t column) const { return bandwidths[row * targetPositions.size() + column]; }
+double sys_sage::DataPathMatrix::GetLatency(size_t row, size_t column) const { return latencies[row * targetPositions.size() + column]; }
+const double* sys_sage::DataPathMatrix::GetBandwidthRow(size_t row) const { return bandwidths.data() + row * targetPositions.size(); }
+const double* sys_sage::DataPathMatrix::GetLatencyRow(size_t row) const { return latencies.data() + row * targetPositions.size(); }
+
+//the row scans compare without branching on the values (NaN compares false), so that the compiler can vectorize them
+sys_sage::Component* sys_sage::DataPathMatrix::FindMaxBandwidthTarget(const Component* source, bool excludeSelf) const
+{
+    int64_t row = GetSourceIndex(source);
+    if(row < 0)
+        return nullptr;
+    int64_t self = excludeSelf ? GetTargetIndex(source) : -1;
+    const double* v = GetBandwidthRow(row);
+    double max = -std::numeric_limits<double>::infinity();
+    size_t n = targetPositions.size(), best = n;
+    for(size_t i = 0; i < n; i++)
+    {
+        bool better = (v[i] > max) & (static_cast<int64_t>(i) != self);
+        max = better ? v[i] : max;
+        best = better ? i : best;
+    }
+    return (best < n) ? GetTarget(best) : nullptr;
+}
+
+sys_sage::Component* sys_sage::DataPathMatrix::FindMinLatencyTarget(const Component* source, bool excludeSelf) const
+{
+    int64_t row = GetSourceIndex(source);
+    if(row < 0)
+        return nullptr;
+    int64_t self = excludeSelf ? GetTargetIndex(source) : -1;
+    const double* v = GetLatencyRow(row);
+    double min = std::numeric_limits<double>::infinity();
+    size_t n = targetPositions.size(), best = n;
+    for(size_t i = 0; i < n; i++)
+    {
+        bool better = (v[i] < min) & (static_cast<int64_t>(i) != self);
+        min = better ? v[i] : min;
+        best = better ? i : best;
+    }
+    return (best < n) ? GetTarget(best) : nullptr;
+}
+
+sys_sage::DataPath* sys_sage::DataPathMatrix::Materialize(const Component* source, const Component* target)
+{
+    int64_t row = GetSourceIndex(source), column = GetTargetIndex(target);
+    if(row < 0 || column < 0)
+        return nullptr;
+    double bandwidth = GetBandwidth(row, column), latency = GetLatency(row, column);
+    if(std::isnan(bandwidth) && std::isnan(latency))
+        return nullptr;
+
+    DataPath* dp = source->FindDataPath(target, dp_type);
+    if(dp == nullptr)
+        return new DataPath(GetSource(row), GetTarget(column), DataPathOrientation::Oriented, dp_type, bandwidth, latency);
+    dp->SetBandwidth(bandwidth);
+    dp->SetLatency(latency);
+    return dp;
+}
+
+size_t sys_sage::DataPathMatrix::MaterializeAll()
+{
+    size_t numMaterialized = 0;
+    for(size_t row = 0; row < numSources; row++)
+        for(size_t column = 0; column < targetPositions.size(); column++)
+            if(row != targetPositions[column] && Materialize(GetSource(row), GetTarget(column)) != nullptr)
+                numMaterialized++;
+    return numMaterialized;
+}
+
+size_t sys_sage::DataPathMatrix::_GetMembersHeapSize() const
+{
+    return Relation::_GetMembersHeapSize() + _VectorHeapSize(targetPositions) + _UnorderedMapHeapSize(sourceIndex) + _UnorderedMapHeapSize(targetIndex)
+        + _VectorHeapSize(bandwidths) + _VectorHeapSize(latencies);
+}
@@ -0,0 +1,143 @@
+#ifndef DATAPATH_MATRIX_HPP
+#define DATAPATH_MATRIX_HPP
+
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+#include "Relation.hpp"
+
+namespace sys_sage { //forward declaration
+    class Component;
+    class DataPath;
+}
+
+namespace sys_sage {
+    /**
+     * @class DataPathMatrix
+     * @brief Dense matrix of the bandwidths and latencies from a set of source Components to a set of target Components, as one Relation (e.g. the core-to-core latencies of cccbench, or the CPU/NUMA-to-NUMA measurements of caps-numa-benchmark).
+     *
+     * Instead of one DataPath per pair (an object, its entries in the Relations of both Components, and its attributes), the values are stored in two contiguous row-major arrays (one row per source, one column per target),
+     * with hash maps from the Components to their rows and columns. The lookup of a pair is O(1); the values of a source are a contiguous row, which GetBandwidthRow()/GetLatencyRow() expose and FindMaxBandwidthTarget()/FindMinLatencyTarget() scan.
+     * \n Entries that were not set hold NaN. Materialize() creates the DataPath of an entry on demand, for the APIs working with DataPaths (e.g. FindDataPaths()).
+     * \n The Components of the Relation are the sources, followed by the targets that are not sources; the matrix is added to the Relations (of type RelationType::DataPathMatrix) of each of them.
+     * Like other Relations, it is deleted when one of its Components is deleted.
+     */
+    class DataPathMatrix : public Relation {
+    public:
+        /**
+         * @brief Square DataPathMatrix constructor: the components are both the sources and the targets.
+         * @param _components The (distinct) components
+         * @param _dp_type Type of the DataPaths represented by the matrix (see DataPathType; default: DataPathType::None)
+         */
+        DataPathMatrix(const std::vector<Component*>& _components, DataPathType::type _dp_type = DataPathType::None);
+        /**
+         * @brief DataPathMatrix constructor.
+         * @param sources The (distinct) source components (the rows)
+         * @param targets The (distinct) target components (the columns); they may overlap with the sources
+         * @param _dp_type Type of the DataPaths represented by the matrix (see DataPathType; default: DataPathType::None)
+         */
+        DataPathMatrix(const std::vector<Component*>& sources, const std::vector<Component*>& targets, DataPathType::type _dp_type = DataPathType::None);
+
+        /**
+         * @brief Returns the type of the DataPaths represented by the matrix.
+         */
+        DataPathType::type GetDataPathType() const;
+        size_t GetNumSources() const;
+        size_t GetNumTargets() const;
+        /**
+         * @brief Returns the source component of a row.
+         */
+        Component* GetSource(size_t row) const;
+        /**
+         * @brief Returns the target component of a column.
+         */
+        Component* GetTarget(size_t column) const;
+        /**
+         * @brief Returns the row of a source component, or -1 if it is not a source.
+         */
+        int64_t GetSourceIndex(const Component* source) const;
+        /**
+         * @brief Returns the column of a target component, or -1 if it is not a target.
+         */
+        int64_t GetTargetIndex(const Component* target) const;
+
+        /**
+         * @brief Sets the bandwidth and latency from source to target.
+         * @return 0 on success, 1 if source is not a source or target is not a target of the matrix
+         */
+        int Set(const Component* source, const Component* target, double bandwidth, double latency);
+        /**
+         * @brief Sets the bandwidth and latency of an entry by its row and column.
+         */
+        void Set(size_t row, size_t column, double bandwidth, double latency);
+        /**
+         * @brief Returns the bandwidth from source to target, or NaN if the entry is not set or the components are not in the matrix. O(1).
+         */
+        double GetBandwidth(const Component* source, const Component* target) const;
+        /**
+         * @brief Returns the latency from source to target, or NaN if the entry is not set or the components are not in the matrix. O(1).
+         */
+        double GetLatency(const Component* source, const Component* target) const;
+        double GetBandwidth(size_t row, size_t column) const;
+        double GetLatency(size_t row, size_t column) const;
+        /**
+         * @brief Returns the bandwidths of a row (GetNumTargets() values, NaN for entries not set).
+         */
+        const double* GetBandwidthRow(size_t row) const;
+        /**
+         * @brief Returns the latencies of a row (GetNumTargets() values, NaN for entries not set).
+         */
+        const double* GetLatencyRow(size_t row) const;
+
+        /**
+         * @brief Returns the target with the maximal bandwidth from source (the first one on ties), or nullptr if source has no bandwidth set.
+         * @param source The source component
+         * @param excludeSelf Whether to skip the entry from source to itself (in square matrices)
+         */
+        Component* FindMaxBandwidthTarget(const Component* source, bool excludeSelf = true) const;
+        /**
+         * @brief Returns the target with the minimal latency from source (the first one on ties), or nullptr if source has no latency set.
+         * @param source The source component
+         * @param excludeSelf Whether to skip the entry from source to itself (in square matrices)
+         */
+        Component* FindMinLatencyTarget(const Component* source, bool excludeSelf = true) const;
+
+        /**
+         * @brief Returns an oriented DataPath (of the type of the matrix) from source to target carrying the values of the entry.
+         * An existing DataPath of the type from source to target (see Component::FindDataPath()) gets the values of the entry; otherwise, a new DataPath is created.
+         * @return The DataPath, or nullptr if the entry is not set or the components are not in the matrix
+         */
+        DataPath* Materialize(const Component* source, const Component* target);
+        /**
+         * @brief Materializes all entries that are set (except from a component to itself).
+         * @return Number of DataPaths materialized
+         */
+        size_t MaterializeAll();
+
+        /**
+         * @private
+         * @brief Helper function for XML export.
+         *
+         * Should normally not be used directly. Used internally for exporting the matrix to XML.
+         * @return Pointer to the created XML entry node.
+         */
+        xmlNodePtr _CreateXmlEntry() override;
+        /**
+         * @private
+         * @brief Rebuilds the maps from the components to the rows and columns (after the components were replaced, see Relation::_CloneWith()).
+         */
+        void _RebuildIndices();
+        size_t _GetMembersHeapSize() const override;
+
+    private:
+        DataPathType::type dp_type;
+        size_t numSources; /**< The sources are components[0, numSources) */
+        std::vector<uint32_t> targetPositions; /**< Position of the target of each column in components */
+        std::unordered_map<const Component*, uint32_t> sourceIndex;
+        std::unordered_map<const Component*, uint32_t> targetIndex;
+        std::vector<double> bandwidths; /**< Row-major, numSources x GetNumTargets() */
+        std::vector<double> latencies; /**< Row-major, numSources x GetNumTargets() */
+    };
+}
+#endif //DATAPATH_MATRIX_HPP
@@ -0,0 +1,177 @@
+#include "DataPathRouter.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <queue>
+#include <utility>
+
+#include "Component.hpp"
+#include "DataPath.hpp"
+#include "Footprint.hpp"
+
+namespace {
+    constexpr double unset = std::numeric_limits<double>::quiet_NaN();
+    constexpr double infinity = std::numeric_limits<double>::infinity();
+}
+
+sys_sage::DataPathRouter::DataPathRouter(DataPathType::type _dp_type) : dp_type(_dp_type) {}
+
+sys_sage::DataPathType::type sys_sage::DataPathRouter::GetDataPathType() const { return dp_type; }
+
+void sys_sage::DataPathRouter::_Search(Component* source, const Component* target, RouteMetric::type metric, std::unordered_map<const Component*, Label>& labels) const
+{
+    bool minLatency = (metric == RouteMetric::MinLatency);
+    //the queue pops the best key first: the smallest latency or the largest bandwidth; entries of components settled since are skipped
+    std::priority_queue<std::pair<double, Component*>> queue;
+    labels[source] = { minLatency ? 0.0 : infinity, nullptr, nullptr, false };
+    queue.emplace(minLatency ? -0.0 : infinity, source);
+    while(!queue.empty())
+    {
+        Component* u = queue.top().second;
+        queue.pop();
+        Label& lu = labels[u];
+        if(lu.done)
+            continue;
+        lu.done = true;
+        if(u == target)
+            return;
+        double key = lu.key;
+        u->ForEachDataPath([&](DataPath* dp){
+            const RelationComponents& components = dp->GetComponents();
+            if(components.size() < 2)
+                return;
+            Component* v = (components[0] == u) ? components[1] : components[0];
+            if(v == u)
+                return;
+            double candidate;
+            if(minLatency)
+            {
+                double latency = dp->GetLatency();
+                if(!(latency >= 0))
+                    return;
+                candidate = key + latency;
+            }
+            else
+            {
+                double bandwidth = dp->GetBandwidth();
+                if(!(bandwidth > 0))
+                    return;
+                candidate = std::min(key, bandwidth);
+            }
+            auto [it, added] = labels.try_emplace(v, Label{ candidate, dp, u, false });
+            if(!added)
+            {
+                Label& lv = it->second;
+                if(lv.done || !(minLatency ? candidate < lv.key : candidate > lv.key))
+                    return;
+                lv = { candidate, dp, u, false };
+            }
+            queue.emplace(minLatency ? -candidate : candidate, v);
+        }, dp_type, DataPathDirection::Outgoing);
+    }
+}
+
+sys_sage::DataPathRoute sys_sage::DataPathRouter::_BuildRoute(Component* source, Component* target, const std::unordered_map<const Component*, Label>& labels)
+{
+    DataPathRoute route;
+    auto it = labels.find(target);
+    if(it == labels.end() || !it->second.done)
+    {
+        route.latency = unset;
+        route.bandwidth = unset;
+        return route;
+    }
+    route.bandwidth = infinity;
+    for(Component* c = target; c != source; )
+    {
+        const Label& l = labels.at(c);
+        route.components.push_back(c);
+        route.dataPaths.push_back(l.via);
+        double latency = l.via->GetLatency(), bandwidth = l.via->GetBandwidth();
+        route.latency += (latency >= 0) ? latency : unset;
+        route.bandwidth = (bandwidth > 0) ? std::min(route.bandwidth, bandwidth) : unset;
+        c = l.from;
+    }
+    route.components.push_back(source);
+    std::reverse(route.components.begin(), route.components.end());
+    std::reverse(route.dataPaths.begin(), route.dataPaths.end());
+    return route;
+}
+
+sys_sage::DataPathRoute sys_sage::DataPathRouter::FindRoute(Component* source, Component* target, RouteMetric::type metric) const
+{
+    std::unordered_map<const Component*, Label> labels;
+    _Search(source, target, metric, labels);
+    return _BuildRoute(source, target, labels);
+}
+
+void sys_sage::DataPathRouter::ComputeAllPairs(const std::vector<Component*>& components, RouteMetric::type metric)
+{
+    cachedComponents = components;
+    cachedMetric = metric;
+    cachedIndex.clear();
+    cachedIndex.reserve(components.size());
+    for(uint32_t i = 0; i < components.size(); i++)
+        cachedIndex.emplace(components[i], i);
+    _Recompute();
+}
+
+void sys_sage::DataPathRouter::_Recompute()
+{
+    //taken before the searches, so that changes during them invalidate the result
+    cachedGeneration = DataPath::GetGeneration();
+    size_t n = cachedComponents.size();
+    routes.clear();
+    routes.reserve(n * n);
+    std::unordered_map<const Component*, Label> labels;
+    for(Component* source : cachedComponents)
+    {
+        labels.clear();
+        _Search(source, nullptr, cachedMetric, labels);
+        for(Component* target : cachedComponents)
+            routes.push_back(_BuildRoute(source, target, labels));
+    }
+}
+
+const sys_sage::DataPathRoute* sys_sage::DataPathRouter::GetRoute(const Component* source, const Component* target)
+{
+    auto s = cachedIndex.find(source), t = cachedIndex.find(target);
+    if(s == cachedIndex.end() || t == cachedIndex.end())
+        return nullptr;
+    if(!IsCacheValid())
+        _Recompute();
+    return &routes[s->second * cachedComponents.size() + t->second];
+}
+
+double sys_sage::DataPathRouter::GetLatency(const Component* source, const Component* target)
+{
+    const DataPathRoute* route = GetRoute(source, target);
+    return (route != nullptr) ? route->latency : unset;
+}
+
+double sys_sage::DataPathRouter::GetBandwidth(const Component* source, const Component* target)
+{
+    const DataPathRoute* route = GetRoute(source, target);
+    return (route != nullptr) ? route->bandwidth : unset;
+}
+
+bool sys_sage::DataPathRouter::IsCacheValid() const
+{
+    return routes.size() == cachedComponents.size() * cachedComponents.size() && cachedGeneration == DataPath::GetGeneration();
+}
+
+void sys_sage::DataPathRouter::ClearCache()
+{
+    cachedComponents.clear();
+    cachedIndex.clear();
+    routes.clear();
+}
+
+size_t sys_sage::DataPathRouter::GetFootprint() const
+{
+    size_t size = sizeof(DataPathRouter) + _VectorHeapSize(cachedComponents) + _UnorderedMapHeapSize(cachedIndex) + _VectorHeapSize(routes);
+    for(const DataPathRoute& route : routes)
+        size += _VectorHeapSize(route.components) + _VectorHeapSize(route.dataPaths);
+    return size;
+}
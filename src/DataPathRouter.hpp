@@ -0,0 +1,124 @@
+#ifndef DATAPATH_ROUTER_HPP
+#define DATAPATH_ROUTER_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+#include "enums.hpp"
+
+namespace sys_sage { //forward declaration
+    class Component;
+    class DataPath;
+}
+
+namespace sys_sage {
+
+    /**
+     * @struct DataPathRoute
+     * @brief A route between two Components over DataPaths, as found by DataPathRouter.
+     */
+    struct DataPathRoute {
+        std::vector<Component*> components; /**< The components on the route, from the source to the target; empty if there is no route */
+        std::vector<DataPath*> dataPaths; /**< The DataPaths of the route (components.size() - 1 of them) */
+        double latency = 0; /**< Sum of the latencies of the DataPaths (NaN if one of them has no latency, i.e. a negative one) */
+        double bandwidth = 0; /**< Minimal bandwidth of the DataPaths (infinity for the route from a component to itself; NaN if one of them has no bandwidth, i.e. one <= 0) */
+
+        /**
+         * @brief Returns whether a route was found.
+         */
+        bool Found() const { return !components.empty(); }
+    };
+
+    /**
+     * @class DataPathRouter
+     * @brief Finds the best routes between Components over the DataPaths of the topology: with the minimal latency (Dijkstra) or the maximal bottleneck bandwidth (widest path), see RouteMetric.
+     *
+     * A route follows the DataPaths from each component to the other end (oriented DataPaths from their source to their target, bidirectional ones both ways), i.e. the outgoing DataPaths of Component::FindDataPaths(), of the DataPathType of the router;
+     * it may pass through any component, not only the source, target and the components of ComputeAllPairs().
+     * DataPaths without a latency (a negative or NaN one) are not used for MinLatency routes; DataPaths without a bandwidth (<= 0 or NaN) are not used for MaxBandwidth routes.
+     * \n FindRoute() searches the DataPaths from the source on each call. For repeated queries, ComputeAllPairs() computes the routes among a set of components once; GetRoute(), GetLatency() and GetBandwidth() then answer with hash lookups.
+     * The results are cached together with DataPath::GetGeneration() and recomputed on the next query after any DataPath of the process was added, deleted, moved or had its bandwidth or latency changed.
+     * \n A router is not thread-safe; concurrent queries need a router each.
+     */
+    class DataPathRouter {
+    public:
+        /**
+         * @brief Creates a router over the DataPaths of type dp_type.
+         * @param dp_type DataPathType of the DataPaths to route over (default: Any)
+         */
+        explicit DataPathRouter(DataPathType::type dp_type = DataPathType::Any);
+
+        /**
+         * @brief Returns the DataPathType of the DataPaths the router uses.
+         */
+        DataPathType::type GetDataPathType() const;
+
+        /**
+         * @brief Searches the best route from source to target.
+         * @param source The component the route starts at
+         * @param target The component the route ends at
+         * @param metric RouteMetric::MinLatency or RouteMetric::MaxBandwidth
+         * @return The route (DataPathRoute::Found() is false if target cannot be reached)
+         */
+        DataPathRoute FindRoute(Component* source, Component* target, RouteMetric::type metric) const;
+
+        /**
+         * @brief Computes and caches the best routes between all (ordered) pairs of components (one search from each of them).
+         * Replaces the previously cached routes.
+         * @param components The (distinct) components
+         * @param metric RouteMetric::MinLatency or RouteMetric::MaxBandwidth
+         */
+        void ComputeAllPairs(const std::vector<Component*>& components, RouteMetric::type metric);
+        /**
+         * @brief Returns the cached route from source to target (see ComputeAllPairs()), recomputing all routes first if the DataPaths changed since.
+         * @return The route, or nullptr if source or target is not one of the components of ComputeAllPairs()
+         */
+        const DataPathRoute* GetRoute(const Component* source, const Component* target);
+        /**
+         * @brief Returns the latency of the cached route from source to target (see GetRoute()), or NaN if there is none.
+         */
+        double GetLatency(const Component* source, const Component* target);
+        /**
+         * @brief Returns the bandwidth of the cached route from source to target (see GetRoute()), or NaN if there is none.
+         */
+        double GetBandwidth(const Component* source, const Component* target);
+        /**
+         * @brief Returns whether the cached routes are up to date, i.e. no DataPath changed since they were computed.
+         */
+        bool IsCacheValid() const;
+        /**
+         * @brief Drops the cached routes.
+         */
+        void ClearCache();
+
+        /**
+         * @brief Returns the memory of the cached routes.
+         */
+        size_t GetFootprint() const;
+
+    private:
+        struct Label {
+            double key; /**< accumulated latency or bottleneck bandwidth */
+            DataPath* via; /**< DataPath the component was reached through (nullptr for the source) */
+            Component* from; /**< component the component was reached from */
+            bool done;
+        };
+
+        //single-source search; stops early once target is settled (nullptr: search everything)
+        void _Search(Component* source, const Component* target, RouteMetric::type metric, std::unordered_map<const Component*, Label>& labels) const;
+        static DataPathRoute _BuildRoute(Component* source, Component* target, const std::unordered_map<const Component*, Label>& labels);
+        void _Recompute();
+
+        DataPathType::type dp_type;
+
+        std::vector<Component*> cachedComponents; /**< Components of ComputeAllPairs() */
+        RouteMetric::type cachedMetric = RouteMetric::MinLatency;
+        std::unordered_map<const Component*, uint32_t> cachedIndex; /**< Position of each component in cachedComponents */
+        std::vector<DataPathRoute> routes; /**< Row-major: route from cachedComponents[i] to cachedComponents[j] */
+        uint64_t cachedGeneration = 0; /**< DataPath::GetGeneration() when the routes were computed */
+    };
+}
+
+#endif
@@ -0,0 +1,196 @@
+#include "Epoch.hpp"
+
+#include <algorithm>
+#include <functional>
+
+namespace {
+    std::atomic<uint64_t> nextInstance { 1 };
+    constexpr size_t noSlot = SIZE_MAX;
+    constexpr size_t reclaimBatch = 64; /**< Retire() tries to free retired objects whenever this many are pending */
+}
+
+sys_sage::EpochManager::EpochManager(size_t maxReaders) : instance(nextInstance++), slots(new ReaderSlot[std::max<size_t>(maxReaders, 1)]), numSlots(std::max<size_t>(maxReaders, 1)) {}
+
+sys_sage::EpochManager::~EpochManager()
+{
+    for(Retired& r : retired)
+        r.deleter(r.obj);
+}
+
+sys_sage::EpochManager::ReadGuard::ReadGuard(EpochManager& _epochs) : epochs(_epochs) { epochs._EnterRead(); }
+sys_sage::EpochManager::ReadGuard::~ReadGuard() { epochs._ExitRead(); }
+sys_sage::EpochManager::WriteGuard::WriteGuard(EpochManager& _epochs) : epochs(_epochs) { epochs._EnterWrite(); }
+sys_sage::EpochManager::WriteGuard::~WriteGuard() { epochs._ExitWrite(); }
+
+std::vector<sys_sage::EpochManager::ThreadState>& sys_sage::EpochManager::_ThreadStates()
+{
+    //one entry per EpochManager the thread is currently in a guard of
+    thread_local std::vector<ThreadState> states;
+    return states;
+}
+
+sys_sage::EpochManager::ThreadState* sys_sage::EpochManager::_GetThreadState(bool create) const
+{
+    std::vector<ThreadState>& states = _ThreadStates();
+    for(ThreadState& st : states)
+        if(st.instance == instance)
+            return &st;
+    if(!create)
+        return nullptr;
+    states.push_back({ instance, noSlot, 0, 0 });
+    return &states.back();
+}
+
+void sys_sage::EpochManager::_ReleaseThreadState(ThreadState* st) const
+{
+    if(st->readDepth > 0 || st->writeDepth > 0)
+        return;
+    std::vector<ThreadState>& states = _ThreadStates();
+    *st = states.back();
+    states.pop_back();
+}
+
+void sys_sage::EpochManager::_EnterRead()
+{
+    ThreadState* st = _GetThreadState(true);
+    if(st->readDepth++ > 0 || st->writeDepth > 0) //nested, or the thread is the (exclusive) writer
+        return;
+
+    //claim a free slot, starting at a per-thread position to avoid contention
+    size_t start = std::hash<std::thread::id>{}(std::this_thread::get_id()) % numSlots;
+    for(size_t i = start; ; i = (i + 1) % numSlots)
+    {
+        bool expected = false;
+        if(!slots[i].inUse.load(std::memory_order_relaxed) && slots[i].inUse.compare_exchange_strong(expected, true, std::memory_order_acquire))
+        {
+            st->slot = i;
+            break;
+        }
+        if((i + 1) % numSlots == start)
+            std::this_thread::yield();
+    }
+
+    ReaderSlot& slot = slots[st->slot];
+    while(true)
+    {
+        slot.epoch.store(globalEpoch.load());
+        if(!writerActive.load())
+            break;
+        slot.epoch.store(0, std::memory_order_release);
+        writerActive.wait(true, std::memory_order_acquire);
+    }
+}
+
+void sys_sage::EpochManager::_ExitRead()
+{
+    ThreadState* st = _GetThreadState(false);
+    if(--st->readDepth > 0)
+        return;
+    if(st->slot != noSlot)
+    {
+        slots[st->slot].epoch.store(0, std::memory_order_release);
+        slots[st->slot].inUse.store(false, std::memory_order_release);
+        st->slot = noSlot;
+    }
+    _ReleaseThreadState(st);
+}
+
+void sys_sage::EpochManager::_EnterWrite()
+{
+    ThreadState* st = _GetThreadState(true);
+    if(st->writeDepth++ > 0)
+        return;
+    //a reader upgrading to a writer gives up its epoch while it waits, so that two upgrading readers do not wait for each other
+    if(st->slot != noSlot)
+        slots[st->slot].epoch.store(0, std::memory_order_release);
+
+    writerMutex.lock();
+    writerActive.store(true);
+    for(size_t i = 0; i < numSlots; i++)
+        while(slots[i].epoch.load() != 0)
+            std::this_thread::yield();
+}
+
+void sys_sage::EpochManager::_ExitWrite()
+{
+    ThreadState* st = _GetThreadState(false);
+    if(--st->writeDepth > 0)
+        return;
+    //an upgraded reader re-enters its read section before other writers can run
+    if(st->slot != noSlot)
+        slots[st->slot].epoch.store(globalEpoch.load());
+    writerActive.store(false);
+    writerActive.notify_all();
+    writerMutex.unlock();
+    _ReleaseThreadState(st);
+    _Reclaim(_MinActiveEpoch());
+}
+
+void sys_sage::EpochManager::Retire(void* obj, void (*deleter)(void*))
+{
+    if(obj == nullptr)
+        return;
+    size_t pending;
+    {
+        std::lock_guard<std::mutex> lock(retiredMutex);
+        retired.push_back({ obj, deleter, globalEpoch.fetch_add(1) });
+        pending = retired.size();
+    }
+    if(pending % reclaimBatch == 0)
+        _Reclaim(_MinActiveEpoch());
+}
+
+void sys_sage::EpochManager::Synchronize()
+{
+    uint64_t epoch = globalEpoch.fetch_add(1);
+    ThreadState* st = _GetThreadState(false);
+    size_t ownSlot = (st != nullptr) ? st->slot : noSlot;
+    for(size_t i = 0; i < numSlots; i++)
+    {
+        if(i == ownSlot)
+            continue;
+        for(uint64_t e = slots[i].epoch.load(); e != 0 && e <= epoch; e = slots[i].epoch.load())
+            std::this_thread::yield();
+    }
+    _Reclaim(epoch + 1);
+}
+
+size_t sys_sage::EpochManager::GetNumRetired() const
+{
+    std::lock_guard<std::mutex> lock(retiredMutex);
+    return retired.size();
+}
+
+bool sys_sage::EpochManager::IsWriter() const
+{
+    ThreadState* st = _GetThreadState(false);
+    return st != nullptr && st->writeDepth > 0;
+}
+
+std::mutex& sys_sage::EpochManager::_GetPublishMutex() { return publishMutex; }
+
+uint64_t sys_sage::EpochManager::_MinActiveEpoch() const
+{
+    uint64_t minActive = UINT64_MAX;
+    for(size_t i = 0; i < numSlots; i++)
+    {
+        uint64_t e = slots[i].epoch.load();
+        if(e != 0)
+            minActive = std::min(minActive, e);
+    }
+    return minActive;
+}
+
+void sys_sage::EpochManager::_Reclaim(uint64_t bound)
+{
+    //retired objects are ordered by epoch, so the reclaimable ones form a prefix
+    std::vector<Retired> reclaimable;
+    {
+        std::lock_guard<std::mutex> lock(retiredMutex);
+        auto end = std::find_if(retired.begin(), retired.end(), [bound](const Retired& r){ return r.epoch >= bound; });
+        reclaimable.assign(retired.begin(), end);
+        retired.erase(retired.begin(), end);
+    }
+    for(Retired& r : reclaimable)
+        r.deleter(r.obj);
+}
@@ -0,0 +1,141 @@
+#ifndef EPOCH_HPP
+#define EPOCH_HPP
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace sys_sage {
+
+    /**
+     * @class EpochManager
+     * @brief Coordinates concurrent readers and writers of a Component Tree (opt-in concurrency mode).
+     *
+     * Readers enclose their accesses in a ReadGuard. Entering and leaving a ReadGuard only writes to a reader slot owned by the calling thread, so readers do not contend with each other and never take a lock.
+     * Readers are not wait-free, though: entering a ReadGuard waits while a WriteGuard is open, so every structural change stalls the readers for its duration (value updates do not).
+     * \n Changes to the values of the tree (Component::PublishAttrib(), DataPath::SetBandwidth()/SetLatency(), Core::SetFreq()) are published atomically without excluding readers.
+     * A value replaced by PublishAttrib() is retired (see Retire()) and freed only after all readers that might still see it have left their ReadGuards (epoch-based reclamation).
+     * \n Structural changes (InsertChild(), new DataPath, Delete(), inserting a new attribute key, ...) are made in a WriteGuard. Writers are serialized; a WriteGuard waits for the current readers to leave and makes new readers wait until it ends,
+     * so that readers observe each WriteGuard as one atomic change. Components and Relations deleted in a WriteGuard can therefore be freed immediately.
+     * \n Readers must only use the lock-free accessors for values that are updated concurrently (Component::ReadAttrib(), DataPath::GetBandwidth()/GetLatency(), Core::GetFreq()).
+     */
+    class EpochManager {
+    public:
+        /**
+         * @param maxReaders Maximum number of threads in a ReadGuard at the same time (further readers wait for a free slot)
+         */
+        EpochManager(size_t maxReaders = 128);
+        /**
+         * @brief Frees all retired objects. No thread may be in a ReadGuard or WriteGuard of this EpochManager.
+         */
+        ~EpochManager();
+        EpochManager(const EpochManager&) = delete;
+        EpochManager& operator=(const EpochManager&) = delete;
+
+        /**
+         * @class ReadGuard
+         * @brief Read-side critical section: while it exists, the Component Tree is not structurally modified and retired objects are not freed.
+         * ReadGuards of the same thread may be nested.
+         */
+        class ReadGuard {
+        public:
+            ReadGuard(EpochManager& _epochs);
+            ~ReadGuard();
+            ReadGuard(const ReadGuard&) = delete;
+            ReadGuard& operator=(const ReadGuard&) = delete;
+        private:
+            EpochManager& epochs;
+        };
+
+        /**
+         * @class WriteGuard
+         * @brief Exclusive section for structural changes of the Component Tree; see EpochManager.
+         * WriteGuards of the same thread may be nested. A thread holding a ReadGuard may open a WriteGuard; its read section is suspended while it waits for the WriteGuard, so other writers may change the tree in between.
+         */
+        class WriteGuard {
+        public:
+            WriteGuard(EpochManager& _epochs);
+            ~WriteGuard();
+            WriteGuard(const WriteGuard&) = delete;
+            WriteGuard& operator=(const WriteGuard&) = delete;
+        private:
+            EpochManager& epochs;
+        };
+
+        /**
+         * @brief Hands over an object that is no longer reachable for new readers; it is freed with deleter once all readers that entered before have left.
+         * Can be called from any thread, also without a WriteGuard.
+         * @param obj The object (nothing happens for nullptr)
+         * @param deleter Function freeing obj
+         */
+        void Retire(void* obj, void (*deleter)(void*));
+        /**
+         * @brief Retires an object allocated with new (see Retire(void*, void(*)(void*))).
+         */
+        template <class T>
+        void Retire(T* obj) { Retire(obj, [](void* p){ delete static_cast<T*>(p); }); }
+
+        /**
+         * @brief Waits until all readers that are currently in a ReadGuard (except the calling thread) have left it, and frees all objects retired so far.
+         */
+        void Synchronize();
+
+        /**
+         * @brief Returns the number of retired objects that have not been freed yet.
+         */
+        size_t GetNumRetired() const;
+        /**
+         * @brief Returns whether the calling thread is in a WriteGuard of this EpochManager.
+         */
+        bool IsWriter() const;
+
+        /**
+         * @private
+         * @brief Returns the mutex that serializes the Component::PublishAttrib() calls while they swap values and their owners (readers never take it).
+         */
+        std::mutex& _GetPublishMutex();
+
+    private:
+        struct alignas(64) ReaderSlot {
+            std::atomic<bool> inUse { false };
+            std::atomic<uint64_t> epoch { 0 }; /**< epoch in which the reader entered; 0 = not in a ReadGuard */
+        };
+        struct Retired {
+            void* obj;
+            void (*deleter)(void*);
+            uint64_t epoch; /**< epoch at the time of retirement */
+        };
+        struct ThreadState {
+            uint64_t instance; /**< instance number of the EpochManager this state belongs to */
+            size_t slot;
+            int readDepth;
+            int writeDepth;
+        };
+
+        static std::vector<ThreadState>& _ThreadStates();
+        ThreadState* _GetThreadState(bool create) const;
+        void _ReleaseThreadState(ThreadState* st) const;
+        void _EnterRead();
+        void _ExitRead();
+        void _EnterWrite();
+        void _ExitWrite();
+        uint64_t _MinActiveEpoch() const;
+        void _Reclaim(uint64_t bound);
+
+        const uint64_t instance; /**< unique number of this EpochManager (identifies its thread-local states) */
+        std::unique_ptr<ReaderSlot[]> slots;
+        size_t numSlots;
+        std::atomic<uint64_t> globalEpoch { 1 };
+        std::atomic<bool> writerActive { false }; /**< true while a WriteGuard is open; readers wait for it to become false */
+        std::mutex writerMutex; /**< serializes writers */
+        std::mutex publishMutex; /**< serializes Component::PublishAttrib() */
+        mutable std::mutex retiredMutex;
+        std::vector<Retired> retired; /**< retired objects, in the order of retirement */
+    };
+}
+
+#endif
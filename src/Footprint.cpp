@@ -0,0 +1,98 @@
+#include "Footprint.hpp"
+#include "TimeSeries.hpp"
+
+#include <cstdint>
+#include <iostream>
+#include <tuple>
+#include <utility>
+
+size_t sys_sage::_StringHeapSize(const std::string& s)
+{
+    //short strings are stored inside the string object
+    const char* data = s.data();
+    const char* object = reinterpret_cast<const char*>(&s);
+    if(data >= object && data < object + sizeof(std::string))
+        return 0;
+    return s.capacity() + 1;
+}
+
+//for a specific key, return the size of the value; the keys and types are the ones of the default attributes of XML export/import and of the parsers
+size_t sys_sage::_search_default_attrib_size(const std::string& key, const void* value)
+{
+    //value: uint64_t
+    if(!key.compare("CATcos") ||
+    !key.compare("CATL3mask") )
+        return sizeof(uint64_t);
+    //value: long long
+    else if(!key.compare("mig_size") ||
+    !key.compare("clockRate") )
+        return sizeof(long long);
+    //value: int or uint32_t
+    else if(!key.compare("Number_of_streaming_multiprocessors") ||
+    !key.compare("Number_of_cores_in_GPU") ||
+    !key.compare("Number_of_cores_per_SM")  ||
+    !key.compare("Bus_Width_bit") ||
+    !key.compare("busWidth") ||
+    !key.compare("multiProcessorCount") ||
+    !key.compare("numberOfCoresPerMultiProcessor") ||
+    !key.compare("maxThreadsPerBlock") ||
+    !key.compare("warpSize") ||
+    !key.compare("maxThreadsPerMultiProcessor") ||
+    !key.compare("maxBlocksPerMultiProcessor") ||
+    !key.compare("numXDCDs") ||
+    !key.compare("computeUnitsPerDie") ||
+    !key.compare("numSIMDsPerCu") )
+        return sizeof(int);
+    //value: double
+    else if(!key.compare("Clock_Frequency") ||
+    !key.compare("GPU_Clock_Rate") ||
+    !key.compare("readBandwidth") ||
+    !key.compare("writeBandwidth") ||
+    !key.compare("missPenalty") )
+        return sizeof(double);
+    //value: size_t
+    else if(!key.compare("fetchGranularity") ||
+    !key.compare("segmentSize") )
+        return sizeof(size_t);
+    //value: float
+    else if(!key.compare("latency") ||
+    !key.compare("latency_min") ||
+    !key.compare("latency_max") )
+        return sizeof(float);
+    //value: std::pair<int, int>
+    else if(!key.compare("computeCapability"))
+        return sizeof(std::pair<int, int>);
+    //value: string
+    else if(!key.compare("CUDA_compute_capability") ||
+    !key.compare("mig_uuid") )
+    {
+        const std::string* val = static_cast<const std::string*>(value);
+        return sizeof(std::string) + _StringHeapSize(*val);
+    }
+    //value: TimeSeries
+    else if(!key.compare("freq_history") ||
+    !key.compare("readout_history") )
+    {
+        const TimeSeries* val = static_cast<const TimeSeries*>(value);
+        return sizeof(*val) + val->GetHeapSize();
+    }
+
+    return 0;
+}
+
+void sys_sage::MemoryFootprint::Print() const
+{
+    std::cout << "Memory footprint: " << total << " bytes" << std::endl;
+    for(const auto& [componentType, size] : componentTypes)
+        std::cout << "  components " << ComponentType::ToString(componentType) << ": " << size << std::endl;
+    for(const auto& [relationType, size] : relationTypes)
+        std::cout << "  relations " << RelationType::ToString(relationType) << ": " << size << std::endl;
+    for(const auto& [key, size] : attributes)
+        std::cout << "  attribute " << key << ": " << size << std::endl;
+    std::cout << "  children containers: " << childrenContainers << std::endl;
+    std::cout << "  relation containers: " << relationContainers << std::endl;
+    std::cout << "  typed attribute containers: " << attribContainers << std::endl;
+    std::cout << "  subtree indexes: " << indexes << std::endl;
+    if(numUnknownAttribs > 0)
+        std::cout << "  (" << numUnknownAttribs << " attribute values of unknown size not counted)" << std::endl;
+}
@@ -0,0 +1,87 @@
+#ifndef FOOTPRINT_HPP
+#define FOOTPRINT_HPP
+
+#include <cstddef>
+#include <functional>
+#include <map>
+#include <string>
+#include <vector>
+
+#include "enums.hpp"
+#include "InlineVector.hpp"
+
+namespace sys_sage {
+
+    /**
+     * @brief Memory footprint of a subtree and its Relations, broken down per category (see Component::CalcFootprint()).
+     *
+     * All sizes are in bytes requested from the allocator: the objects themselves and the heap memory they own (string buffers, vector capacities, map nodes), without the bookkeeping of the allocator itself.
+     */
+    struct MemoryFootprint {
+        size_t total { 0 }; /**< Sum of all categories below */
+        std::map<ComponentType::type, size_t> componentTypes; /**< Per ComponentType: the component objects and the heap memory of their members (name, Cache name, Chip vendor and model, ...) */
+        std::map<RelationType::type, size_t> relationTypes; /**< Per RelationType: the Relation objects, their component vectors and the heap memory of their members */
+        std::map<std::string, size_t> attributes; /**< Per attribute key (of components and Relations): the attrib map nodes, the key strings and the values, and the typed attribute entries (see AttribStore) with the heap memory of their values */
+        size_t childrenContainers { 0 }; /**< Children vectors of the components */
+        size_t relationContainers { 0 }; /**< Relation arrays and Relation vectors of the components */
+        size_t attribContainers { 0 }; /**< Unused capacity of the typed attribute stores, and the ownership records of the attrib map values (see Component::SetAttrib()) */
+        size_t indexes { 0 }; /**< SubtreeIndexes and DataPathIndexes of the components (see Component::EnableSubtreeIndex(), DataPathIndexCache) */
+        size_t numUnknownAttribs { 0 }; /**< Number of attribute values of unknown type; their map nodes and keys are counted, the values are not */
+
+        /**
+         * @brief Prints the footprint, one line per category.
+         */
+        void Print() const;
+    };
+
+    /**
+     * @brief Function returning the size of an attribute value (including the heap memory it owns), given the attribute key and the value. Returns 0 for unknown keys.
+     * @see Component::CalcFootprint()
+     */
+    using AttribSizeFcn = std::function<size_t(const std::string& key, const void* value)>;
+
+    /**
+     * @private
+     * @brief Default size function for the attributes set by sys-sage itself (e.g. by the parsers and the external interfaces). Can be used as a reference for a custom AttribSizeFcn.
+     * @param key Attribute key
+     * @param value Attribute value
+     * @return Size of the value in bytes, or 0 if the key is unknown
+     */
+    size_t _search_default_attrib_size(const std::string& key, const void* value);
+    /**
+     * @private
+     * @brief Returns the heap memory owned by a string (0 if the string is stored inline).
+     */
+    size_t _StringHeapSize(const std::string& s);
+    /**
+     * @private
+     * @brief Returns the heap memory owned by a vector (its capacity, without the heap memory of its elements).
+     */
+    template <class T>
+    size_t _VectorHeapSize(const std::vector<T>& v) { return v.capacity() * sizeof(T); }
+    /**
+     * @private
+     * @brief Returns the heap memory owned by an InlineVector (0 while its values are kept inside the object).
+     */
+    template <class T, uint32_t N>
+    size_t _VectorHeapSize(const InlineVector<T, N>& v) { return (v.capacity() > N) ? v.capacity() * sizeof(T) : 0; }
+    /**
+     * @private
+     * @brief Bookkeeping of a std::map node besides the key and value: three pointers and the color, padded to a pointer.
+     */
+    constexpr size_t _mapNodeOverhead = 4 * sizeof(void*);
+    /**
+     * @private
+     * @brief Returns the heap memory owned by a std::map (its nodes, without the heap memory of its keys and values).
+     */
+    template <class Map>
+    size_t _MapHeapSize(const Map& m) { return m.size() * (sizeof(typename Map::value_type) + _mapNodeOverhead); }
+    /**
+     * @private
+     * @brief Returns the heap memory owned by a std::unordered_map (its nodes -- each linked to the next one -- and its bucket array, without the heap memory of its keys and values).
+     */
+    template <class UnorderedMap>
+    size_t _UnorderedMapHeapSize(const UnorderedMap& m) { return m.size() * (sizeof(typename UnorderedMap::value_type) + sizeof(void*)) + m.bucket_count() * sizeof(void*); }
+}
+
+#endif
@@ -0,0 +1,207 @@
+#include "FrozenTopology.hpp"
+
+#include <algorithm>
+#include <utility>
+
+#include "Component.hpp"
+#include "DataPath.hpp"
+
+sys_sage::FrozenTopology::FrozenTopology(Component* root)
+{
+    //pre-order traversal with an explicit stack (children pushed in reverse order)
+    std::vector<std::pair<Component*, uint32_t>> stack { { root, None } };
+    while(!stack.empty())
+    {
+        auto [c, parentIndex] = stack.back();
+        stack.pop_back();
+        uint32_t index = static_cast<uint32_t>(components.size());
+        if(!indexOf.emplace(c, index).second)
+            continue; //inconsistent tree (Component reachable twice) -- keep the first occurrence
+        components.push_back(c);
+        types.push_back(c->GetComponentType());
+        ids.push_back(c->GetId());
+        names.push_back(c->GetName());
+        parents.push_back(parentIndex);
+        depths.push_back(parentIndex == None ? 0 : depths[parentIndex] + 1);
+
+        const std::vector<Component*>& liveChildren = c->GetChildren();
+        for(auto it = liveChildren.rbegin(); it != liveChildren.rend(); ++it)
+            stack.emplace_back(*it, index);
+    }
+    uint32_t n = static_cast<uint32_t>(components.size());
+
+    //subtree ends: every Component extends the subtree of its parent
+    subtreeEnds.resize(n);
+    for(uint32_t i = 0; i < n; i++)
+        subtreeEnds[i] = i + 1;
+    for(uint32_t i = n; i-- > 1;)
+        subtreeEnds[parents[i]] = std::max(subtreeEnds[parents[i]], subtreeEnds[i]);
+
+    //children in CSR layout, in the order of the live children vectors
+    childOffsets.resize(n + 1);
+    childIndices.reserve(n > 0 ? n - 1 : 0);
+    for(uint32_t i = 0; i < n; i++)
+    {
+        childOffsets[i] = static_cast<uint32_t>(childIndices.size());
+        for(Component* child : components[i]->GetChildren())
+        {
+            auto it = indexOf.find(child);
+            if(it != indexOf.end() && parents[it->second] == i)
+                childIndices.push_back(it->second);
+        }
+    }
+    childOffsets[n] = static_cast<uint32_t>(childIndices.size());
+
+    //per-type ranges: indices sorted by type, pre-order within each type
+    preOrder.resize(n);
+    for(uint32_t i = 0; i < n; i++)
+        preOrder[i] = i;
+    byType = preOrder;
+    std::stable_sort(byType.begin(), byType.end(), [this](uint32_t a, uint32_t b){ return types[a] < types[b]; });
+    for(uint32_t begin = 0; begin < n;)
+    {
+        uint32_t end = begin;
+        while(end < n && types[byType[end]] == types[byType[begin]])
+            end++;
+        typeRanges.emplace(types[byType[begin]], std::make_pair(begin, end));
+        begin = end;
+    }
+
+    //DataPaths with both endpoints in the snapshot; each one is stored once and referenced from the CSR lists of its endpoints
+    std::unordered_map<const DataPath*, uint32_t> dpIndexOf;
+    dpOffsets.resize(n + 1);
+    for(uint32_t i = 0; i < n; i++)
+    {
+        dpOffsets[i] = static_cast<uint32_t>(dpIndices.size());
+        for(Relation* r : components[i]->GetRelationsByType(RelationType::DataPath))
+        {
+            DataPath* dp = reinterpret_cast<DataPath*>(r);
+            auto known = dpIndexOf.find(dp);
+            if(known != dpIndexOf.end())
+            {
+                dpIndices.push_back(known->second);
+                continue;
+            }
+            uint32_t source = GetIndex(dp->GetSource());
+            uint32_t target = GetIndex(dp->GetTarget());
+            if(source == None || target == None)
+                continue;
+            uint32_t dpIndex = static_cast<uint32_t>(dataPaths.size());
+            dataPaths.push_back({ source, target, dp->GetDataPathType(), dp->IsOrdered(), dp->GetBandwidth(), dp->GetLatency(), dp });
+            dpIndexOf.emplace(dp, dpIndex);
+            dpIndices.push_back(dpIndex);
+        }
+    }
+    dpOffsets[n] = static_cast<uint32_t>(dpIndices.size());
+}
+
+uint32_t sys_sage::FrozenTopology::GetNumComponents() const { return static_cast<uint32_t>(components.size()); }
+sys_sage::Component* sys_sage::FrozenTopology::GetComponent(uint32_t index) const { return components[index]; }
+
+uint32_t sys_sage::FrozenTopology::GetIndex(const Component* c) const
+{
+    auto it = indexOf.find(c);
+    if(it == indexOf.end())
+        return None;
+    return it->second;
+}
+
+sys_sage::ComponentType::type sys_sage::FrozenTopology::GetComponentType(uint32_t index) const { return types[index]; }
+int sys_sage::FrozenTopology::GetId(uint32_t index) const { return ids[index]; }
+const std::string& sys_sage::FrozenTopology::GetName(uint32_t index) const { return names[index]; }
+uint32_t sys_sage::FrozenTopology::GetDepth(uint32_t index) const { return depths[index]; }
+uint32_t sys_sage::FrozenTopology::GetParent(uint32_t index) const { return parents[index]; }
+uint32_t sys_sage::FrozenTopology::GetSubtreeEnd(uint32_t index) const { return subtreeEnds[index]; }
+
+std::span<const uint32_t> sys_sage::FrozenTopology::GetChildren(uint32_t index) const
+{
+    return std::span<const uint32_t>(childIndices.data() + childOffsets[index], childOffsets[index + 1] - childOffsets[index]);
+}
+
+std::span<const uint32_t> sys_sage::FrozenTopology::GetComponentsByType(ComponentType::type componentType) const
+{
+    if(componentType == ComponentType::Any)
+        return std::span<const uint32_t>(preOrder);
+    auto it = typeRanges.find(componentType);
+    if(it == typeRanges.end())
+        return {};
+    return std::span<const uint32_t>(byType.data() + it->second.first, it->second.second - it->second.first);
+}
+
+std::span<const uint32_t> sys_sage::FrozenTopology::FindDescendantsByType(uint32_t index, ComponentType::type componentType) const
+{
+    if(componentType == ComponentType::Any)
+        return std::span<const uint32_t>(preOrder.data() + index, subtreeEnds[index] - index);
+    //the subtree is a contiguous range of pre-order indices, so it is also contiguous within the (pre-order sorted) range of the type
+    std::span<const uint32_t> ofType = GetComponentsByType(componentType);
+    auto begin = std::lower_bound(ofType.begin(), ofType.end(), index);
+    auto end = std::lower_bound(begin, ofType.end(), subtreeEnds[index]);
+    return ofType.subspan(begin - ofType.begin(), end - begin);
+}
+
+uint32_t sys_sage::FrozenTopology::CountDescendantsByType(uint32_t index, ComponentType::type componentType) const
+{
+    uint32_t count = static_cast<uint32_t>(FindDescendantsByType(index, componentType).size());
+    if(componentType == ComponentType::Any || types[index] == componentType)
+        count--;
+    return count;
+}
+
+uint32_t sys_sage::FrozenTopology::GetAncestorByType(uint32_t index, ComponentType::type componentType) const
+{
+    while(index != None && types[index] != componentType)
+        index = parents[index];
+    return index;
+}
+
+uint32_t sys_sage::FrozenTopology::GetNthAncestor(uint32_t index, int n) const
+{
+    if(n < 0)
+        return None;
+    for(; n > 0 && index != None; n--)
+        index = parents[index];
+    return index;
+}
+
+bool sys_sage::FrozenTopology::IsAncestorOf(uint32_t ancestor, uint32_t descendant) const
+{
+    return ancestor <= descendant && descendant < subtreeEnds[ancestor];
+}
+
+uint32_t sys_sage::FrozenTopology::GetNumDataPaths() const { return static_cast<uint32_t>(dataPaths.size()); }
+const sys_sage::FrozenDataPath& sys_sage::FrozenTopology::GetDataPath(uint32_t dpIndex) const { return dataPaths[dpIndex]; }
+
+std::span<const uint32_t> sys_sage::FrozenTopology::GetDataPaths(uint32_t index) const
+{
+    return std::span<const uint32_t>(dpIndices.data() + dpOffsets[index], dpOffsets[index + 1] - dpOffsets[index]);
+}
+
+bool sys_sage::FrozenTopology::_MatchesDirection(uint32_t index, const FrozenDataPath& dp, DataPathDirection::type direction) const
+{
+    //same semantics as Component::FindDataPaths(): bidirectional DataPaths match any direction
+    return !dp.oriented ||
+        direction == DataPathDirection::Any ||
+        (direction == DataPathDirection::Outgoing && dp.source == index) ||
+        (direction == DataPathDirection::Incoming && dp.target == index);
+}
+
+void sys_sage::FrozenTopology::FindDataPaths(uint32_t index, std::vector<uint32_t>* outDpArr, DataPathType::type dp_type, DataPathDirection::type direction) const
+{
+    for(uint32_t dpIndex : GetDataPaths(index))
+    {
+        const FrozenDataPath& dp = dataPaths[dpIndex];
+        if(_MatchesDirection(index, dp, direction) && (dp_type == DataPathType::Any || dp.dp_type == dp_type))
+            outDpArr->push_back(dpIndex);
+    }
+}
+
+uint32_t sys_sage::FrozenTopology::GetDataPathByType(uint32_t index, DataPathType::type dp_type, DataPathDirection::type direction) const
+{
+    for(uint32_t dpIndex : GetDataPaths(index))
+    {
+        const FrozenDataPath& dp = dataPaths[dpIndex];
+        if(_MatchesDirection(index, dp, direction) && dp.dp_type == dp_type)
+            return dpIndex;
+    }
+    return None;
+}
@@ -0,0 +1,187 @@
+#ifndef FROZEN_TOPOLOGY_HPP
+#define FROZEN_TOPOLOGY_HPP
+
+#include <cstdint>
+#include <limits>
+#include <span>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "enums.hpp"
+
+namespace sys_sage { //forward declaration
+    class Component;
+    class DataPath;
+}
+
+namespace sys_sage {
+
+    /**
+     * @brief One DataPath as stored in a FrozenTopology.
+     * Source and target are indices of Components in the FrozenTopology.
+     */
+    struct FrozenDataPath {
+        uint32_t source; /**< index of the source Component */
+        uint32_t target; /**< index of the target Component */
+        DataPathType::type dp_type; /**< type of the DataPath */
+        bool oriented; /**< true for DataPathOrientation::Oriented, false for DataPathOrientation::Bidirectional */
+        double bw; /**< bandwidth (see DataPath::GetBandwidth()) */
+        double latency; /**< latency (see DataPath::GetLatency()) */
+        DataPath* dataPath; /**< the live DataPath this entry was created from */
+    };
+
+    /**
+     * @class FrozenTopology
+     * @brief Immutable, flat snapshot of a Component Tree and its DataPaths, laid out in contiguous arrays.
+     *
+     * Components are identified by their index, which is their position in pre-order (DFS) order -- the root has index 0, and the subtree of a Component with index i occupies the indices [i, GetSubtreeEnd(i)).
+     * The snapshot stores (as separate arrays) the type, id, name, depth and parent index of each Component, the children in CSR layout, and an array of all Components sorted by type, so that all Components of a type in a subtree form one contiguous range.
+     * DataPaths whose both endpoints are in the snapshot are stored once in an array of FrozenDataPath, and each Component's DataPaths are stored in CSR layout (in the same order as in the live Component).
+     * \n The snapshot does not change when the live Component Tree changes; create a new one after modifications. GetComponent() and GetIndex() map between indices and the live Component objects.
+     * @see Topology::Freeze()
+     */
+    class FrozenTopology {
+    public:
+        /**
+         * @brief Index value denoting "no Component" (e.g. the parent of the root).
+         */
+        static constexpr uint32_t None = std::numeric_limits<uint32_t>::max();
+
+        /**
+         * @brief Creates a snapshot of the subtree of root (including root itself) and of the DataPaths among its Components.
+         * @param root Root of the subtree to freeze
+         */
+        FrozenTopology(Component* root);
+
+        /**
+         * @brief Returns the number of Components in the snapshot.
+         */
+        uint32_t GetNumComponents() const;
+        /**
+         * @brief Returns the live Component with the given index.
+         */
+        Component* GetComponent(uint32_t index) const;
+        /**
+         * @brief Returns the index of a live Component in the snapshot.
+         * @return Index of the Component, or FrozenTopology::None if it is not part of the snapshot
+         */
+        uint32_t GetIndex(const Component* c) const;
+
+        /**
+         * @brief Returns the ComponentType of the Component with the given index.
+         */
+        ComponentType::type GetComponentType(uint32_t index) const;
+        /**
+         * @brief Returns the id of the Component with the given index.
+         */
+        int GetId(uint32_t index) const;
+        /**
+         * @brief Returns the name of the Component with the given index.
+         */
+        const std::string& GetName(uint32_t index) const;
+        /**
+         * @brief Returns the depth of the Component with the given index, relative to the root of the snapshot (root = 0).
+         */
+        uint32_t GetDepth(uint32_t index) const;
+        /**
+         * @brief Returns the index of the parent, or FrozenTopology::None for the root.
+         */
+        uint32_t GetParent(uint32_t index) const;
+        /**
+         * @brief Returns the end of the subtree of a Component: the subtree of index occupies the indices [index, GetSubtreeEnd(index)).
+         */
+        uint32_t GetSubtreeEnd(uint32_t index) const;
+        /**
+         * @brief Returns the indices of the children of the Component with the given index (in the order of the live children vector).
+         */
+        std::span<const uint32_t> GetChildren(uint32_t index) const;
+
+        /**
+         * @brief Returns the indices of all Components of the given type in the snapshot, in pre-order.
+         * @param componentType Required type, or ComponentType::Any for all Components
+         */
+        std::span<const uint32_t> GetComponentsByType(ComponentType::type componentType) const;
+        /**
+         * @brief Returns the indices of all Components of the given type in the subtree of index (including index itself), in pre-order.
+         * Equivalent to Component::FindDescendantsByType(), but without traversal and without allocation (binary search in the per-type range).
+         * @param index Root of the subtree
+         * @param componentType Required type, or ComponentType::Any for all Components
+         */
+        std::span<const uint32_t> FindDescendantsByType(uint32_t index, ComponentType::type componentType) const;
+        /**
+         * @brief Counts the descendants of the given type (not including index itself). Equivalent to Component::CountDescendantsByType().
+         */
+        uint32_t CountDescendantsByType(uint32_t index, ComponentType::type componentType) const;
+        /**
+         * @brief Returns the closest ancestor of the given type (including index itself). Equivalent to Component::GetAncestorByType().
+         * @return Index of the ancestor, or FrozenTopology::None if there is none
+         */
+        uint32_t GetAncestorByType(uint32_t index, ComponentType::type componentType) const;
+        /**
+         * @brief Returns the ancestor n levels above. Equivalent to Component::GetNthAncestor().
+         * @return Index of the ancestor, or FrozenTopology::None if there is none
+         */
+        uint32_t GetNthAncestor(uint32_t index, int n) const;
+        /**
+         * @brief Returns true if ancestor is an ancestor of (or identical to) descendant. O(1).
+         */
+        bool IsAncestorOf(uint32_t ancestor, uint32_t descendant) const;
+
+        /**
+         * @brief Returns the number of DataPaths in the snapshot.
+         */
+        uint32_t GetNumDataPaths() const;
+        /**
+         * @brief Returns the DataPath with the given (DataPath) index.
+         */
+        const FrozenDataPath& GetDataPath(uint32_t dpIndex) const;
+        /**
+         * @brief Returns the DataPath indices of all DataPaths of the Component with the given index.
+         */
+        std::span<const uint32_t> GetDataPaths(uint32_t index) const;
+        /**
+         * @brief Retrieves the DataPaths of a Component with matching type and direction. Equivalent to Component::FindDataPaths().
+         * @param index Index of the Component
+         * @param outDpArr output parameter; DataPath indices are pushed back
+         * @param dp_type DataPath type to search for (default: Any)
+         * @param direction Direction relative to the Component (default: Any)
+         */
+        void FindDataPaths(uint32_t index, std::vector<uint32_t>* outDpArr, DataPathType::type dp_type = DataPathType::Any, DataPathDirection::type direction = DataPathDirection::Any) const;
+        /**
+         * @brief Returns the first DataPath of a Component with matching type and direction. Equivalent to Component::GetDataPathByType().
+         * @return DataPath index, or FrozenTopology::None if there is none
+         */
+        uint32_t GetDataPathByType(uint32_t index, DataPathType::type dp_type, DataPathDirection::type direction = DataPathDirection::Any) const;
+
+    private:
+        bool _MatchesDirection(uint32_t index, const FrozenDataPath& dp, DataPathDirection::type direction) const;
+
+        //per-Component arrays (indexed by pre-order index)
+        std::vector<Component*> components;
+        std::vector<ComponentType::type> types;
+        std::vector<int> ids;
+        std::vector<std::string> names;
+        std::vector<uint32_t> depths;
+        std::vector<uint32_t> parents;
+        std::vector<uint32_t> subtreeEnds;
+
+        //children in CSR layout: children of i are childIndices[childOffsets[i] .. childOffsets[i+1])
+        std::vector<uint32_t> childOffsets;
+        std::vector<uint32_t> childIndices;
+
+        //all indices (0..n-1), and all indices sorted by (type, pre-order) with the range of each type
+        std::vector<uint32_t> preOrder;
+        std::vector<uint32_t> byType;
+        std::unordered_map<ComponentType::type, std::pair<uint32_t, uint32_t>> typeRanges;
+
+        //DataPaths, and the DataPaths of each Component in CSR layout
+        std::vector<FrozenDataPath> dataPaths;
+        std::vector<uint32_t> dpOffsets;
+        std::vector<uint32_t> dpIndices;
+
+        std::unordered_map<const Component*, uint32_t> indexOf; /**< live Component -> index */
+    };
+}
+
+#endif
@@ -0,0 +1,200 @@
+#ifndef INLINE_VECTOR_HPP
+#define INLINE_VECTOR_HPP
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <initializer_list>
+#include <iterator>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+
+namespace sys_sage {
+
+    /**
+     * @class InlineVector
+     * @brief A vector of trivially copyable values that keeps up to N of them inside the object, and only moves them to the heap when it grows beyond N.
+     *
+     * Holds the components of a Relation: the two endpoints of a DataPath or a CouplingMap need no heap allocation of their own.
+     * It offers the part of the std::vector interface that is used on them (contiguous storage, pointers as iterators), converts to a std::vector and compares equal to one with the same values.
+     */
+    template <class T, uint32_t N>
+    class InlineVector {
+        static_assert(std::is_trivially_copyable_v<T>, "InlineVector holds trivially copyable values only");
+        static_assert(N > 0, "InlineVector needs room for at least one value");
+    public:
+        using value_type = T;
+        using size_type = size_t;
+        using difference_type = ptrdiff_t;
+        using reference = T&;
+        using const_reference = const T&;
+        using pointer = T*;
+        using const_pointer = const T*;
+        using iterator = T*;
+        using const_iterator = const T*;
+
+        InlineVector() {}
+        InlineVector(std::initializer_list<T> init) { assign(init.begin(), init.end()); }
+        InlineVector(const InlineVector& other) { assign(other.begin(), other.end()); }
+        InlineVector(InlineVector&& other) noexcept { _Take(other); }
+        InlineVector& operator=(const InlineVector& other)
+        {
+            if(this != &other)
+                assign(other.begin(), other.end());
+            return *this;
+        }
+        InlineVector& operator=(InlineVector&& other) noexcept
+        {
+            if(this != &other)
+            {
+                _Release();
+                _Take(other);
+            }
+            return *this;
+        }
+        ~InlineVector() { _Release(); }
+
+        /**
+         * @brief Returns a std::vector with the same values (a copy).
+         */
+        operator std::vector<T>() const { return std::vector<T>(begin(), end()); }
+
+        T* data() { return (cap > N) ? heap : local; }
+        const T* data() const { return (cap > N) ? heap : local; }
+        iterator begin() { return data(); }
+        iterator end() { return data() + count; }
+        const_iterator begin() const { return data(); }
+        const_iterator end() const { return data() + count; }
+        const_iterator cbegin() const { return begin(); }
+        const_iterator cend() const { return end(); }
+
+        size_t size() const { return count; }
+        bool empty() const { return count == 0; }
+        /**
+         * @brief Returns the number of values that fit without growing: N while the values are kept inside the object.
+         */
+        size_t capacity() const { return cap; }
+
+        T& operator[](size_t i) { return data()[i]; }
+        const T& operator[](size_t i) const { return data()[i]; }
+        T& at(size_t i)
+        {
+            if(i >= count)
+                throw std::out_of_range("InlineVector::at: index out of range");
+            return data()[i];
+        }
+        const T& at(size_t i) const { return const_cast<InlineVector*>(this)->at(i); }
+        T& front() { return data()[0]; }
+        const T& front() const { return data()[0]; }
+        T& back() { return data()[count - 1]; }
+        const T& back() const { return data()[count - 1]; }
+
+        void reserve(size_t n)
+        {
+            if(n > cap)
+                _Reallocate(n);
+        }
+        /**
+         * @brief Moves the values back inside the object if they fit, or to a heap block of the exact size otherwise.
+         */
+        void shrink_to_fit()
+        {
+            if(cap > N && count < cap)
+                _Reallocate(count);
+        }
+        void clear() { count = 0; }
+        void push_back(const T& value)
+        {
+            if(count == cap)
+            {
+                T copy = value; //value may live in the storage that is reallocated
+                _Reallocate(2 * static_cast<size_t>(cap));
+                data()[count++] = copy;
+                return;
+            }
+            data()[count++] = value;
+        }
+        template <class... Args>
+        T& emplace_back(Args&&... args)
+        {
+            push_back(T(std::forward<Args>(args)...));
+            return back();
+        }
+        void pop_back() { count--; }
+        void resize(size_t n, const T& value = T())
+        {
+            reserve(n);
+            std::fill(data() + std::min<size_t>(count, n), data() + n, value);
+            count = static_cast<uint32_t>(n);
+        }
+        iterator erase(const_iterator position)
+        {
+            T* p = data() + (position - begin());
+            std::memmove(p, p + 1, (end() - p - 1) * sizeof(T));
+            count--;
+            return p;
+        }
+        template <class It>
+        void assign(It first, It last)
+        {
+            size_t n = std::distance(first, last);
+            count = 0;
+            reserve(n);
+            std::copy(first, last, data());
+            count = static_cast<uint32_t>(n);
+        }
+
+        friend bool operator==(const InlineVector& a, const InlineVector& b) { return std::equal(a.begin(), a.end(), b.begin(), b.end()); }
+        friend bool operator==(const InlineVector& a, const std::vector<T>& b) { return std::equal(a.begin(), a.end(), b.begin(), b.end()); }
+
+    private:
+        //moves the values to storage for n values (inside the object if n <= N)
+        void _Reallocate(size_t n)
+        {
+            T* fresh = (n > N) ? new T[n] : nullptr;
+            T moved[N];
+            T* target = (fresh != nullptr) ? fresh : moved;
+            std::memcpy(static_cast<void*>(target), data(), count * sizeof(T));
+            _Release();
+            if(fresh != nullptr)
+            {
+                heap = fresh;
+                cap = static_cast<uint32_t>(n);
+            }
+            else
+            {
+                std::memcpy(static_cast<void*>(local), moved, count * sizeof(T));
+                cap = N;
+            }
+        }
+        void _Release()
+        {
+            if(cap > N)
+                delete[] heap;
+            cap = N;
+        }
+        //takes over the values of other (which is left empty); this must not own a heap block
+        void _Take(InlineVector& other)
+        {
+            if(other.cap > N)
+                heap = other.heap;
+            else
+                std::memcpy(static_cast<void*>(local), other.local, other.count * sizeof(T));
+            cap = other.cap;
+            count = other.count;
+            other.cap = N;
+            other.count = 0;
+        }
+
+        union {
+            T local[N]; /**< The values, while there are at most N of them (cap == N) */
+            T* heap; /**< The values, once they moved to the heap (cap > N) */
+        };
+        uint32_t count = 0; /**< Number of values */
+        uint32_t cap = N; /**< Number of values that fit into local or heap */
+    };
+}
+
+#endif
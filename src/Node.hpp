@@ -36,14 +36,17 @@ namespace sys_sage {
         /**
          * Refreshes the CPU core frequency of the node.
          * @param keep_history - If true, the history of the CPU core frequency will be kept.
+         * @param columns - If not nullptr, the frequencies are also written into its "freq" column of the Cores (see ColumnStore).
+         * @param epochs - If not nullptr, "freq_history" and the columns are updated in an EpochManager::WriteGuard of epochs, so that readers in its ReadGuards can access them concurrently.
+         * Without epochs, only the frequency itself (GetFreq()) may be read concurrently, i.e. a refresh with keep_history == false and columns == nullptr is the only reader-safe one.
          */
-        int RefreshCpuCoreFrequency(bool keep_history = false);
+        int RefreshCpuCoreFrequency(bool keep_history = false, ColumnStore* columns = nullptr, EpochManager* epochs = nullptr);
     #endif
     #ifdef INTEL_PQOS //defined in intel_pqos.cpp
     public:
         /**
         \n Creates/updates (bidirectional) data paths between all cores (class Thread) and their L3 cache segment (class Cache). The data paths of type SYS_SAGE_DATAPATH_TYPE_L3CAT contain the COS id (attrib with key "CATcos", value is of type uint64_t*) and the open L3 cache ways (attrib with key "CATL3mask", value is of type uint64_t*) to contain the current settings.
-        \n Each time the method is called, new DataPath objects get created, so the last one is always the most up-to-date.
+        \n The first call creates the DataPaths; later calls overwrite their attributes in place (see Component::UpsertDataPath()), without allocating.
         
         Note: This function is defined only when sys-sage is compiled with INTEL_PQOS functionality (only for Intel CPUs).
         */
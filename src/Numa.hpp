@@ -50,7 +50,7 @@ namespace sys_sage {
         !!Should normally not be used!! Helper function of XML dump generation.
         @see exportToXml(Component* root, string path = "", std::function<int(string,void*,string*)> custom_search_attrib_key_fcn = NULL);
         */
-        xmlNodePtr _CreateXmlSubtree() override;
+        xmlNodePtr _CreateXmlNode() override;
     private:
         long long size; /**< size of the Numa memory segment.*/
     };
@@ -0,0 +1,164 @@
+#include "ParallelTraversal.hpp"
+
+#include "Component.hpp"
+
+namespace {
+    thread_local bool insideTask = false; /**< true on pool workers and on a thread running a batch; nested batches run serially */
+}
+
+sys_sage::WorkStealingPool::WorkStealingPool(unsigned numThreads)
+{
+    if(numThreads == 0)
+        numThreads = std::thread::hardware_concurrency();
+    if(numThreads == 0)
+        numThreads = 1;
+    for(unsigned i = 0; i < numThreads; i++)
+        queues.push_back(std::make_unique<Queue>());
+    for(unsigned i = 1; i < numThreads; i++)
+        threads.emplace_back(&WorkStealingPool::_WorkerLoop, this, i);
+}
+
+sys_sage::WorkStealingPool::~WorkStealingPool()
+{
+    stopping = true;
+    generation++;
+    generation.notify_all();
+    for(std::thread& t : threads)
+        t.join();
+}
+
+unsigned sys_sage::WorkStealingPool::GetNumThreads() const { return static_cast<unsigned>(queues.size()); }
+
+sys_sage::WorkStealingPool* sys_sage::WorkStealingPool::GetDefault()
+{
+    static WorkStealingPool defaultPool;
+    return &defaultPool;
+}
+
+void sys_sage::WorkStealingPool::Run(size_t numTasks, const std::function<void(size_t)>& task)
+{
+    if(numTasks <= 1 || threads.empty() || insideTask)
+    {
+        for(size_t i = 0; i < numTasks; i++)
+            task(i);
+        return;
+    }
+
+    std::lock_guard<std::mutex> runLock(runMutex);
+    currentTask = &task;
+    remaining = numTasks;
+    //contiguous blocks keep neighbouring pieces (which often share cache lines of their parents) on one worker
+    size_t numQueues = queues.size();
+    for(size_t q = 0; q < numQueues; q++)
+    {
+        std::lock_guard<std::mutex> lock(queues[q]->mutex);
+        for(size_t i = q * numTasks / numQueues; i < (q + 1) * numTasks / numQueues; i++)
+            queues[q]->tasks.push_back(i);
+    }
+    generation++;
+    generation.notify_all();
+
+    insideTask = true;
+    _Work(0);
+    insideTask = false;
+    //tasks stolen by other workers may still be running
+    for(size_t left = remaining.load(); left != 0; left = remaining.load())
+        remaining.wait(left);
+    currentTask = nullptr;
+}
+
+void sys_sage::WorkStealingPool::_WorkerLoop(unsigned worker)
+{
+    insideTask = true;
+    uint64_t seenGeneration = 0;
+    while(true)
+    {
+        generation.wait(seenGeneration);
+        if(stopping)
+            return;
+        seenGeneration = generation.load();
+        _Work(worker);
+    }
+}
+
+void sys_sage::WorkStealingPool::_Work(unsigned worker)
+{
+    size_t task;
+    while(_Pop(worker, &task))
+    {
+        (*currentTask)(task);
+        if(remaining.fetch_sub(1) == 1)
+            remaining.notify_all();
+    }
+}
+
+bool sys_sage::WorkStealingPool::_Pop(unsigned worker, size_t* task)
+{
+    {
+        Queue& own = *queues[worker];
+        std::lock_guard<std::mutex> lock(own.mutex);
+        if(!own.tasks.empty())
+        {
+            *task = own.tasks.front();
+            own.tasks.pop_front();
+            return true;
+        }
+    }
+    for(size_t i = 1; i < queues.size(); i++)
+    {
+        Queue& victim = *queues[(worker + i) % queues.size()];
+        std::lock_guard<std::mutex> lock(victim.mutex);
+        if(!victim.tasks.empty())
+        {
+            *task = victim.tasks.back();
+            victim.tasks.pop_back();
+            return true;
+        }
+    }
+    return false;
+}
+
+sys_sage::ParallelTraversal::ParallelTraversal(WorkStealingPool* _pool, size_t _serialThreshold, int _maxSplitDepth) :
+    pool(_pool != nullptr ? _pool : WorkStealingPool::GetDefault()), serialThreshold(_serialThreshold), maxSplitDepth(_maxSplitDepth) {}
+
+sys_sage::WorkStealingPool* sys_sage::ParallelTraversal::GetPool() const { return pool; }
+size_t sys_sage::ParallelTraversal::GetSerialThreshold() const { return serialThreshold; }
+
+std::vector<sys_sage::ParallelTraversal::Piece> sys_sage::ParallelTraversal::Partition(Component* root) const
+{
+    std::vector<Piece> pieces { { root, true } };
+    if(root == nullptr || pool->GetNumThreads() <= 1)
+        return pieces;
+    //stops counting at the threshold, so that the check costs at most serialThreshold steps
+    size_t size = 0;
+    for([[maybe_unused]] Component* c : root->TraversePreOrder())
+        if(++size >= serialThreshold)
+            break;
+    if(size < serialThreshold)
+        return pieces;
+
+    //replace each whole-subtree piece by its root and the subtrees of its children, level by level
+    size_t targetPieces = static_cast<size_t>(pool->GetNumThreads()) * 8;
+    for(int level = 0; level < maxSplitDepth && pieces.size() < targetPieces; level++)
+    {
+        std::vector<Piece> next;
+        bool split = false;
+        for(const Piece& piece : pieces)
+        {
+            const std::vector<Component*>& children = piece.root->GetChildren();
+            if(!piece.wholeSubtree || children.empty())
+            {
+                next.push_back(piece);
+                continue;
+            }
+            next.push_back({ piece.root, false });
+            for(Component* child : children)
+                next.push_back({ child, true });
+            split = true;
+        }
+        pieces.swap(next);
+        if(!split)
+            break;
+    }
+    return pieces;
+}
@@ -0,0 +1,145 @@
+#ifndef PARALLEL_TRAVERSAL_HPP
+#define PARALLEL_TRAVERSAL_HPP
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace sys_sage { //forward declaration
+    class Component;
+}
+
+namespace sys_sage {
+
+    /**
+     * @class WorkStealingPool
+     * @brief Fixed-size pool of worker threads that runs batches of independent tasks.
+     *
+     * Run() distributes the tasks of a batch in contiguous blocks over per-worker queues; a worker takes tasks from the front of its own queue and, when that is empty, steals from the back of the other queues.
+     * The calling thread takes part in the work as one of the workers. The worker threads sleep between batches.
+     * \n Batches from different threads are run one after another. Run() called from within a task runs the nested batch serially on the calling worker.
+     */
+    class WorkStealingPool {
+    public:
+        /**
+         * @brief Starts the worker threads.
+         * @param numThreads Number of threads working on a batch, including the thread calling Run(); 0 (default) = std::thread::hardware_concurrency()
+         */
+        WorkStealingPool(unsigned numThreads = 0);
+        /**
+         * @brief Stops and joins the worker threads.
+         */
+        ~WorkStealingPool();
+        WorkStealingPool(const WorkStealingPool&) = delete;
+        WorkStealingPool& operator=(const WorkStealingPool&) = delete;
+
+        /**
+         * @brief Returns the number of threads working on a batch (including the thread calling Run()).
+         */
+        unsigned GetNumThreads() const;
+        /**
+         * @brief Runs task(0) ... task(numTasks-1) on the pool and returns when all of them have finished.
+         * The tasks may run concurrently and in any order.
+         * @param numTasks Number of tasks
+         * @param task Function called with the index of each task
+         */
+        void Run(size_t numTasks, const std::function<void(size_t)>& task);
+
+        /**
+         * @brief Returns a process-wide pool with std::thread::hardware_concurrency() threads, created on first use.
+         */
+        static WorkStealingPool* GetDefault();
+
+    private:
+        struct Queue {
+            std::mutex mutex;
+            std::deque<size_t> tasks;
+        };
+
+        void _WorkerLoop(unsigned worker);
+        void _Work(unsigned worker);
+        bool _Pop(unsigned worker, size_t* task);
+
+        std::vector<std::thread> threads; /**< worker threads 1..n-1 (worker 0 is the thread calling Run()) */
+        std::vector<std::unique_ptr<Queue>> queues; /**< one task queue per worker */
+        std::mutex runMutex; /**< serializes batches */
+        std::atomic<uint64_t> generation { 0 }; /**< number of batches started so far; the workers wait for it to change */
+        std::atomic<bool> stopping { false };
+        const std::function<void(size_t)>* currentTask { nullptr }; /**< task of the current batch */
+        std::atomic<size_t> remaining { 0 }; /**< tasks of the current batch that have not finished yet; Run() waits for it to reach 0 */
+    };
+
+    /**
+     * @class ParallelTraversal
+     * @brief Settings for parallel whole-subtree operations, such as Component::FindDescendantsByType(), Component::CalcSubtreeSize() and Component::PrintRelationsInSubtree() with a ParallelTraversal argument.
+     *
+     * The subtree is split at its top levels (e.g. Topology -> Node, Node -> Chip) into pieces: the split Components themselves, and the whole subtrees of their children.
+     * The pieces are processed on a WorkStealingPool, and their results are combined in the order of the pieces, so that the results are in the same (pre-order) order as with the serial functions.
+     * Subtrees with fewer than serialThreshold Components are processed serially.
+     */
+    class ParallelTraversal {
+    public:
+        /**
+         * @brief Default minimum number of Components of a subtree for parallel processing.
+         */
+        static constexpr size_t defaultSerialThreshold = 32768;
+
+        /**
+         * @brief Part of a subtree processed by one task.
+         */
+        struct Piece {
+            Component* root; /**< root of the piece */
+            bool wholeSubtree; /**< true: the piece is the whole subtree of root; false: the piece is root only (its children are separate pieces) */
+        };
+
+        /**
+         * @param _pool Pool to run on; nullptr (default) = WorkStealingPool::GetDefault()
+         * @param _serialThreshold Subtrees with fewer Components are processed serially
+         * @param _maxSplitDepth Maximum number of tree levels that are split into pieces
+         */
+        ParallelTraversal(WorkStealingPool* _pool = nullptr, size_t _serialThreshold = defaultSerialThreshold, int _maxSplitDepth = 4);
+
+        /**
+         * @brief Returns the pool the pieces are processed on.
+         */
+        WorkStealingPool* GetPool() const;
+        /**
+         * @brief Returns the minimum number of Components of a subtree for parallel processing.
+         */
+        size_t GetSerialThreshold() const;
+
+        /**
+         * @brief Splits the subtree of root into pieces, in pre-order: visiting the pieces in order (a piece with wholeSubtree in pre-order) visits the subtree in pre-order.
+         * Levels are split until there are enough pieces for the pool (or _maxSplitDepth levels were split). A subtree smaller than the serial threshold is returned as a single piece.
+         * @param root Root of the subtree
+         */
+        std::vector<Piece> Partition(Component* root) const;
+
+        /**
+         * @brief Calls pieceFn on each piece of the subtree of root (see Partition()) on the pool, and returns the results in the order of the pieces.
+         * @param root Root of the subtree
+         * @param pieceFn Function called (concurrently) as Result pieceFn(const Piece&)
+         */
+        template <class Result, class PieceFn>
+        std::vector<Result> MapPieces(Component* root, PieceFn&& pieceFn) const
+        {
+            std::vector<Piece> pieces = Partition(root);
+            std::vector<Result> results(pieces.size());
+            pool->Run(pieces.size(), [&pieces, &results, &pieceFn](size_t i){ results[i] = pieceFn(pieces[i]); });
+            return results;
+        }
+
+    private:
+        WorkStealingPool* pool;
+        size_t serialThreshold;
+        int maxSplitDepth;
+    };
+}
+
+#endif
@@ -1,4 +1,5 @@
 #include "QuantumBackend.hpp"
+#include "Footprint.hpp"
 
 #include "Qubit.hpp"
 
@@ -91,4 +92,4 @@ QDMI_Device sys_sage::QuantumBackend::GetQDMIDevice(){ return device; }
 
 #endif
 
-
+size_t sys_sage::QuantumBackend::_GetMembersHeapSize() const { return Component::_GetMembersHeapSize() + _VectorHeapSize(gate_types); }
@@ -151,7 +151,12 @@ namespace sys_sage {
         !!Should normally not be used!! Helper function of XML dump generation.
         @see exportToXml(Component* root, string path = "", std::function<int(string,void*,string*)> custom_search_attrib_key_fcn = NULL);
         */
-        xmlNodePtr _CreateXmlSubtree() override;
+        xmlNodePtr _CreateXmlNode() override;
+        /**
+         * @private
+         * @brief Returns the heap memory owned by the members of this component (see Component::_GetMembersHeapSize()).
+         */
+        size_t _GetMembersHeapSize() const override;
 
         /** Destructor for QuantumBackend. */
         ~QuantumBackend() override = default;
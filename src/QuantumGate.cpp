@@ -1,5 +1,6 @@
 
 #include "QuantumGate.hpp"
+#include "Footprint.hpp"
 
 #include <iostream>
 
@@ -95,4 +96,4 @@ void sys_sage::QuantumGate::Print() const
     std::cout << std::endl;
 }
 
-
+size_t sys_sage::QuantumGate::_GetMembersHeapSize() const { return Relation::_GetMembersHeapSize() + _StringHeapSize(name) + _StringHeapSize(unitary); }
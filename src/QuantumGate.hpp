@@ -166,6 +166,11 @@ namespace sys_sage {
          * @return Pointer to the created XML entry node.
          */
         xmlNodePtr _CreateXmlEntry() override;
+        /**
+         * @private
+         * @brief Returns the heap memory owned by the members of this quantum gate (see Relation::_GetMembersHeapSize()).
+         */
+        size_t _GetMembersHeapSize() const override;
 
     private:
 
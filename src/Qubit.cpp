@@ -1,4 +1,5 @@
 #include "Qubit.hpp"
+#include "Footprint.hpp"
 
 
 
@@ -23,3 +24,5 @@ double sys_sage::Qubit::Get1QFidelity() const { return q1_fidelity;}
 double sys_sage::Qubit::GetReadoutLength() const { return readout_length; }
 double sys_sage::Qubit::GetFrequency() const { return frequency; }
 const std::string& sys_sage::Qubit::GetCalibrationTime() const { return calibration_time; }
+
+size_t sys_sage::Qubit::_GetMembersHeapSize() const { return Component::_GetMembersHeapSize() + _StringHeapSize(calibration_time); }
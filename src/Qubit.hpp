@@ -100,9 +100,14 @@ namespace sys_sage {
          *
          * Should normally not be used directly. Used internally for exporting the topology to XML.
          * @see exportToXml(Component* root, string path = "", std::function<int(string,void*,string*)> custom_search_attrib_key_fcn = NULL);
-         * @return Pointer to the created XML subtree node.
+         * @return Pointer to the created XML node (without the children of the component).
          */
-        xmlNodePtr _CreateXmlSubtree() override;
+        xmlNodePtr _CreateXmlNode() override;
+        /**
+         * @private
+         * @brief Returns the heap memory owned by the members of this component (see Component::_GetMembersHeapSize()).
+         */
+        size_t _GetMembersHeapSize() const override;
 
         /** Destructor for Qubir. */
         ~Qubit() override = default;
@@ -2,6 +2,13 @@
 #include "Relation.hpp"
 #include <iostream>
 #include "Component.hpp"
+#include "Arena.hpp"
+#include "Footprint.hpp"
+#include "AttribIndex.hpp"
+#include "DataPath.hpp"
+#include "QuantumGate.hpp"
+#include "CouplingMap.hpp"
+#include "DataPathMatrix.hpp"
 
 using std::cout;
 using std::endl;
@@ -15,6 +22,8 @@ sys_sage::Relation::Relation(const std::vector<Component*>& components, int _id,
 }
 sys_sage::Relation::Relation(const std::vector<Component*>& components, int _id, bool _ordered, RelationCategory::type _relation_category): Relation(components, _id, _ordered, sys_sage::RelationType::Relation, _relation_category) {}
 
+sys_sage::Relation::~Relation() { _RemoveFromAttribIndices(this); }
+
 void sys_sage::Relation::SetId(int _id) {id = _id;}
 int sys_sage::Relation::GetId() const{ return id; }
 bool sys_sage::Relation::IsOrdered() const{ return ordered; }
@@ -34,14 +43,45 @@ sys_sage::Component* sys_sage::Relation::GetComponent(int index) const
     }
 }
 
-const std::vector<sys_sage::Component*>& sys_sage::Relation::GetComponents() const { return components; }
+const sys_sage::RelationComponents& sys_sage::Relation::GetComponents() const { return components; }
+
+void sys_sage::Relation::SetAttr(const std::string& key, AttribValue value) { SetAttr(InternAttribKey(key), std::move(value)); }
+void sys_sage::Relation::SetAttr(AttribId key, AttribValue value)
+{
+    attrs.Set(key, std::move(value));
+    _UpdateAttribIndices(this, key);
+}
+void sys_sage::Relation::SetAttrPtr(const std::string& key, void* value, void (*deleter)(void*)) { SetAttr(InternAttribKey(key), AttribPtr(value, deleter)); }
+
+bool sys_sage::Relation::HasAttr(const std::string& key) const
+{
+    AttribId id = FindAttribKey(key);
+    if(id != invalidAttribId && attrs.Find(id) != nullptr)
+        return true;
+    return attrib.find(key) != attrib.end();
+}
+
+bool sys_sage::Relation::EraseAttr(const std::string& key)
+{
+    AttribId id = FindAttribKey(key);
+    if(id == invalidAttribId || !attrs.Erase(id))
+        return false;
+    _UpdateAttribIndices(this, id);
+    return true;
+}
+
+const sys_sage::AttribStore& sys_sage::Relation::GetAttribStore() const { return attrs; }
+void sys_sage::Relation::SetAttrib(const std::string& key, void* value, void (*deleter)(void*)) { _SetOwnedAttrib(attrib, attribOwners, key, value, deleter); }
+bool sys_sage::Relation::EraseAttrib(const std::string& key) { return _EraseOwnedAttrib(attrib, attribOwners, key); }
+bool sys_sage::Relation::OwnsAttrib(const std::string& key) const { return _OwnsAttrib(attrib, attribOwners, key); }
+const sys_sage::AttribStore& sys_sage::Relation::_GetAttribOwners() const { return attribOwners; }
 
 
 
 void sys_sage::Relation::AddComponent(Component* c)
 {
     components.emplace_back(c);
-    c->_AddRelation(type, this);
+    slots.push_back(c->_AddRelation(type, this));
 }
 
 
@@ -75,12 +115,96 @@ void sys_sage::Relation::Print() const
 
 void sys_sage::Relation::Delete()
 {
-    for(Component* c : components)
+    _Unlink();
+    _Free();
+}
+
+void sys_sage::Relation::_Unlink(const Component* skip)
+{
+    //each removal may move another entry of this relation (if a component takes part twice), so the slots are read one by one
+    for(size_t i = 0; i < components.size(); i++)
     {
-        std::vector<Relation*>& component_relation_vector = c->_GetRelationsByType(type);
-        component_relation_vector.erase(std::remove(component_relation_vector.begin(), component_relation_vector.end(), this), component_relation_vector.end());
+        if(components[i] == skip || slots[i] == noSlot)
+            continue;
+        uint32_t slot = slots[i];
+        slots[i] = noSlot;
+        components[i]->_RemoveRelation(type, this, slot);
     }
-    delete this;
+}
+
+void sys_sage::Relation::_MoveSlot(const Component* c, uint32_t oldSlot, uint32_t newSlot)
+{
+    for(size_t i = 0; i < components.size(); i++)
+        if(components[i] == c && slots[i] == oldSlot)
+        {
+            slots[i] = newSlot;
+            return;
+        }
+}
+
+void sys_sage::Relation::_ClearSlots(const Component* c)
+{
+    for(size_t i = 0; i < components.size(); i++)
+        if(components[i] == c)
+            slots[i] = noSlot;
+}
+
+void sys_sage::Relation::_AssignSlot(const Component* c, uint32_t slot)
+{
+    for(size_t i = 0; i < components.size(); i++)
+        if(components[i] == c && slots[i] == noSlot)
+        {
+            slots[i] = slot;
+            return;
+        }
+}
+
+void sys_sage::Relation::_Free()
+{
+    if(slabPool != nullptr)
+    {
+        SlabPool* pool = slabPool;
+        this->~Relation();
+        pool->Free(this);
+    }
+    else
+        delete this;
+}
+void sys_sage::Relation::_SetSlabPool(SlabPool* pool) { slabPool = pool; }
+sys_sage::SlabPool* sys_sage::Relation::_GetSlabPool() const { return slabPool; }
+size_t sys_sage::Relation::_GetMembersHeapSize() const { return _VectorHeapSize(components) + _VectorHeapSize(slots); }
+sys_sage::Relation* sys_sage::Relation::_CloneWith(const std::vector<Component*>& _components) const
+{
+    Relation* copy;
+    switch(type)
+    {
+        case RelationType::DataPath:
+            copy = new DataPath(*static_cast<const DataPath*>(this));
+        break;
+        case RelationType::QuantumGate:
+            copy = new QuantumGate(*static_cast<const QuantumGate*>(this));
+        break;
+        case RelationType::CouplingMap:
+            copy = new CouplingMap(*static_cast<const CouplingMap*>(this));
+        break;
+        case RelationType::DataPathMatrix:
+            copy = new DataPathMatrix(*static_cast<const DataPathMatrix*>(this));
+        break;
+        default:
+            copy = new Relation(*this);
+        break;
+    }
+    copy->slabPool = nullptr;
+    copy->components.clear();
+    copy->slots.clear();
+    copy->components.reserve(_components.size());
+    copy->slots.reserve(_components.size());
+    for(Component* c : _components)
+        copy->AddComponent(c);
+    if(type == RelationType::DataPathMatrix)
+        static_cast<DataPathMatrix*>(copy)->_RebuildIndices();
+    _AddToAttribIndices(copy);
+    return copy;
 }
 sys_sage::RelationType::type sys_sage::Relation::GetType() const{ return type;}
 sys_sage::RelationCategory::type sys_sage::Relation::GetCategory() const{ return category;}
@@ -98,11 +222,13 @@ int sys_sage::Relation::UpdateComponent(int index, Component * _new_component)
         std::cerr << "WARNING: sys_sage::Relation::UpdateComponent index out of bounds -- nothing updated." << std::endl;
         return 1;
     }
-    std::vector<Relation*>& component_relation_vector = components[index]->_GetRelationsByType(type);
-    component_relation_vector.erase(std::remove(component_relation_vector.begin(), component_relation_vector.end(), this), component_relation_vector.end());
+    if(slots[index] != noSlot)
+        components[index]->_RemoveRelation(type, this, slots[index]);
 
-    _new_component->_AddRelation(type, this);
     components[index] = _new_component;
+    slots[index] = _new_component->_AddRelation(type, this);
+    if(type == RelationType::DataPathMatrix)
+        static_cast<DataPathMatrix*>(this)->_RebuildIndices();
     return 0;
 }
 
@@ -122,11 +248,22 @@ int sys_sage::Relation::RemoveComponent(size_t index)
 {
     if (index >= components.size())
         return -1;
+    //the rows and columns of a DataPathMatrix are bound to its components
+    if(type == RelationType::DataPathMatrix)
+    {
+        std::cerr << "WARNING: sys_sage::Relation::RemoveComponent cannot remove a component of a DataPathMatrix -- nothing removed." << std::endl;
+        return -1;
+    }
 
-    std::vector<Relation *> &cRelations = components[index]->_GetRelationsByType(type);
-    cRelations.erase(std::remove(cRelations.begin(), cRelations.end(), this), cRelations.end());
+    if(slots[index] != noSlot)
+        components[index]->_RemoveRelation(type, this, slots[index]);
 
     components.erase(components.begin() + index);
+    slots.erase(slots.begin() + index);
+    //the positions of the remaining components changed (e.g. the target of a DataPath becomes its source)
+    if(type == RelationType::DataPath)
+        for(Component* c : components)
+            c->_InvalidateDataPathIndex();
 
     return 0;
 }
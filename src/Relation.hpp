@@ -12,6 +12,7 @@
  * to represent specific types of connections.
  */
 
+#include <cstdint>
 #include <map>
 #include <vector>
 #include <string>
@@ -19,15 +20,23 @@
 
 #include "defines.hpp"
 #include "enums.hpp"
+#include "Attrib.hpp"
+#include "InlineVector.hpp"
 
 namespace sys_sage { //forward declaration
     class Component;
+    class SlabPool;
     class Qubit;
     struct CpuMetrics;
 }
 
 namespace sys_sage {
 
+    /**
+     * @brief The components of a Relation: up to two of them (e.g. the source and target of a DataPath) are kept inside the Relation object, without a heap allocation.
+     */
+    using RelationComponents = InlineVector<Component*, 2>;
+
     /**
      * @class Relation
      * @brief Abstract base class representing a multi-way connection among Components.
@@ -102,11 +111,98 @@ namespace sys_sage {
         Component* GetComponent(int index) const;
         /**
          * @brief Access the list of components.
-         * @return Read-only reference to the component vector.
+         * @return Read-only reference to the components (converts to a std::vector<Component*>, which copies them).
          * 
          * This avoids copying and prevents direct modification.
          */
-        const std::vector<Component*>& GetComponents() const;
+        const RelationComponents& GetComponents() const;
+        /**
+         * @brief Returns a pointer to the value of the attribute key, looking it up in the typed attributes first (see SetAttr()) and in the attrib map second.
+         * \n For T being int, int64_t, double, std::string or std::vector<double>, a typed value is only returned if it holds a T. Opaque typed values and values of the attrib map are cast to T* without a check.
+         * @param key Name of the attribute
+         * @return Pointer to the value, or nullptr if the attribute does not exist
+         * @see Component::GetAttr()
+         */
+        template <class T>
+        T* GetAttr(const std::string& key) { return _GetAttr<T>(attrs, attrib, FindAttribKey(key), &key); }
+        template <class T>
+        const T* GetAttr(const std::string& key) const { return _GetAttr<T>(attrs, attrib, FindAttribKey(key), &key); }
+        /**
+         * @brief Returns a pointer to the value of the attribute with the interned key (see GetAttr(const std::string&)).
+         * @param key AttribId returned by InternAttribKey()
+         */
+        template <class T>
+        T* GetAttr(AttribId key) { return _GetAttr<T>(attrs, attrib, key, nullptr); }
+        template <class T>
+        const T* GetAttr(AttribId key) const { return _GetAttr<T>(attrs, attrib, key, nullptr); }
+        /**
+         * @brief Sets the typed attribute key (see Component::SetAttr()).
+         */
+        void SetAttr(const std::string& key, AttribValue value);
+        /**
+         * @brief Sets the typed attribute with the interned key (see Component::SetAttr()).
+         */
+        void SetAttr(AttribId key, AttribValue value);
+        /**
+         * @brief Sets the typed attribute key to an opaque value that is freed with deleter when the attribute is replaced or erased, or the relation is deleted.
+         */
+        void SetAttrPtr(const std::string& key, void* value, void (*deleter)(void*));
+        /**
+         * @brief Sets the typed attribute key to an opaque value allocated with new.
+         */
+        template <class T>
+        void SetAttrPtr(const std::string& key, T* value) { SetAttrPtr(key, value, [](void* p){ delete static_cast<T*>(p); }); }
+        /**
+         * @brief Returns whether the attribute key exists, either as a typed attribute or in the attrib map.
+         */
+        bool HasAttr(const std::string& key) const;
+        /**
+         * @brief Removes the typed attribute key and releases its value. Entries of the attrib map are not affected.
+         * @return Whether the typed attribute existed
+         */
+        bool EraseAttr(const std::string& key);
+        /**
+         * @brief Returns the typed attributes of this relation.
+         */
+        const AttribStore& GetAttribStore() const;
+        /**
+         * @brief Sets attrib[key] to value and takes ownership of it: the value is freed with deleter when it is replaced by SetAttrib(), removed by EraseAttrib(), or when the relation is deleted.
+         * A previous value of key is freed if it is owned, and left alone otherwise (values written to attrib directly are never freed by sys-sage).
+         * Copies of the relation (e.g. made by Component::Clone()) share the owned values; a value is freed with the last of them.
+         * @note Do not free an owned value yourself, and do not overwrite it by writing to attrib directly -- use SetAttrib() or EraseAttrib().
+         */
+        void SetAttrib(const std::string& key, void* value, void (*deleter)(void*));
+        /**
+         * @brief Sets attrib[key] to a value allocated with new and takes ownership of it (see SetAttrib(const std::string&, void*, void(*)(void*))).
+         */
+        template <class T>
+        void SetAttrib(const std::string& key, T* value) { SetAttrib(key, value, [](void* p){ delete static_cast<T*>(p); }); }
+        /**
+         * @brief Removes attrib[key], freeing its value if it is owned (see SetAttrib()).
+         * @return Whether attrib contained key
+         */
+        bool EraseAttrib(const std::string& key);
+        /**
+         * @brief Returns whether attrib[key] is owned by this relation, i.e. was set with SetAttrib() (and not overwritten directly since).
+         */
+        bool OwnsAttrib(const std::string& key) const;
+        /**
+         * @brief Assigns value to the owned value of attrib[key] in place, or sets attrib[key] to a new T(value) (see SetAttrib()) if the relation does not own one -- so that repeated updates of an attribute allocate only once.
+         * The owned value must be a T (this is not checked, like the attrib map itself).
+         */
+        template <class T>
+        void UpdateAttrib(const std::string& key, const T& value)
+        {
+            if(OwnsAttrib(key))
+                *static_cast<T*>(attrib[key]) = value;
+            else
+                SetAttrib(key, new T(value));
+        }
+        /**
+         * @private
+         * @brief Returns the owners of the values of attrib set with SetAttrib().
+         */
+        const AttribStore& _GetAttribOwners() const;
         /**
          * @brief Virtual function to print the details of the relationship.
          * 
@@ -156,7 +252,7 @@ namespace sys_sage {
          * 
          * @param index The index of interest.
          *
-         * @return 0 on success, -1 otherwise.
+         * @return 0 on success, -1 otherwise (also for a DataPathMatrix, whose rows and columns are bound to its components).
          */
         int RemoveComponent(size_t index);
 
@@ -171,15 +267,68 @@ namespace sys_sage {
         /**
          * @brief Virtual function to delete the relation.
          *
+         * The owned attribute values (see SetAttrib()) are freed.
+         * The relation is removed from the relation list of each of its components in O(1): the last relation of the list takes its place, so the order of the list changes.
          * Should be overridden in subclasses if custom destruction logic is needed.
          */
         virtual void Delete();//TODO
+        /**
+         * @private
+         * @brief Removes this relation from the relation lists of its components, except from the lists of skip (which the caller updates itself).
+         */
+        void _Unlink(const Component* skip = nullptr);
+        /**
+         * @private
+         * @brief Frees this relation (returning its memory to its SlabPool, if any) without touching the relation lists of its components (see _Unlink()).
+         */
+        void _Free();
+        /**
+         * @private
+         * @brief Updates the position of this relation in the relation list of c from oldSlot to newSlot (after Component::_RemoveRelation() moved it).
+         */
+        void _MoveSlot(const Component* c, uint32_t oldSlot, uint32_t newSlot);
+        /**
+         * @private
+         * @brief Marks all entries of c as not listed (while c rebuilds its relation list, see Component::_ReindexRelations()).
+         */
+        void _ClearSlots(const Component* c);
+        /**
+         * @private
+         * @brief Sets the first unlisted entry of c to slot, if c has one. Used by Component::_ReindexRelations().
+         */
+        void _AssignSlot(const Component* c, uint32_t slot);
         /**
          * @brief Destructor for the Relation class.
          * 
          * This is a virtual destructor to ensure proper cleanup of derived classes.
          */
-        virtual ~Relation() = default;
+        virtual ~Relation();
+
+        /**
+         * @private
+         * @brief Only called by Arena::New() -- marks the relation as allocated from the given SlabPool (instead of with new).
+         * @param pool SlabPool holding this relation
+         */
+        void _SetSlabPool(SlabPool* pool);
+        /**
+         * @private
+         * @brief Returns the SlabPool this relation was allocated from, or nullptr if it was allocated with new.
+         */
+        SlabPool* _GetSlabPool() const;
+        /**
+         * @private
+         * @brief Creates a copy of this relation (of the same class, with the same attributes and attrib map) that connects the given components instead, and adds it to their Relations.
+         * Used by Component::Clone() and Component::MakeWritable().
+         * @param _components The components of the copy; one for each component of this relation, in the same order
+         * @return The copy
+         */
+        Relation* _CloneWith(const std::vector<Component*>& _components) const;
+        /**
+         * @private
+         * @brief Returns the heap memory owned by the members of this relation (its component vector and the members of its class), without its attributes.
+         * Overridden by the classes with further heap-allocated members. Used by Component::CalcFootprint().
+         */
+        virtual size_t _GetMembersHeapSize() const;
 
 #ifdef SS_PAPI
         /**
@@ -325,9 +474,31 @@ namespace sys_sage {
          * @brief A vector of components associated with the relationship.
          * 
          * This member variable holds pointers to components that are part of
-         * the relationship.
+         * the relationship (the first two inline, see RelationComponents).
+         */
+        RelationComponents components;
+        /**
+         * @brief Position of this relation in the relation list (of its type) of each component, in the order of components, so that it is removed from the lists in O(1) (see Component::_RemoveRelation()).
+         * noSlot for entries that are not listed, e.g. the target of a DataPath from a component to itself.
+         */
+        InlineVector<uint32_t, 2> slots;
+        static constexpr uint32_t noSlot = UINT32_MAX;
+
+        /**
+         * @brief SlabPool of the Arena this relation was allocated from (nullptr if allocated with new).
+         *
+         * Delete() returns the memory to this pool.
          */
-        std::vector<Component*> components;
+        SlabPool* slabPool { nullptr };
+
+        /**
+         * @brief Typed attributes of the relation. @see SetAttr()
+         */
+        AttribStore attrs;
+        /**
+         * @brief Owners (AttribPtr) of the values of attrib set with SetAttrib(), by key; they free the values when released. @see SetAttrib()
+         */
+        AttribStore attribOwners;
 
     public:
         /**
@@ -396,9 +567,17 @@ namespace sys_sage {
         * }
         * ```
         * 
+        * 6. Letting the relation own the value (freed on overwrite, EraseAttrib() and deletion of the relation):
+        * 
+        * ```cpp
+        * SetAttrib("exampleKey", new int(42));
+        * SetAttrib("exampleKey", new int(100)); // frees the old value
+        * EraseAttrib("exampleKey"); // frees the value
+        * ```
+        * 
         * Note:
         * - Proper memory management is crucial when using `void*` pointers. Always ensure
-        *   that dynamically allocated memory is freed when no longer needed.
+        *   that dynamically allocated memory is freed when no longer needed -- or use SetAttrib().
         * - Type safety is not enforced, so it is important to cast pointers to the correct
         *   type when retrieving values from the map.
         */
@@ -0,0 +1,264 @@
+#include "SubtreeIndex.hpp"
+
+#include <bit>
+#include <numeric>
+
+#include "Component.hpp"
+#include "Footprint.hpp"
+
+std::atomic<size_t> sys_sage::SubtreeIndex::numInstances { 0 };
+std::atomic<sys_sage::SubtreeIndex::LabelSlotChunk*> sys_sage::SubtreeIndex::labelSlotChunks[maxLabelSlotChunks] {};
+uint32_t sys_sage::SubtreeIndex::numLabelSlots = 0;
+std::vector<uint32_t> sys_sage::SubtreeIndex::freeLabelSlots;
+std::mutex sys_sage::SubtreeIndex::labelMutex;
+
+sys_sage::SubtreeIndex::SubtreeIndex(Component* _root) : root(_root) { numInstances++; }
+sys_sage::SubtreeIndex::~SubtreeIndex()
+{
+    _ReleaseLabelStamp();
+    numInstances--;
+}
+
+size_t sys_sage::SubtreeIndex::_GetNumInstances() { return numInstances.load(std::memory_order_relaxed); }
+
+const std::vector<sys_sage::Component*>& sys_sage::SubtreeIndex::GetComponentsByType(ComponentType::type componentType)
+{
+    if(!valid)
+        _Rebuild();
+    if(componentType == ComponentType::Any)
+        return all;
+
+    auto it = byType.find(componentType);
+    if(it == byType.end())
+    {
+        static const std::vector<Component*> empty;
+        return empty;
+    }
+    return it->second;
+}
+
+size_t sys_sage::SubtreeIndex::CountComponentsByType(ComponentType::type componentType)
+{
+    return GetComponentsByType(componentType).size();
+}
+
+sys_sage::Component* sys_sage::SubtreeIndex::GetComponentById(int id, ComponentType::type componentType)
+{
+    if(!idsValid)
+        _RebuildIds();
+    auto it = byId.find(_IdKey(id, componentType));
+    if(it == byId.end())
+        return nullptr;
+    return it->second;
+}
+
+void sys_sage::SubtreeIndex::Invalidate()
+{
+    valid = false;
+    idsValid = false;
+    if(labelsValid.exchange(false))
+    {
+        //the labels on the components are no longer current
+        const LabelSlotChunk* chunk = _GetLabelSlotChunk(static_cast<uint32_t>(labelStamp >> 32));
+        const_cast<LabelSlotChunk*>(chunk)->generations[(labelStamp >> 32) % labelSlotChunkSize].fetch_add(1, std::memory_order_release);
+    }
+}
+
+bool sys_sage::SubtreeIndex::IsValid() const { return valid; }
+sys_sage::Component* sys_sage::SubtreeIndex::GetRoot() const { return root; }
+size_t sys_sage::SubtreeIndex::GetFootprint() const
+{
+    size_t size = sizeof(SubtreeIndex) + _VectorHeapSize(all) + _UnorderedMapHeapSize(byType) + _UnorderedMapHeapSize(byId) + _VectorHeapSize(labelOrder) + _VectorHeapSize(labelDepths) + _VectorHeapSize(rangeMinimum);
+    for(const auto& [componentType, components] : byType)
+        size += _VectorHeapSize(components);
+    for(const std::vector<uint32_t>& level : rangeMinimum)
+        size += _VectorHeapSize(level);
+    return size;
+}
+
+void sys_sage::SubtreeIndex::_OnSubtreeInserted(Component* child, bool appendedInPreOrder)
+{
+    if(!appendedInPreOrder)
+    {
+        Invalidate();
+        return;
+    }
+    //components appended at the end of the pre-order never shadow an existing (earlier) entry
+    if(valid)
+        _AddSubtree(child);
+    if(idsValid)
+        _AddSubtreeIds(child);
+    if(labelsValid)
+    {
+        //the new labels follow all existing ones; only the subtrees of the ancestors of child grow
+        uint32_t depth = 0;
+        for(Component* ancestor = child->GetParent(); ancestor != root; ancestor = ancestor->GetParent())
+            depth++;
+        _LabelSubtree(child, depth + 1);
+        uint32_t end = static_cast<uint32_t>(labelOrder.size());
+        for(Component* ancestor = child->GetParent(); ancestor != root; ancestor = ancestor->GetParent())
+            ancestor->_SetIntervalLabelEnd(end);
+        root->_SetIntervalLabelEnd(end);
+        rangeMinimumValid = false;
+    }
+}
+
+void sys_sage::SubtreeIndex::_OnSubtreeRemoved([[maybe_unused]] Component* child)
+{
+    Invalidate();
+}
+
+void sys_sage::SubtreeIndex::_OnIdChanged(Component* c, int oldId)
+{
+    if(!idsValid)
+        return;
+    auto oldEntry = byId.find(_IdKey(oldId, c->GetComponentType()));
+    if(oldEntry != byId.end() && oldEntry->second == c)
+    {
+        //another component with the old id may have been shadowed by c
+        idsValid = false;
+        return;
+    }
+    auto [newEntry, inserted] = byId.emplace(_IdKey(c->GetId(), c->GetComponentType()), c);
+    if(!inserted && newEntry->second != c) //unknown which of the two comes first in pre-order
+        idsValid = false;
+}
+
+uint64_t sys_sage::SubtreeIndex::_IdKey(int id, ComponentType::type componentType)
+{
+    return (static_cast<uint64_t>(static_cast<uint32_t>(componentType)) << 32) | static_cast<uint32_t>(id);
+}
+
+void sys_sage::SubtreeIndex::_Rebuild()
+{
+    all.clear();
+    for(auto& [componentType, components] : byType)
+        components.clear();
+    _AddSubtree(root);
+    valid = true;
+}
+
+void sys_sage::SubtreeIndex::_RebuildIds()
+{
+    byId.clear();
+    _AddSubtreeIds(root);
+    idsValid = true;
+}
+
+void sys_sage::SubtreeIndex::_AddSubtreeIds(Component* subtreeRoot)
+{
+    for(Component* c : subtreeRoot->TraversePreOrder())
+        byId.emplace(_IdKey(c->GetId(), c->GetComponentType()), c);
+}
+
+void sys_sage::SubtreeIndex::_AddSubtree(Component* subtreeRoot)
+{
+    for(Component* c : subtreeRoot->TraversePreOrder())
+    {
+        all.push_back(c);
+        byType[c->GetComponentType()].push_back(c);
+    }
+}
+
+void sys_sage::SubtreeIndex::UpdateIntervalLabels()
+{
+    if(labelsValid.load(std::memory_order_acquire))
+        return;
+    std::lock_guard<std::mutex> lock(labelMutex);
+    //another query may have labelled the subtree meanwhile
+    if(labelsValid.load(std::memory_order_relaxed))
+        return;
+    //a new stamp invalidates the labels left on components that are no longer part of the subtree
+    uint32_t slot;
+    if(labelStamp != 0)
+        slot = static_cast<uint32_t>(labelStamp >> 32);
+    else if(!freeLabelSlots.empty())
+    {
+        slot = freeLabelSlots.back();
+        freeLabelSlots.pop_back();
+    }
+    else
+    {
+        //without a free slot, the subtree stays unlabelled and the queries walk up the parents
+        if(numLabelSlots == labelSlotChunkSize * maxLabelSlotChunks)
+            return;
+        slot = numLabelSlots++;
+        if(slot % labelSlotChunkSize == 0)
+            labelSlotChunks[slot / labelSlotChunkSize].store(new LabelSlotChunk(), std::memory_order_release);
+    }
+    LabelSlotChunk* chunk = const_cast<LabelSlotChunk*>(_GetLabelSlotChunk(slot));
+    chunk->owners[slot % labelSlotChunkSize].store(this, std::memory_order_release);
+    uint32_t generation = chunk->generations[slot % labelSlotChunkSize].load(std::memory_order_relaxed) + 1;
+    labelStamp = (static_cast<uint64_t>(slot) << 32) | generation;
+    labelOrder.clear();
+    labelDepths.clear();
+    _LabelSubtree(root, 0);
+    rangeMinimumValid.store(false, std::memory_order_relaxed);
+    //publishing the generation makes the labels current (release: after all of them are written)
+    chunk->generations[slot % labelSlotChunkSize].store(generation, std::memory_order_release);
+    labelsValid.store(true, std::memory_order_release);
+}
+
+bool sys_sage::SubtreeIndex::AreIntervalLabelsValid() const { return labelsValid.load(std::memory_order_acquire); }
+
+uint64_t sys_sage::SubtreeIndex::_GetLabelStamp() const { return labelStamp; }
+
+void sys_sage::SubtreeIndex::_ReleaseLabelStamp()
+{
+    if(labelStamp == 0)
+        return;
+    std::lock_guard<std::mutex> lock(labelMutex);
+    uint32_t slot = static_cast<uint32_t>(labelStamp >> 32);
+    LabelSlotChunk* chunk = const_cast<LabelSlotChunk*>(_GetLabelSlotChunk(slot));
+    chunk->owners[slot % labelSlotChunkSize].store(nullptr, std::memory_order_release);
+    chunk->generations[slot % labelSlotChunkSize].fetch_add(1, std::memory_order_release);
+    freeLabelSlots.push_back(slot);
+    labelStamp = 0;
+}
+
+void sys_sage::SubtreeIndex::_LabelSubtree(Component* subtreeRoot, uint32_t depth)
+{
+    Component::WalkSubtree(subtreeRoot, [this, depth](Component* c, int d){
+        uint32_t first = static_cast<uint32_t>(labelOrder.size());
+        c->_SetIntervalLabel(labelStamp, first, first + 1);
+        labelOrder.push_back(c);
+        labelDepths.push_back(depth + d);
+    }, [this](Component* c, int){
+        c->_SetIntervalLabelEnd(static_cast<uint32_t>(labelOrder.size()));
+    });
+}
+
+void sys_sage::SubtreeIndex::_BuildRangeMinimum()
+{
+    size_t n = labelOrder.size();
+    rangeMinimum.assign(1, std::vector<uint32_t>(n));
+    std::iota(rangeMinimum[0].begin(), rangeMinimum[0].end(), 0);
+    for(size_t k = 1; (size_t(1) << k) <= n; k++)
+    {
+        const std::vector<uint32_t>& prev = rangeMinimum[k - 1];
+        size_t half = size_t(1) << (k - 1);
+        std::vector<uint32_t> level(n - 2 * half + 1);
+        for(size_t i = 0; i < level.size(); i++)
+        {
+            uint32_t a = prev[i], b = prev[i + half];
+            level[i] = labelDepths[b] < labelDepths[a] ? b : a;
+        }
+        rangeMinimum.push_back(std::move(level));
+    }
+    rangeMinimumValid.store(true, std::memory_order_release);
+}
+
+sys_sage::Component* sys_sage::SubtreeIndex::_FindLowestCommonAncestor(uint32_t first, uint32_t second)
+{
+    if(!rangeMinimumValid.load(std::memory_order_acquire))
+    {
+        std::lock_guard<std::mutex> lock(labelMutex);
+        if(!rangeMinimumValid.load(std::memory_order_relaxed))
+            _BuildRangeMinimum();
+    }
+    //the shallowest component in (first, second] is a child of the lowest common ancestor
+    uint32_t begin = first + 1, end = second + 1;
+    int k = std::bit_width(end - begin) - 1;
+    uint32_t a = rangeMinimum[k][begin], b = rangeMinimum[k][end - (uint32_t(1) << k)];
+    return labelOrder[labelDepths[b] < labelDepths[a] ? b : a]->GetParent();
+}
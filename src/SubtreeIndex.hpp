@@ -0,0 +1,199 @@
+#ifndef SUBTREE_INDEX_HPP
+#define SUBTREE_INDEX_HPP
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+#include "enums.hpp"
+
+namespace sys_sage { //forward declaration
+    class Component;
+}
+
+namespace sys_sage {
+
+    /**
+     * @class SubtreeIndex
+     * @brief Optional index over the subtree of one Component, which answers subtree queries without traversing the subtree.
+     *
+     * The index maps each ComponentType to the Components of that type in the subtree (including the indexed Component itself), in pre-order (DFS) order, i.e. in the same order as Component::FindDescendantsByType() returns them.
+     * It also holds a hash map from (id, ComponentType) to the first Component in pre-order with that id and type, as returned by Component::GetDescendantById(). Each of the two parts is built lazily on its first query.
+     * \n Optionally, the index assigns interval labels to the Components of the subtree (see UpdateIntervalLabels()): each Component stores its position in pre-order and the end of its subtree in pre-order,
+     * which turns Component::IsAncestorOf() into an O(1) check and Component::FindLowestCommonAncestor() into an O(1) range-minimum query (over a sparse table built on the first such query).
+     * \n It is kept up to date by Component::InsertChild(), RemoveChild(), InsertBetweenParentAndChild(ren)(), Delete() and SetId():
+     * subtrees appended at the end of the pre-order (the usual case when a tree is built top-down, e.g. by the parsers) are added incrementally;
+     * other modifications mark the index as stale, and it is rebuilt with a single traversal on the next query. The interval labels are extended in the same way, or relabelled on the next query.
+     * \n Modifications that bypass these functions (e.g. manipulating _GetChildren() or calling SetParent() directly) are not tracked -- call Invalidate() afterwards.
+     * \n Concurrent queries (e.g. in an EpochManager::ReadGuard, while the subtree is not modified): Component::IsAncestorOf() and Component::FindLowestCommonAncestor() are safe from any number of threads,
+     * as the lazy (re)labelling and the sparse table are built under a mutex and the labels are published only once complete.
+     * The per-type and id queries (GetComponentsByType(), GetComponentById(), and Component::FindDescendantsByType() and GetDescendantById() answered from the index) rebuild a stale index without synchronization; call them once in the writer before querying concurrently.
+     * Modifying the subtree and calling UpdateIntervalLabels() on an index nested in another labelled one are writes.
+     * @see Component::EnableSubtreeIndex()
+     */
+    class SubtreeIndex {
+    public:
+        /**
+         * @brief SubtreeIndex constructor. The index is built lazily on the first query.
+         * @param _root Component whose subtree is indexed
+         */
+        SubtreeIndex(Component* _root);
+        ~SubtreeIndex();
+        SubtreeIndex(const SubtreeIndex&) = delete;
+        SubtreeIndex& operator=(const SubtreeIndex&) = delete;
+
+        /**
+         * @brief Returns all Components of the given type in the subtree (including the root) in pre-order.
+         * @param componentType Required ComponentType, or ComponentType::Any for all Components
+         * @return Reference to the internal (pre-order) vector; valid until the next modification of the subtree
+         */
+        const std::vector<Component*>& GetComponentsByType(ComponentType::type componentType);
+        /**
+         * @brief Returns the number of Components of the given type in the subtree (including the root).
+         * @param componentType Required ComponentType, or ComponentType::Any for all Components
+         */
+        size_t CountComponentsByType(ComponentType::type componentType);
+
+        /**
+         * @brief Returns the first Component (in pre-order) of the subtree with the given id and type.
+         * @param id Id of the Component
+         * @param componentType ComponentType of the Component
+         * @return Pointer to the Component, or nullptr if there is no such Component in the subtree
+         * @see Component::GetDescendantById()
+         */
+        Component* GetComponentById(int id, ComponentType::type componentType);
+
+        /**
+         * @brief Assigns interval labels to all Components of the subtree, unless they are already up to date.
+         * Afterwards, Component::IsAncestorOf() and Component::FindLowestCommonAncestor() run in O(1) for pairs of Components of the subtree.
+         * \n The labels are also built automatically on the first such query on Components of the subtree; concurrent queries wait for one of them to build the labels.
+         */
+        void UpdateIntervalLabels();
+        /**
+         * @brief Returns true if the interval labels of the subtree are up to date.
+         */
+        bool AreIntervalLabelsValid() const;
+
+        /**
+         * @brief Marks the index as stale; it will be rebuilt on the next query.
+         */
+        void Invalidate();
+        /**
+         * @brief Returns true if the per-type part of the index is up to date (i.e. a query by type does not trigger a rebuild).
+         */
+        bool IsValid() const;
+        /**
+         * @brief Returns the Component whose subtree is indexed.
+         */
+        Component* GetRoot() const;
+        /**
+         * @brief Returns the memory used by the index in bytes (the index object and its arrays and maps).
+         */
+        size_t GetFootprint() const;
+
+        /**
+         * @private
+         * @brief Called when the subtree of child was attached to a Component of the indexed subtree.
+         * @param child Root of the newly attached subtree
+         * @param appendedInPreOrder true if the attached subtree is the last part of the indexed subtree in pre-order
+         */
+        void _OnSubtreeInserted(Component* child, bool appendedInPreOrder);
+        /**
+         * @private
+         * @brief Called when the subtree of child was detached from a Component of the indexed subtree.
+         * @param child Root of the detached subtree
+         */
+        void _OnSubtreeRemoved(Component* child);
+        /**
+         * @private
+         * @brief Called when a Component of the indexed subtree changed its id.
+         * @param c The Component (already carrying the new id)
+         * @param oldId The previous id of the Component
+         */
+        void _OnIdChanged(Component* c, int oldId);
+        /**
+         * @private
+         * @brief Returns the number of existing SubtreeIndex objects. When it is 0, Component does not have to look for indexes among the ancestors on modifications.
+         */
+        static size_t _GetNumInstances();
+        /**
+         * @private
+         * @brief Returns true if the interval labels with the given stamp are up to date. Inline, as it is on the fast path of Component::IsAncestorOf().
+         */
+        static bool _IsLabelStampCurrent(uint64_t stamp)
+        {
+            const LabelSlotChunk* chunk = _GetLabelSlotChunk(static_cast<uint32_t>(stamp >> 32));
+            //acquire: the labels with the stamp were written before its generation was published
+            return stamp != 0 && chunk != nullptr && chunk->generations[(stamp >> 32) % labelSlotChunkSize].load(std::memory_order_acquire) == static_cast<uint32_t>(stamp);
+        }
+        /**
+         * @private
+         * @brief Returns the SubtreeIndex that assigned the interval labels with the given stamp, or nullptr if that index no longer exists.
+         * The labels may be stale (see _IsLabelStampCurrent()).
+         */
+        static SubtreeIndex* _GetLabelStampOwner(uint64_t stamp)
+        {
+            const LabelSlotChunk* chunk = _GetLabelSlotChunk(static_cast<uint32_t>(stamp >> 32));
+            return chunk != nullptr ? chunk->owners[(stamp >> 32) % labelSlotChunkSize].load(std::memory_order_acquire) : nullptr;
+        }
+        /**
+         * @private
+         * @brief Returns the stamp of the current interval labels (0 if the subtree was never labelled).
+         */
+        uint64_t _GetLabelStamp() const;
+        /**
+         * @private
+         * @brief Returns the lowest common ancestor of the Components with pre-order labels first and second, where first < second and neither Component is an ancestor of the other.
+         * Requires valid interval labels.
+         */
+        Component* _FindLowestCommonAncestor(uint32_t first, uint32_t second);
+
+    private:
+        //label slots are allocated in chunks that never move, so that queries can read them while other threads allocate slots
+        static constexpr uint32_t labelSlotChunkSize = 1024;
+        static constexpr uint32_t maxLabelSlotChunks = 1024;
+        struct LabelSlotChunk {
+            std::atomic<SubtreeIndex*> owners[labelSlotChunkSize] {}; /**< slot -> SubtreeIndex owning the slot (nullptr if free); stamps with an older generation are stale, but still lead to their index */
+            std::atomic<uint32_t> generations[labelSlotChunkSize] {}; /**< slot -> current generation */
+        };
+        static const LabelSlotChunk* _GetLabelSlotChunk(uint32_t slot)
+        {
+            return (slot / labelSlotChunkSize < maxLabelSlotChunks) ? labelSlotChunks[slot / labelSlotChunkSize].load(std::memory_order_acquire) : nullptr;
+        }
+
+        static uint64_t _IdKey(int id, ComponentType::type componentType);
+        static std::atomic<size_t> numInstances;
+        void _Rebuild();
+        void _RebuildIds();
+        void _AddSubtree(Component* c);
+        void _AddSubtreeIds(Component* c);
+        void _LabelSubtree(Component* c, uint32_t depth);
+        void _BuildRangeMinimum();
+        void _ReleaseLabelStamp();
+
+        Component* root; /**< Component whose subtree is indexed */
+        bool valid { false }; /**< false if the index has to be rebuilt before answering a query */
+        std::vector<Component*> all; /**< all Components of the subtree in pre-order */
+        std::unordered_map<ComponentType::type, std::vector<Component*>> byType; /**< Components of the subtree in pre-order, per ComponentType */
+        bool idsValid { false }; /**< false if the id map has to be rebuilt before answering a query */
+        std::unordered_map<uint64_t, Component*> byId; /**< (id, ComponentType) -> first Component in pre-order */
+
+        //label stamps are (slot << 32 | generation); the generation of a slot grows whenever its labels become stale and when its index is destroyed, so stale labels are never mistaken for current ones
+        //a relabelling publishes the new generation only after all labels are written
+        static std::atomic<LabelSlotChunk*> labelSlotChunks[maxLabelSlotChunks];
+        static uint32_t numLabelSlots; /**< number of slots ever allocated (guarded by labelMutex) */
+        static std::vector<uint32_t> freeLabelSlots; /**< guarded by labelMutex */
+        static std::mutex labelMutex; /**< serializes the allocation of slots, (re)labelling and building the sparse table */
+        std::atomic<bool> labelsValid { false }; /**< false if the interval labels have to be reassigned before answering a query */
+        uint64_t labelStamp { 0 }; /**< stamp of the current interval labels; 0 if never labelled */
+        std::vector<Component*> labelOrder; /**< Components in the order of their pre-order labels */
+        std::vector<uint32_t> labelDepths; /**< depth (relative to root) of the Component with the given pre-order label */
+        std::atomic<bool> rangeMinimumValid { false }; /**< false if rangeMinimum has to be rebuilt before answering a lowest common ancestor query */
+        std::vector<std::vector<uint32_t>> rangeMinimum; /**< sparse table: rangeMinimum[k][i] is the label of minimum depth in [i, i + 2^k) */
+    };
+}
+
+#endif
@@ -37,8 +37,11 @@ namespace sys_sage {
     public:
         /**
         * Refreshes the frequency of the thread.
+        * @param columns - If not nullptr, the frequency of the Core of the thread is also written into its "freq" column of the Cores (see ColumnStore).
+        * @param epochs - If not nullptr, "freq_history" and the columns are updated in an EpochManager::WriteGuard of epochs, so that readers in its ReadGuards can access them concurrently.
+        * Without epochs, only the frequency itself (GetFreq()) may be read concurrently, i.e. a refresh with keep_history == false and columns == nullptr is the only reader-safe one.
         */
-        int RefreshFreq(bool keep_history = false);
+        int RefreshFreq(bool keep_history = false, ColumnStore* columns = nullptr, EpochManager* epochs = nullptr);
 
         /**
         * Gets the frequency of the thread.
@@ -0,0 +1,199 @@
+#include "TimeSeries.hpp"
+
+#include <algorithm>
+
+#include "Footprint.hpp"
+
+sys_sage::TimeSeries::Retention sys_sage::TimeSeries::historyRetention { 10000, 0 };
+
+sys_sage::TimeSeries::_Ring::_Ring(size_t _width, Retention _retention) : retention(_retention), width(_width) {}
+
+double* sys_sage::TimeSeries::_Ring::Push(int64_t timestamp)
+{
+    if(retention.maxSamples > 0 && count == retention.maxSamples)
+    {
+        head = (head + 1) % capacity;
+        count--;
+    }
+    if(retention.maxAge > 0)
+    {
+        while(count > 0 && timestamps[head] < timestamp - retention.maxAge)
+        {
+            head = (head + 1) % capacity;
+            count--;
+        }
+    }
+    if(count == capacity)
+        _Grow();
+    size_t slot = _Slot(count);
+    count++;
+    timestamps[slot] = timestamp;
+    return &values[slot * width];
+}
+
+//doubles the capacity (up to maxSamples) and moves the rows to the front
+void sys_sage::TimeSeries::_Ring::_Grow()
+{
+    size_t newCapacity = std::max<size_t>(8, 2 * capacity);
+    if(retention.maxSamples > 0)
+        newCapacity = std::min(newCapacity, retention.maxSamples);
+    std::vector<int64_t> newTimestamps(newCapacity);
+    std::vector<double> newValues(newCapacity * width);
+    for(size_t i = 0; i < count; i++)
+    {
+        newTimestamps[i] = Timestamp(i);
+        std::copy(Row(i), Row(i) + width, &newValues[i * width]);
+    }
+    timestamps.swap(newTimestamps);
+    values.swap(newValues);
+    capacity = newCapacity;
+    head = 0;
+}
+
+size_t sys_sage::TimeSeries::_Ring::LowerBound(int64_t timestamp) const
+{
+    size_t first = 0, len = count;
+    while(len > 0)
+    {
+        size_t half = len / 2;
+        if(Timestamp(first + half) < timestamp)
+        {
+            first += half + 1;
+            len -= half + 1;
+        }
+        else
+            len = half;
+    }
+    return first;
+}
+
+size_t sys_sage::TimeSeries::_Ring::HeapSize() const { return _VectorHeapSize(timestamps) + _VectorHeapSize(values); }
+
+sys_sage::TimeSeries::TimeSeries(std::vector<std::string> _channels, Retention _retention) : channels(std::move(_channels)), samples(channels.size(), _retention) {}
+
+size_t sys_sage::TimeSeries::AddTier(int64_t period, Retention retention)
+{
+    if(period <= 0)
+        return invalidTier;
+    tiers.push_back({ period, _Ring(1 + 3 * channels.size(), retention) });
+    return tiers.size() - 1;
+}
+
+int sys_sage::TimeSeries::Append(int64_t timestamp, double value)
+{
+    if(channels.size() != 1)
+        return 1;
+    return _Append(timestamp, &value, 1);
+}
+
+int sys_sage::TimeSeries::Append(int64_t timestamp, const std::vector<double>& values)
+{
+    return _Append(timestamp, values.data(), values.size());
+}
+
+//shared by both Append() overloads, so that appending a single value does not allocate a vector per sample
+int sys_sage::TimeSeries::_Append(int64_t timestamp, const double* values, size_t numValues)
+{
+    if(numValues != channels.size() || (samples.Size() > 0 && timestamp < samples.Timestamp(samples.Size() - 1)))
+        return 1;
+    std::copy(values, values + numValues, samples.Push(timestamp));
+    _AddToTiers(timestamp, values);
+    return 0;
+}
+
+//adds a sample to the aggregate of its period in each tier, opening a new aggregate when a new period starts
+void sys_sage::TimeSeries::_AddToTiers(int64_t timestamp, const double* values)
+{
+    size_t numChannels = channels.size();
+    for(Tier& tier : tiers)
+    {
+        //start of the period (rounded down, also for negative timestamps)
+        int64_t start = timestamp - ((timestamp % tier.period) + tier.period) % tier.period;
+        size_t n = tier.aggregates.Size();
+        if(n > 0 && tier.aggregates.Timestamp(n - 1) == start)
+        {
+            double* row = tier.aggregates.Row(n - 1);
+            row[0] += 1;
+            for(size_t c = 0; c < numChannels; c++)
+            {
+                row[1 + 3 * c] = std::min(row[1 + 3 * c], values[c]);
+                row[2 + 3 * c] = std::max(row[2 + 3 * c], values[c]);
+                row[3 + 3 * c] += values[c];
+            }
+        }
+        else if(n == 0 || tier.aggregates.Timestamp(n - 1) < start)
+        {
+            double* row = tier.aggregates.Push(start);
+            row[0] = 1;
+            for(size_t c = 0; c < numChannels; c++)
+            {
+                row[1 + 3 * c] = values[c];
+                row[2 + 3 * c] = values[c];
+                row[3 + 3 * c] = values[c];
+            }
+        }
+        //else: the sample belongs to a period before a restored aggregate (see _RestoreAggregate()); it is only kept in the samples
+    }
+}
+
+size_t sys_sage::TimeSeries::Size() const { return samples.Size(); }
+bool sys_sage::TimeSeries::Empty() const { return samples.Size() == 0; }
+int64_t sys_sage::TimeSeries::GetTimestamp(size_t i) const { return samples.Timestamp(i); }
+double sys_sage::TimeSeries::GetValue(size_t i, size_t channel) const { return samples.Row(i)[channel]; }
+size_t sys_sage::TimeSeries::LowerBound(int64_t timestamp) const { return samples.LowerBound(timestamp); }
+
+std::pair<size_t, size_t> sys_sage::TimeSeries::FindRange(int64_t from, int64_t to) const
+{
+    if(to < from)
+        return { 0, 0 };
+    return { samples.LowerBound(from), (to == INT64_MAX) ? samples.Size() : samples.LowerBound(to + 1) };
+}
+
+size_t sys_sage::TimeSeries::GetNumTiers() const { return tiers.size(); }
+int64_t sys_sage::TimeSeries::GetTierPeriod(size_t tier) const { return tiers.at(tier).period; }
+const sys_sage::TimeSeries::Retention& sys_sage::TimeSeries::GetTierRetention(size_t tier) const { return tiers.at(tier).aggregates.retention; }
+size_t sys_sage::TimeSeries::GetTierSize(size_t tier) const { return tiers.at(tier).aggregates.Size(); }
+
+sys_sage::TimeSeries::Aggregate sys_sage::TimeSeries::GetAggregate(size_t tier, size_t i, size_t channel) const
+{
+    const _Ring& aggregates = tiers.at(tier).aggregates;
+    const double* row = aggregates.Row(i);
+    return { aggregates.Timestamp(i), static_cast<uint64_t>(row[0]), row[1 + 3 * channel], row[2 + 3 * channel], row[3 + 3 * channel] };
+}
+
+std::pair<size_t, size_t> sys_sage::TimeSeries::FindTierRange(size_t tier, int64_t from, int64_t to) const
+{
+    const _Ring& aggregates = tiers.at(tier).aggregates;
+    if(to < from)
+        return { 0, 0 };
+    return { aggregates.LowerBound(from), (to == INT64_MAX) ? aggregates.Size() : aggregates.LowerBound(to + 1) };
+}
+
+const std::vector<std::string>& sys_sage::TimeSeries::GetChannels() const { return channels; }
+const sys_sage::TimeSeries::Retention& sys_sage::TimeSeries::GetRetention() const { return samples.retention; }
+
+size_t sys_sage::TimeSeries::GetHeapSize() const
+{
+    size_t size = _VectorHeapSize(channels) + samples.HeapSize() + _VectorHeapSize(tiers);
+    for(const std::string& channel : channels)
+        size += _StringHeapSize(channel);
+    for(const Tier& tier : tiers)
+        size += tier.aggregates.HeapSize();
+    return size;
+}
+
+void sys_sage::TimeSeries::SetHistoryRetention(Retention retention) { historyRetention = retention; }
+sys_sage::TimeSeries::Retention sys_sage::TimeSeries::GetHistoryRetention() { return historyRetention; }
+
+int sys_sage::TimeSeries::_RestoreAggregate(size_t tier, int64_t timestamp, uint64_t count, const std::vector<double>& stats)
+{
+    if(tier >= tiers.size() || stats.size() != 3 * channels.size())
+        return 1;
+    _Ring& aggregates = tiers[tier].aggregates;
+    if(aggregates.Size() > 0 && timestamp <= aggregates.Timestamp(aggregates.Size() - 1))
+        return 1;
+    double* row = aggregates.Push(timestamp);
+    row[0] = static_cast<double>(count);
+    std::copy(stats.begin(), stats.end(), row + 1);
+    return 0;
+}
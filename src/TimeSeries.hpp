@@ -0,0 +1,186 @@
+#ifndef TIME_SERIES_HPP
+#define TIME_SERIES_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace sys_sage {
+
+    /**
+     * @class TimeSeries
+     * @brief Bounded history of timestamped samples with one or more channels (e.g. the frequency of a Core, or T1, T2 and the fidelities of a Qubit).
+     *
+     * The samples are kept in a ring buffer in the order of their timestamps. The retention limits the number of samples and/or their age (relative to the newest sample); older samples are dropped when new ones are appended, so the memory of a long-running monitor stays bounded.
+     * \n Optional downsampling tiers keep aggregates (count, min, max, sum per channel) over fixed periods (e.g. 1 s and 1 min), each with its own retention, so that a long history can be kept at a coarser resolution.
+     * \n Time-range queries (LowerBound(), FindRange()) are binary searches, i.e. O(log n).
+     * \n Used for the attributes "freq_history" (of Cores, see Core::RefreshFreq()) and "readout_history" (of Qubits and CouplingMaps, see parseIQM()), stored as TimeSeries* in the attrib map.
+     * To use another retention or tiers for these attributes, insert a TimeSeries under the key before the first refresh, or change the default with SetHistoryRetention().
+     */
+    class TimeSeries {
+    public:
+        static constexpr size_t invalidTier = SIZE_MAX; /**< Returned by AddTier() for an invalid period */
+
+        /**
+         * @brief Retention of samples (or aggregates); 0 means unlimited.
+         */
+        struct Retention {
+            size_t maxSamples; /**< Maximal number of samples kept (the oldest are dropped) */
+            int64_t maxAge; /**< Samples older than the newest timestamp minus maxAge are dropped */
+        };
+        /**
+         * @brief Aggregate of the samples of one channel in one period of a downsampling tier.
+         */
+        struct Aggregate {
+            int64_t timestamp; /**< Start of the period */
+            uint64_t count; /**< Number of samples in the period */
+            double min;
+            double max;
+            double sum;
+            double Mean() const { return sum / count; }
+        };
+
+        /**
+         * @param _channels Names of the channels (the values of each sample)
+         * @param _retention Retention of the samples
+         */
+        TimeSeries(std::vector<std::string> _channels = {"value"}, Retention _retention = {0, 0});
+
+        /**
+         * @brief Adds a downsampling tier aggregating the samples appended from now on.
+         * @param period Length of the aggregation periods, in the unit of the timestamps (periods start at multiples of period); must be positive
+         * @param retention Retention of the aggregates
+         * @return Index of the tier, or invalidTier (and no tier is added) if period is not positive
+         */
+        size_t AddTier(int64_t period, Retention retention = {0, 0});
+
+        /**
+         * @brief Appends a sample of a single-channel time series.
+         * @return 0 on success, 1 if the timestamp is older than the newest sample or the time series has more than one channel
+         */
+        int Append(int64_t timestamp, double value);
+        /**
+         * @brief Appends a sample (one value per channel).
+         * @return 0 on success, 1 if the timestamp is older than the newest sample or the number of values does not match the number of channels
+         */
+        int Append(int64_t timestamp, const std::vector<double>& values);
+
+        /**
+         * @brief Returns the number of samples kept.
+         */
+        size_t Size() const;
+        bool Empty() const;
+        /**
+         * @brief Returns the timestamp of the i-th sample kept (0 being the oldest).
+         */
+        int64_t GetTimestamp(size_t i) const;
+        /**
+         * @brief Returns the value of a channel of the i-th sample kept (0 being the oldest).
+         */
+        double GetValue(size_t i, size_t channel = 0) const;
+        /**
+         * @brief Returns the index of the first sample with a timestamp >= timestamp (Size() if there is none). O(log n).
+         */
+        size_t LowerBound(int64_t timestamp) const;
+        /**
+         * @brief Returns the indices [first, last) of the samples with from <= timestamp <= to. O(log n).
+         */
+        std::pair<size_t, size_t> FindRange(int64_t from, int64_t to) const;
+
+        /**
+         * @brief Returns the number of downsampling tiers.
+         */
+        size_t GetNumTiers() const;
+        /**
+         * @brief Returns the aggregation period of a tier.
+         */
+        int64_t GetTierPeriod(size_t tier) const;
+        /**
+         * @brief Returns the retention of a tier.
+         */
+        const Retention& GetTierRetention(size_t tier) const;
+        /**
+         * @brief Returns the number of aggregates kept in a tier (the last one belongs to the current, still open period).
+         */
+        size_t GetTierSize(size_t tier) const;
+        /**
+         * @brief Returns the i-th aggregate (0 being the oldest) of a channel in a tier.
+         */
+        Aggregate GetAggregate(size_t tier, size_t i, size_t channel = 0) const;
+        /**
+         * @brief Returns the indices [first, last) of the aggregates of a tier whose periods start in [from, to]. O(log n).
+         */
+        std::pair<size_t, size_t> FindTierRange(size_t tier, int64_t from, int64_t to) const;
+
+        /**
+         * @brief Returns the names of the channels.
+         */
+        const std::vector<std::string>& GetChannels() const;
+        /**
+         * @brief Returns the retention of the samples.
+         */
+        const Retention& GetRetention() const;
+        /**
+         * @brief Returns the heap memory owned by the time series (samples, aggregates and channel names).
+         */
+        size_t GetHeapSize() const;
+
+        /**
+         * @brief Sets the retention of the histories created by sys-sage ("freq_history", "readout_history").
+         * Applies to histories created from now on. By default, 10000 samples are kept.
+         */
+        static void SetHistoryRetention(Retention retention);
+        /**
+         * @brief Returns the retention of the histories created by sys-sage (see SetHistoryRetention()).
+         */
+        static Retention GetHistoryRetention();
+
+        /**
+         * @private
+         * @brief Restores an aggregate of a tier, e.g. when importing from XML; stats holds min, max and sum for each channel.
+         * @return 0 on success, 1 if the tier does not exist, the aggregate is older than the newest one, or stats has the wrong size
+         */
+        int _RestoreAggregate(size_t tier, int64_t timestamp, uint64_t count, const std::vector<double>& stats);
+
+    private:
+        //ring buffer of rows (a timestamp and a fixed number of values), ordered by timestamp
+        class _Ring {
+        public:
+            _Ring(size_t _width, Retention _retention);
+            size_t Size() const { return count; }
+            int64_t Timestamp(size_t i) const { return timestamps[_Slot(i)]; }
+            const double* Row(size_t i) const { return &values[_Slot(i) * width]; }
+            double* Row(size_t i) { return &values[_Slot(i) * width]; }
+            double* Push(int64_t timestamp);
+            size_t LowerBound(int64_t timestamp) const;
+            size_t HeapSize() const;
+            Retention retention;
+        private:
+            size_t _Slot(size_t i) const { return (head + i) % capacity; }
+            void _Grow();
+            size_t width;
+            std::vector<int64_t> timestamps;
+            std::vector<double> values;
+            size_t head { 0 };
+            size_t count { 0 };
+            size_t capacity { 0 };
+        };
+        struct Tier {
+            int64_t period;
+            _Ring aggregates; /**< Row: count, then min, max and sum for each channel */
+        };
+
+        int _Append(int64_t timestamp, const double* values, size_t numValues);
+        void _AddToTiers(int64_t timestamp, const double* values);
+
+        std::vector<std::string> channels;
+        _Ring samples;
+        std::vector<Tier> tiers;
+
+        static Retention historyRetention;
+    };
+}
+
+#endif
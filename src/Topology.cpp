@@ -1,4 +1,61 @@
-
 #include "Topology.hpp"
 
+#include <algorithm>
+
+#include "Relation.hpp"
+
 sys_sage::Topology::Topology():Component(0, "sys-sage Topology", sys_sage::ComponentType::Topology){}
+
+sys_sage::Topology::~Topology()
+{
+    if(arena != nullptr)
+        ReleaseArena();
+    delete arena;
+}
+
+sys_sage::Arena* sys_sage::Topology::CreateArena()
+{
+    if(arena == nullptr)
+        arena = new Arena();
+    return arena;
+}
+
+sys_sage::Arena* sys_sage::Topology::GetArena() const { return arena; }
+
+size_t sys_sage::Topology::ReleaseArena()
+{
+    if(arena == nullptr)
+        return 0;
+
+    //only the Topology itself is updated; everything below it is dropped together with the Arena
+    auto firstReleased = std::stable_partition(children.begin(), children.end(), [](Component* c){ return c->_GetSlabPool() == nullptr; });
+    //the SubtreeIndex of the Topology (or of its ancestors) must not keep the released components
+    for(auto it = firstReleased; it != children.end(); ++it)
+        _NotifySubtreeRemoved(*it);
+    children.erase(firstReleased, children.end());
+    firstStaleChildIndex = 0;
+    if(relations != nullptr)
+    {
+        size_t numReleasedRelations = 0;
+        for(std::vector<Relation*>* rv : *relations)
+        {
+            if(rv == nullptr)
+                continue;
+            size_t size = rv->size();
+            rv->erase(std::remove_if(rv->begin(), rv->end(), [](Relation* r){ return r->_GetSlabPool() != nullptr; }), rv->end());
+            numReleasedRelations += size - rv->size();
+        }
+        //drops the DataPathIndex of the Topology and makes DataPathRouter caches stale
+        if(numReleasedRelations > 0)
+            _InvalidateDataPathIndex();
+    }
+
+    size_t numObjects = arena->GetNumObjects();
+    arena->Release();
+    return numObjects;
+}
+
+sys_sage::FrozenTopology sys_sage::Topology::Freeze()
+{
+    return FrozenTopology(this);
+}
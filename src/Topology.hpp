@@ -2,6 +2,8 @@
 #define TOPOLOGY_HPP
 
 #include "Component.hpp"
+#include "Arena.hpp"
+#include "FrozenTopology.hpp"
 
 namespace sys_sage {
 
@@ -21,10 +23,41 @@ namespace sys_sage {
         /**
         * @private
         * Use Delete() or DeleteSubtree() for deleting and deallocating the components. 
+        * The Arena of the Topology (if any) is released as well.
         */
-        ~Topology() override = default;
+        ~Topology() override;
+
+        /**
+         * @brief Creates the Arena of this Topology (if it does not exist yet).
+         * Components, Relations and attribute values of the Topology can then be allocated from the Arena's slab pools instead of one-by-one with new, e.g.
+         * \n Thread* t = topo->CreateArena()->New<Thread>(core, 0);
+         * @return Pointer to the Arena owned by this Topology
+         * @see Arena
+         */
+        Arena* CreateArena();
+        /**
+         * @brief Returns the Arena of this Topology, or nullptr if CreateArena() was not called.
+         */
+        Arena* GetArena() const;
+        /**
+         * @brief Deletes all Components, Relations and attribute values allocated from the Arena of this Topology at once.
+         * The Component Tree is not traversed: the arena-allocated children and Relations of the Topology itself are unlinked from it, and then all slab pools are released.
+         * \n Components or Relations allocated with new must not be connected to arena-allocated ones when calling this function (they are neither visited nor updated).
+         * @return Number of objects released from the Arena
+         */
+        size_t ReleaseArena();
+
+        /**
+         * @brief Packs the current Component Tree of this Topology (and the DataPaths among its Components) into an immutable, flat snapshot.
+         * Queries on the snapshot scan contiguous arrays instead of chasing pointers; results can be mapped back to the live Components via FrozenTopology::GetComponent().
+         * \n The snapshot is not updated by later modifications of the Topology; call Freeze() again after modifying it.
+         * @return The snapshot
+         * @see FrozenTopology
+         */
+        FrozenTopology Freeze();
     private:
+        Arena* arena { nullptr }; /**< Arena owned by this Topology (lazily created by CreateArena()) */
     };
 }
 
-#endif
\ No newline at end of file
+#endif
@@ -0,0 +1,102 @@
+#include "Traversal.hpp"
+
+#include <vector>
+
+#include "Component.hpp"
+
+sys_sage::SubtreeIterator::SubtreeIterator(Component* root, ComponentType::type _componentType, bool _postOrder) : current(root), componentType(_componentType), postOrder(_postOrder)
+{
+    if(postOrder)
+        _DescendToFirstLeaf();
+    while(current != nullptr && !_Matches())
+        _Step();
+}
+
+sys_sage::SubtreeIterator& sys_sage::SubtreeIterator::operator++()
+{
+    do {
+        _Step();
+    } while(current != nullptr && !_Matches());
+    return *this;
+}
+
+sys_sage::SubtreeIterator sys_sage::SubtreeIterator::operator++(int)
+{
+    SubtreeIterator ret = *this;
+    ++*this;
+    return ret;
+}
+
+int sys_sage::SubtreeIterator::GetDepth() const { return depth; }
+
+void sys_sage::SubtreeIterator::SkipChildren() { skipChildren = true; }
+
+bool sys_sage::SubtreeIterator::_Matches() const
+{
+    return componentType == ComponentType::Any || current->GetComponentType() == componentType;
+}
+
+void sys_sage::SubtreeIterator::_PushChild(Component* parent, size_t position)
+{
+    if(depth < inlineDepth)
+        path[depth] = { parent, position };
+    depth++;
+    current = parent->GetChildren()[position];
+}
+
+sys_sage::SubtreeIterator::Frame sys_sage::SubtreeIterator::_CurrentFrame() const
+{
+    if(depth <= inlineDepth)
+        return path[depth - 1];
+    //deeper than the inline path: recover the position from the parent pointer and the index in the parent's children
+    Component* parent = current->GetParent();
+    int index = current->GetIndexInParent();
+    return { parent, index < 0 ? parent->GetChildren().size() : static_cast<size_t>(index) };
+}
+
+void sys_sage::SubtreeIterator::_DescendToFirstLeaf()
+{
+    while(!current->GetChildren().empty())
+        _PushChild(current, 0);
+}
+
+void sys_sage::SubtreeIterator::_Step()
+{
+    if(postOrder)
+    {
+        if(depth == 0)
+        {
+            current = nullptr;
+            return;
+        }
+        Frame frame = _CurrentFrame();
+        depth--;
+        if(frame.position + 1 < frame.parent->GetChildren().size())
+        {
+            _PushChild(frame.parent, frame.position + 1);
+            _DescendToFirstLeaf();
+        }
+        else
+            current = frame.parent;
+        return;
+    }
+
+    if(!skipChildren && !current->GetChildren().empty())
+    {
+        _PushChild(current, 0);
+        return;
+    }
+    skipChildren = false;
+    while(depth > 0)
+    {
+        Frame frame = _CurrentFrame();
+        depth--;
+        if(frame.position + 1 < frame.parent->GetChildren().size())
+        {
+            _PushChild(frame.parent, frame.position + 1);
+            return;
+        }
+        current = frame.parent;
+    }
+    current = nullptr;
+}
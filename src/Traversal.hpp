@@ -0,0 +1,131 @@
+#ifndef TRAVERSAL_HPP
+#define TRAVERSAL_HPP
+
+#include <array>
+#include <cstddef>
+#include <functional>
+#include <iterator>
+#include <ranges>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "enums.hpp"
+
+namespace sys_sage { //forward declaration
+    class Component;
+}
+
+namespace sys_sage {
+
+    /**
+     * @class SubtreeIterator
+     * @brief Lazy forward iterator over a subtree of the Component Tree in pre-order or post-order, optionally filtered by ComponentType.
+     *
+     * The iterator does not allocate: the path from the root of the traversal to the current Component (parent and position of each Component on the path) is kept in a fixed-size array of SubtreeIterator::inlineDepth entries.
+     * Below that depth, the position is recovered from the parent pointer and Component::GetIndexInParent().
+     * \n The subtree must not be modified while it is being traversed.
+     * \n Normally, SubtreeIterators are obtained via Component::TraversePreOrder() and Component::TraversePostOrder() and compared against std::default_sentinel.
+     */
+    class SubtreeIterator {
+    public:
+        using iterator_concept = std::forward_iterator_tag;
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = Component*;
+        using difference_type = std::ptrdiff_t;
+        using reference = Component*;
+
+        /**
+         * @brief Number of tree levels below the root of the traversal whose positions are stored inline.
+         */
+        static constexpr int inlineDepth = 32;
+
+        /**
+         * @brief Constructs an end iterator.
+         */
+        SubtreeIterator() = default;
+        /**
+         * @brief Constructs an iterator pointing to the first Component of the traversal matching componentType.
+         * @param root Root of the traversed subtree (it is part of the traversal)
+         * @param componentType Required ComponentType, or ComponentType::Any for all Components
+         * @param postOrder false for pre-order (parents before children), true for post-order (children before parents)
+         */
+        SubtreeIterator(Component* root, ComponentType::type componentType, bool postOrder);
+
+        Component* operator*() const { return current; }
+        SubtreeIterator& operator++();
+        SubtreeIterator operator++(int);
+        bool operator==(const SubtreeIterator& other) const { return current == other.current; }
+        bool operator==(std::default_sentinel_t) const { return current == nullptr; }
+
+        /**
+         * @brief Returns the depth of the current Component relative to the root of the traversal (root = 0).
+         */
+        int GetDepth() const;
+        /**
+         * @brief Pre-order only: the next increment does not descend into the children of the current Component.
+         */
+        void SkipChildren();
+
+    private:
+        struct Frame {
+            Component* parent; /**< parent of the Component on the path */
+            size_t position; /**< position of the Component on the path in the children of parent */
+        };
+
+        bool _Matches() const;
+        void _Step();
+        void _PushChild(Component* parent, size_t position);
+        Frame _CurrentFrame() const;
+        void _DescendToFirstLeaf();
+
+        Component* current { nullptr }; /**< current Component; nullptr at the end of the traversal */
+        ComponentType::type componentType { ComponentType::Any };
+        bool postOrder { false };
+        bool skipChildren { false };
+        int depth { 0 };
+        std::array<Frame, inlineDepth> path {}; /**< path[d] describes the Component at depth d+1 */
+    };
+
+    /**
+     * @class SubtreeRange
+     * @brief Range of the Components of a subtree, as returned by Component::TraversePreOrder() and Component::TraversePostOrder().
+     * It can be used in range-based for loops and in C++20 ranges pipelines (it is a std::ranges::view); the traversal is performed lazily while iterating.
+     */
+    class SubtreeRange : public std::ranges::view_interface<SubtreeRange> {
+    public:
+        SubtreeRange() = default;
+        /**
+         * @param _root Root of the traversed subtree
+         * @param _componentType Required ComponentType, or ComponentType::Any for all Components
+         * @param _postOrder false for pre-order, true for post-order
+         */
+        SubtreeRange(Component* _root, ComponentType::type _componentType, bool _postOrder) : root(_root), componentType(_componentType), postOrder(_postOrder) {}
+
+        SubtreeIterator begin() const { return root == nullptr ? SubtreeIterator() : SubtreeIterator(root, componentType, postOrder); }
+        std::default_sentinel_t end() const { return std::default_sentinel; }
+
+    private:
+        Component* root { nullptr };
+        ComponentType::type componentType { ComponentType::Any };
+        bool postOrder { false };
+    };
+
+    /**
+     * @private
+     * @brief Calls a visitor and returns whether the traversal should continue. Visitors either return bool (false = stop) or void (never stop).
+     */
+    template <class Visitor, class... Args>
+    bool _InvokeVisitor(Visitor& visitor, Args&&... args)
+    {
+        if constexpr (std::is_void_v<std::invoke_result_t<Visitor&, Args...>>)
+        {
+            std::invoke(visitor, std::forward<Args>(args)...);
+            return true;
+        }
+        else
+            return static_cast<bool>(std::invoke(visitor, std::forward<Args>(args)...));
+    }
+}
+
+#endif
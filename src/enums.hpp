@@ -115,13 +115,15 @@ namespace sys_sage {
         constexpr type DataPath = 1;
         constexpr type QuantumGate = 2;
         constexpr type CouplingMap = 3;
-        constexpr type _num_relation_types = 4;
+        constexpr type DataPathMatrix = 4;
+        constexpr type _num_relation_types = 5;
 
         constexpr type RelationTypeList [_num_relation_types] = {
             Relation, 
             DataPath, 
             QuantumGate, 
             CouplingMap,
+            DataPathMatrix,
         };
 
         //SVTODO this should remain private???
@@ -130,7 +132,8 @@ namespace sys_sage {
             {Relation, "Relation"},
             {DataPath, "DataPath"},
             {QuantumGate, "QuantumGate"},
-            {CouplingMap, "CouplingMap"}
+            {CouplingMap, "CouplingMap"},
+            {DataPathMatrix, "DataPathMatrix"}
         };
 
         /**
@@ -190,6 +193,17 @@ namespace sys_sage {
         constexpr type Incoming = 3; /**< This Component is the target DataPath. */
     }
 
+    /**
+     * @namespace RouteMetric
+     * @brief Enumerates the optimization criteria of DataPathRouter.
+     */
+    namespace RouteMetric{
+        using type = int32_t; /**< RouteMetric datatype -- to indicate a parameter should be from this enum/namespace (as there are no hard restrictions from C++). */
+
+        constexpr type MinLatency = 1; /**< Route with the minimal sum of the latencies of its DataPaths. */
+        constexpr type MaxBandwidth = 2; /**< Route with the maximal bottleneck (minimal) bandwidth of its DataPaths. */
+    }
+
     //SVTODO rename this to RelationOrientation? oriented x not oriented and include this also into general Relation, rather than just DataPath?
     /**
      * @namespace DataPathOrientation
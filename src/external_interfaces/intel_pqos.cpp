@@ -126,15 +126,13 @@ int sys_sage::Node::UpdateL3CATCoreCOS(){
         {
             Thread* thread = *it_threads;
             //std::cout << "  thread " << thread->GetComponentTypeStr() << " id " << thread->GetId() << std::endl;
-            uint64_t* cos = new uint64_t();
-            uint64_t* mask = new uint64_t();
-            *cos = getCoreCOS(socket->GetId(), thread->GetId(), p_l3cat_ids, l3cat_id_count, p_cpu);
-            if(*cos == std::numeric_limits<uint64_t>::max()){
+            uint64_t cos = getCoreCOS(socket->GetId(), thread->GetId(), p_l3cat_ids, l3cat_id_count, p_cpu);
+            if(cos == std::numeric_limits<uint64_t>::max()){
                 cerr << "getCoreCOS failed" << endl;
                 continue;
             }
-            *mask = getCOSL3Bitmask(socket->GetId(), *cos, p_l3cat_ids, l3cat_id_count);
-            if(*mask == std::numeric_limits<uint64_t>::max()){
+            uint64_t mask = getCOSL3Bitmask(socket->GetId(), cos, p_l3cat_ids, l3cat_id_count);
+            if(mask == std::numeric_limits<uint64_t>::max()){
                 cerr << "getCOSL3Bitmask failed" << endl;
                 continue;
             }
@@ -151,12 +149,10 @@ int sys_sage::Node::UpdateL3CATCoreCOS(){
                 cerr << "L3 cache not found" << endl; continue;
             }
 
-            //TODO check if exists -> overwrite
-
-            //add DataPath to thread and L3
-            DataPath* d = new DataPath(thread, c, sys_sage::DataPathOrientation::Bidirectional, sys_sage::DataPathType::L3CAT);
-            d->attrib.insert({"CATcos", reinterpret_cast<void*>(cos)});
-            d->attrib.insert({"CATL3mask", reinterpret_cast<void*>(mask)});
+            //add the DataPath to thread and L3, or overwrite the one of a previous call
+            DataPath* d = thread->UpsertDataPath(c, sys_sage::DataPathType::L3CAT, sys_sage::DataPathOrientation::Bidirectional);
+            d->UpdateAttrib<uint64_t>("CATcos", cos);
+            d->UpdateAttrib<uint64_t>("CATL3mask", mask);
         }
     }
     return 1;
@@ -164,10 +160,9 @@ int sys_sage::Node::UpdateL3CATCoreCOS(){
 
 long long sys_sage::Thread::GetCATAwareL3Size()
 {
-    //look for dp_outgoing where attrib contains "CATL3mask"
-    for(auto it = std::begin(dp_outgoing); it != std::end(dp_outgoing); ++it)
+    //look for the L3CAT DataPath (see Node::UpdateL3CATCoreCOS()), whose attrib contains "CATL3mask"
+    for(DataPath* dp : FindDataPaths(sys_sage::DataPathType::L3CAT, sys_sage::DataPathDirection::Outgoing))
     {
-        DataPath* dp = *it;
         auto search = dp->attrib.find("CATL3mask");
         if (search == dp->attrib.end()) {
             continue;
@@ -16,6 +16,32 @@
 #include "Memory.hpp"
 #include "Cache.hpp"
 #include "Subdivision.hpp"
+#include "AttribIndex.hpp"
+
+namespace {
+    //MIG DataPaths of c with the given mig_uuid: looked up in the index of "mig_uuid" if there is one (see RelationAttribIndex), otherwise by scanning the DataPaths of c
+    //(the index only holds typed attributes, as set by Chip::UpdateMIGSettings(); a mig_uuid in the attrib map is only found by the scan)
+    std::vector<sys_sage::DataPath*> FindMIGDataPaths(const sys_sage::Component* c, const std::string& uuid)
+    {
+        using namespace sys_sage;
+        std::vector<DataPath*> found;
+        if(RelationAttribIndex* index = RelationAttribIndex::Get(InternAttribKey("mig_uuid")))
+        {
+            for(Relation* r : index->Find(uuid))
+                if(r->GetType() == RelationType::DataPath && static_cast<DataPath*>(r)->GetDataPathType() == DataPathType::MIG && r->ContainsComponent(const_cast<Component*>(c)))
+                    found.push_back(static_cast<DataPath*>(r));
+            return found;
+        }
+        for(Relation* r : c->GetRelationsByType(RelationType::DataPath))
+        {
+            DataPath * dp = static_cast<DataPath*>(r);
+            const std::string* mig_uuid = dp->GetAttr<std::string>("mig_uuid");
+            if(dp->GetDataPathType() == DataPathType::MIG && mig_uuid != nullptr && *mig_uuid == uuid)
+                found.push_back(dp);
+        }
+        return found;
+    }
+}
 
 
 //SVTODO refactor to std::map<std::string, std::any> attrib;
@@ -51,27 +77,14 @@ int sys_sage::Chip::UpdateMIGSettings(std::string uuid)
 
     //cout << "...........multiprocessorCount " << attributes.multiprocessorCount << " gpuInstanceSliceCount=" << attributes.gpuInstanceSliceCount << "  computeInstanceSliceCount=" << attributes.computeInstanceSliceCount << "    memorySizeMB=" << attributes.memorySizeMB << endl;
     
+    //the MIG DataPaths are keyed by their mig_uuid: a repeated call updates the ones of the previous call in place
     //main memory, expects the memory as a child of
     Memory* m = static_cast<Memory*>(GetChildByType(ComponentType::Memory));
-    long long* mig_size;
+    long long mig_size = 0;
     if(m != NULL){
-        DataPath * d = NULL;
-        //iterate over dp_outgoing to check if DP already exists
-        for(Relation* r : GetRelationsByType(RelationType::DataPath))
-        {
-            DataPath * dp = static_cast<DataPath*>(r);
-            if( dp->GetDataPathType() == DataPathType::MIG && *(static_cast<std::string*>(dp->attrib["mig_uuid"])) == uuid)
-            {
-                d = dp;
-                break;
-            }
-        }
-
-        d = new DataPath(this, m, DataPathOrientation::Bidirectional, DataPathType::MIG);
-        std::string* mig_uuid = new std::string(uuid);
-        mig_size = new long long(attributes.memorySizeMB*1000000);
-        d->attrib.insert({"mig_uuid",reinterpret_cast<void*>(mig_uuid)});
-        d->attrib.insert({"mig_size",reinterpret_cast<void*>(mig_size)});
+        DataPath * d = UpsertDataPath(m, DataPathType::MIG, DataPathOrientation::Bidirectional, "mig_uuid", uuid);
+        mig_size = attributes.memorySizeMB*1000000;
+        d->UpdateAttrib<long long>("mig_size", mig_size);
     } else {
         std::cerr << "Chip::UpdateMIGSettings: Component Type Memory not found as a child of this Chip. Memory info will not be updated." << std::endl;
         ret = 1;
@@ -79,8 +92,8 @@ int sys_sage::Chip::UpdateMIGSettings(std::string uuid)
 
     //L2 cache(s)
     unsigned int L2_fraction = 1; //which fraction of L2 is in MIG partition (the same fraction as the fraction of main memory)
-    if(m->GetSize() > *mig_size){
-        L2_fraction = (m->GetSize() + (*mig_size/2)) / *mig_size; //divide and round up or down
+    if(m != NULL && mig_size > 0 && m->GetSize() > mig_size){
+        L2_fraction = (m->GetSize() + (mig_size/2)) / mig_size; //divide and round up or down
     }
     std::vector<Component*> caches;
     FindDescendantsByType(&caches, ComponentType::Cache);
@@ -94,14 +107,11 @@ int sys_sage::Chip::UpdateMIGSettings(std::string uuid)
     if(num_caches > 0){
         int cache_id = 0;
         for(Cache* c : L2_caches){
-            DataPath * d = new DataPath(this, c, DataPathOrientation::Bidirectional, DataPathType::MIG);
-            std::string* mig_uuid = new std::string(uuid);
-            mig_size = new long long();
-            *mig_size = c->GetCacheSize() * ( static_cast<float>(num_caches)/static_cast<float>(L2_fraction)-static_cast<float>(cache_id)/static_cast<float>(num_caches));
-            if(*mig_size <0)
-                *mig_size=0;
-            d->attrib.insert({"mig_uuid",reinterpret_cast<void*>(mig_uuid)});
-            d->attrib.insert({"mig_size",reinterpret_cast<void*>(mig_size)});
+            DataPath * d = UpsertDataPath(c, DataPathType::MIG, DataPathOrientation::Bidirectional, "mig_uuid", uuid);
+            long long L2_mig_size = c->GetCacheSize() * ( static_cast<float>(num_caches)/static_cast<float>(L2_fraction)-static_cast<float>(cache_id)/static_cast<float>(num_caches));
+            if(L2_mig_size <0)
+                L2_mig_size=0;
+            d->UpdateAttrib<long long>("mig_size", L2_mig_size);
             cache_id++;
         }
     } else {
@@ -119,9 +129,7 @@ int sys_sage::Chip::UpdateMIGSettings(std::string uuid)
     }
     for(Subdivision* sm: sms){
         if(sm->GetId() < static_cast<int>(attributes.multiprocessorCount)){
-            DataPath * d = new DataPath(this, sm, DataPathOrientation::Bidirectional, DataPathType::MIG);
-            std::string* mig_uuid = new std::string(uuid);
-            d->attrib.insert({"mig_uuid",reinterpret_cast<void*>(mig_uuid)});
+            UpsertDataPath(sm, DataPathType::MIG, DataPathOrientation::Bidirectional, "mig_uuid", uuid);
         }
     }
 
@@ -151,14 +159,11 @@ int sys_sage::Chip::GetMIGNumSMs(std::string uuid)
     } 
     else
     {
-        for(Relation* r : GetRelationsByType(RelationType::DataPath))
+        for(DataPath* dp : FindMIGDataPaths(this, uuid))
         {
-            DataPath * dp = static_cast<DataPath*>(r);
-            if(dp->GetDataPathType() == DataPathType::MIG && *reinterpret_cast<std::string*>(dp->attrib["mig_uuid"]) == uuid){
-                Component* target = dp->GetTarget();
-                if(target->GetComponentType() == ComponentType::Subdivision && static_cast<Subdivision*>(target)->GetSubdivisionType() == SubdivisionType::GpuSM ){
-                    num_sm++;
-                }
+            Component* target = dp->GetTarget();
+            if(target->GetComponentType() == ComponentType::Subdivision && static_cast<Subdivision*>(target)->GetSubdivisionType() == SubdivisionType::GpuSM ){
+                num_sm++;
             }
         }
     }
@@ -188,14 +193,11 @@ int sys_sage::Chip::GetMIGNumCores(std::string uuid)
     }
     else
     {
-        for(Relation* r : GetRelationsByType(RelationType::DataPath))
+        for(DataPath* dp : FindMIGDataPaths(this, uuid))
         {
-            DataPath * dp = static_cast<DataPath*>(r);
-            if(dp->GetDataPathType() == DataPathType::MIG && *reinterpret_cast<std::string*>(dp->attrib["mig_uuid"]) == uuid){
-                Component* target = dp->GetTarget();
-                if(target->GetComponentType() == ComponentType::Subdivision && static_cast<Subdivision*>(target)->GetSubdivisionType() == SubdivisionType::GpuSM ){
-                    sms.push_back(static_cast<Subdivision*>(target));
-                }
+            Component* target = dp->GetTarget();
+            if(target->GetComponentType() == ComponentType::Subdivision && static_cast<Subdivision*>(target)->GetSubdivisionType() == SubdivisionType::GpuSM ){
+                sms.push_back(static_cast<Subdivision*>(target));
             }
         }
     }
@@ -222,14 +224,11 @@ long long sys_sage::Memory::GetMIGSize(std::string uuid) const
         return size;
     } 
 
-    for(Relation* r : GetRelationsByType(RelationType::DataPath))
+    for(DataPath* dp : FindMIGDataPaths(this, uuid))
     {
-        DataPath * dp = static_cast<DataPath*>(r);
-        if(dp->GetDataPathType() == DataPathType::MIG && *reinterpret_cast<std::string*>(dp->attrib["mig_uuid"]) == uuid){
-            if (dp->attrib.count("mig_size")){
-                long long r = *reinterpret_cast<long long*>(dp->attrib["mig_size"]);
-                return r;
-            }
+        if (dp->attrib.count("mig_size")){
+            long long r = *reinterpret_cast<long long*>(dp->attrib["mig_size"]);
+            return r;
         }
     }
     std::cerr << "Memory::GetMIGSize: no information found about specified UUID " << uuid << " - returning full memory size." << std::endl;
@@ -251,14 +250,11 @@ long long sys_sage::Cache::GetMIGSize(std::string uuid) const
     }
 
     if(GetCacheLevel() == 2){
-        for(Relation* r : GetRelationsByType(RelationType::DataPath))
+        for(DataPath* dp : FindMIGDataPaths(this, uuid))
         {
-            DataPath * dp = static_cast<DataPath*>(r);
-            if(dp->GetDataPathType() == DataPathType::MIG && *reinterpret_cast<std::string*>(dp->attrib["mig_uuid"]) == uuid){
-                if (dp->attrib.count("mig_size")){
-                    long long r = *reinterpret_cast<long long*>(dp->attrib["mig_size"]);
-                    return r;
-                }
+            if (dp->attrib.count("mig_size")){
+                long long r = *reinterpret_cast<long long*>(dp->attrib["mig_size"]);
+                return r;
             }
         }
     }
@@ -13,19 +13,24 @@
 #include <algorithm>
 #include <tuple>
 #include <chrono>
+#include <atomic>
+#include <optional>
 
 #include "Component.hpp"
 #include "Thread.hpp"
 #include "Core.hpp"
 #include "Node.hpp"
 #include "Chip.hpp"
+#include "ColumnStore.hpp"
+#include "TimeSeries.hpp"
+#include "Epoch.hpp"
 
 using std::cout;
 using std::endl;
 
 //retrieve frequency in MHz from /proc/cpuinfo for each thread in std::vector<Thread*> threads
 //helper function is called by RefreshCpuCoreFrequency/RefreshFreq methods
-int _readCpuinfoFreq(std::vector<sys_sage::Thread*> threads, bool keep_history = false)
+int _readCpuinfoFreq(std::vector<sys_sage::Thread*> threads, bool keep_history = false, sys_sage::ColumnStore* columns = nullptr, sys_sage::EpochManager* epochs = nullptr)
 {
     int fd = open("/proc/cpuinfo", O_RDONLY);
     if(fd == -1)
@@ -53,10 +58,12 @@ int _readCpuinfoFreq(std::vector<sys_sage::Thread*> threads, bool keep_history =
 
     ptrdiff_t current_thread_pos = -1;
     int threads_processed = 0;
+    //the frequency of each refreshed core; the columns and the history are updated once the whole file is parsed
+    std::vector<std::pair<sys_sage::Core*, double>> samples;
 
     std::string line;
     size_t pos = 0;
-    while (std::getline(file, line))
+    while (threads_processed < num_threads && std::getline(file, line))
     {
         if (line.rfind("processor", 0) == 0)
         {
@@ -79,34 +86,50 @@ int _readCpuinfoFreq(std::vector<sys_sage::Thread*> threads, bool keep_history =
                 sys_sage::Core* c = static_cast<sys_sage::Core*>(threads[current_thread_pos]->GetAncestorByType(sys_sage::ComponentType::Core));
                 if(c != NULL)
                 {
+                    //atomic, so it needs no WriteGuard
                     static_cast<sys_sage::Core*>(c)->SetFreq(freq);
-                    if(keep_history)
-                    {
-                        //check if freq_history exists; if not, create it -- vector of tuples <timestamp,frequency>
-                        if (c->attrib.find("freq_history") == c->attrib.end()) {
-                            c->attrib["freq_history"] = reinterpret_cast<void*>(new std::vector<std::tuple<long long,double>>());
-                        }
-                        long long ts = std::chrono::high_resolution_clock::now().time_since_epoch().count();
-                        static_cast<std::vector<std::tuple<long long,double>>*>(c->attrib["freq_history"])->push_back(std::make_tuple(ts,freq));
-                    }
+                    samples.emplace_back(c, freq);
                     //cout << "----------------Core " << c->GetId() << " (HW thread " << threads[current_thread_pos]->GetId() << ") frequency: " << freq << endl;
                     threads_processed++;
-                    if(threads_processed == num_threads)
-                    {
-                        close(fd);
-                        return 0;
-                    }
                     current_thread_pos = -1;
                 }
             }
         }
     }
-    cout << "Not all cores updated their Frequency: " << threads_processed << " of total " << num_threads << " processed." << endl;
     close(fd);
-    return 1;
+
+    if(!samples.empty() && (columns != nullptr || keep_history))
+    {
+        //inserting freq_history, appending to it and writing the columns are not atomic -- readers of epochs must not see them half-done
+        std::optional<sys_sage::EpochManager::WriteGuard> writer;
+        if(epochs != nullptr)
+            writer.emplace(*epochs);
+        const sys_sage::AttribId freqKey = sys_sage::InternAttribKey("freq");
+        long long ts = std::chrono::high_resolution_clock::now().time_since_epoch().count();
+        for(auto [c, freq] : samples)
+        {
+            if(columns != nullptr)
+                columns->Set(c, freqKey, freq);
+            if(keep_history)
+            {
+                //check if freq_history exists; if not, create it -- bounded time series of <timestamp,frequency>
+                if (c->attrib.find("freq_history") == c->attrib.end()) {
+                    c->SetAttrib("freq_history", new sys_sage::TimeSeries({"frequency"}, sys_sage::TimeSeries::GetHistoryRetention()));
+                }
+                static_cast<sys_sage::TimeSeries*>(c->attrib["freq_history"])->Append(ts, freq);
+            }
+        }
+    }
+
+    if(num_threads == 0 || threads_processed < num_threads)
+    {
+        cout << "Not all cores updated their Frequency: " << threads_processed << " of total " << num_threads << " processed." << endl;
+        return 1;
+    }
+    return 0;
 }
 
-int sys_sage::Node::RefreshCpuCoreFrequency(bool keep_history)
+int sys_sage::Node::RefreshCpuCoreFrequency(bool keep_history, ColumnStore* columns, EpochManager* epochs)
 {
     std::vector<Component*> sockets = this->FindChildrenByType(ComponentType::Chip);
     std::vector<Thread*> cpu_hw_threads, hw_threads_to_refresh;
@@ -130,27 +153,28 @@ int sys_sage::Node::RefreshCpuCoreFrequency(bool keep_history)
     }
     //cout << endl;
 
-    return _readCpuinfoFreq(hw_threads_to_refresh, keep_history);
+    return _readCpuinfoFreq(hw_threads_to_refresh, keep_history, columns, epochs);
 }
 
-int sys_sage::Core::RefreshFreq(bool keep_history)
+int sys_sage::Core::RefreshFreq(bool keep_history, ColumnStore* columns, EpochManager* epochs)
 {
     std::vector<Thread*> cpu_hw_threads;
     Thread* hw_thread = static_cast<Thread*>(this->GetChildByType(sys_sage::ComponentType::Thread));
     if(hw_thread != NULL)
         cpu_hw_threads.push_back(hw_thread);
-    return _readCpuinfoFreq(cpu_hw_threads, keep_history);
+    return _readCpuinfoFreq(cpu_hw_threads, keep_history, columns, epochs);
 }
 
-int sys_sage::Thread::RefreshFreq(bool keep_history)
+int sys_sage::Thread::RefreshFreq(bool keep_history, ColumnStore* columns, EpochManager* epochs)
 {
     std::vector<Thread*> cpu_hw_threads;
     cpu_hw_threads.push_back(this);
-    return _readCpuinfoFreq(cpu_hw_threads, keep_history);
+    return _readCpuinfoFreq(cpu_hw_threads, keep_history, columns, epochs);
 }
 
-double sys_sage::Core::GetFreq() const {return freq;}
-void sys_sage::Core::SetFreq(double _freq) {freq = _freq;}
+//atomic accesses, so that the frequency can be refreshed while readers of an EpochManager access it
+double sys_sage::Core::GetFreq() const {return std::atomic_ref<double>(const_cast<double&>(freq)).load(std::memory_order_relaxed);}
+void sys_sage::Core::SetFreq(double _freq) {std::atomic_ref<double>(freq).store(_freq, std::memory_order_relaxed);}
 double sys_sage::Thread::GetFreq()
 {
     Core * c = static_cast<Core*>(this->GetAncestorByType(sys_sage::ComponentType::Core));
@@ -151,7 +151,7 @@ static inline void AppendNewCpuMetrics(std::vector<CpuMetrics> *eventMetrics,
 
 static inline void RemoveCpu(Relation *metrics, int cpuNum)
 {
-  const std::vector<Component *> &components = metrics->GetComponents();
+  const RelationComponents& components = metrics->GetComponents();
   
   auto cpuIt = std::find_if(components.begin(), components.end(),
                             [cpuNum](const Component *component)
@@ -203,8 +203,8 @@ static void DeleteEntries(Relation *metrics)
         }
 
         if (eventMetrics->size() == 0) { // no entries left for the event
-            delete eventMetrics;
-            it = metrics->attrib.erase(it);
+            std::string event = (it++)->first;
+            metrics->EraseAttrib(event); // frees eventMetrics
         } else {
             it++;
         }
@@ -243,7 +243,7 @@ static int StorePerfCounters(Relation *metrics, const int *events, int numEvents
         if (eventMetricsIt == metrics->attrib.end()) {
             eventMetrics = new std::vector<CpuMetrics>;
             AppendNewCpuMetrics(eventMetrics, meta->cpuReferenceCounters, ts, counters[i], permanent, cpu->GetId());
-            metrics->attrib[buf] = reinterpret_cast<void *>( eventMetrics );
+            metrics->SetAttrib(buf, eventMetrics);
 
             continue;
         }
@@ -321,7 +321,7 @@ static int AccumPerfCounters(Relation *metrics, const int *events, int numEvents
         if (eventMetricsIt == metrics->attrib.end()) {
             eventMetrics = new std::vector<CpuMetrics>;
             AppendNewCpuMetrics(eventMetrics, meta->cpuReferenceCounters, ts, counters[i], permanent, cpu->GetId());
-            metrics->attrib[buf] = reinterpret_cast<void *>( eventMetrics );
+            metrics->SetAttrib(buf, eventMetrics);
 
             continue;
         }
@@ -389,7 +389,7 @@ int sys_sage::SS_PAPI_start(int eventSet, Relation **metrics)
         std::vector<Component *> empty {};
         *metrics = new Relation(empty, 0, false, RelationCategory::PAPI_Metrics);
 
-        (*metrics)->attrib[metaKey] = reinterpret_cast<void *>( new MetaData{ .startTimestamp = TIME(), .eventSet = eventSet } );
+        (*metrics)->SetAttrib(metaKey, new MetaData{ .startTimestamp = TIME(), .eventSet = eventSet });
     } else {
         if ((*metrics)->GetCategory() != RelationCategory::PAPI_Metrics)
             return PAPI_EINVAL;
@@ -422,7 +422,7 @@ int sys_sage::SS_PAPI_reset(Relation *metrics)
 }
 
 int sys_sage::SS_PAPI_read(Relation *metrics, Component *root, bool permanent,
-                           unsigned long long *timestamp)
+                           unsigned long long *timestamp, EpochManager *epochs)
 {
     if (!metrics || metrics->GetCategory() != RelationCategory::PAPI_Metrics || !root)
         return PAPI_EINVAL;
@@ -451,11 +451,15 @@ int sys_sage::SS_PAPI_read(Relation *metrics, Component *root, bool permanent,
     if (!cpu)
         return PAPI_EINVAL; // TODO: better error handling
 
+    //storing the values may insert attributes and grow the metric vectors
+    std::optional<EpochManager::WriteGuard> writer;
+    if (epochs)
+        writer.emplace(*epochs);
     return StorePerfCounters(metrics, events.get(), numEvents, counters, cpu, permanent, timestamp);
 }
 
 int sys_sage::SS_PAPI_accum(Relation *metrics, Component *root, bool permanent,
-                            unsigned long long *timestamp)
+                            unsigned long long *timestamp, EpochManager *epochs)
 {
     if (!metrics || metrics->GetCategory() != RelationCategory::PAPI_Metrics || !root)
         return PAPI_EINVAL;
@@ -484,11 +488,15 @@ int sys_sage::SS_PAPI_accum(Relation *metrics, Component *root, bool permanent,
     if (!cpu)
         return PAPI_EINVAL; // TODO: better error handling
 
+    //storing the values may insert attributes and grow the metric vectors
+    std::optional<EpochManager::WriteGuard> writer;
+    if (epochs)
+        writer.emplace(*epochs);
     return AccumPerfCounters(metrics, events.get(), numEvents, counters, cpu, permanent, timestamp);
 }
 
 int sys_sage::SS_PAPI_stop(Relation *metrics, Component *root, bool permanent,
-                           unsigned long long *timestamp)
+                           unsigned long long *timestamp, EpochManager *epochs)
 {
     if (!metrics || metrics->GetCategory() != RelationCategory::PAPI_Metrics || !root)
         return PAPI_EINVAL;
@@ -517,6 +525,10 @@ int sys_sage::SS_PAPI_stop(Relation *metrics, Component *root, bool permanent,
     if (!cpu)
         return PAPI_EINVAL; // TODO: better error handling
 
+    //storing the values may insert attributes and grow the metric vectors
+    std::optional<EpochManager::WriteGuard> writer;
+    if (epochs)
+        writer.emplace(*epochs);
     return StorePerfCounters(metrics, events.get(), numEvents, counters, cpu, permanent, timestamp);
 }
 
@@ -873,3 +885,17 @@ std::ostream &operator<<(std::ostream &stream, const Metric &metric)
 {
     return stream << "{ .timestamp = " << metric.timestamp << ", .value = " << metric.value << " }";
 }
+
+size_t sys_sage::_CalcPAPImetricsAttribSize(const std::string &key, const void *value)
+{
+    if (key == metaKey) {
+        auto meta = static_cast<const MetaData *>( value );
+        return sizeof(MetaData) + _UnorderedMapHeapSize(meta->cpuReferenceCounters);
+    }
+
+    auto eventMetrics = static_cast<const std::vector<CpuMetrics> *>( value );
+    size_t size = sizeof(*eventMetrics) + _VectorHeapSize(*eventMetrics);
+    for (const CpuMetrics &cpuMetrics : *eventMetrics)
+        size += _VectorHeapSize(cpuMetrics.entries);
+    return size;
+}
@@ -7,6 +7,7 @@
 #include <unordered_map>
 #include <vector>
 #include <ostream>
+#include <string>
 
 /*! \file */
 
@@ -70,11 +71,15 @@ namespace sys_sage {
      *                  temporary (i.e. can be overwritten).
      * @param timestamp An optional output paramter containing the timestamp of the
      *                  perf counter reading.
+     * @param epochs If not nullptr, the perf counter values are stored in an
+     *               `EpochManager::WriteGuard` of epochs, so that readers in its
+     *               ReadGuards can access the metrics concurrently. Without it,
+     *               the metrics must not be read during the call.
      *
      * @return The return-codes of PAPI have been used. For more info, have a look at PAPI's documentation.
      */
     int SS_PAPI_read(Relation *metrics, Component *root, bool permanent = false,
-                     unsigned long long *timestamp = nullptr);
+                     unsigned long long *timestamp = nullptr, EpochManager *epochs = nullptr);
 
     /**
      * @brief sys-sage wrapper around `PAPI_accum`.
@@ -87,11 +92,15 @@ namespace sys_sage {
      *                  temporary (i.e. can be overwritten).
      * @param timestamp An optional output paramter containing the timestamp of the
      *                  perf counter reading.
+     * @param epochs If not nullptr, the perf counter values are stored in an
+     *               `EpochManager::WriteGuard` of epochs, so that readers in its
+     *               ReadGuards can access the metrics concurrently. Without it,
+     *               the metrics must not be read during the call.
      *
      * @return The return-codes of PAPI have been used. For more info, have a look at PAPI's documentation.
      */
     int SS_PAPI_accum(Relation *metrics, Component *root, bool permanent = false,
-                      unsigned long long *timestamp = nullptr);
+                      unsigned long long *timestamp = nullptr, EpochManager *epochs = nullptr);
 
     /**
      * @brief sys-sage wrapper around `PAPI_stop`.
@@ -104,11 +113,24 @@ namespace sys_sage {
      *                  temporary (i.e. can be overwritten).
      * @param timestamp An optional output paramter containing the timestamp of the
      *                  perf counter reading.
+     * @param epochs If not nullptr, the perf counter values are stored in an
+     *               `EpochManager::WriteGuard` of epochs, so that readers in its
+     *               ReadGuards can access the metrics concurrently. Without it,
+     *               the metrics must not be read during the call.
      *
      * @return The return-codes of PAPI have been used. For more info, have a look at PAPI's documentation.
      */
     int SS_PAPI_stop(Relation *metrics, Component *root, bool permanent = false,
-                     unsigned long long *timestamp = nullptr);
+                     unsigned long long *timestamp = nullptr, EpochManager *epochs = nullptr);
+
+    /**
+     * @private
+     * @brief Returns the size of an attribute value of a relation of category
+     *        `RelationCategory::PAPI_Metrics` (the metadata or the metrics of
+     *        one event), including the heap memory it owns.
+     *        Used by Component::CalcFootprint().
+     */
+    size_t _CalcPAPImetricsAttribSize(const std::string &key, const void *value);
 
 }
 
@@ -1,12 +1,17 @@
 
 #include "caps-numa-benchmark.hpp"
 
+#include "SubtreeIndex.hpp"
+#include "DataPathMatrix.hpp"
+
 #include <iostream>
 #include <fstream>
+#include <tuple>
+#include <unordered_set>
 #include <vector>
 
 
-int sys_sage::parseCapsNumaBenchmark(Component* rootComponent, std::string benchmarkPath, std::string delim)
+int sys_sage::parseCapsNumaBenchmark(Component* rootComponent, std::string benchmarkPath, std::string delim, bool asMatrix)
 {
     CSVReader reader(benchmarkPath, delim);
     std::vector<std::vector<std::string> > benchmarkData;
@@ -46,6 +51,20 @@ int sys_sage::parseCapsNumaBenchmark(Component* rootComponent, std::string bench
         return 1;
     }
 
+    //look the components up through a SubtreeIndex (hash map) instead of searching the subtree twice per row
+    //the temporary index is dropped on every exit, also when stoi()/stoul() throw on a malformed row
+    struct TemporaryIndex {
+        Component* root;
+        ~TemporaryIndex() { if(root != nullptr) root->DisableSubtreeIndex(); }
+    } temporaryIndex{(rootComponent->GetSubtreeIndex() == nullptr) ? rootComponent : nullptr};
+    if(temporaryIndex.root != nullptr)
+        rootComponent->EnableSubtreeIndex();
+
+    //with asMatrix, the rows are collected first, since the matrix needs all its sources and targets
+    std::vector<std::tuple<Component*, Component*, double, double>> entries;
+    std::vector<Component*> sources, targets;
+    std::unordered_set<Component*> seenSources, seenTargets;
+
     //cout << "caps-numa-benchmark parser: num entries: " << benchmarkData.size()-1 << endl;
     //parse each line as one DataPath, skip header
     for(unsigned int i=1; i<benchmarkData.size(); i++)
@@ -69,10 +88,25 @@ int sys_sage::parseCapsNumaBenchmark(Component* rootComponent, std::string bench
             bw = stoul(benchmarkData[i][bw_idx]);
             ldlat = stoul(benchmarkData[i][ldlat_idx]);
 
-            new DataPath(src, target, sys_sage::DataPathOrientation::Oriented, sys_sage::DataPathType::Datatransfer, static_cast<double>(bw), static_cast<double>(ldlat));
+            if(asMatrix)
+            {
+                entries.emplace_back(src, target, static_cast<double>(bw), static_cast<double>(ldlat));
+                if(seenSources.insert(src).second)
+                    sources.push_back(src);
+                if(seenTargets.insert(target).second)
+                    targets.push_back(target);
+            }
+            else
+                new DataPath(src, target, sys_sage::DataPathOrientation::Oriented, sys_sage::DataPathType::Datatransfer, static_cast<double>(bw), static_cast<double>(ldlat));
 
         }
     }
+    if(asMatrix && !entries.empty())
+    {
+        DataPathMatrix* matrix = new DataPathMatrix(sources, targets, sys_sage::DataPathType::Datatransfer);
+        for(const auto& [src, target, bw, ldlat] : entries)
+            matrix->Set(src, target, bw, ldlat);
+    }
     return 0;
 }
 
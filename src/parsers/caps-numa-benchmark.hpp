@@ -6,7 +6,15 @@
 
 
 namespace sys_sage {
-    int parseCapsNumaBenchmark(Component* rootComponent, std::string benchmarkPath, std::string delim = ";");
+    /**
+     * @brief Parses the output of caps-numa-benchmark into DataPaths (of type DataPathType::Datatransfer) from the source CPUs (Threads) or NUMA nodes to the target NUMA nodes.
+     * @param rootComponent Root of the subtree containing the measured components
+     * @param benchmarkPath Path to the CSV output
+     * @param delim Delimiter of the CSV output
+     * @param asMatrix Store the measurements in one DataPathMatrix (sources in the order of their first appearance) instead of one DataPath per row
+     * @return 0 on success, 1 if the file cannot be parsed
+     */
+    int parseCapsNumaBenchmark(Component* rootComponent, std::string benchmarkPath, std::string delim = ";", bool asMatrix = false);
 
     class CSVReader
     {
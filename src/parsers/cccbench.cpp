@@ -6,9 +6,11 @@
 #include <string>
 #include <vector>
 #include <exception>
+#include <limits>
 //#include <bits/stdc++.h>
 #include <sstream>
 #include "cccbench.hpp"
+#include "DataPathMatrix.hpp"
 
 using namespace std;
 
@@ -107,18 +109,53 @@ void sys_sage::CccbenchParser::applyDataPaths(Component *root)
             auto min = new float(*min_element(xtoylatv.begin(), xtoylatv.end()));
             auto dtp = new DataPath(xcore, ycore, sys_sage::DataPathOrientation::Oriented,
                                    sys_sage::DataPathType::C2C, 0, *mean);
-            dtp->attrib.insert(std::pair<string, void *>("latency_max", reinterpret_cast<void*>(max)));
-            dtp->attrib.insert(std::pair<string, void *>("latency_min", reinterpret_cast<void*>(min)));
-            dtp->attrib.insert(std::pair<string, void *>("latency", reinterpret_cast<void*>(mean)));
+            dtp->SetAttrib("latency_max", max);
+            dtp->SetAttrib("latency_min", min);
+            dtp->SetAttrib("latency", mean);
         }
     }
 }
 
-int sys_sage::parseCccbenchOutput(Node* n, std::string cccPath)
+void sys_sage::CccbenchParser::applyDataPathMatrix(Component *root)
+{
+    vector<Component *> corev;
+    root->FindDescendantsByType(&corev, sys_sage::ComponentType::Core);
+    auto matrix = new DataPathMatrix(corev, sys_sage::DataPathType::C2C);
+    //minimal and maximal latencies, row-major like the mean latencies of the matrix (see DataPathMatrix::GetLatencyRow())
+    vector<double> latencyMin(corev.size() * corev.size(), numeric_limits<double>::quiet_NaN());
+    vector<double> latencyMax(corev.size() * corev.size(), numeric_limits<double>::quiet_NaN());
+
+    for(size_t x = 0; x < corev.size(); x++)
+    {
+        for(size_t y = 0; y < corev.size(); y++)
+        {
+            auto xci = corev[x]->GetId();
+            auto yci = corev[y]->GetId();
+            if(xci == yci)
+            {
+                continue;
+            }
+            const vector<float>& xtoylatv = (*this->c2cDatapoints)[xci][yci];
+            if(xtoylatv.empty())
+                continue;
+            auto sum = accumulate(xtoylatv.begin(), xtoylatv.end(), 0.0);
+            matrix->Set(x, y, 0, sum / xtoylatv.size());
+            latencyMin[x * corev.size() + y] = *min_element(xtoylatv.begin(), xtoylatv.end());
+            latencyMax[x * corev.size() + y] = *max_element(xtoylatv.begin(), xtoylatv.end());
+        }
+    }
+    matrix->SetAttr("latency_min", std::move(latencyMin));
+    matrix->SetAttr("latency_max", std::move(latencyMax));
+}
+
+int sys_sage::parseCccbenchOutput(Node* n, std::string cccPath, bool asMatrix)
 {
     const char *cstr_path = cccPath.c_str();
     auto cccparser = new CccbenchParser(cstr_path);
-    cccparser->applyDataPaths(n);
+    if(asMatrix)
+        cccparser->applyDataPathMatrix(n);
+    else
+        cccparser->applyDataPaths(n);
     delete cccparser;
     return 0;
 }
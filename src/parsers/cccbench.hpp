@@ -12,7 +12,12 @@
 
 
 namespace sys_sage {
-    int parseCccbenchOutput(Node* , std::string );
+    /**
+     * @brief Parses the output of cccbench into core-to-core DataPaths (of type DataPathType::C2C) among the Cores of n.
+     * @param asMatrix Store the mean latencies in one DataPathMatrix instead of one DataPath (with "latency", "latency_min" and "latency_max" attributes) per pair of Cores;
+     * the minimal and maximal latencies are then kept in the "latency_min" and "latency_max" attributes of the matrix (see CccbenchParser::applyDataPathMatrix())
+     */
+    int parseCccbenchOutput(Node* , std::string, bool asMatrix = false);
 
     template <typename T>class Vec2DArray
     {
@@ -21,6 +26,9 @@ namespace sys_sage {
         unsigned int size, xdim, ydim;
     public:
         Vec2DArray(unsigned xdim, unsigned ydim);
+        ~Vec2DArray(){delete [] array;}
+        Vec2DArray(const Vec2DArray&) = delete;
+        Vec2DArray& operator=(const Vec2DArray&) = delete;
         std::vector<T> *operator [](unsigned int xindex);
     };
 
@@ -47,11 +55,17 @@ namespace sys_sage {
         Vec2DArray<float> *c2cDatapoints;
         CccbenchParser():c2cDatapoints((Vec2DArray<float> *)0){}
     public:
-        virtual ~CccbenchParser(){if(this->c2cDatapoints) {delete [] c2cDatapoints;}}
+        virtual ~CccbenchParser(){delete c2cDatapoints;}
         unsigned int xtoi(unsigned int _x){return _x - this->firstCore;}
         unsigned int ytoi(unsigned int _y){return _y - this->firstCore;}
         CccbenchParser(const char *csv_path);
         void applyDataPaths(Component *root);
+        /**
+         * Stores the mean latencies among the Cores of root in one DataPathMatrix (of type DataPathType::C2C), instead of N*(N-1) DataPaths.
+         * The minimal and maximal latencies are stored as typed std::vector<double> attributes "latency_min" and "latency_max" of the matrix, row-major with one row per source (the entry of row r and column c is at r * GetNumTargets() + c, as in GetLatencyRow()).
+         * Pairs without measurements are not set (NaN).
+         */
+        void applyDataPathMatrix(Component *root);
     };
 
 } //namespace sys_sage
@@ -140,6 +140,7 @@ int sys_sage::xmlProcessChildren(Component* c, xmlNode* parent, int level)
                         {
                             //cout << "inserting " << type << " to " << c->GetName() << endl;
                             childC = createChildC(type, child);
+                            childC->ReserveChildren(xmlChildElementCount(child)); //upper bound (also counts info nodes)
 
                             bool inserted_as_sibling = false;
                             if(childC->GetComponentType() == sys_sage::ComponentType::Cache)
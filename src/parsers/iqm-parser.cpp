@@ -7,17 +7,17 @@
 #include <sstream>
 
 
-int sys_sage::parseIQM(Component* parent, std::string dataSourcePath, int qcId, int tsForHistory)
+int sys_sage::parseIQM(Component* parent, std::string dataSourcePath, int qcId, int tsForHistory, ColumnStore* columns)
 {
     if(parent == NULL){
         std::cerr << "parseIQM: parent is null" << std::endl;
         return 1;
     }
     QuantumBackend* qc = new QuantumBackend(parent,qcId);
-    return parseIQM(qc, dataSourcePath, qcId, tsForHistory, true);   
+    return parseIQM(qc, dataSourcePath, qcId, tsForHistory, true, columns);   
 }
 
-int sys_sage::parseIQM(QuantumBackend* qc, std::string dataSourcePath, int qcId, int tsForHistory, bool createTopo)
+int sys_sage::parseIQM(QuantumBackend* qc, std::string dataSourcePath, int qcId, int tsForHistory, bool createTopo, ColumnStore* columns)
 {
     IQMParser iqm(qc,dataSourcePath);
     int ret;
@@ -30,7 +30,7 @@ int sys_sage::parseIQM(QuantumBackend* qc, std::string dataSourcePath, int qcId,
     }
     
     //assumes that the qubits and coupling mappings are already in place
-    ret = iqm.ParseDynamicData(tsForHistory);
+    ret = iqm.ParseDynamicData(tsForHistory, columns);
     return ret;
 }
 
@@ -78,17 +78,17 @@ int sys_sage::IQMParser::CreateQcTopo()
     }
 
     //create attrib keys "T1_max", "T2_max", "q1_fidelity_max", "readout_fidelity_max", "two_q_fidelity_max"
-    backend->attrib["T1_max"] = static_cast<void*>(new double());
-    backend->attrib["T2_max"] = static_cast<void*>(new double());
-    backend->attrib["q1_fidelity_max"] = static_cast<void*>(new double());
-    backend->attrib["readout_fidelity_max"] = static_cast<void*>(new double());
-    backend->attrib["two_q_fidelity_max"] = static_cast<void*>(new double());
+    backend->SetAttrib("T1_max", new double());
+    backend->SetAttrib("T2_max", new double());
+    backend->SetAttrib("q1_fidelity_max", new double());
+    backend->SetAttrib("readout_fidelity_max", new double());
+    backend->SetAttrib("two_q_fidelity_max", new double());
 
     return 0;
 }
 
 
-int sys_sage::IQMParser::ParseDynamicData(int tsForHistory)
+int sys_sage::IQMParser::ParseDynamicData(int tsForHistory, ColumnStore* columns)
 {
     double max;
     std::vector<double> T1;
@@ -138,13 +138,25 @@ int sys_sage::IQMParser::ParseDynamicData(int tsForHistory)
         q->SetProperties(T1[i], T2[i], readout_fidelity[i], q1_fidelity[i]);
         if(tsForHistory > 0)
         {
-            //check if readout_history exists; if not, create it -- vector of tuples <timestamp,t1,t2,readout_fidelity,q1_fidelity>
+            //check if readout_history exists; if not, create it -- bounded time series of <timestamp,t1,t2,readout_fidelity,q1_fidelity>
             if(! q->attrib.contains("readout_history"))
-                q->attrib["readout_history"] = reinterpret_cast<void*>(new std::vector<std::tuple<int,double,double,double,double>>());
-            auto rh = reinterpret_cast<std::vector<std::tuple<int,double,double,double,double>>*>(q->attrib["readout_history"]);
-            rh->emplace_back(tsForHistory, T1[i], T2[i], readout_fidelity[i], q1_fidelity[i]);
+                q->SetAttrib("readout_history", new TimeSeries({"t1", "t2", "readout_fidelity", "q1_fidelity"}, TimeSeries::GetHistoryRetention()));
+            auto rh = reinterpret_cast<TimeSeries*>(q->attrib["readout_history"]);
+            rh->Append(tsForHistory, {T1[i], T2[i], readout_fidelity[i], q1_fidelity[i]});
         }
     }
+    if(columns != nullptr)
+    {
+        //bulk update of the whole columns, in the order of the values in the json
+        std::vector<Component*> qubits;
+        for(int i=0; i<backend->GetNumQubits(); i++)
+            qubits.push_back(backend->GetChildById(i));
+        columns->Set(qubits, InternAttribKey("T1"), T1);
+        columns->Set(qubits, InternAttribKey("T2"), T2);
+        columns->Set(qubits, InternAttribKey("readout_fidelity"), readout_fidelity);
+        columns->Set(qubits, InternAttribKey("q1_fidelity"), q1_fidelity);
+    }
+
     std::map<std::string, std::string> two_q_fidelity = jsonData["two_q_fidelity"];
     max = 0;
     for(auto [cm_str,fidelity_str] : two_q_fidelity)
@@ -167,11 +179,11 @@ int sys_sage::IQMParser::ParseDynamicData(int tsForHistory)
                         
                 if(tsForHistory > 0)
                 {
-                    //check if readout_history exists; if not, create it -- vector of tuples <timestamp,fidelity>
+                    //check if readout_history exists; if not, create it -- bounded time series of <timestamp,fidelity>
                     if(! cm->attrib.contains("readout_history"))
-                        cm->attrib["readout_history"] = reinterpret_cast<void*>(new std::vector<std::tuple<int,double>>());
-                    auto rh = reinterpret_cast<std::vector<std::tuple<int,double>>*>(cm->attrib["readout_history"]);
-                    rh->emplace_back(tsForHistory, fidelity);
+                        cm->SetAttrib("readout_history", new TimeSeries({"fidelity"}, TimeSeries::GetHistoryRetention()));
+                    auto rh = reinterpret_cast<TimeSeries*>(cm->attrib["readout_history"]);
+                    rh->Append(tsForHistory, fidelity);
                 }
 
                 break;
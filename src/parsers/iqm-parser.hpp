@@ -15,13 +15,16 @@
 #include "QuantumBackend.hpp"
 #include "Qubit.hpp"
 #include "CouplingMap.hpp"
+#include "ColumnStore.hpp"
+#include "TimeSeries.hpp"
 
 using json = nlohmann::json;
 
 namespace sys_sage {
     //user calls only these functions
-    int parseIQM(Component* parent, std::string dataSourcePath, int qcId, int tsForHistory = -1);
-    int parseIQM(QuantumBackend* parent, std::string dataSourcePath, int qcId, int tsForHistory = -1, bool createTopo = true);
+    //if columns is not nullptr, the calibration data of the Qubits is also written into its "T1", "T2", "readout_fidelity" and "q1_fidelity" columns (see ColumnStore)
+    int parseIQM(Component* parent, std::string dataSourcePath, int qcId, int tsForHistory = -1, ColumnStore* columns = nullptr);
+    int parseIQM(QuantumBackend* parent, std::string dataSourcePath, int qcId, int tsForHistory = -1, bool createTopo = true, ColumnStore* columns = nullptr);
 
     class IQMParser
     {
@@ -29,7 +32,7 @@ namespace sys_sage {
 
         IQMParser(QuantumBackend* _qc,std::string filepath);
         int CreateQcTopo();
-        int ParseDynamicData(int tsForHistory);
+        int ParseDynamicData(int tsForHistory, ColumnStore* columns = nullptr);
     private:
         double t1_max, t2_max, q1_fidelity_max, readout_fidelity_max;
 
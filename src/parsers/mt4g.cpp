@@ -26,14 +26,14 @@ static void ParseGeneral(const json &general, Chip *gpu)
   gpu->SetModel(general["name"].get<std::string>());
   gpu->SetVendor(general["vendor"].get<std::string>());
 
-  gpu->attrib["computeCapability"] = reinterpret_cast<void *>(
+  gpu->SetAttrib("computeCapability",
     new std::pair<int, int> {
           general["computeCapability"]["major"].get<int>(),
           general["computeCapability"]["minor"].get<int>()
         }
   );
 
-  gpu->attrib["clockRate"] = reinterpret_cast<void *>(
+  gpu->SetAttrib("clockRate",
     // the clockRate field is actually of type `int`, but due to the conversion
     // from [kHz] to [Hz], it might be better to use `long long` to avoid
     // overflows
@@ -44,35 +44,35 @@ static void ParseGeneral(const json &general, Chip *gpu)
 static std::tuple<int, uint32_t> ParseCompute(const json &compute, Chip *gpu)
 {
   auto multiProcessorCount = new int( compute["multiProcessorCount"].get<int>() );
-  gpu->attrib["multiProcessorCount"] = reinterpret_cast<void *>( multiProcessorCount );
+  gpu->SetAttrib("multiProcessorCount", multiProcessorCount);
 
   auto numberOfCoresPerMultiProcessor = new uint32_t( compute["numberOfCoresPerMultiProcessor"].get<uint32_t>() );
-  gpu->attrib["numberOfCoresPerMultiProcessor"] = reinterpret_cast<void *>( numberOfCoresPerMultiProcessor );
+  gpu->SetAttrib("numberOfCoresPerMultiProcessor", numberOfCoresPerMultiProcessor);
 
-  gpu->attrib["maxThreadsPerBlock"] = reinterpret_cast<void *>(
+  gpu->SetAttrib("maxThreadsPerBlock",
     new int( compute["maxThreadsPerBlock"].get<int>() )
   );
 
   // TODO: maybe parse register info?
 
-  gpu->attrib["warpSize"] = reinterpret_cast<void *>(
+  gpu->SetAttrib("warpSize",
     new int( compute["warpSize"].get<int>() )
   );
-  gpu->attrib["maxThreadsPerMultiProcessor"] = reinterpret_cast<void *>(
+  gpu->SetAttrib("maxThreadsPerMultiProcessor",
     new int( compute["maxThreadsPerMultiProcessor"].get<int>() )
   );
-  gpu->attrib["maxBlocksPerMultiProcessor"] = reinterpret_cast<void *>(
+  gpu->SetAttrib("maxBlocksPerMultiProcessor",
     new int( compute["maxBlocksPerMultiProcessor"].get<int>() )
   );
 
   if (auto it = compute.find("numXDCDs"); it != compute.end())
-    gpu->attrib["numXDCDs"] = reinterpret_cast<void *>( new uint32_t(it->get<uint32_t>()) );
+    gpu->SetAttrib("numXDCDs", new uint32_t(it->get<uint32_t>()));
 
   if (auto it = compute.find("computeUnitsPerDie"); it != compute.end())
-    gpu->attrib["computeUnitsPerDie"] = reinterpret_cast<void *>( new uint32_t(it->get<uint32_t>()) );
+    gpu->SetAttrib("computeUnitsPerDie", new uint32_t(it->get<uint32_t>()));
 
   if (auto it = compute.find("numSIMDsPerCu"); it != compute.end())
-    gpu->attrib["numSIMDsPerCu"] = reinterpret_cast<void *>( new uint32_t(it->get<uint32_t>()) );
+    gpu->SetAttrib("numSIMDsPerCu", new uint32_t(it->get<uint32_t>()));
 
 
   return { *multiProcessorCount, *numberOfCoresPerMultiProcessor };
@@ -86,10 +86,10 @@ static void ParseMainMemory(const json &main, std::vector<Component *> &cores,
 
   auto mainMem = new Memory(leafs[0], 0, "GPU Main Memory", size);
 
-  mainMem->attrib["clockRate"] = reinterpret_cast<void *>(
+  mainMem->SetAttrib("clockRate",
     new long long ( kHz_to_Hz(main["memoryClockRate"]["value"].get<int>()) )
   );
-  mainMem->attrib["busWidth"] = reinterpret_cast<void *>(
+  mainMem->SetAttrib("busWidth",
     new int ( main["memoryBusWidth"]["value"].get<int>() )
   );
 
@@ -99,12 +99,13 @@ static void ParseMainMemory(const json &main, std::vector<Component *> &cores,
     double readBandwidth = GiBs_to_Bs( main["readBandwidth"]["value"].get<double>() );
     double writeBandwidth = GiBs_to_Bs( main["writeBandwidth"]["value"].get<double>() );
 
+    mainMem->ReserveRelations(RelationType::DataPath, cores.size());
     for (auto core : cores) {
       // bidirectional, because we have read & write bandwidth
       auto dp = new DataPath(mainMem, core, DataPathOrientation::Bidirectional,
                              DataPathType::Logical, -1, latency);
-      dp->attrib["readBandwidth"] = reinterpret_cast<void *>( new double (readBandwidth) );
-      dp->attrib["writeBandwidth"] = reinterpret_cast<void *>( new double (writeBandwidth) );
+      dp->SetAttrib("readBandwidth", new double (readBandwidth));
+      dp->SetAttrib("writeBandwidth", new double (writeBandwidth));
     }
   }
 
@@ -131,8 +132,8 @@ static void ParseL3Caches(const json &l3, std::vector<Component *> &cores,
   size_t id = 0;
 
   for (auto leaf : leafs)
-    for (size_t i = 0; i < amountPerLeaf; i++, id++)
-      l3Caches[id] = new Cache(leaf, id, "L3", size, -1, lineSize);
+    for (Cache *l3Cache : leaf->CreateChildren<Cache>(amountPerLeaf, id, "L3", size, -1, lineSize))
+      l3Caches[id++] = l3Cache;
 
   // the existence of `readBandwidth` implies the existence of `writeBandwidth`
   if (auto it = l3.find("readBandwidth"); it != l3.end()) {
@@ -140,11 +141,12 @@ static void ParseL3Caches(const json &l3, std::vector<Component *> &cores,
     double writeBandwidth = GiBs_to_Bs( l3["writeBandwidth"]["value"].get<double>() );
 
     for (auto l3Cache : l3Caches) {
+      l3Cache->ReserveRelations(RelationType::DataPath, cores.size());
       for (auto core : cores) {
         auto dp = new DataPath(l3Cache, core, DataPathOrientation::Bidirectional,
                                DataPathType::Logical, -1, -1);
-        dp->attrib["readBandwidth"] = reinterpret_cast<void *>( new double (readBandwidth) );
-        dp->attrib["writeBandwidth"] = reinterpret_cast<void *>( new double (writeBandwidth) );
+        dp->SetAttrib("readBandwidth", new double (readBandwidth));
+        dp->SetAttrib("writeBandwidth", new double (writeBandwidth));
       }
     }
   }
@@ -179,13 +181,13 @@ static void ParseL2Caches(const json &l2, std::vector<Component *> &cores,
   size_t id = 0;
 
   for (auto leaf : leafs) {
-    for (size_t i = 0; i < amountPerLeaf; i++, id++) {
-      l2Caches[id] = new Cache(leaf, id, "L2", size, -1, lineSize);
-
+    for (Cache *l2Cache : leaf->CreateChildren<Cache>(amountPerLeaf, id, "L2", size, -1, lineSize)) {
       if (fetchGranularity > 0)
-        l2Caches[id]->attrib["fetchGranularity"] = reinterpret_cast<void *>( new size_t(fetchGranularity) );
+        l2Cache->SetAttrib("fetchGranularity", new size_t(fetchGranularity));
       if (segmentSize > 0)
-        l2Caches[id]->attrib["segmentSize"] = reinterpret_cast<void *>( new size_t(segmentSize) );
+        l2Cache->SetAttrib("segmentSize", new size_t(segmentSize));
+
+      l2Caches[id++] = l2Cache;
     }
   }
 
@@ -198,13 +200,14 @@ static void ParseL2Caches(const json &l2, std::vector<Component *> &cores,
       missPenalty = (*missPenaltyIt)["value"].get<double>();
 
     for (auto l2Cache : l2Caches) {
+      l2Cache->ReserveRelations(RelationType::DataPath, cores.size());
       for (auto core : cores) {
         auto dp = new DataPath(l2Cache, core, DataPathOrientation::Bidirectional,
                                DataPathType::Logical, -1, latency);
-        dp->attrib["readBandwidth"] = reinterpret_cast<void *>( new double (readBandwidth) );
-        dp->attrib["writeBandwidth"] = reinterpret_cast<void *>( new double (writeBandwidth) );
+        dp->SetAttrib("readBandwidth", new double (readBandwidth));
+        dp->SetAttrib("writeBandwidth", new double (writeBandwidth));
         if (missPenalty > 0)
-          dp->attrib["missPenalty"] = reinterpret_cast<void *>( new double (missPenalty) );
+          dp->SetAttrib("missPenalty", new double (missPenalty));
       }
     }
   }
@@ -240,11 +243,12 @@ static bool ParseScalarL1Caches(const json &scalarL1,
     for (size_t i = 0; i < amountPerLeaf; i++, id++) {
       scalarL1Caches[id] = new Cache(leaf, id, "Scalar L1", size, -1, lineSize);
 
-      scalarL1Caches[id]->attrib["fetchGranularity"] = reinterpret_cast<void *>(
+      scalarL1Caches[id]->SetAttrib("fetchGranularity",
         new size_t (fetchGranularity)
       );
 
       if (insertMPs) {
+        scalarL1Caches[id]->ReserveChildren((*sharedBetweenIt)[id].size());
         for (const auto &elem : (*sharedBetweenIt)[id]) {
           (*mpIt)->SetId(elem.get<int>());
           scalarL1Caches[id]->InsertChild(*mpIt);
@@ -269,11 +273,12 @@ static bool ParseScalarL1Caches(const json &scalarL1,
     size_t numMPs = insertMPs ? scalarL1Cache->GetChildren().size() : defaultAmountMPsPerScalarL1Cache;
     size_t numCores = numMPs * numCoresPerMP;
 
+    scalarL1Cache->ReserveRelations(RelationType::DataPath, numCores);
     for (size_t i = 0; i < numCores; i++, coreIt++) {
       auto dp = new DataPath(scalarL1Cache, *coreIt, DataPathOrientation::Oriented,
                              DataPathType::Logical, -1, latency);
       if (missPenalty > 0)
-        dp->attrib["missPenalty"] = reinterpret_cast<void *>( new double (missPenalty) );
+        dp->SetAttrib("missPenalty", new double (missPenalty));
     }
   }
 
@@ -302,9 +307,11 @@ static void ParseConstantCaches(const json &constant,
 
     auto coreIt = cores.begin();
 
-    for (auto constantCache : constantCaches)
+    for (auto constantCache : constantCaches) {
+      constantCache->ReserveRelations(RelationType::DataPath, numCoresPerMP);
       for (size_t i = 0; i < numCoresPerMP; i++, coreIt++)
         new DataPath(constantCache, *coreIt, DataPathOrientation::Oriented, DataPathType::Logical);
+    }
 
     return;
   }
@@ -327,7 +334,7 @@ static void ParseConstantCaches(const json &constant,
   for (auto mp : mps) {
     cL1_5Caches[cL1_5Id] = new Cache(mp, cL1_5Id, "Constant L1.5", cL1_5Size, -1, cL1_5LineSize);
 
-    cL1_5Caches[cL1_5Id]->attrib["fetchGranularity"] = reinterpret_cast<void *>(
+    cL1_5Caches[cL1_5Id]->SetAttrib("fetchGranularity",
       new size_t (cL1_5FetchGranularity)
     );
 
@@ -339,9 +346,11 @@ static void ParseConstantCaches(const json &constant,
 
     auto coreIt = cores.begin();
 
-    for (auto cL1_5Cache : cL1_5Caches)
+    for (auto cL1_5Cache : cL1_5Caches) {
+      cL1_5Cache->ReserveRelations(RelationType::DataPath, numCoresPerMP);
       for (size_t i = 0; i < numCoresPerMP; i++, coreIt++)
         new DataPath(cL1_5Cache, *coreIt, DataPathOrientation::Oriented, DataPathType::Logical, -1, cL1_5Latency);
+    }
   }
 
   const json &cL1 = constant["l1"];
@@ -363,9 +372,10 @@ static void ParseConstantCaches(const json &constant,
   size_t cL1Id = 0;
 
   for (auto cL1_5Cache : cL1_5Caches) {
-    for (uint32_t i = 0; i < amountPerMP; i++, cL1Id++) {
-      cL1Caches[cL1Id] = new Cache(cL1_5Cache, cL1Id, "Constant L1", cL1LineSize, -1, cL1Size);
-      cL1Caches[cL1Id]->attrib["fetchGranularity"] = reinterpret_cast<void *>( new size_t (cL1FetchGranularity) );
+    for (Cache *cL1Cache : cL1_5Cache->CreateChildren<Cache>(amountPerMP, cL1Id, "Constant L1", cL1LineSize, -1, cL1Size)) {
+      cL1Cache->SetAttrib("fetchGranularity", new size_t (cL1FetchGranularity));
+      cL1Cache->ReserveRelations(RelationType::DataPath, numCoresPerMP);
+      cL1Caches[cL1Id++] = cL1Cache;
     }
   }
 
@@ -381,7 +391,7 @@ static void ParseConstantCaches(const json &constant,
         auto dp = new DataPath(cL1Caches[k + i * amountPerMP], cores[j + i * numCoresPerMP], DataPathOrientation::Oriented, DataPathType::Logical, -1, cL1Latency);
 
         if (cL1MissPenalty > 0)
-          dp->attrib["missPenalty"] = reinterpret_cast<void *>( new double (cL1MissPenalty) );
+          dp->SetAttrib("missPenalty", new double (cL1MissPenalty));
       }
     }
   }
@@ -407,11 +417,13 @@ static void ParseSharedMemory(const json &shared, std::vector<Component *> &mps,
   for (auto mp : mps) {
     auto sharedMem = new Memory(mp, id++, "Shared Memory", memPerMultiProcessor);
 
-    sharedMem->attrib["memPerBlock"] = reinterpret_cast<void *>( new long long (memPerBlock) );
+    sharedMem->SetAttrib("memPerBlock", new long long (memPerBlock));
 
-    if (latency > 0)
+    if (latency > 0) {
+      sharedMem->ReserveRelations(RelationType::DataPath, numCoresPerMP);
       for (size_t i = 0; i < numCoresPerMP; i++, coreIt++)
         new DataPath(sharedMem, *coreIt, DataPathOrientation::Oriented, DataPathType::Logical, -1, latency);
+    }
   }
 }
 
@@ -458,11 +470,11 @@ ParseL1Caches(const json &l1, std::vector<Component *> &mps,
   size_t id = 0;
 
   for (auto mp : mps) {
-    for (uint32_t i = 0; i < amountPerMP; i++, id++) {
-      l1Caches[id] = new Cache(mp, id, name, size, -1, lineSize);
-
+    for (Cache *l1Cache : mp->CreateChildren<Cache>(amountPerMP, id, name, size, -1, lineSize)) {
       if (fetchGranularity > 0)
-        l1Caches[id]->attrib["fetchGranularity"] = reinterpret_cast<void *>( new double(fetchGranularity) );
+        l1Cache->SetAttrib("fetchGranularity", new double(fetchGranularity));
+
+      l1Caches[id++] = l1Cache;
     }
   }
 
@@ -470,8 +482,8 @@ ParseL1Caches(const json &l1, std::vector<Component *> &mps,
   auto coreIt = cores.begin();
 
   for (auto l1Cache : l1Caches) {
-    for (size_t i = 0; i < amountCoresPerL1Cache; i++, coreIt++)
-      l1Cache->InsertChild(*coreIt);
+    l1Cache->InsertChildren(std::vector<Component *>(coreIt, coreIt + amountCoresPerL1Cache));
+    coreIt += amountCoresPerL1Cache;
   }
 
   if (auto it = l1.find("latency"); it != l1.end()) {
@@ -481,13 +493,16 @@ ParseL1Caches(const json &l1, std::vector<Component *> &mps,
     if (auto missPenaltyIt = l1.find("missPenalty"); missPenaltyIt != l1.end())
       missPenalty = (*missPenaltyIt)["value"].get<double>();
 
+    for (auto l1Cache : l1Caches)
+      l1Cache->ReserveRelations(RelationType::DataPath, numCoresPerMP);
+
     for (size_t i = 0; i < mps.size(); i++) {
       for (size_t j = 0; j < numCoresPerMP; j++) {
         for (uint32_t k = 0; k < amountPerMP; k++) {
           auto dp = new DataPath(l1Caches[k + i * amountPerMP], cores[j + i * numCoresPerMP], DataPathOrientation::Oriented, DataPathType::Logical, -1, latency);
 
           if (missPenalty > 0)
-            dp->attrib["missPenalty"] = reinterpret_cast<void *>( new double (missPenalty) );
+            dp->SetAttrib("missPenalty", new double (missPenalty));
         }
       }
     }
@@ -529,9 +544,10 @@ static bool ParseTextureCaches(const json &texture, std::vector<Component *> &mp
   size_t id = 0;
 
   for (auto mp : mps) {
-    for (uint32_t i = 0; i < amountPerMP; i++, id++) {
-      textureCaches[id] = new Cache(mp, id, name, size, -1, lineSize);
-      textureCaches[id]->attrib["fetchGranularity"] = reinterpret_cast<void *>( new int(fetchGranularity) );
+    for (Cache *textureCache : mp->CreateChildren<Cache>(amountPerMP, id, name, size, -1, lineSize)) {
+      textureCache->SetAttrib("fetchGranularity", new int(fetchGranularity));
+      textureCache->ReserveRelations(RelationType::DataPath, numCoresPerMP);
+      textureCaches[id++] = textureCache;
     }
   }
 
@@ -547,7 +563,7 @@ static bool ParseTextureCaches(const json &texture, std::vector<Component *> &mp
         auto dp = new DataPath(textureCaches[k + i * amountPerMP], cores[j + i * numCoresPerMP], DataPathOrientation::Oriented, DataPathType::Logical, -1, latency);
 
         if (missPenalty > 0)
-          dp->attrib["missPenalty"] = reinterpret_cast<void *>( new double (missPenalty) );
+          dp->SetAttrib("missPenalty", new double (missPenalty));
       }
     }
   }
@@ -577,9 +593,10 @@ static void ParseReadOnlyCaches(const json &readOnly, std::vector<Component *> &
   size_t id = 0;
 
   for (auto mp : mps) {
-    for (uint32_t i = 0; i < amountPerMP; i++, id++) {
-      readOnlyCaches[id] = new Cache(mp, id, "Read Only", size, -1, lineSize);
-      readOnlyCaches[id]->attrib["fetchGranularity"] = reinterpret_cast<void *>( new int(fetchGranularity) );
+    for (Cache *readOnlyCache : mp->CreateChildren<Cache>(amountPerMP, id, "Read Only", size, -1, lineSize)) {
+      readOnlyCache->SetAttrib("fetchGranularity", new int(fetchGranularity));
+      readOnlyCache->ReserveRelations(RelationType::DataPath, numCoresPerMP);
+      readOnlyCaches[id++] = readOnlyCache;
     }
   }
 
@@ -595,7 +612,7 @@ static void ParseReadOnlyCaches(const json &readOnly, std::vector<Component *> &
         auto dp = new DataPath(readOnlyCaches[k + i * amountPerMP], cores[j + i * numCoresPerMP], DataPathOrientation::Oriented, DataPathType::Logical, -1, latency);
 
         if (missPenalty > 0)
-          dp->attrib["missPenalty"] = reinterpret_cast<void *>( new double (missPenalty) );
+          dp->SetAttrib("missPenalty", new double (missPenalty));
       }
     }
   }
@@ -620,9 +637,10 @@ static void ParseGlobalMemory(const json &memory, Chip *gpu,
   size_t amountPerLeaf = mps.size() / leafs.size();
   auto mpIt = mps.begin();
 
-  for (auto leaf : leafs)
-    for (size_t i = 0; i < amountPerLeaf; i++, mpIt++)
-      leaf->InsertChild(*mpIt);
+  for (auto leaf : leafs) {
+    leaf->InsertChildren(std::vector<Component *>(mpIt, mpIt + amountPerLeaf));
+    mpIt += amountPerLeaf;
+  }
 
   // at the end of the function, the leafs are the lowest level of global
   // memory/cache and the MPs are inserted as the leafs' children
@@ -686,8 +704,12 @@ int sys_sage::ParseMt4g_v1_x(Chip *gpu, const std::string &path)
     mps[i] = new Subdivision(i, "Multiprocessor");
     static_cast<Subdivision *>(mps[i])->SetSubdivisionType(sys_sage::SubdivisionType::GpuSM);
   }
-  for (size_t i = 0; i < numCores; i++)
+  // roughly one DataPath per memory element (plus one for the two levels of constant caches) ends at each core
+  size_t numDataPathsPerCore = data["memory"].size() + 1;
+  for (size_t i = 0; i < numCores; i++) {
     cores[i] = new Thread(i, "GPU Core");
+    cores[i]->ReserveRelations(RelationType::DataPath, numDataPathsPerCore);
+  }
 
   ParseGlobalMemory(data["memory"], gpu, mps, cores);
 
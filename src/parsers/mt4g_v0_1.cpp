@@ -263,7 +263,7 @@ int Mt4gParser::parseCOMPUTE_RESOURCE_INFORMATION()
                 return 1;
             }
             std::string * val = new std::string(data[i+1]);
-            root->attrib.insert({data[i], reinterpret_cast<void*>(val)});
+            root->SetAttrib(data[i], val);
             i++;
         }
         else if(data[i]== "Number_of_streaming_multiprocessors" ||
@@ -275,7 +275,7 @@ int Mt4gParser::parseCOMPUTE_RESOURCE_INFORMATION()
                 return 1;
             }
             int * val = new int(std::stoi(data[i+1]));
-            root->attrib.insert({data[i], reinterpret_cast<void*>(val)});
+            root->SetAttrib(data[i], val);
 
             i++;
         }
@@ -345,7 +345,7 @@ int Mt4gParser::parseADDITIONAL_INFORMATION()
                 *val *= 1000*1000;
             else if(unit == "GHz")
                 *val *= 1000*1000*1000;
-            root->attrib.insert({data[i], reinterpret_cast<void*>(val)});
+            root->SetAttrib(data[i], val);
             i+=2;
         }
     }
@@ -419,11 +419,11 @@ int Mt4gParser::parseMemory(std::string header_name, std::string memory_name)
         Memory * mem = new Memory(root, 0, memory_name, (long long)size);
         if(Memory_Clock_Frequency > -1){
             double * mfreq = new double(Memory_Clock_Frequency);
-            mem->attrib.insert({"Clock_Frequency", reinterpret_cast<void*>(mfreq)});
+            mem->SetAttrib("Clock_Frequency", mfreq);
         }
         if(Memory_Bus_Width > -1){
             int * busW = new int(Memory_Bus_Width);
-            mem->attrib.insert({"Bus_Width", reinterpret_cast<void*>(busW)});
+            mem->SetAttrib("Bus_Width", busW);
         }
           
         //make SMs as main memory's children and insert DP with latency
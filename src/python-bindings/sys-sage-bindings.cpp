@@ -11,6 +11,7 @@
 #include <pybind11/pybind11.h>
 #include <pybind11/stl.h>
 #include <pybind11/attr.h>
+#include <pybind11/functional.h>
 #include <string>
 #include <tuple>
 
@@ -95,60 +96,44 @@ int xmlloader_complex(xmlNodePtr node, sys_sage::Component *c) {
     return 0;
 }
 
-//TODO: Add dynamic allocation for values
-//TODO: Delete values only after success
+//replaces the attribute key by value, which is then owned by self (see SetAttrib()); a previous value that is not owned is freed as a V as well
+template <typename T, typename V>
+void replace_attribute(T &self, const std::string &key, V *value) {
+    auto val = self.attrib.find(key);
+    if (val != self.attrib.end() && !self.OwnsAttrib(key))
+        delete static_cast<V*>(val->second);
+    self.SetAttrib(key, value);
+}
+
 template <typename T>
 void set_attribute(T &self, const std::string &key, py::object &value) {
     //std::cout << "set attribute: " << key << " = " << value << std::endl;
 
-    auto val = self.attrib.find(key);
-    
     if (!key.compare("CATcos") || !key.compare("CATL3mask")) {
-        void * newval = static_cast<void*>(new uint64_t(py::cast<uint64_t>(value)));
-        if(val != self.attrib.end())
-            delete static_cast<uint64_t*>(val->second);
-        self.attrib[key] = newval;
+        replace_attribute(self, key, new uint64_t(py::cast<uint64_t>(value)));
     } else if (!key.compare("mig_size")) {
-        void* new_val = static_cast<void*>(new long long(py::cast<long long>(value)));
-        if(val != self.attrib.end())
-            delete static_cast<long long*>(val->second);
-        self.attrib[key] = new_val;
+        replace_attribute(self, key, new long long(py::cast<long long>(value)));
     } else if (!key.compare("Number_of_streaming_multiprocessors") || 
                !key.compare("Number_of_cores_in_GPU") || 
                !key.compare("Number_of_cores_per_SM") || 
                !key.compare("Bus_Width_bit")) {
-        void* new_val = static_cast<void*>(new int(py::cast<int>(value)));
-        if(val != self.attrib.end())
-            delete static_cast<int*>(val->second);
-        self.attrib[key] = new_val;
+        replace_attribute(self, key, new int(py::cast<int>(value)));
     } else if (!key.compare("Clock_Frequency") || !key.compare("GPU_Clock_Rate")) {
-        void * new_val = static_cast<void*>(new double(py::cast<double>(value)));
-        if(val != self.attrib.end())
-            delete static_cast<double*>(val->second);
-        self.attrib[key] = new_val;
+        replace_attribute(self, key, new double(py::cast<double>(value)));
     } else if (!key.compare("latency") ||
                !key.compare("latency_min") ||
                !key.compare("latency_max")) {
-        void * new_val = static_cast<void*>(new float(py::cast<float>(value)));
-        if(val != self.attrib.end())
-            delete static_cast<float*>(val->second);
-        self.attrib[key] = new_val;
+        replace_attribute(self, key, new float(py::cast<float>(value)));
     } else if (!key.compare("CUDA_compute_capability") || 
                !key.compare("mig_uuid")) {
-        void * new_val= static_cast<void*>(new std::string(py::cast<std::string>(value)));
-        if(val != self.attrib.end())
-            delete static_cast<std::string*>(val->second);
-        self.attrib[key] = new_val;
+        replace_attribute(self, key, new std::string(py::cast<std::string>(value)));
     } else if (!key.compare("freq_history")) {
-        auto fh = new std::vector<std::tuple<long long, double>>;
+        auto fh = new sys_sage::TimeSeries({"frequency"}, sys_sage::TimeSeries::GetHistoryRetention());
         py::dict fh_dict = py::cast<py::dict>(value);
         for (auto [key, value] : fh_dict) {
-            fh->push_back(std::make_tuple(py::cast<long long>(key), py::cast<double>(value)));
+            fh->Append(py::cast<long long>(key), py::cast<double>(value));
         }
-        void * new_val = static_cast<void*>(fh);
-        if(val != self.attrib.end())
-            delete static_cast<std::vector<std::tuple<long long, double>>*>(val->second);
-        self.attrib[key] = new_val;
+        replace_attribute(self, key, fh);
     //} else if (!key.compare("GPU_Clock_Rate")) {
     //    std::cout << "Setting attribute: " << key << std::endl;
     //    py::object freq = value["freq"];
@@ -160,11 +145,7 @@ void set_attribute(T &self, const std::string &key, py::object &value) {
     //        delete static_cast<std::tuple<double, std::string>*>(val->second);
     //    self.attrib[key] = new_val;
     } else {
-        void * new_val = static_cast<void*>(new std::shared_ptr<py::object>(
-            std::make_shared<py::object>(value)));
-        if (val != self.attrib.end())
-            delete static_cast<std::shared_ptr<py::object>*>(val->second);
-        self.attrib[key] = new_val;
+        replace_attribute(self, key, new std::shared_ptr<py::object>(std::make_shared<py::object>(value)));
     }
 
 }
@@ -208,11 +189,10 @@ py::object get_attribute(T &self, const std::string &key) {
             return py::cast(*reinterpret_cast<std::string*>(val->second));
         }
         else if(!key.compare("freq_history") ){
-            std::vector<std::tuple<long long,double>>* value = reinterpret_cast<std::vector<std::tuple<long long,double>>*>(val->second);
+            sys_sage::TimeSeries* value = reinterpret_cast<sys_sage::TimeSeries*>(val->second);
             py::dict freq_dict;
-             for(auto [ ts,freq ] : *value){
-                 freq_dict[py::cast(ts)] = py::cast(freq);
-                 //printf("ts:%lld freq:%f\n",ts,freq);
+             for(size_t i = 0; i < value->Size(); i++){
+                 freq_dict[py::cast(value->GetTimestamp(i))] = py::cast(value->GetValue(i));
              }
              return freq_dict;
         //}
@@ -227,6 +207,15 @@ py::object get_attribute(T &self, const std::string &key) {
             auto * ptr = static_cast<std::shared_ptr<py::object>*>(val->second);
             return *ptr->get();
         }
+    } else if (const sys_sage::AttribValue* typed = self.GetAttribStore().Find(sys_sage::FindAttribKey(key))) {
+        //typed attributes (see SetAttr()), e.g. the mig_uuid of the DataPaths of UpdateMIGSettings()
+        return std::visit([&](const auto& value) -> py::object {
+            using V = std::decay_t<decltype(value)>;
+            if constexpr (std::is_same_v<V, sys_sage::AttribPtr>)
+                throw py::type_error("Attribute '" + key + "' holds an opaque value");
+            else
+                return py::cast(value);
+        }, *typed);
     } else {
         throw py::attribute_error("Attribute '" + key + "' not found"); 
     }
@@ -245,7 +234,9 @@ py::object get_attribute(T &self, int pos){
 template <typename T>
 void remove_attribute(T &self, const std::string &key) {
     auto val = self.attrib.find(key);
-    if (val != self.attrib.end()) {
+    if (val != self.attrib.end() && self.OwnsAttrib(key)) {
+        self.EraseAttrib(key);
+    } else if (val != self.attrib.end()) {
         delete static_cast<std::shared_ptr<py::object>*>(val->second);
         self.attrib.erase(val);
     } else {
@@ -286,6 +277,7 @@ PYBIND11_MODULE(sys_sage, m) {
     m.attr("RELATION_TYPE_DATAPATH") = RelationType::DataPath;
     m.attr("RELATION_TYPE_QUANTUMGATE") = RelationType::QuantumGate;
     m.attr("RELATION_TYPE_COUPLINGMAP") = RelationType::CouplingMap;
+    m.attr("RELATION_TYPE_DATAPATHMATRIX") = RelationType::DataPathMatrix;
 
     m.attr("RELATION_CATEGORY_ANY") = RelationCategory::Any;
     m.attr("RELATION_CATEGORY_DEFAULT") = RelationCategory::Default;
@@ -306,6 +298,9 @@ PYBIND11_MODULE(sys_sage, m) {
     m.attr("DATAPATH_DIRECTION_OUTGOING") = DataPathDirection::Outgoing;
     m.attr("DATAPATH_DIRECTION_INCOMING") = DataPathDirection::Incoming;
 
+    m.attr("ROUTE_METRIC_MIN_LATENCY") = RouteMetric::MinLatency;
+    m.attr("ROUTE_METRIC_MAX_BANDWIDTH") = RouteMetric::MaxBandwidth;
+
     m.attr("DATAPATH_ORIENTATION_ORIENTED") = DataPathOrientation::Oriented;
     m.attr("DATAPATH_ORIENTATION_BIDIRECTIONAL") = DataPathOrientation::Bidirectional;
 
@@ -406,6 +401,10 @@ PYBIND11_MODULE(sys_sage, m) {
 // --
         .def("FindRelations", &Component::FindRelations, py::arg("type") = RelationType::Any, py::arg("position") = -1, "Find the relations of that type and position")
         .def("GetDataPathByType", &Component::GetDataPathByType, py::arg("type"), py::arg("direction") = DataPathDirection::Any,"Get the first data path associated with the component by type")
+        .def("FindDataPath", &Component::FindDataPath, py::arg("target"), py::arg("type") = DataPathType::Any, "Get the data path from the component to target (oriented from the component, or bidirectional)")
+        .def("UpsertDataPath", [](Component& self, Component* target, DataPathType::type type, DataPathOrientation::type orientation, const std::string& key, const std::string& value) {
+            return self.UpsertDataPath(target, type, orientation, key, value);
+        }, py::arg("target"), py::arg("type"), py::arg("orientation") = DataPathOrientation::Oriented, py::arg("key") = "", py::arg("value") = "", "Get the data path from the component to target of that type (with the string attribute key equal to value, if a key is given), creating it if there is none")
 // -- DEPRECATED GetAllDataPaths (used up until version 1.0.0)
         .def("GetAllDataPaths", (std::vector<DataPath *> (Component::*) (DataPathType::type, DataPathDirection::type) const) &Component::FindDataPaths, py::arg("type") = DataPathType::Any, py::arg("direction") = DataPathDirection::Any, "Get all datapaths of that type and direction")
 // --
@@ -436,9 +435,10 @@ PYBIND11_MODULE(sys_sage, m) {
         .def("CalcDepth", &Component::CalcDepth, py::arg("refresh"), "Calculate the depth of the component, if refresh is true it will update the depth")
         .def("DeleteRelation", &Component::DeleteRelation, py::arg("relation"), "Delete the given relation from the component")
 // -- DEPRECATED DeleteAllRelations (used up until version 1.0.0)
-        .def("DeleteAllRelations", &Component::DeleteRelations, py::arg("type") = RelationType::Any,"Delete all relations of that type from the component")
+        .def("DeleteAllRelations", (void (Component::*)(RelationType::type))(&Component::DeleteRelations), py::arg("type") = RelationType::Any,"Delete all relations of that type from the component")
 // --
-        .def("DeleteRelations", &Component::DeleteRelations, py::arg("type") = RelationType::Any, "Delete the relations of that type from the component")
+        .def("DeleteRelations", (void (Component::*)(RelationType::type))(&Component::DeleteRelations), py::arg("type") = RelationType::Any, "Delete the relations of that type from the component")
+        .def("DeleteRelations", (size_t (Component::*)(RelationType::type, const std::function<bool(Relation*)>&))(&Component::DeleteRelations), py::arg("type"), py::arg("predicate"), "Delete the relations of that type for which predicate returns True, in one pass over the relation list; returns the number of deleted relations")
         .def("DeleteSubtree", &Component::DeleteSubtree,"Delete the subtree of the component")
         .def("Delete", &Component::Delete,py::arg("withSubtree") = true,"Delete the component")
 #ifdef SS_PAPI
@@ -462,7 +462,7 @@ PYBIND11_MODULE(sys_sage, m) {
         .def("UpdateL3CATCoreCOS", &Node::UpdateL3CATCoreCOS, "Create new data paths between all cores of the node and the L3 cache to reflect new L3 cache settings")
         #endif
         #ifdef PROC_CPUINFO
-        .def("RefreshCpuCoreFrequency", &Node::RefreshCpuCoreFrequency, py::arg("keep_history")=false,"Refresh the cpu core frequency")
+        .def("RefreshCpuCoreFrequency", [](Node& self, bool keep_history){ return self.RefreshCpuCoreFrequency(keep_history); }, py::arg("keep_history")=false,"Refresh the cpu core frequency")
         #endif
         .def(py::init<int, std::string>(), py::arg("id") = 0, py::arg("name")= "Node")
         .def(py::init<Component*, int, std::string>(), py::arg("parent"), py::arg("id") = 0, py::arg("name") = "Node");
@@ -518,7 +518,7 @@ PYBIND11_MODULE(sys_sage, m) {
 
     py::class_<Core, std::unique_ptr<Core, py::nodelete>, Component>(m, "Core")
         #ifdef PROC_CPUINFO
-        .def("RefreshFreq", &Core::RefreshFreq,py::arg("keep_history") = false,"Refresh the frequency of the component")
+        .def("RefreshFreq", [](Core& self, bool keep_history){ return self.RefreshFreq(keep_history); },py::arg("keep_history") = false,"Refresh the frequency of the component")
         .def_property("freq", &Core::GetFreq, &Core::SetFreq, "Frequency of this core")
         #endif
         .def(py::init<int,std::string>(),py::arg("id") = 0, py::arg("name") = "Core")
@@ -529,7 +529,7 @@ PYBIND11_MODULE(sys_sage, m) {
         .def("GetCATAwareL3Size", &Thread::GetCATAwareL3Size, "Get L3 size of this thread")
         #endif
         #ifdef PROC_CPUINFO
-        .def("RefreshFreq", &Thread::RefreshFreq,py::arg("keep_history") = false,"Refresh the frequency of the component")
+        .def("RefreshFreq", [](Thread& self, bool keep_history){ return self.RefreshFreq(keep_history); },py::arg("keep_history") = false,"Refresh the frequency of the component")
         .def_property_readonly("freq", &Thread::GetFreq, "Get Frequency of this thread")
         #endif
 #ifdef SS_PAPI
@@ -602,7 +602,7 @@ PYBIND11_MODULE(sys_sage, m) {
         .def_property_readonly("type", &Relation::GetType)
         .def_property_readonly("category", &Relation::GetCategory)
         .def_property_readonly("ordered", &Relation::IsOrdered)
-        .def_property_readonly("components", &Relation::GetComponents)
+        .def_property_readonly("components", [](const Relation& self) { return std::vector<Component*>(self.GetComponents()); })
         .def("__setitem__", [](Relation& self, const std::string& name, py::object value) {
             set_attribute<Relation>(self,name, value);
         })
@@ -652,6 +652,39 @@ PYBIND11_MODULE(sys_sage, m) {
         .def_property("fidelity", &CouplingMap::GetFidelity, &CouplingMap::SetFidelity)
         .def("Delete", &CouplingMap::Delete, "Delete the coupling map");
 
+    py::class_<DataPathRoute>(m, "DataPathRoute")
+        .def_readonly("components", &DataPathRoute::components)
+        .def_readonly("dataPaths", &DataPathRoute::dataPaths)
+        .def_readonly("latency", &DataPathRoute::latency)
+        .def_readonly("bandwidth", &DataPathRoute::bandwidth)
+        .def("Found", &DataPathRoute::Found);
+
+    py::class_<DataPathRouter>(m, "DataPathRouter")
+        .def(py::init<DataPathType::type>(), py::arg("type") = sys_sage::DataPathType::Any)
+        .def("FindRoute", &DataPathRouter::FindRoute, py::arg("source"), py::arg("target"), py::arg("metric"), "Search the best route from source to target")
+        .def("ComputeAllPairs", &DataPathRouter::ComputeAllPairs, py::arg("components"), py::arg("metric"), "Compute and cache the best routes among the components")
+        .def("GetRoute", &DataPathRouter::GetRoute, py::arg("source"), py::arg("target"), py::return_value_policy::copy, "Get the cached route from source to target")
+        .def("GetLatency", &DataPathRouter::GetLatency, py::arg("source"), py::arg("target"))
+        .def("GetBandwidth", &DataPathRouter::GetBandwidth, py::arg("source"), py::arg("target"))
+        .def("IsCacheValid", &DataPathRouter::IsCacheValid)
+        .def("ClearCache", &DataPathRouter::ClearCache);
+
+    py::class_<DataPathMatrix, std::unique_ptr<DataPathMatrix, py::nodelete>, Relation>(m, "DataPathMatrix")
+        .def(py::init<const std::vector<Component*>&, DataPathType::type>(), py::arg("components"), py::arg("type") = sys_sage::DataPathType::None)
+        .def(py::init<const std::vector<Component*>&, const std::vector<Component*>&, DataPathType::type>(), py::arg("sources"), py::arg("targets"), py::arg("type") = sys_sage::DataPathType::None)
+        .def_property_readonly("dp_type", &DataPathMatrix::GetDataPathType, "The type of the data paths represented by the matrix")
+        .def("GetNumSources", &DataPathMatrix::GetNumSources)
+        .def("GetNumTargets", &DataPathMatrix::GetNumTargets)
+        .def("GetSource", &DataPathMatrix::GetSource, py::arg("row"))
+        .def("GetTarget", &DataPathMatrix::GetTarget, py::arg("column"))
+        .def("Set", (int (DataPathMatrix::*)(const Component*, const Component*, double, double)) &DataPathMatrix::Set, py::arg("source"), py::arg("target"), py::arg("bw"), py::arg("latency"), "Set the bandwidth and latency from source to target")
+        .def("GetBandwidth", (double (DataPathMatrix::*)(const Component*, const Component*) const) &DataPathMatrix::GetBandwidth, py::arg("source"), py::arg("target"))
+        .def("GetLatency", (double (DataPathMatrix::*)(const Component*, const Component*) const) &DataPathMatrix::GetLatency, py::arg("source"), py::arg("target"))
+        .def("FindMaxBandwidthTarget", &DataPathMatrix::FindMaxBandwidthTarget, py::arg("source"), py::arg("excludeSelf") = true)
+        .def("FindMinLatencyTarget", &DataPathMatrix::FindMinLatencyTarget, py::arg("source"), py::arg("excludeSelf") = true)
+        .def("Materialize", &DataPathMatrix::Materialize, py::arg("source"), py::arg("target"), "Return a data path from source to target carrying the values of the entry")
+        .def("MaterializeAll", &DataPathMatrix::MaterializeAll, "Materialize all entries as data paths");
+
     py::class_<QuantumGate, std::unique_ptr<QuantumGate, py::nodelete>, Relation>(m, "QuantumGate")
         .def(py::init<size_t, std::string, double, std::string>(), py::arg("size") = 0, py::arg("name") = "", py::arg("fidelity") = 0.0, py::arg("unitary") = "")
         .def(py::init<size_t, const std::vector<Qubit *> &>(), py::arg("size"), py::arg("qubits"))
@@ -672,12 +705,12 @@ PYBIND11_MODULE(sys_sage, m) {
 
     m.def("parseHwlocOutput", &parseHwlocOutput, "parseHwlocOutput", py::arg("root"), py::arg("xmlPath"));
 
-    m.def("parseCccbenchOutput", &parseCccbenchOutput, "parseCccbenchOutput", py::arg("root"), py::arg("cccPath"));
+    m.def("parseCccbenchOutput", &parseCccbenchOutput, "parseCccbenchOutput", py::arg("root"), py::arg("cccPath"), py::arg("asMatrix") = false);
 
-    m.def("parseCapsNumaBenchmark", &parseCapsNumaBenchmark,  py::arg("root"), py::arg("benchmarkPath"), py::arg("delim") = ";");
+    m.def("parseCapsNumaBenchmark", &parseCapsNumaBenchmark,  py::arg("root"), py::arg("benchmarkPath"), py::arg("delim") = ";", py::arg("asMatrix") = false);
 
-    m.def("parseIQM", (int (*) (Component *, std::string, int, int)) &parseIQM, "parseIQM", py::arg("parent"), py::arg("dataSourcePath"), py::arg("qcId"), py::arg("tsForHistory") = -1);
-    m.def("parseIQM", (int (*) (QuantumBackend *, std::string, int, int, bool)) &parseIQM, "parseIQM", py::arg("parent"), py::arg("dataSourcePath"), py::arg("qcId"), py::arg("tsForHistory") = -1, py::arg("createTopo") = true);
+    m.def("parseIQM", [](Component* parent, std::string dataSourcePath, int qcId, int tsForHistory){ return parseIQM(parent, dataSourcePath, qcId, tsForHistory); }, "parseIQM", py::arg("parent"), py::arg("dataSourcePath"), py::arg("qcId"), py::arg("tsForHistory") = -1);
+    m.def("parseIQM", [](QuantumBackend* parent, std::string dataSourcePath, int qcId, int tsForHistory, bool createTopo){ return parseIQM(parent, dataSourcePath, qcId, tsForHistory, createTopo); }, "parseIQM", py::arg("parent"), py::arg("dataSourcePath"), py::arg("qcId"), py::arg("tsForHistory") = -1, py::arg("createTopo") = true);
 
     // TODO: QDMI parser logic is missing in src/parsers/qdmi-parser.hpp
 
@@ -696,6 +729,13 @@ PYBIND11_MODULE(sys_sage, m) {
             read_complex_attributes = *search_custom_complex_attrib_key_fcn;
         return importFromXml(path,search_custom_attrib_key_fcn ? xmlloader : nullptr, search_custom_complex_attrib_key_fcn ? xmlloader_complex : nullptr );
     }, py::arg("path"), py::arg("search_custom_attrib_key_fcn") = py::none(), py::arg("search_custom_complex_attrib_key_fcn") = py::none());
+    m.def("importFromXmlStreaming",[](std::string path, std::optional<py::function> search_custom_attrib_key_fcn = std::nullopt, std::optional<py::function> search_custom_complex_attrib_key_fcn = std::nullopt) {
+        if(search_custom_attrib_key_fcn)
+            read_attributes = *search_custom_attrib_key_fcn;
+        if(search_custom_complex_attrib_key_fcn)
+            read_complex_attributes = *search_custom_complex_attrib_key_fcn;
+        return importFromXmlStreaming(path,search_custom_attrib_key_fcn ? xmlloader : nullptr, search_custom_complex_attrib_key_fcn ? xmlloader_complex : nullptr );
+    }, py::arg("path"), py::arg("search_custom_attrib_key_fcn") = py::none(), py::arg("search_custom_complex_attrib_key_fcn") = py::none());
 
 #ifdef SS_PAPI
     py::class_<Metric, std::unique_ptr<Metric, py::nodelete>>(m, "Metric")
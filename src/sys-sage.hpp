@@ -3,6 +3,20 @@
 
 //includes all other headers
 #include "Topology.hpp"
+#include "Arena.hpp"
+#include "SubtreeIndex.hpp"
+#include "DataPathIndex.hpp"
+#include "DataPathMatrix.hpp"
+#include "DataPathRouter.hpp"
+#include "FrozenTopology.hpp"
+#include "Traversal.hpp"
+#include "ParallelTraversal.hpp"
+#include "Epoch.hpp"
+#include "Footprint.hpp"
+#include "Attrib.hpp"
+#include "ColumnStore.hpp"
+#include "AttribIndex.hpp"
+#include "TimeSeries.hpp"
 #include "Component.hpp"
 #include "Thread.hpp"
 #include "Core.hpp"
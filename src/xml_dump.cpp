@@ -22,6 +22,7 @@
 #include "DataPath.hpp"
 #include "QuantumGate.hpp"
 #include "CouplingMap.hpp"
+#include "DataPathMatrix.hpp"
 
 std::function<int(std::string,void*,std::string*)> store_custom_attrib_fcn = NULL;
 std::function<int(std::string,void*,xmlNodePtr)> store_custom_complex_attrib_fcn = NULL;
@@ -79,22 +80,11 @@ int sys_sage::_search_default_attrib_key(std::string key, void* value, std::stri
 
 int sys_sage::_search_default_complex_attrib_key(std::string key, void* value, xmlNodePtr n)
 {
-    //value: std::vector<std::tuple<long long,double>>*
-    if(!key.compare("freq_history"))
+    //value: TimeSeries*
+    if(!key.compare("freq_history") ||
+    !key.compare("readout_history") )
     {
-        std::vector<std::tuple<long long,double>>* val = reinterpret_cast<std::vector<std::tuple<long long,double>>*>(value);
-
-        xmlNodePtr attrib_node = xmlNewNode(NULL, (const unsigned char *)"Attribute");
-        xmlNewProp(attrib_node, reinterpret_cast<const unsigned char *>("name"), reinterpret_cast<const unsigned char *>(key.c_str()));
-        xmlAddChild(n, attrib_node);
-        for(auto [ ts,freq ] : *val)
-        {
-            xmlNodePtr attrib = xmlNewNode(NULL, reinterpret_cast<const unsigned char *>(key.c_str()));
-            xmlNewProp(attrib, reinterpret_cast<const unsigned char *>("timestamp"), reinterpret_cast<const unsigned char *>(std::to_string(ts).c_str()));
-            xmlNewProp(attrib, reinterpret_cast<const unsigned char *>("frequency"), reinterpret_cast<const unsigned char *>(std::to_string(freq).c_str()));
-            xmlNewProp(attrib, reinterpret_cast<const unsigned char *>("unit"), reinterpret_cast<const unsigned char *>("MHz"));
-            xmlAddChild(attrib_node, attrib);
-        }
+        _print_time_series(key, reinterpret_cast<TimeSeries*>(value), n);
         return 1;
     }
     //value: std::tuple<double, std::string>
@@ -115,6 +105,62 @@ int sys_sage::_search_default_complex_attrib_key(std::string key, void* value, x
     return 0;
 }
 
+int sys_sage::_print_time_series(std::string key, const TimeSeries* ts, xmlNodePtr n)
+{
+    const std::vector<std::string>& channels = ts->GetChannels();
+    std::string channel_list;
+    for(size_t c = 0; c < channels.size(); c++)
+        channel_list += (c > 0 ? " " : "") + channels[c];
+
+    xmlNodePtr attrib_node = xmlNewNode(NULL, (const unsigned char *)"Attribute");
+    xmlNewProp(attrib_node, reinterpret_cast<const unsigned char *>("name"), reinterpret_cast<const unsigned char *>(key.c_str()));
+    xmlNewProp(attrib_node, reinterpret_cast<const unsigned char *>("channels"), reinterpret_cast<const unsigned char *>(channel_list.c_str()));
+    if(ts->GetRetention().maxSamples > 0)
+        xmlNewProp(attrib_node, reinterpret_cast<const unsigned char *>("maxSamples"), reinterpret_cast<const unsigned char *>(std::to_string(ts->GetRetention().maxSamples).c_str()));
+    if(ts->GetRetention().maxAge > 0)
+        xmlNewProp(attrib_node, reinterpret_cast<const unsigned char *>("maxAge"), reinterpret_cast<const unsigned char *>(std::to_string(ts->GetRetention().maxAge).c_str()));
+    xmlAddChild(n, attrib_node);
+
+    //samples: one node per sample, named after the attribute, with one property per channel
+    for(size_t i = 0; i < ts->Size(); i++)
+    {
+        xmlNodePtr sample = xmlNewNode(NULL, reinterpret_cast<const unsigned char *>(key.c_str()));
+        xmlNewProp(sample, reinterpret_cast<const unsigned char *>("timestamp"), reinterpret_cast<const unsigned char *>(std::to_string(ts->GetTimestamp(i)).c_str()));
+        for(size_t c = 0; c < channels.size(); c++)
+            xmlNewProp(sample, reinterpret_cast<const unsigned char *>(channels[c].c_str()), reinterpret_cast<const unsigned char *>(std::to_string(ts->GetValue(i, c)).c_str()));
+        if(!key.compare("freq_history"))
+            xmlNewProp(sample, reinterpret_cast<const unsigned char *>("unit"), reinterpret_cast<const unsigned char *>("MHz"));
+        xmlAddChild(attrib_node, sample);
+    }
+
+    //downsampling tiers: one node per aggregate, with min, max and sum per channel
+    for(size_t t = 0; t < ts->GetNumTiers(); t++)
+    {
+        xmlNodePtr tier = xmlNewNode(NULL, reinterpret_cast<const unsigned char *>("tier"));
+        xmlNewProp(tier, reinterpret_cast<const unsigned char *>("period"), reinterpret_cast<const unsigned char *>(std::to_string(ts->GetTierPeriod(t)).c_str()));
+        if(ts->GetTierRetention(t).maxSamples > 0)
+            xmlNewProp(tier, reinterpret_cast<const unsigned char *>("maxSamples"), reinterpret_cast<const unsigned char *>(std::to_string(ts->GetTierRetention(t).maxSamples).c_str()));
+        if(ts->GetTierRetention(t).maxAge > 0)
+            xmlNewProp(tier, reinterpret_cast<const unsigned char *>("maxAge"), reinterpret_cast<const unsigned char *>(std::to_string(ts->GetTierRetention(t).maxAge).c_str()));
+        xmlAddChild(attrib_node, tier);
+        for(size_t i = 0; i < ts->GetTierSize(t); i++)
+        {
+            xmlNodePtr aggregate = xmlNewNode(NULL, reinterpret_cast<const unsigned char *>("aggregate"));
+            xmlNewProp(aggregate, reinterpret_cast<const unsigned char *>("timestamp"), reinterpret_cast<const unsigned char *>(std::to_string(ts->GetAggregate(t, i).timestamp).c_str()));
+            xmlNewProp(aggregate, reinterpret_cast<const unsigned char *>("count"), reinterpret_cast<const unsigned char *>(std::to_string(ts->GetAggregate(t, i).count).c_str()));
+            for(size_t c = 0; c < channels.size(); c++)
+            {
+                TimeSeries::Aggregate a = ts->GetAggregate(t, i, c);
+                xmlNewProp(aggregate, reinterpret_cast<const unsigned char *>((channels[c] + "_min").c_str()), reinterpret_cast<const unsigned char *>(std::to_string(a.min).c_str()));
+                xmlNewProp(aggregate, reinterpret_cast<const unsigned char *>((channels[c] + "_max").c_str()), reinterpret_cast<const unsigned char *>(std::to_string(a.max).c_str()));
+                xmlNewProp(aggregate, reinterpret_cast<const unsigned char *>((channels[c] + "_sum").c_str()), reinterpret_cast<const unsigned char *>(std::to_string(a.sum).c_str()));
+            }
+            xmlAddChild(tier, aggregate);
+        }
+    }
+    return 1;
+}
+
 int sys_sage::_print_attrib(std::map<std::string,void*> attrib, xmlNodePtr n)
 {
     std::string attrib_value;
@@ -143,24 +189,66 @@ int sys_sage::_print_attrib(std::map<std::string,void*> attrib, xmlNodePtr n)
     return 1;
 }
 
-xmlNodePtr sys_sage::Memory::_CreateXmlSubtree()
+int sys_sage::_print_typed_attrib(const AttribStore& attrs, xmlNodePtr n)
 {
-    xmlNodePtr n = Component::_CreateXmlSubtree();
+    for (auto const& [id, value] : attrs.GetEntries()){
+        const std::string& key = GetAttribKeyName(id);
+        std::string attrib_type, attrib_value;
+        if(const int* v = std::get_if<int>(&value)){
+            attrib_type = "int";
+            attrib_value = std::to_string(*v);
+        }
+        else if(const int64_t* v = std::get_if<int64_t>(&value)){
+            attrib_type = "int64";
+            attrib_value = std::to_string(*v);
+        }
+        else if(const double* v = std::get_if<double>(&value)){
+            attrib_type = "double";
+            attrib_value = std::to_string(*v);
+        }
+        else if(const std::string* v = std::get_if<std::string>(&value)){
+            attrib_type = "string";
+            attrib_value = *v;
+        }
+        else if(const std::vector<double>* v = std::get_if<std::vector<double>>(&value)){
+            attrib_type = "vector";
+            for(size_t i = 0; i < v->size(); i++)
+                attrib_value += (i > 0 ? " " : "") + std::to_string((*v)[i]);
+        }
+        else{ //opaque value: stored like the values of the attrib map
+            std::map<std::string, void*> opaque { { key, std::get<AttribPtr>(value).get() } };
+            _print_attrib(opaque, n);
+            continue;
+        }
+
+        xmlNodePtr attrib_node = xmlNewNode(NULL, reinterpret_cast<const unsigned char *>("Attribute"));
+        xmlNewProp(attrib_node, reinterpret_cast<const unsigned char *>("name"), reinterpret_cast<const unsigned char *>(key.c_str()));
+        xmlNewProp(attrib_node, reinterpret_cast<const unsigned char *>("value"), reinterpret_cast<const unsigned char *>(attrib_value.c_str()));
+        xmlNewProp(attrib_node, reinterpret_cast<const unsigned char *>("type"), reinterpret_cast<const unsigned char *>(attrib_type.c_str()));
+        xmlAddChild(n, attrib_node);
+    }
+
+    return 1;
+}
+
+xmlNodePtr sys_sage::Memory::_CreateXmlNode()
+{
+    xmlNodePtr n = Component::_CreateXmlNode();
     if(size > 0)
         xmlNewProp(n, reinterpret_cast<const unsigned char *>("size"), reinterpret_cast<const unsigned char *>(std::to_string(size).c_str()));
     xmlNewProp(n, reinterpret_cast<const unsigned char *>("is_volatile"), reinterpret_cast<const unsigned char *>((std::to_string(is_volatile?1:0)).c_str()));
     return n;
 }
-xmlNodePtr sys_sage::Storage::_CreateXmlSubtree()
+xmlNodePtr sys_sage::Storage::_CreateXmlNode()
 {
-    xmlNodePtr n = Component::_CreateXmlSubtree();
+    xmlNodePtr n = Component::_CreateXmlNode();
     if(size > 0)
         xmlNewProp(n, reinterpret_cast<const unsigned char *>("size"), reinterpret_cast<const unsigned char *>(std::to_string(size).c_str()));
     return n;
 }
-xmlNodePtr sys_sage::Chip::_CreateXmlSubtree()
+xmlNodePtr sys_sage::Chip::_CreateXmlNode()
 {
-    xmlNodePtr n = Component::_CreateXmlSubtree();
+    xmlNodePtr n = Component::_CreateXmlNode();
     if(!vendor.empty())
         xmlNewProp(n, reinterpret_cast<const unsigned char *>("vendor"), reinterpret_cast<const unsigned char *>(vendor.c_str()));
     if(!model.empty())
@@ -168,9 +256,9 @@ xmlNodePtr sys_sage::Chip::_CreateXmlSubtree()
     xmlNewProp(n, reinterpret_cast<const unsigned char *>("type"), reinterpret_cast<const unsigned char *>(std::to_string(type).c_str()));
     return n;
 }
-xmlNodePtr sys_sage::Cache::_CreateXmlSubtree()
+xmlNodePtr sys_sage::Cache::_CreateXmlNode()
 {
-    xmlNodePtr n = Component::_CreateXmlSubtree();
+    xmlNodePtr n = Component::_CreateXmlNode();
     xmlNewProp(n, reinterpret_cast<const unsigned char *>("cache_type"), reinterpret_cast<const unsigned char *>(cache_type.c_str()));
     if(cache_size >= 0)
         xmlNewProp(n, reinterpret_cast<const unsigned char *>("cache_size"), reinterpret_cast<const unsigned char *>(std::to_string(cache_size).c_str()));
@@ -180,22 +268,22 @@ xmlNodePtr sys_sage::Cache::_CreateXmlSubtree()
         xmlNewProp(n, reinterpret_cast<const unsigned char *>("cache_line_size"), reinterpret_cast<const unsigned char *>(std::to_string(cache_line_size).c_str()));
     return n;
 }
-xmlNodePtr sys_sage::Subdivision::_CreateXmlSubtree()
+xmlNodePtr sys_sage::Subdivision::_CreateXmlNode()
 {
-    xmlNodePtr n = Component::_CreateXmlSubtree();
+    xmlNodePtr n = Component::_CreateXmlNode();
     xmlNewProp(n, reinterpret_cast<const unsigned char *>("subdivision_type"), reinterpret_cast<const unsigned char *>(std::to_string(type).c_str()));
     return n;
 }
-xmlNodePtr sys_sage::Numa::_CreateXmlSubtree()
+xmlNodePtr sys_sage::Numa::_CreateXmlNode()
 {
-    xmlNodePtr n = Component::_CreateXmlSubtree();
+    xmlNodePtr n = Component::_CreateXmlNode();
     if(size > 0)
         xmlNewProp(n, reinterpret_cast<const unsigned char *>("size"), reinterpret_cast<const unsigned char *>(std::to_string(size).c_str()));
     return n;
 }
-xmlNodePtr sys_sage::Qubit::_CreateXmlSubtree()
+xmlNodePtr sys_sage::Qubit::_CreateXmlNode()
 {
-    xmlNodePtr n = Component::_CreateXmlSubtree();
+    xmlNodePtr n = Component::_CreateXmlNode();
     xmlNewProp(n, reinterpret_cast<const unsigned char *>("q1_fidelity"), reinterpret_cast<const unsigned char *>(std::to_string(q1_fidelity).c_str()));
     xmlNewProp(n, reinterpret_cast<const unsigned char *>("t1"), reinterpret_cast<const unsigned char *>(std::to_string(t1).c_str()));
     xmlNewProp(n, reinterpret_cast<const unsigned char *>("t2"), reinterpret_cast<const unsigned char *>(std::to_string(t2).c_str()));
@@ -205,10 +293,10 @@ xmlNodePtr sys_sage::Qubit::_CreateXmlSubtree()
     xmlNewProp(n, reinterpret_cast<const unsigned char *>("calibration_time"), reinterpret_cast<const unsigned char *>(calibration_time.c_str()));
     return n;
 }
-xmlNodePtr sys_sage::QuantumBackend::_CreateXmlSubtree()
+xmlNodePtr sys_sage::QuantumBackend::_CreateXmlNode()
 {
     //SVTODO deal with gate_types -- can this go into Relations?
-    xmlNodePtr n = Component::_CreateXmlSubtree();
+    xmlNodePtr n = Component::_CreateXmlNode();
     xmlNewProp(n, reinterpret_cast<const unsigned char *>("num_qubits"), reinterpret_cast<const unsigned char *>(std::to_string(num_qubits).c_str()));
     // if(gate_types.size() > 0)
     // {
@@ -226,9 +314,9 @@ xmlNodePtr sys_sage::QuantumBackend::_CreateXmlSubtree()
 
     return n;
 }
-xmlNodePtr sys_sage::AtomSite::_CreateXmlSubtree()
+xmlNodePtr sys_sage::AtomSite::_CreateXmlNode()
 {
-    xmlNodePtr n = Component::_CreateXmlSubtree();
+    xmlNodePtr n = Component::_CreateXmlNode();
     
     xmlNodePtr xml_siteprops = xmlNewNode(NULL, (const unsigned char *)"SiteProperties");
     xmlNewProp(xml_siteprops, reinterpret_cast<const unsigned char *>("nRows"), reinterpret_cast<const unsigned char *>(std::to_string(properties.nRows).c_str()));
@@ -246,6 +334,19 @@ xmlNodePtr sys_sage::AtomSite::_CreateXmlSubtree()
     return n;
 }
 xmlNodePtr sys_sage::Component::_CreateXmlSubtree()
+{
+    //explicit-stack walk: xmlParents[d] is the XML node of the component at depth d on the current path
+    std::vector<xmlNodePtr> xmlParents;
+    WalkSubtree(this, [&xmlParents](Component* c, int depth){
+        xmlNodePtr n = c->_CreateXmlNode();
+        xmlParents.resize(depth);
+        if(!xmlParents.empty())
+            xmlAddChild(xmlParents.back(), n);
+        xmlParents.push_back(n);
+    }, [](Component*, int){});
+    return xmlParents.front();
+}
+xmlNodePtr sys_sage::Component::_CreateXmlNode()
 {
     xmlNodePtr n = xmlNewNode(NULL, (const unsigned char *)GetComponentTypeStr().c_str());
     xmlNewProp(n, reinterpret_cast<const unsigned char *>("id"), reinterpret_cast<const unsigned char *>(std::to_string(id).c_str()));
@@ -257,12 +358,7 @@ xmlNodePtr sys_sage::Component::_CreateXmlSubtree()
     xmlNewProp(n, reinterpret_cast<const unsigned char *>("addr"), reinterpret_cast<const unsigned char *>(addr.str().c_str()));
 
     _print_attrib(attrib, n);
-
-    for(Component * c : children)
-    {
-        xmlNodePtr child = _buildComponentSubtree(c);
-        xmlAddChild(n, child);
-    }
+    _print_typed_attrib(attrs, n);
 
     return n;
 }
@@ -335,6 +431,26 @@ xmlNodePtr sys_sage::CouplingMap::_CreateXmlEntry()
     xmlNewProp(r_xml, reinterpret_cast<const unsigned char *>("fidelity"), reinterpret_cast<const unsigned char *>(std::to_string(fidelity).c_str()));
     return r_xml;
 }
+xmlNodePtr sys_sage::DataPathMatrix::_CreateXmlEntry()
+{
+    xmlNodePtr r_xml = Relation::_CreateXmlEntry();
+
+    //the targets are the positions of the target components in "components"; the values are row-major, "nan" for entries not set
+    std::ostringstream targets, bw, lat;
+    for(size_t i = 0; i < targetPositions.size(); i++)
+        targets << (i > 0 ? " " : "") << targetPositions[i];
+    for(size_t i = 0; i < bandwidths.size(); i++)
+    {
+        bw << (i > 0 ? " " : "") << std::to_string(bandwidths[i]);
+        lat << (i > 0 ? " " : "") << std::to_string(latencies[i]);
+    }
+    xmlNewProp(r_xml, reinterpret_cast<const unsigned char *>("DataPathType"), reinterpret_cast<const unsigned char *>(std::to_string(dp_type).c_str()));
+    xmlNewProp(r_xml, reinterpret_cast<const unsigned char *>("numSources"), reinterpret_cast<const unsigned char *>(std::to_string(numSources).c_str()));
+    xmlNewProp(r_xml, reinterpret_cast<const unsigned char *>("targets"), reinterpret_cast<const unsigned char *>(targets.str().c_str()));
+    xmlNewProp(r_xml, reinterpret_cast<const unsigned char *>("bw"), reinterpret_cast<const unsigned char *>(bw.str().c_str()));
+    xmlNewProp(r_xml, reinterpret_cast<const unsigned char *>("latency"), reinterpret_cast<const unsigned char *>(lat.str().c_str()));
+    return r_xml;
+}
 xmlNodePtr sys_sage::Relation::_CreateXmlEntry()
 {
     xmlNodePtr r_xml = xmlNewNode(NULL, BAD_CAST GetTypeStr().c_str());
@@ -353,6 +469,7 @@ xmlNodePtr sys_sage::Relation::_CreateXmlEntry()
     //RelationType provided through the xml node name
 
     _print_attrib(attrib, r_xml);
+    _print_typed_attrib(attrs, r_xml);
 
     return r_xml;
 }
@@ -411,6 +528,9 @@ int sys_sage::exportToXml(
                         case RelationType::CouplingMap:
                             r_xml = reinterpret_cast<CouplingMap*>(r)->_CreateXmlEntry();
                             break;
+                        case RelationType::DataPathMatrix:
+                            r_xml = reinterpret_cast<DataPathMatrix*>(r)->_CreateXmlEntry();
+                            break;
                     }
                     xmlAddChild(relations_root, r_xml);
                 }
@@ -5,6 +5,7 @@
 
 #include "Component.hpp"
 #include "DataPath.hpp"
+#include "TimeSeries.hpp"
 
 namespace sys_sage{
     /**
@@ -68,5 +69,26 @@ namespace sys_sage{
      * @return 0 on success, nonzero on error.
      */
     int _print_attrib(std::map<std::string, void *> attrib, xmlNodePtr n);
+    /**
+     * @private
+     * @brief Prints a TimeSeries attribute (e.g. freq_history) to XML: its channels and retention, its samples and the aggregates of its downsampling tiers.
+     *
+     * @param key Attribute key.
+     * @param ts The time series.
+     * @param n XML node to attach the attribute to.
+     * @return 1
+     */
+    int _print_time_series(std::string key, const TimeSeries* ts, xmlNodePtr n);
+    /**
+     * @private
+     * @brief Prints the typed attributes of a component or relation to XML, as Attribute nodes with a type property (int, int64, double, string or vector).
+     *
+     * Opaque values are printed like the values of the attrib map (see _print_attrib()).
+     *
+     * @param attrs Typed attributes.
+     * @param n XML node to attach the attributes to.
+     * @return 1
+     */
+    int _print_typed_attrib(const AttribStore& attrs, xmlNodePtr n);
 } //namespace sys_sage
 #endif
@@ -1,11 +1,14 @@
 #include <cstddef>
 #include <cstdio>
 #include <cstring>
+#include <algorithm>
 #include <filesystem>
+#include <sstream>
 #include <functional>
 #include <string>
 #include <sys/types.h>
 #include <tuple>
+#include <unordered_map>
 #include <vector>
 
 #include "xml_load.hpp"
@@ -27,6 +30,7 @@
 #include "Relation.hpp"
 #include "DataPath.hpp"
 #include "QuantumGate.hpp"
+#include "DataPathMatrix.hpp"
 #include "CouplingMap.hpp"
 
 using std::cout;
@@ -34,6 +38,7 @@ using std::endl;
 
 
 #include <libxml/parser.h>
+#include <libxml/xmlreader.h>
 
 // Function pointer for custom attribute key search
 std::function<void*(xmlNodePtr)> load_custom_attrib_fcn = NULL;
@@ -42,15 +47,24 @@ std::function<int(xmlNodePtr, sys_sage::Component *)> load_custom_complex_attrib
 
 // Create map of addresses to Components created
 // this is used to create the Datapaths
-std::map<std::string, sys_sage::Component *> addr_to_component;
+std::unordered_map<std::string, sys_sage::Component *> addr_to_component;
 
-//Helper-Function to retrieve string from xml-node
+//Helper-Function to retrieve string from xml-node (empty if the property is missing)
 std::string sys_sage::_getStringFromProp(xmlNodePtr n, std::string prop) {
-	const unsigned char *v = xmlGetProp(n, reinterpret_cast<const unsigned char *>(prop.c_str()));
+	xmlChar *v = xmlGetProp(n, reinterpret_cast<const unsigned char *>(prop.c_str()));
+	if (v == NULL)
+		return std::string();
 	std::string value(reinterpret_cast<char const *>(v));
+	xmlFree(v);
 	return value;
 }
 
+// Component of an address written by exportToXml (NULL if unknown)
+static sys_sage::Component* _find_component(const std::string& addr) {
+	auto it = addr_to_component.find(addr);
+	return (it != addr_to_component.end()) ? it->second : NULL;
+}
+
 // Extract attribute value from xml-node based on attribute name
 void* sys_sage::_search_default_attrib_key(xmlNodePtr n) {
 	std::string key, value;
@@ -109,6 +123,79 @@ void* sys_sage::_search_default_attrib_key(xmlNodePtr n) {
 	return NULL; // Attribute not found or not handled
 }
 
+// Deleter of a value returned by _search_default_attrib_key for key
+static void (*_default_attrib_deleter(const std::string& key))(void*) {
+	if (!key.compare("CATcos") || !key.compare("CATL3mask") || !key.compare("mig_size"))
+		return [](void* p) { delete static_cast<long long*>(p); };
+	else if (!key.compare("Number_of_streaming_multiprocessors") ||
+		!key.compare("Number_of_cores_in_GPU") ||
+		!key.compare("Number_of_cores_per_SM") ||
+		!key.compare("Bus_Width_bit"))
+		return [](void* p) { delete static_cast<int*>(p); };
+	else if (!key.compare("Clock_Frequency") || !key.compare("GPU_Clock_Rate"))
+		return [](void* p) { delete static_cast<double*>(p); };
+	else if (!key.compare("latency") || !key.compare("latency_min") ||
+		!key.compare("latency_max"))
+		return [](void* p) { delete static_cast<float*>(p); };
+	return [](void* p) { delete static_cast<std::string*>(p); };
+}
+
+// Create a TimeSeries from an Attribute-node written by _print_time_series
+sys_sage::TimeSeries* sys_sage::_load_time_series(xmlNodePtr n, std::vector<std::string> defaultChannels) {
+	std::vector<std::string> channels;
+	if (xmlHasProp(n, BAD_CAST "channels")) {
+		std::istringstream in(_getStringFromProp(n, "channels"));
+		for (std::string channel; in >> channel;)
+			channels.push_back(channel);
+	}
+	else {
+		channels = defaultChannels;
+	}
+	TimeSeries::Retention retention{};
+	if (xmlHasProp(n, BAD_CAST "maxSamples"))
+		retention.maxSamples = std::stoull(_getStringFromProp(n, "maxSamples"));
+	if (xmlHasProp(n, BAD_CAST "maxAge"))
+		retention.maxAge = std::stoll(_getStringFromProp(n, "maxAge"));
+	TimeSeries* ts = new TimeSeries(channels, retention);
+
+	// samples first; the aggregates of the tiers are restored afterwards, so
+	// that the samples are not aggregated twice
+	std::vector<double> values(channels.size());
+	for (xmlNodePtr cur = n->children; cur != NULL; cur = cur->next) {
+		if (cur->type != XML_ELEMENT_NODE || !xmlStrcmp(cur->name, BAD_CAST "tier"))
+			continue;
+		long long timestamp = std::strtoll(_getStringFromProp(cur, "timestamp").c_str(), NULL, 10);
+		for (size_t ch = 0; ch < channels.size(); ch++)
+			values[ch] = std::stod(_getStringFromProp(cur, channels[ch]));
+		ts->Append(timestamp, values);
+	}
+	for (xmlNodePtr cur = n->children; cur != NULL; cur = cur->next) {
+		if (cur->type != XML_ELEMENT_NODE || xmlStrcmp(cur->name, BAD_CAST "tier"))
+			continue;
+		TimeSeries::Retention tierRetention{};
+		if (xmlHasProp(cur, BAD_CAST "maxSamples"))
+			tierRetention.maxSamples = std::stoull(_getStringFromProp(cur, "maxSamples"));
+		if (xmlHasProp(cur, BAD_CAST "maxAge"))
+			tierRetention.maxAge = std::stoll(_getStringFromProp(cur, "maxAge"));
+		size_t tier = ts->AddTier(std::stoll(_getStringFromProp(cur, "period")), tierRetention);
+		// a malformed tier (period <= 0) is skipped with its aggregates
+		if (tier == TimeSeries::invalidTier)
+			continue;
+		std::vector<double> stats(3 * channels.size());
+		for (xmlNodePtr agg = cur->children; agg != NULL; agg = agg->next) {
+			if (agg->type != XML_ELEMENT_NODE)
+				continue;
+			for (size_t ch = 0; ch < channels.size(); ch++) {
+				stats[3 * ch] = std::stod(_getStringFromProp(agg, channels[ch] + "_min"));
+				stats[3 * ch + 1] = std::stod(_getStringFromProp(agg, channels[ch] + "_max"));
+				stats[3 * ch + 2] = std::stod(_getStringFromProp(agg, channels[ch] + "_sum"));
+			}
+			ts->_RestoreAggregate(tier, std::stoll(_getStringFromProp(agg, "timestamp")), std::stoull(_getStringFromProp(agg, "count")), stats);
+		}
+	}
+	return ts;
+}
+
 // Search for custom complex attributes in xmlNode n and add them to Component c
 //
 // Complex attributes are attributes that have a value that is not a simple type
@@ -123,25 +210,11 @@ int sys_sage::_search_default_complex_attrib_key(xmlNodePtr n, Component *c) {
 	{
 		return 0;
 	}
-	// freq_history is a vector of tuples containing the timestamp and the
-	// frequency
-	if (!key.compare("freq_history")) {
-		std::vector<std::tuple<long long, double>>* val = new std::vector<std::tuple<long long, double>>();
-		for (xmlNodePtr cur = n->children; cur != NULL; cur = cur->next) 
-		{
-			// skip text nodes
-			if (cur->type == XML_TEXT_NODE)
-				continue;
-
-			// add value to vector
-			std::string ts = _getStringFromProp(cur, "timestamp");
-			std::string freq = _getStringFromProp(cur, "frequency");
-			long long ts_ll = std::strtoll((const char *)ts.c_str(), NULL, 10);
-			double freq_d = std::stod(freq);
-
-			val->push_back(std::make_tuple(ts_ll, freq_d));
-		}
-		c->attrib[key] = reinterpret_cast<void*>(val);
+	// freq_history and readout_history are time series of samples with a
+	// timestamp and one value per channel
+	if (!key.compare("freq_history") || !key.compare("readout_history")) {
+		// files written before the channels were stored only contain freq_history
+		c->SetAttrib(key, _load_time_series(n, {"frequency"}));
 		return 1;
 	} 
 	//else if (!key.compare("GPU_Clock_Rate"))
@@ -166,6 +239,35 @@ int sys_sage::_search_default_complex_attrib_key(xmlNodePtr n, Component *c) {
 	return 0;
 }
 
+// Add a typed attribute (with a type-property) to Component c
+int sys_sage::_collect_typed_attrib(xmlNodePtr n, Component *c) {
+	if (!xmlHasProp(n, BAD_CAST "name") || !xmlHasProp(n, BAD_CAST "value"))
+		return 0;
+	std::string key = _getStringFromProp(n, "name");
+	std::string type = _getStringFromProp(n, "type");
+	std::string value = _getStringFromProp(n, "value");
+
+	if (!type.compare("int"))
+		c->SetAttr(key, std::stoi(value));
+	else if (!type.compare("int64"))
+		c->SetAttr(key, static_cast<int64_t>(std::stoll(value)));
+	else if (!type.compare("double"))
+		c->SetAttr(key, std::stod(value));
+	else if (!type.compare("string"))
+		c->SetAttr(key, value);
+	else if (!type.compare("vector"))
+	{
+		std::vector<double> values;
+		std::istringstream in(value);
+		for (double v; in >> v;)
+			values.push_back(v);
+		c->SetAttr(key, std::move(values));
+	}
+	else
+		return 0;
+	return 1;
+}
+
 // Collect all attributes and add to Component c
 //
 // This function traverses the xmlNode n and extracts all attributes.
@@ -173,17 +275,28 @@ int sys_sage::_search_default_complex_attrib_key(xmlNodePtr n, Component *c) {
 // If the custom functions are not null, they are called first. If they
 // can not handle the attribute, the default functions are used.
 int sys_sage::_collect_attrib(xmlNodePtr n, Component *c) {
+	// typed attributes (see Component::SetAttr()) carry their type
+	if (xmlHasProp(n, BAD_CAST "type"))
+		return _collect_typed_attrib(n, c);
+
 	void *attrib_value = NULL;
+	bool default_value = false;
 	// try custom attribute search function
 	if (load_custom_attrib_fcn != NULL)
 		attrib_value = load_custom_attrib_fcn(n);
 	// if custom function could not handle attribute, try default
-	if (attrib_value == NULL)
+	if (attrib_value == NULL) {
 		attrib_value = _search_default_attrib_key(n);
-	// if attribute was handled, add it to Component
+		default_value = (attrib_value != NULL);
+	}
+	// if attribute was handled, add it to Component; the values of the
+	// default keys are owned by the Component, custom values by the caller
 	if (attrib_value != NULL) {
 		std::string key = _getStringFromProp(n, "name");
-		c->attrib[key] = attrib_value;
+		if (default_value)
+			c->SetAttrib(key, attrib_value, _default_attrib_deleter(key));
+		else
+			c->attrib[key] = attrib_value;
 	}
 	int ret = 0;
 	// try custom complex attribute search function
@@ -196,34 +309,14 @@ int sys_sage::_collect_attrib(xmlNodePtr n, Component *c) {
 	return 0;
 }
 
-// Create ComponentSubtree from xmlNodes
-//
-// This function creates a ComponentSubtree from the xmlNode n by creating
-// a Component and then recursively calling itself for all children of n.
-sys_sage::Component* sys_sage::_CreateComponentSubtree(xmlNodePtr n) {
+// Create a Component from the xmlNode n of a Component (its name and
+// properties only; the children of n are not processed)
+sys_sage::Component* sys_sage::_CreateComponent(xmlNodePtr n) {
 	Component *c = NULL;
 
 	std::string nodeName(reinterpret_cast<const char *>(n->name));
-	// cout << "_CreateComponentSubtree nodeName = " << nodeName << endl;
-
-	// entrypoint is 'Components' -- just scan for a non-'text' child and process that"
-	if(nodeName.compare("Components") == 0)
-	{
-		for (xmlNodePtr xml_child = n->children; xml_child != NULL; xml_child = xml_child->next)
-		{
-			std::string childName(reinterpret_cast<const char *>(xml_child->name));
-			if (childName.compare("text") == 0)
-				continue;
-			else
-				return _CreateComponentSubtree(xml_child);
-		}
-	}
-
-	//from here processing real Components
-
 	std::string name = _getStringFromProp(n, "name");
 	int id = std::stoi(_getStringFromProp(n, "id"));
-	std::string addr = _getStringFromProp(n, "addr");
 
 	// Check the type of Component and create the corresponding Component
 	if (nodeName.compare("None") == 0) {
@@ -314,6 +407,32 @@ sys_sage::Component* sys_sage::_CreateComponentSubtree(xmlNodePtr n) {
 	if (nodeName.compare("Topology") == 0) {
 		c = new Topology();
 	}
+	return c;
+}
+
+// Create ComponentSubtree from xmlNodes
+//
+// This function creates a ComponentSubtree from the xmlNode n by creating
+// a Component and then recursively calling itself for all children of n.
+sys_sage::Component* sys_sage::_CreateComponentSubtree(xmlNodePtr n) {
+	std::string nodeName(reinterpret_cast<const char *>(n->name));
+	// cout << "_CreateComponentSubtree nodeName = " << nodeName << endl;
+
+	// entrypoint is 'Components' -- just scan for a non-'text' child and process that"
+	if(nodeName.compare("Components") == 0)
+	{
+		for (xmlNodePtr xml_child = n->children; xml_child != NULL; xml_child = xml_child->next)
+		{
+			std::string childName(reinterpret_cast<const char *>(xml_child->name));
+			if (childName.compare("text") == 0)
+				continue;
+			else
+				return _CreateComponentSubtree(xml_child);
+		}
+	}
+
+	//from here processing real Components
+	Component *c = _CreateComponent(n);
 
 	// Recursively traverse all children of n and create Components
 	for (xmlNodePtr xml_child = n->children; xml_child != NULL; xml_child = xml_child->next)
@@ -335,7 +454,7 @@ sys_sage::Component* sys_sage::_CreateComponentSubtree(xmlNodePtr n) {
 		}
 	}
 	// Add the Component to the hashmap
-	addr_to_component[addr] = c;
+	addr_to_component[_getStringFromProp(n, "addr")] = c;
 	return c;
 }
 
@@ -349,57 +468,83 @@ int sys_sage::_CreateRelations(xmlNodePtr relationNode) {
 		// skip non-element nodes
 		if (xml_child->type != XML_ELEMENT_NODE)
 			continue;
+		_CreateRelation(xml_child);
+	}
+	return 1;
+}
 
-		std::string childName(reinterpret_cast<const char *>(xml_child->name));
-		// cout << "_CreateRelations childName = " << childName << endl;
+// Create the Relation object of the xmlNode xml_child (a child of the
+// Relations-node) and add it to the corresponding Components
+void sys_sage::_CreateRelation(xmlNodePtr xml_child) {
+	std::string childName(reinterpret_cast<const char *>(xml_child->name));
+	// cout << "_CreateRelations childName = " << childName << endl;
 
     std::vector<Component *> components;
-		xmlChar *str = xmlGetProp(xml_child, BAD_CAST "components");
+	xmlChar *str = xmlGetProp(xml_child, BAD_CAST "components");
     if (str != nullptr) {
         std::istringstream stream (reinterpret_cast<const char *>(str));
         std::string component;
         while (std::getline(stream, component, ' '))
-          components.push_back(addr_to_component[component]);
+          components.push_back(_find_component(component));
+        xmlFree(str);
     }
 
-		std::string ordered_str = _getStringFromProp(xml_child, "ordered");
-		bool ordered = (ordered_str == "1");
-		int id = std::stoi(_getStringFromProp(xml_child, "id"));
+	std::string ordered_str = _getStringFromProp(xml_child, "ordered");
+	bool ordered = (ordered_str == "1");
+	int id = std::stoi(_getStringFromProp(xml_child, "id"));
 
 
-		if (childName.compare("Relation") == 0)
-		{
-			new Relation(components, id, ordered);
-		}
-		if (childName.compare("DataPath") == 0)
-		{
-			int dataPathType = std::stoi(_getStringFromProp(xml_child, "DataPathType"));
-			double bw = std::stod(_getStringFromProp(xml_child, "bw"));
-			double latency = std::stod(_getStringFromProp(xml_child, "latency"));
-			DataPathOrientation::type dpo = (ordered ? DataPathOrientation::Oriented : DataPathOrientation::Bidirectional);
+	if (childName.compare("Relation") == 0)
+	{
+		new Relation(components, id, ordered);
+	}
+	if (childName.compare("DataPath") == 0)
+	{
+		int dataPathType = std::stoi(_getStringFromProp(xml_child, "DataPathType"));
+		double bw = std::stod(_getStringFromProp(xml_child, "bw"));
+		double latency = std::stod(_getStringFromProp(xml_child, "latency"));
+		DataPathOrientation::type dpo = (ordered ? DataPathOrientation::Oriented : DataPathOrientation::Bidirectional);
 
-			new DataPath(components[0], components[1], dpo, dataPathType, bw, latency);
-		}
-		if (childName.compare("QuantumGate") == 0)
-		{
-			int gate_size = std::stoi(_getStringFromProp(xml_child, "gate_size"));
-			std::string name = _getStringFromProp(xml_child, "name");
-			int gate_length = std::stoi(_getStringFromProp(xml_child, "gate_length"));
-			QuantumGateType::type gate_type = std::stoi(_getStringFromProp(xml_child, "gate_type"));
-			double fidelity = std::stod(_getStringFromProp(xml_child, "fidelity"));
-			std::string unitary = _getStringFromProp(xml_child, "unitary");
-
-			new QuantumGate(components, id, ordered, gate_size, name, gate_length, gate_type, fidelity, unitary);
-		}
-		if (childName.compare("CouplingMap") == 0)
-		{
-			CouplingMap* cm = new CouplingMap(components, id, ordered);
+		new DataPath(components[0], components[1], dpo, dataPathType, bw, latency);
+	}
+	if (childName.compare("QuantumGate") == 0)
+	{
+		int gate_size = std::stoi(_getStringFromProp(xml_child, "gate_size"));
+		std::string name = _getStringFromProp(xml_child, "name");
+		int gate_length = std::stoi(_getStringFromProp(xml_child, "gate_length"));
+		QuantumGateType::type gate_type = std::stoi(_getStringFromProp(xml_child, "gate_type"));
+		double fidelity = std::stod(_getStringFromProp(xml_child, "fidelity"));
+		std::string unitary = _getStringFromProp(xml_child, "unitary");
+
+		new QuantumGate(components, id, ordered, gate_size, name, gate_length, gate_type, fidelity, unitary);
+	}
+	if (childName.compare("CouplingMap") == 0)
+	{
+		CouplingMap* cm = new CouplingMap(components, id, ordered);
 
-			double fidelity = std::stod(_getStringFromProp(xml_child, "fidelity"));
-			cm->SetFidelity(fidelity);
-		}		
+		double fidelity = std::stod(_getStringFromProp(xml_child, "fidelity"));
+		cm->SetFidelity(fidelity);
+	}		
+	if (childName.compare("DataPathMatrix") == 0)
+	{
+		int dataPathType = std::stoi(_getStringFromProp(xml_child, "DataPathType"));
+		size_t numSources = std::stoul(_getStringFromProp(xml_child, "numSources"));
+		std::vector<Component*> sources(components.begin(), components.begin() + std::min(numSources, components.size()));
+		std::vector<Component*> targets;
+		std::istringstream targetStream(_getStringFromProp(xml_child, "targets"));
+		size_t position;
+		while (targetStream >> position)
+			if (position < components.size())
+				targets.push_back(components[position]);
+		DataPathMatrix* m = new DataPathMatrix(sources, targets, dataPathType);
+
+		//values are row-major; "nan" marks the entries not set
+		std::istringstream bwStream(_getStringFromProp(xml_child, "bw"));
+		std::istringstream latencyStream(_getStringFromProp(xml_child, "latency"));
+		std::string bw, latency;
+		for (size_t i = 0; i < sources.size() * targets.size() && bwStream >> bw && latencyStream >> latency; i++)
+			m->Set(i / targets.size(), i % targets.size(), std::stod(bw), std::stod(latency));
 	}
-	return 1;
 }
 
 sys_sage::Component* sys_sage::importFromXml(
@@ -410,9 +555,14 @@ sys_sage::Component* sys_sage::importFromXml(
 
 	load_custom_attrib_fcn = _load_custom_attrib_fcn;
 	load_custom_complex_attrib_fcn = _load_custom_complex_attrib_fcn;
+	addr_to_component.clear();
 
 	xmlInitParser();
 	xmlDocPtr doc = xmlReadFile(path.c_str(), NULL, 0);
+	if (doc == NULL) {
+		std::cerr << "importFromXml: could not read " << path << std::endl;
+		return NULL;
+	}
 	xmlNodePtr sys_sage_root = xmlDocGetRootElement(doc);
 	// cout << "sys_sage_root->name = " << sys_sage_root->name << endl;
 
@@ -429,6 +579,122 @@ sys_sage::Component* sys_sage::importFromXml(
 		}
 	}
 
+	xmlFreeDoc(doc);
+	std::unordered_map<std::string, Component *>().swap(addr_to_component);
 	return c;
 	}
 
+// Streaming counterpart of importFromXml
+//
+// The xmlTextReader keeps only the current element and its ancestors:
+// Components are created at their start tags (from the properties of the
+// element) and inserted below the Component of the enclosing element.
+// Only Attribute-nodes and the children of the Relations-node are expanded
+// (as xmlNodes for _collect_attrib and _CreateRelation). Relations that
+// come before the Components-node are kept until the Components are read.
+sys_sage::Component* sys_sage::importFromXmlStreaming(
+	std::string path,
+	std::function<void*(xmlNodePtr)> _load_custom_attrib_fcn,
+	std::function<int(xmlNodePtr, Component *)> _load_custom_complex_attrib_fcn)
+{
+	load_custom_attrib_fcn = _load_custom_attrib_fcn;
+	load_custom_complex_attrib_fcn = _load_custom_complex_attrib_fcn;
+	addr_to_component.clear();
+
+	xmlInitParser();
+	xmlTextReaderPtr reader = xmlReaderForFile(path.c_str(), NULL, 0);
+	if (reader == NULL) {
+		std::cerr << "importFromXmlStreaming: could not read " << path << std::endl;
+		return NULL;
+	}
+
+	enum { Other, Components, Relations } section = Other;
+	bool componentsDone = false;
+	Component *root = NULL;
+	// Components of the open elements in the Components-node (NULL for unknown elements)
+	std::vector<Component *> open;
+	std::vector<xmlNodePtr> deferredRelations;
+
+	int ret = xmlTextReaderRead(reader);
+	while (ret == 1) {
+		bool skipSubtree = false;
+		int type = xmlTextReaderNodeType(reader);
+		int depth = xmlTextReaderDepth(reader);
+		const xmlChar *name = xmlTextReaderConstName(reader);
+
+		if (type == XML_READER_TYPE_ELEMENT && depth == 1) {
+			if (xmlStrcmp(name, BAD_CAST "Components") == 0)
+				section = Components;
+			else if (xmlStrcmp(name, BAD_CAST "Relations") == 0)
+				section = Relations;
+			else
+				section = Other;
+			if (xmlTextReaderIsEmptyElement(reader)) {
+				componentsDone |= (section == Components);
+				section = Other;
+			}
+		}
+		else if (type == XML_READER_TYPE_ELEMENT && section == Components) {
+			if (xmlStrcmp(name, BAD_CAST "Attribute") == 0) {
+				xmlNodePtr n = xmlTextReaderExpand(reader);
+				if (n != NULL && !open.empty() && open.back() != NULL)
+					_collect_attrib(n, open.back());
+				skipSubtree = true;
+			}
+			else if (depth == 2 && root != NULL) {
+				// like importFromXml, only the first Component of the Components-node is imported
+				skipSubtree = true;
+			}
+			else {
+				xmlNodePtr n = xmlTextReaderCurrentNode(reader);
+				Component *c = _CreateComponent(n);
+				addr_to_component[_getStringFromProp(n, "addr")] = c;
+				if (depth == 2)
+					root = c;
+				else if (c != NULL && !open.empty() && open.back() != NULL)
+					open.back()->InsertChild(c);
+				if (!xmlTextReaderIsEmptyElement(reader))
+					open.push_back(c);
+			}
+		}
+		else if (type == XML_READER_TYPE_ELEMENT && section == Relations && depth == 2) {
+			xmlNodePtr n = xmlTextReaderExpand(reader);
+			if (n != NULL) {
+				if (componentsDone)
+					_CreateRelation(n);
+				else
+					deferredRelations.push_back(xmlCopyNode(n, 1));
+			}
+			skipSubtree = true;
+		}
+		else if (type == XML_READER_TYPE_END_ELEMENT) {
+			if (depth == 1) {
+				componentsDone |= (section == Components);
+				section = Other;
+			}
+			else if (section == Components && !open.empty())
+				open.pop_back();
+		}
+
+		ret = skipSubtree ? xmlTextReaderNext(reader) : xmlTextReaderRead(reader);
+	}
+	xmlFreeTextReader(reader);
+	if (ret != 0) {
+		// like importFromXml, a file that cannot be parsed yields no topology (not the part read so far)
+		std::cerr << "importFromXmlStreaming: failed to parse " << path << std::endl;
+		for (xmlNodePtr n : deferredRelations)
+			xmlFreeNode(n);
+		if (root != NULL)
+			root->Delete(true);
+		std::unordered_map<std::string, Component *>().swap(addr_to_component);
+		return NULL;
+	}
+
+	for (xmlNodePtr n : deferredRelations) {
+		_CreateRelation(n);
+		xmlFreeNode(n);
+	}
+	std::unordered_map<std::string, Component *>().swap(addr_to_component);
+	return root;
+}
+
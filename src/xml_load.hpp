@@ -5,6 +5,7 @@
 
 #include "Component.hpp"
 #include "DataPath.hpp"
+#include "TimeSeries.hpp"
 
 //SVTODO make sure all functions from the .cpp are also in the header
 //SVTODO check the import and export functionalities and adapt them to Relations
@@ -21,6 +22,19 @@ namespace sys_sage {
      * @return Pointer to the root Component of the imported tree.
      */
     Component* importFromXml(std::string path, std::function<void*(xmlNodePtr)> search_custom_attrib_key_fcn = NULL, std::function<int(xmlNodePtr, Component*)> search_custom_complex_attrib_key_fcn = NULL);
+    /**
+     * @brief Imports the sys-sage internal representation from an XML file, streaming it with an xmlTextReader.
+     *
+     * Produces the same Component tree and Relations as importFromXml(), but does not build the document tree of the whole file:
+     * Components are created as their elements are read, so the memory needed besides the imported topology is proportional to the depth of the Component tree, plus the table of component addresses used to resolve the Relations.
+     * The attribute handlers are called with the (expanded) Attribute node, as with importFromXml().
+     *
+     * @param path Path to the XML file.
+     * @param search_custom_attrib_key_fcn Optional user-provided function for custom attribute deserialization (string attributes).
+     * @param search_custom_complex_attrib_key_fcn Optional user-provided function for custom attribute deserialization (complex attributes, e.g., XML nodes).
+     * @return Pointer to the root Component of the imported tree (NULL if the file cannot be read or parsed; nothing of a partially parsed file is kept).
+     */
+    Component* importFromXmlStreaming(std::string path, std::function<void*(xmlNodePtr)> search_custom_attrib_key_fcn = NULL, std::function<int(xmlNodePtr, Component*)> search_custom_complex_attrib_key_fcn = NULL);
 
     /**
      * @private
@@ -37,6 +51,12 @@ namespace sys_sage {
      * @return 0 on success, nonzero on error.
      */   
     int _CreateRelations(xmlNodePtr relationNode);
+    /**
+     * @private
+     * @brief Creates the Relation object of one child of the Relations node.
+     * @param n XML node pointer of the relation.
+     */
+    void _CreateRelation(xmlNodePtr n);
 
     /**
      * @private
@@ -45,6 +65,13 @@ namespace sys_sage {
      * @return Pointer to the root Component of the created subtree.
      */
     Component* _CreateComponentSubtree(xmlNodePtr n);
+    /**
+     * @private
+     * @brief Creates a Component from an XML node (from its name and properties; its children are not processed).
+     * @param n XML node pointer.
+     * @return Pointer to the created Component (NULL for an unknown element).
+     */
+    Component* _CreateComponent(xmlNodePtr n);
     /**
      * @private
      * @brief Searches for and deserializes a default attribute from an XML node. Can be used as a reference for creating custom handlers.
@@ -70,6 +97,22 @@ namespace sys_sage {
      * @return 0 on success, nonzero on error.
      */
     int _collect_attrib(xmlNodePtr n, Component* c);
+    /**
+     * @private
+     * @brief Creates a TimeSeries from an Attribute node written by _print_time_series() (samples, retention and downsampling tiers).
+     * @param n XML node pointer.
+     * @param defaultChannels Channels of the time series if the node does not list them (files written by older versions).
+     * @return Pointer to the new TimeSeries.
+     */
+    TimeSeries* _load_time_series(xmlNodePtr n, std::vector<std::string> defaultChannels);
+    /**
+     * @private
+     * @brief Adds a typed attribute (an Attribute node with a type property, see _print_typed_attrib()) to a Component.
+     * @param n XML node pointer.
+     * @param c Pointer to the Component to attach the attribute to.
+     * @return 1 if the attribute was added, 0 if its type is unknown.
+     */
+    int _collect_typed_attrib(xmlNodePtr n, Component* c);
 } //namespace sys_sage
 #endif
 
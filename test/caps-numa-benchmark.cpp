@@ -1,6 +1,7 @@
 #include <boost/ut.hpp>
 #include <string_view>
 #include <algorithm>
+#include <fstream>
 
 #include "sys-sage.hpp"
 
@@ -100,4 +101,65 @@ static suite<"caps-numa-benchmark"> _ = []
         expect(that % 211 == dp(2, 3)->GetLatency());
         expect(that % 246 == dp(3, 3)->GetLatency());
     };
+    "Data path matrix"_test = [&]
+    {
+        Topology matrixTopo;
+        Node matrixNode{&matrixTopo};
+        expect(that % (0 == parseHwlocOutput(&matrixNode, SYS_SAGE_TEST_RESOURCE_DIR "/skylake_hwloc.xml")) >> fatal);
+        expect(that % (0 == parseCapsNumaBenchmark(&matrixNode, SYS_SAGE_TEST_RESOURCE_DIR "/skylake_caps_numa_benchmark.csv", ";", true)) >> fatal);
+
+        std::vector<Component *> matrixNumas;
+        matrixNode.FindDescendantsByType(&matrixNumas, ComponentType::Numa);
+        expect(that % (4 == matrixNumas.size()) >> fatal);
+        expect(that % 0u == matrixNumas[0]->FindDataPaths(DataPathType::Any, DataPathDirection::Any).size());
+        expect(that % (1u == matrixNumas[0]->GetRelationsByType(RelationType::DataPathMatrix).size()) >> fatal);
+        auto matrix = static_cast<DataPathMatrix *>(matrixNumas[0]->GetRelationsByType(RelationType::DataPathMatrix)[0]);
+        expect(that % DataPathType::Datatransfer == matrix->GetDataPathType());
+        expect(that % 4u == matrix->GetNumSources() && that % 4u == matrix->GetNumTargets());
+
+        //same values as the DataPaths parsed without asMatrix
+        for (size_t i = 0; i < 4; ++i)
+        {
+            for (size_t k = 0; k < 4; ++k)
+            {
+                auto dp = (numas[i]->FindDataPaths(DataPathType::Any, DataPathDirection::Outgoing))[k];
+                size_t target = std::find(numas.begin(), numas.end(), dp->GetTarget()) - numas.begin();
+                expect(that % dp->GetBandwidth() == matrix->GetBandwidth(matrixNumas[i], matrixNumas[target]));
+                expect(that % dp->GetLatency() == matrix->GetLatency(matrixNumas[i], matrixNumas[target]));
+            }
+        }
+
+        int64_t row = matrix->GetSourceIndex(matrixNumas[0]);
+        expect(that % (row >= 0) >> fatal);
+        expect(that % matrix->GetBandwidth(matrixNumas[0], matrixNumas[1]) == matrix->GetBandwidthRow(row)[matrix->GetTargetIndex(matrixNumas[1])]);
+        expect(that % matrixNumas[1] == matrix->FindMaxBandwidthTarget(matrixNumas[0]));
+        expect(that % matrixNumas[1] == matrix->FindMinLatencyTarget(matrixNumas[0]));
+        expect(that % matrixNumas[0] == matrix->FindMaxBandwidthTarget(matrixNumas[0], false));
+        expect(that % (nullptr == matrix->FindMinLatencyTarget(&matrixNode)));
+
+        MemoryFootprint dataPathsFootprint, matrixFootprint;
+        node.CalcFootprint(&dataPathsFootprint);
+        matrixNode.CalcFootprint(&matrixFootprint);
+        expect(that % matrixFootprint.relationTypes[RelationType::DataPathMatrix] < dataPathsFootprint.relationTypes[RelationType::DataPath]);
+
+        DataPath *dp = matrix->Materialize(matrixNumas[0], matrixNumas[1]);
+        expect(that % (dp != nullptr) >> fatal);
+        expect(that % dp == matrixNumas[0]->FindDataPath(matrixNumas[1], DataPathType::Datatransfer));
+        expect(that % matrix->GetLatency(matrixNumas[0], matrixNumas[1]) == dp->GetLatency());
+        matrix->Set(matrixNumas[0], matrixNumas[1], 1.0, 2.0);
+        expect(that % dp == matrix->Materialize(matrixNumas[0], matrixNumas[1]));
+        expect(that % 1.0 == dp->GetBandwidth() && that % 2.0 == dp->GetLatency());
+        expect(that % 12u == matrix->MaterializeAll());
+        expect(that % 3u == matrixNumas[0]->FindDataPaths(DataPathType::Datatransfer, DataPathDirection::Outgoing).size());
+
+        matrixNumas[3]->Delete(false);
+        expect(that % 0u == matrixNumas[0]->GetRelationsByType(RelationType::DataPathMatrix).size());
+    };
+    "Malformed benchmark file"_test = [&]
+    {
+        std::ofstream("caps_numa_malformed.csv") << "src_numa;target_numa;ldlat(ns);bw(MB/s);\n0; 1; 203; 8237\n0; x; 302; 6439\n";
+        expect(throws([&]{ parseCapsNumaBenchmark(&node, "caps_numa_malformed.csv"); }));
+        //the SubtreeIndex the parser enabled for itself is disabled again
+        expect(that % (nullptr == node.GetSubtreeIndex()));
+    };
 };
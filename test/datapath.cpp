@@ -1,5 +1,10 @@
 #include <boost/ut.hpp>
 
+#include <cmath>
+#include <cstdio>
+#include <fstream>
+#include <limits>
+
 #include "sys-sage.hpp"
 
 using namespace boost::ut;
@@ -126,4 +131,212 @@ static suite<"data-path"> _ = []
             expect(that % std::vector{&dp2, &dp3, &dp4} == v);
         };
     };
+
+    "Data path index"_test = []
+    {
+        Component hub;
+        auto indexSize = [&hub]{ MemoryFootprint footprint; hub.CalcFootprint(&footprint); return footprint.indexes; };
+        std::vector<Component *> others;
+        for(int i = 0; i < 20; i++)
+            others.push_back(new Component(i));
+        //more DataPaths than DataPathIndexCache::minDataPaths, of all orientations; the first DataPaths to others[i] are oriented from the hub
+        std::vector<DataPath *> dps;
+        for(int i = 0; i < 60; i++)
+        {
+            Component *other = others[i % others.size()];
+            DataPathType::type type = (i % 3 == 0) ? DataPathType::C2C : DataPathType::Datatransfer;
+            if(i % 4 == 1 && i >= 20)
+                dps.push_back(new DataPath(other, &hub, DataPathOrientation::Oriented, type));
+            else if(i % 4 == 2 && i >= 20)
+                dps.push_back(new DataPath(other, &hub, DataPathOrientation::Bidirectional, type));
+            else
+                dps.push_back(new DataPath(&hub, other, DataPathOrientation::Oriented, type));
+        }
+
+        //the first lookup scans, the next ones are answered from the index (with the same selection and order)
+        expect(that % 60_u == hub.FindDataPaths().size());
+        expect(that % 0_u == indexSize());
+        for(DataPathType::type type : {DataPathType::Any, DataPathType::C2C, DataPathType::Datatransfer, DataPathType::L3CAT})
+            for(DataPathDirection::type direction : {DataPathDirection::Any, DataPathDirection::Outgoing, DataPathDirection::Incoming})
+            {
+                std::vector<DataPath *> expected;
+                for(DataPath *dp : dps)
+                    if((type == DataPathType::Any || dp->GetDataPathType() == type) &&
+                        (direction == DataPathDirection::Any || dp->GetOrientation() == DataPathOrientation::Bidirectional || (direction == DataPathDirection::Outgoing ? dp->GetSource() : dp->GetTarget()) == &hub))
+                        expected.push_back(dp);
+                expect(that % expected == hub.FindDataPaths(type, direction));
+            }
+        expect(that % indexSize() > 0_u);
+        expect(that % dps[0] == hub.GetDataPathByType(DataPathType::C2C, DataPathDirection::Outgoing));
+        expect(that % dps[22] == hub.GetDataPathByType(DataPathType::Datatransfer, DataPathDirection::Incoming));
+
+        //pair lookups: the first DataPath from the hub to the other component, oriented or bidirectional
+        expect(that % dps[0] == hub.FindDataPath(others[0]));
+        expect(that % dps[0] == hub.FindDataPath(others[0], DataPathType::C2C));
+        expect(that % dps[20] == hub.FindDataPath(others[0], DataPathType::Datatransfer));
+        expect(that % dps[1] == hub.FindDataPath(others[1], DataPathType::Datatransfer));
+        expect(that % nullptr == hub.FindDataPath(others[1], DataPathType::L3CAT));
+        expect(that % dps[22] == others[2]->FindDataPath(&hub));
+        expect(that % dps[21] == others[1]->FindDataPath(&hub, DataPathType::C2C));
+        expect(that % dps[41] == others[1]->FindDataPath(&hub, DataPathType::Datatransfer));
+
+        //changes drop the index
+        dps[0]->Delete();
+        expect(that % 0_u == indexSize());
+        expect(that % dps[20] == hub.FindDataPath(others[0]));
+        expect(that % dps[20] == hub.FindDataPath(others[0]));
+        expect(that % nullptr == hub.FindDataPath(others[0], DataPathType::C2C));
+        DataPath *added = new DataPath(&hub, others[1], DataPathOrientation::Oriented, DataPathType::L3CAT);
+        expect(that % added == hub.FindDataPath(others[1], DataPathType::L3CAT));
+        expect(that % added == hub.FindDataPath(others[1], DataPathType::L3CAT));
+        expect(that % 60_u == hub.FindDataPaths(DataPathType::Any, DataPathDirection::Any).size());
+
+        for(Component *other : others)
+            other->Delete();
+        expect(that % 0_u == hub.FindDataPaths().size());
+        expect(that % nullptr == hub.GetDataPathByType(DataPathType::Any));
+    };
+    "Upsert"_test = []
+    {
+        Component thread{0}, l3{1}, memory{2};
+        bool created = false;
+        //a refresh, repeated: the first call creates the DataPath, later ones update it in place
+        DataPath *cat = nullptr;
+        uint64_t *mask = nullptr;
+        for(uint64_t refresh = 0; refresh < 3; refresh++)
+        {
+            DataPath *dp = thread.UpsertDataPath(&l3, DataPathType::L3CAT, DataPathOrientation::Bidirectional, "", {}, &created);
+            expect(that % (refresh == 0) == created);
+            dp->UpdateAttrib<uint64_t>("CATL3mask", 0xf0 + refresh);
+            if(refresh == 0)
+            {
+                cat = dp;
+                mask = static_cast<uint64_t *>(dp->attrib["CATL3mask"]);
+            }
+            expect(that % cat == dp);
+            expect(that % mask == dp->attrib["CATL3mask"]);
+            expect(that % 0xf0 + refresh == *mask);
+        }
+        expect(that % 1_u == thread.GetRelationsByType(RelationType::DataPath).size());
+        expect(that % DataPathOrientation::Bidirectional == cat->GetOrientation());
+        //found from the other end of a bidirectional DataPath, but not as another type
+        expect(that % cat == l3.UpsertDataPath(&thread, DataPathType::L3CAT));
+        expect(that % cat != thread.UpsertDataPath(&l3, DataPathType::MIG, DataPathOrientation::Bidirectional, "", {}, &created));
+        expect(created);
+        thread.DeleteRelations(RelationType::DataPath, [cat](Relation *r){ return r != cat; });
+
+        //keyed by an attribute: one DataPath per value
+        DataPath *a = thread.UpsertDataPath(&memory, DataPathType::MIG, DataPathOrientation::Bidirectional, "mig_uuid", std::string("MIG-a"));
+        DataPath *b = thread.UpsertDataPath(&memory, DataPathType::MIG, DataPathOrientation::Bidirectional, "mig_uuid", std::string("MIG-b"), &created);
+        expect(created);
+        expect(that % a != b);
+        expect(that % std::string("MIG-b") == *b->GetAttr<std::string>("mig_uuid"));
+        expect(that % a == thread.UpsertDataPath(&memory, DataPathType::MIG, DataPathOrientation::Bidirectional, "mig_uuid", std::string("MIG-a"), &created));
+        expect(not created);
+        expect(that % b == thread.UpsertDataPath(&memory, DataPathType::MIG, DataPathOrientation::Bidirectional, "mig_uuid", std::string("MIG-b")));
+        expect(that % 3_u == thread.GetRelationsByType(RelationType::DataPath).size());
+        //a value in the attrib map (as importFromXml() loads mig_uuid) matches as well
+        DataPath *loaded = new DataPath(&thread, &memory, DataPathOrientation::Bidirectional, DataPathType::MIG);
+        loaded->SetAttrib("mig_uuid", new std::string("MIG-c"));
+        expect(that % loaded == thread.UpsertDataPath(&memory, DataPathType::MIG, DataPathOrientation::Bidirectional, "mig_uuid", std::string("MIG-c"), &created));
+        expect(not created);
+        expect(that % loaded != thread.UpsertDataPath(&memory, DataPathType::MIG, DataPathOrientation::Bidirectional, "mig_uuid", std::string("MIG-d"), &created));
+        expect(created);
+        expect(that % 5_u == thread.GetRelationsByType(RelationType::DataPath).size());
+        thread.DeleteRelations();
+    };
+
+    "Cccbench data path matrix"_test = []
+    {
+        {
+            std::ofstream csv("cccbench.csv");
+            csv << "xcore,ycore,xylat\n0,1,10\n0,1,30\n1,0,5\n1,0,7\n1,0,9\n0,2,4\n2,0,4\n1,2,6\n2,1,8\n";
+        }
+        Node dataPathsNode, matrixNode;
+        for (int i = 0; i < 3; i++)
+        {
+            new Core(&dataPathsNode, i);
+            new Core(&matrixNode, i);
+        }
+        expect(that % 0 == parseCccbenchOutput(&dataPathsNode, "cccbench.csv"));
+        expect(that % 0 == parseCccbenchOutput(&matrixNode, "cccbench.csv", true));
+        std::remove("cccbench.csv");
+
+        //the matrix keeps the minimal and maximal latencies of the DataPaths
+        expect(that % (1u == matrixNode.GetChild(0)->GetRelationsByType(RelationType::DataPathMatrix).size()) >> fatal);
+        auto matrix = static_cast<DataPathMatrix *>(matrixNode.GetChild(0)->GetRelationsByType(RelationType::DataPathMatrix)[0]);
+        const std::vector<double> *latencyMin = matrix->GetAttr<std::vector<double>>("latency_min");
+        const std::vector<double> *latencyMax = matrix->GetAttr<std::vector<double>>("latency_max");
+        expect(that % (latencyMin != nullptr && latencyMax != nullptr) >> fatal);
+        expect(that % (9u == latencyMin->size() && 9u == latencyMax->size()) >> fatal);
+        for (int x = 0; x < 3; x++)
+            for (int y = 0; y < 3; y++)
+            {
+                Component *source = dataPathsNode.GetChild(x), *target = dataPathsNode.GetChild(y);
+                size_t entry = matrix->GetSourceIndex(matrixNode.GetChild(x)) * matrix->GetNumTargets() + matrix->GetTargetIndex(matrixNode.GetChild(y));
+                DataPath *dp = source->FindDataPath(target, DataPathType::C2C);
+                if (x == y)
+                {
+                    expect(that % nullptr == dp);
+                    expect(std::isnan((*latencyMin)[entry]));
+                    continue;
+                }
+                expect(that % (dp != nullptr) >> fatal);
+                expect(that % dp->GetLatency() == matrix->GetLatency(matrixNode.GetChild(x), matrixNode.GetChild(y)));
+                expect(that % double(*static_cast<float *>(dp->attrib["latency_min"])) == (*latencyMin)[entry]);
+                expect(that % double(*static_cast<float *>(dp->attrib["latency_max"])) == (*latencyMax)[entry]);
+            }
+        expect(that % 10.0 == (*latencyMin)[1] && that % 30.0 == (*latencyMax)[1]);
+    };
+    "Routing"_test = []
+    {
+        Component *a = new Component(0), *b = new Component(1), *c = new Component(2), *d = new Component(3), *e = new Component(4);
+        DataPath *ab = new DataPath(a, b, DataPathOrientation::Oriented, 10.0, 1.0);
+        DataPath *bc = new DataPath(b, c, DataPathOrientation::Oriented, 10.0, 1.0);
+        DataPath *ac = new DataPath(a, c, DataPathOrientation::Oriented, 100.0, 5.0);
+        DataPath *cd = new DataPath(c, d, DataPathOrientation::Bidirectional, 50.0, 2.0);
+        new DataPath(a, e, DataPathOrientation::Oriented, DataPathType::C2C, 1000.0, 0.5);
+
+        DataPathRouter router{DataPathType::None};
+        DataPathRoute route = router.FindRoute(a, c, RouteMetric::MinLatency);
+        expect(that % (std::vector<Component *>{a, b, c} == route.components) >> fatal);
+        expect(that % (std::vector<DataPath *>{ab, bc} == route.dataPaths));
+        expect(that % 2.0 == route.latency && that % 10.0 == route.bandwidth);
+        route = router.FindRoute(a, c, RouteMetric::MaxBandwidth);
+        expect(that % (std::vector<DataPath *>{ac} == route.dataPaths));
+        expect(that % 5.0 == route.latency && that % 100.0 == route.bandwidth);
+        expect(that % 4.0 == router.FindRoute(a, d, RouteMetric::MinLatency).latency);
+        expect(that % 50.0 == router.FindRoute(a, d, RouteMetric::MaxBandwidth).bandwidth);
+        //bidirectional DataPaths are used both ways, oriented ones only from the source
+        expect(that % (std::vector<DataPath *>{cd} == router.FindRoute(d, c, RouteMetric::MinLatency).dataPaths));
+        expect(not router.FindRoute(d, a, RouteMetric::MinLatency).Found());
+        //DataPaths of other types are not used
+        expect(not router.FindRoute(a, e, RouteMetric::MinLatency).Found());
+        expect(DataPathRouter{}.FindRoute(a, e, RouteMetric::MinLatency).Found());
+        route = router.FindRoute(a, a, RouteMetric::MaxBandwidth);
+        expect(that % (std::vector<Component *>{a} == route.components));
+        expect(that % 0.0 == route.latency && route.bandwidth == std::numeric_limits<double>::infinity());
+
+        //cached routes follow the changes of the DataPaths
+        router.ComputeAllPairs({a, c, d}, RouteMetric::MinLatency);
+        expect(router.IsCacheValid());
+        expect(that % 4.0 == router.GetLatency(a, d));
+        expect(that % 10.0 == router.GetBandwidth(a, d));
+        expect(that % nullptr == router.GetRoute(a, b));
+        expect(not router.GetRoute(d, a)->Found());
+        ab->SetLatency(10.0);
+        expect(not router.IsCacheValid());
+        expect(that % 7.0 == router.GetLatency(a, d));
+        expect(router.IsCacheValid());
+        ac->Delete();
+        expect(that % 13.0 == router.GetLatency(a, d));
+        DataPath *ad = new DataPath(a, d, DataPathOrientation::Oriented, 1.0, 3.0);
+        expect(that % (std::vector<DataPath *>{ad} == router.GetRoute(a, d)->dataPaths));
+        expect(that % router.GetFootprint() > sizeof(DataPathRouter));
+        router.ClearCache();
+        expect(that % nullptr == router.GetRoute(a, d));
+
+        for(Component *comp : {a, b, c, d, e})
+            comp->Delete();
+    };
 };
@@ -0,0 +1,221 @@
+#include <boost/ut.hpp>
+#include <atomic>
+#include <thread>
+#include <vector>
+
+#include "sys-sage.hpp"
+
+using namespace boost::ut;
+using namespace sys_sage;
+
+static suite<"epoch"> _ = []
+{
+    "Retire and Synchronize"_test = []
+    {
+        static int freed = 0;
+        freed = 0;
+        EpochManager epochs;
+        {
+            EpochManager::ReadGuard reader{epochs};
+            epochs.Retire(new int{1}, [](void *p){ delete static_cast<int *>(p); freed++; });
+            expect(that % 1u == epochs.GetNumRetired());
+            {
+                EpochManager::WriteGuard writer{epochs};
+                expect(epochs.IsWriter());
+            }
+            expect(!epochs.IsWriter());
+        }
+        epochs.Synchronize();
+        expect(that % 0u == epochs.GetNumRetired());
+        expect(that % 1 == freed);
+
+        Component c;
+        expect(that % nullptr == c.ReadAttrib("load"));
+        c.PublishAttrib("load", new double{0.5}, epochs);
+        expect(that % 0.5 == *static_cast<double *>(c.ReadAttrib("load")));
+        c.PublishAttrib("load", new double{0.75}, epochs);
+        expect(that % 0.75 == *static_cast<double *>(c.ReadAttrib("load")));
+        epochs.Synchronize();
+        expect(that % 0u == epochs.GetNumRetired());
+        delete static_cast<double *>(c.attrib["load"]);
+
+        //a value owned through SetAttrib() is released once, by its owner
+        static int released = 0;
+        released = 0;
+        c.SetAttrib("state", new int{1}, [](void *p){ delete static_cast<int *>(p); released++; });
+        c.PublishAttrib("state", new int{2}, epochs);
+        expect(!c.OwnsAttrib("state"));
+        expect(that % 0 == released);
+        epochs.Synchronize();
+        expect(that % 1 == released);
+        delete static_cast<int *>(c.attrib["state"]);
+    };
+
+    "Publishing owned attributes"_test = []
+    {
+        static int freed = 0;
+        freed = 0;
+        auto deleter = [](void *p){ delete static_cast<int *>(p); freed++; };
+        EpochManager epochs;
+        Component *c = new Component();
+
+        //owned values are retired through their owner, whichever way they were set
+        c->SetAttrib("load", new int{1}, deleter);
+        c->PublishOwnedAttrib("load", new int{2}, deleter, epochs);
+        expect(c->OwnsAttrib("load"));
+        c->PublishOwnedAttrib("load", c->attrib["load"], deleter, epochs);
+        expect(c->OwnsAttrib("load"));
+        c->PublishOwnedAttrib("load", new int{3}, deleter, epochs);
+        expect(that % 3 == *static_cast<int *>(c->ReadAttrib("load")));
+        expect(that % 0 == freed);
+        epochs.Synchronize();
+        expect(that % 2 == freed);
+
+        //a new key is owned as well; deleting the component frees the current values
+        c->PublishOwnedAttrib("state", new int{4}, deleter, epochs);
+        expect(c->OwnsAttrib("state"));
+        c->Delete();
+        expect(that % 4 == freed);
+    };
+
+    "Concurrent readers and writers"_test = []
+    {
+        Topology topo;
+        EpochManager epochs;
+        std::vector<Node *> nodes = topo.CreateChildren<Node>(8, 0);
+        for(size_t n = 1; n < nodes.size(); n++)
+            new DataPath(nodes[n - 1], nodes[n], DataPathOrientation::Oriented, DataPathType::Physical, 1.0, 1.0);
+        for(Node *node : nodes)
+            node->PublishAttrib("load", new int{0}, epochs);
+
+        std::atomic<bool> stop{false};
+        std::atomic<int> inconsistencies{0};
+        std::vector<std::thread> readers;
+        for(int r = 0; r < 4; r++)
+        {
+            readers.emplace_back([&]
+            {
+                while(!stop.load())
+                {
+                    EpochManager::ReadGuard guard{epochs};
+                    for(Component *node : topo.GetChildren())
+                    {
+                        int *load = static_cast<int *>(node->ReadAttrib("load"));
+                        if(load == nullptr || *load < 0)
+                            inconsistencies++;
+                        //the structural writer always inserts and deletes children of a node in pairs
+                        if(node->GetChildren().size() % 2 != 0)
+                            inconsistencies++;
+                        for(Relation *r : node->GetRelationsByType(RelationType::DataPath))
+                            if(static_cast<DataPath *>(r)->GetBandwidth() < 1.0)
+                                inconsistencies++;
+                    }
+                }
+            });
+        }
+
+        std::thread publisher([&]
+        {
+            for(int i = 1; i <= 2000; i++)
+            {
+                //values are updated without excluding readers; the guard only protects the iteration over the DataPaths
+                EpochManager::ReadGuard guard{epochs};
+                Component *node = nodes[i % nodes.size()];
+                node->PublishAttrib("load", new int{i}, epochs);
+                for(Relation *r : node->GetRelationsByType(RelationType::DataPath))
+                    static_cast<DataPath *>(r)->SetBandwidth(1.0 + i);
+            }
+        });
+        std::thread structural([&]
+        {
+            for(int i = 0; i < 200; i++)
+            {
+                EpochManager::WriteGuard guard{epochs};
+                Component *node = nodes[i % nodes.size()];
+                if(i % 3 == 2)
+                {
+                    std::vector<Component *> children = node->GetChildren();
+                    for(Component *child : children)
+                        child->Delete(true);
+                }
+                else
+                {
+                    Chip *first = new Chip(node, i);
+                    new Chip(node, i + 1);
+                    new DataPath(first, node, DataPathOrientation::Oriented, DataPathType::Logical, 2.0, 1.0);
+                }
+            }
+        });
+
+        publisher.join();
+        structural.join();
+        stop = true;
+        for(std::thread &t : readers)
+            t.join();
+        epochs.Synchronize();
+
+        expect(that % 0 == inconsistencies.load());
+        expect(that % 0u == epochs.GetNumRetired());
+        for(Node *node : nodes)
+        {
+            expect(that % 0u == node->GetChildren().size() % 2);
+            delete static_cast<int *>(node->ReadAttrib("load"));
+        }
+    };
+
+#ifdef PROC_CPUINFO
+    "Refreshing the frequency history concurrently with readers"_test = []
+    {
+        Node node;
+        Chip socket{&node, 0, "socket", ChipType::CpuSocket};
+        Core core{&socket, 0};
+        Thread thread{&core, 0};
+        EpochManager epochs;
+        ColumnStore columns;
+        const AttribId freqKey = InternAttribKey("freq");
+
+        std::atomic<bool> stop{false};
+        std::atomic<int> inconsistencies{0};
+        std::vector<std::thread> readers;
+        for(int r = 0; r < 4; r++)
+        {
+            readers.emplace_back([&]
+            {
+                while(!stop.load())
+                {
+                    EpochManager::ReadGuard guard{epochs};
+                    auto it = core.attrib.find("freq_history");
+                    if(it == core.attrib.end())
+                        continue;
+                    TimeSeries *history = static_cast<TimeSeries *>(it->second);
+                    //the history and the column are written in the same WriteGuard
+                    if(history->Empty() || history->GetValue(history->Size() - 1) <= 0 || !(columns.Get(&core, freqKey) > 0))
+                        inconsistencies++;
+                }
+            });
+        }
+
+        std::thread writer([&]
+        {
+            for(int i = 0; i < 200; i++)
+            {
+                if(i % 2 == 0)
+                    node.RefreshCpuCoreFrequency(true, &columns, &epochs);
+                else
+                    core.RefreshFreq(true, &columns, &epochs);
+            }
+        });
+
+        writer.join();
+        stop = true;
+        for(std::thread &t : readers)
+            t.join();
+
+        expect(that % 0 == inconsistencies.load());
+        TimeSeries *history = static_cast<TimeSeries *>(core.attrib["freq_history"]);
+        expect(that % (history != nullptr) >> fatal);
+        expect(that % 0u < history->Size());
+        expect(that % core.GetFreq() == columns.Get(&core, freqKey));
+    };
+#endif
+};
@@ -7,6 +7,9 @@
 
 #include "sys-sage.hpp"
 
+#include <cmath>
+#include <fstream>
+#include <iterator>
 #include <memory>
 #include <set>
 #include <string>
@@ -135,6 +138,120 @@ static suite<"export"> _ = []
         validate(SYS_SAGE_TEST_RESOURCE_DIR "/sys-sage_custom_attributes.xml");
     };
 
+    "Typed attributes"_test = []
+    {
+        {
+            auto topo = new Topology;
+            Node *node = new Node{topo, 1};
+            node->SetAttr("cores", 64);
+            node->SetAttr("memory", int64_t{1} << 40);
+            node->SetAttr("freq", 2.5);
+            node->SetAttr("vendor", std::string("AMD"));
+            node->SetAttr("load", std::vector<double>{0.5, 0.25});
+            exportToXml(topo, "test.xml");
+            topo->Delete(true);
+        }
+
+        validate("test.xml");
+        Component *topo = importFromXml("test.xml");
+        expect(that % (topo != nullptr) >> fatal);
+        Component *node = topo->GetChild(1);
+        expect(that % (node != nullptr) >> fatal);
+        expect(that % 64 == *node->GetAttr<int>("cores"));
+        expect(that % (int64_t{1} << 40) == *node->GetAttr<int64_t>("memory"));
+        expect(that % 2.5 == *node->GetAttr<double>("freq"));
+        expect(node->GetAttr<std::string>("vendor")->compare("AMD") == 0);
+        expect(std::vector<double>{0.5, 0.25} == *node->GetAttr<std::vector<double>>("load"));
+        expect(that % 0u == node->attrib.size());
+        topo->Delete(true);
+    };
+
+    "Time series attributes"_test = []
+    {
+        {
+            auto topo = new Topology;
+            Core *core = new Core{topo, 0};
+            TimeSeries *fh = new TimeSeries({"frequency"}, {100, 0});
+            fh->AddTier(1000, {10, 0});
+            for(int64_t t = 0; t < 5; t++)
+                fh->Append(t * 400, 2000.0 + t);
+            core->attrib["freq_history"] = fh;
+            exportToXml(topo, "test.xml");
+            delete fh;
+            topo->Delete(true);
+        }
+
+        validate("test.xml");
+        Component *topo = importFromXml("test.xml");
+        expect(that % (topo != nullptr) >> fatal);
+        Component *core = topo->GetChild(0);
+        expect(that % (core != nullptr && core->attrib.contains("freq_history")) >> fatal);
+        TimeSeries *fh = static_cast<TimeSeries *>(core->attrib["freq_history"]);
+        expect(that % 100u == fh->GetRetention().maxSamples);
+        expect(that % 5u == fh->Size());
+        expect(that % 1600 == fh->GetTimestamp(4));
+        expect(that % 2004.0 == fh->GetValue(4));
+        expect(that % 1u == fh->GetNumTiers());
+        expect(that % 1000 == fh->GetTierPeriod(0));
+        expect(that % 10u == fh->GetTierRetention(0).maxSamples);
+        expect(that % 2u == fh->GetTierSize(0));
+        TimeSeries::Aggregate a = fh->GetAggregate(0, 0);
+        expect(that % 3u == a.count && that % 2000.0 == a.min && that % 2002.0 == a.max && that % 6003.0 == a.sum);
+        //the imported history is owned (and freed) by the component
+        expect(core->OwnsAttrib("freq_history"));
+        topo->Delete(true);
+
+        //a tier with a period <= 0 (which could not aggregate anything) is skipped, the samples are kept
+        std::string text;
+        {
+            std::ifstream in("test.xml");
+            text.assign(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+        }
+        size_t period = text.find("period=\"1000\"");
+        expect((period != std::string::npos) >> fatal);
+        text.replace(period, std::string("period=\"1000\"").size(), "period=\"0\"");
+        std::ofstream("test.xml") << text;
+        topo = importFromXml("test.xml");
+        expect(that % (topo != nullptr) >> fatal);
+        fh = static_cast<TimeSeries *>(topo->GetChild(0)->attrib["freq_history"]);
+        expect(that % 5u == fh->Size());
+        expect(that % 0u == fh->GetNumTiers());
+        fh->Append(2000, 2005.0);
+        expect(that % 6u == fh->Size());
+        topo->Delete(true);
+    };
+
+    "Data path matrix"_test = []
+    {
+        {
+            auto topo = new Topology;
+            Thread *t0 = new Thread{topo, 0};
+            Thread *t1 = new Thread{topo, 1};
+            Numa *n0 = new Numa{topo, 2};
+            auto matrix = new DataPathMatrix({t0, t1}, {n0, t1}, DataPathType::Datatransfer);
+            matrix->Set(t0, n0, 100, 10);
+            matrix->Set(t1, n0, 200, 20);
+            matrix->Set(t0, t1, 300, 30);
+            exportToXml(topo, "test.xml");
+            topo->Delete(true);
+        }
+
+        validate("test.xml");
+        Component *topo = importFromXml("test.xml");
+        expect(that % (topo != nullptr) >> fatal);
+        Component *t0 = topo->GetChild(0), *t1 = topo->GetChild(1), *n0 = topo->GetChild(2);
+        expect(that % (t0 != nullptr && t1 != nullptr && n0 != nullptr) >> fatal);
+        expect(that % (1u == t0->GetRelationsByType(RelationType::DataPathMatrix).size()) >> fatal);
+        auto matrix = static_cast<DataPathMatrix *>(t0->GetRelationsByType(RelationType::DataPathMatrix)[0]);
+        expect(that % DataPathType::Datatransfer == matrix->GetDataPathType());
+        expect(that % 2u == matrix->GetNumSources() && that % 2u == matrix->GetNumTargets());
+        expect(that % 3u == matrix->GetComponents().size());
+        expect(that % 200.0 == matrix->GetBandwidth(t1, n0) && that % 20.0 == matrix->GetLatency(t1, n0));
+        expect(that % 30.0 == matrix->GetLatency(t0, t1));
+        expect(std::isnan(matrix->GetBandwidth(t1, t1)));
+        topo->Delete(true);
+    };
+
     "Single component"_test = []
     {
         {
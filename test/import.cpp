@@ -8,6 +8,8 @@
 
 #include "sys-sage.hpp"
 
+#include <fstream>
+#include <iterator>
 #include <memory>
 #include <set>
 #include <string>
@@ -54,6 +56,86 @@ static suite<"import"> _ = [] {
 
 
   };
+
+  "streaming"_test = [] {
+    //imports path with both importers and compares the results (trees visited in the same order, typed attributes, DataPaths); deletes both
+    auto compare = [](const std::string &path, const std::string &streamedPath) {
+      Component *dom = importFromXml(path);
+      Component *streamed = importFromXmlStreaming(streamedPath);
+      expect((dom != nullptr && streamed != nullptr) >> fatal);
+
+      std::vector<Component *> a = dom->FindDescendantsByType(ComponentType::Any);
+      std::vector<Component *> b = streamed->FindDescendantsByType(ComponentType::Any);
+      expect((a.size() == b.size()) >> fatal);
+      size_t dataPaths = 0;
+      for (size_t i = 0; i < a.size(); i++) {
+        expect(a[i]->GetComponentType() == b[i]->GetComponentType());
+        expect(a[i]->GetId() == b[i]->GetId());
+        expect(a[i]->GetName() == b[i]->GetName());
+        expect(a[i]->GetChildren().size() == b[i]->GetChildren().size());
+        expect(a[i]->attrib.size() == b[i]->attrib.size());
+        expect(a[i]->GetAttribStore().GetEntries() == b[i]->GetAttribStore().GetEntries());
+
+        std::vector<DataPath *> da = a[i]->FindDataPaths(DataPathType::Any, DataPathDirection::Outgoing);
+        std::vector<DataPath *> db = b[i]->FindDataPaths(DataPathType::Any, DataPathDirection::Outgoing);
+        expect((da.size() == db.size()) >> fatal);
+        for (size_t j = 0; j < da.size(); j++) {
+          expect(da[j]->GetBandwidth() == db[j]->GetBandwidth());
+          expect(da[j]->GetLatency() == db[j]->GetLatency());
+          expect(da[j]->GetDataPathType() == db[j]->GetDataPathType());
+          expect(da[j]->GetTarget()->GetId() == db[j]->GetTarget()->GetId());
+        }
+        dataPaths += da.size();
+      }
+      dom->Delete(true);
+      streamed->Delete(true);
+      return dataPaths;
+    };
+
+    expect(compare(SYS_SAGE_TEST_RESOURCE_DIR "/sys-sage_sample_output.xml", SYS_SAGE_TEST_RESOURCE_DIR "/sys-sage_sample_output.xml") > 0U);
+    compare(SYS_SAGE_TEST_RESOURCE_DIR "/sys-sage_custom_attributes.xml", SYS_SAGE_TEST_RESOURCE_DIR "/sys-sage_custom_attributes.xml");
+
+    //typed attributes and DataPaths, in the order of the export and with the Relations before the Components (which are then deferred)
+    {
+      auto topo = new Topology;
+      Node *node = new Node{topo, 1};
+      node->SetAttr("cores", 64);
+      node->SetAttr("memory", int64_t{1} << 40);
+      node->SetAttr("vendor", std::string("AMD"));
+      node->SetAttr("load", std::vector<double>{0.5, 0.25});
+      std::vector<Core *> cores = node->CreateChildren<Core>(4, 0);
+      for (Core *core : cores) {
+        core->SetAttr("freq", 2000.0 + core->GetId());
+        new DataPath(node, core, DataPathOrientation::Oriented, DataPathType::Physical, 10.0 * core->GetId(), 5.0);
+      }
+      new DataPath(cores[0], cores[3], DataPathOrientation::Bidirectional, DataPathType::Logical, 1.0, 2.0);
+      exportToXml(topo, "streaming.xml");
+      topo->Delete(true);
+    }
+    expect(that % compare("streaming.xml", "streaming.xml") == 6U); //the bidirectional DataPath is outgoing at both ends
+
+    std::string text;
+    {
+      std::ifstream in("streaming.xml");
+      text.assign(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+    }
+    size_t c0 = text.find("<Components>"), c1 = text.find("</Components>");
+    size_t r0 = text.find("<Relations>"), r1 = text.find("</Relations>");
+    expect((c1 != std::string::npos && r1 != std::string::npos && c0 < c1 && c1 < r0 && r0 < r1) >> fatal);
+    c1 += std::string("</Components>").size();
+    r1 += std::string("</Relations>").size();
+    std::ofstream("streaming_reordered.xml") << text.substr(0, c0) << text.substr(r0, r1 - r0) << text.substr(c1, r0 - c1) << text.substr(c0, c1 - c0) << text.substr(r1);
+    expect(that % compare("streaming.xml", "streaming_reordered.xml") == 6U);
+
+    //a file that ends in the middle is not imported
+    std::ofstream("streaming_truncated.xml") << text.substr(0, (c0 + c1) / 2);
+    expect(importFromXmlStreaming("streaming_truncated.xml") == nullptr);
+    expect(importFromXmlStreaming(SYS_SAGE_TEST_RESOURCE_DIR "/missing.xml") == nullptr);
+
+    std::remove("streaming.xml");
+    std::remove("streaming_reordered.xml");
+    std::remove("streaming_truncated.xml");
+  };
 };
 // Compare two XML files
 // TODO: Add more tests
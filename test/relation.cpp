@@ -51,6 +51,74 @@ ut::suite<"relation"> _ = []
     ut::expect(ut::that % bar.GetRelationsByType(RelationType::Relation).size() == 0U);
   };
 
+  ut::test("bulk deletion") = []
+  {
+    Component hub, a, b, c;
+    std::vector<DataPath *> dps;
+    for(Component *other : {&a, &b, &c, &a, &b, &c})
+      dps.push_back(new DataPath(&hub, other, DataPathOrientation::Oriented, DataPathType::Physical));
+    DataPath *loop = new DataPath(&hub, &hub, DataPathOrientation::Bidirectional, DataPathType::Logical);
+    Relation *twice = new Relation(std::vector<Component *> {&hub, &a, &hub});
+
+    //deleting from the middle moves the last relation into the gap, in all lists involved
+    dps[1]->Delete();
+    ut::expect(ut::that % hub.GetRelationsByType(RelationType::DataPath) == std::vector<Relation *> {dps[0], loop, dps[2], dps[3], dps[4], dps[5]});
+    ut::expect(ut::that % b.GetRelationsByType(RelationType::DataPath) == std::vector<Relation *> {dps[4]});
+    dps[4]->Delete();
+    ut::expect(ut::that % b.GetRelationsByType(RelationType::DataPath).size() == 0U);
+
+    size_t deleted = hub.DeleteRelations(RelationType::DataPath, [&c](Relation *r) { return static_cast<DataPath *>(r)->GetTarget() == &c; });
+    ut::expect(ut::that % deleted == 2U);
+    ut::expect(ut::that % hub.GetRelationsByType(RelationType::DataPath) == std::vector<Relation *> {dps[0], loop, dps[3]});
+    ut::expect(ut::that % c.GetRelationsByType(RelationType::DataPath).size() == 0U);
+    ut::expect(ut::that % a.GetRelationsByType(RelationType::DataPath) == std::vector<Relation *> {dps[0], dps[3]});
+    dps[0]->Delete();
+    ut::expect(ut::that % a.GetRelationsByType(RelationType::DataPath) == std::vector<Relation *> {dps[3]});
+
+    //a relation with a component taking part twice is listed twice and deleted once
+    ut::expect(ut::that % hub.GetRelationsByType(RelationType::Relation).size() == 2U);
+    ut::expect(ut::that % hub.DeleteRelations(RelationType::Relation, [](Relation *) { return false; }) == 0U);
+    ut::expect(ut::that % hub.GetRelationsByType(RelationType::Relation).size() == 2U);
+    ut::expect(ut::that % hub.DeleteRelations(RelationType::Any, [twice](Relation *r) { return r == twice; }) == 1U);
+    ut::expect(ut::that % hub.GetRelationsByType(RelationType::Relation).size() == 0U);
+    ut::expect(ut::that % a.GetRelationsByType(RelationType::Relation).size() == 0U);
+
+    hub.DeleteRelations(RelationType::Any);
+    ut::expect(ut::that % hub.GetRelationsByType(RelationType::DataPath).size() == 0U);
+    ut::expect(ut::that % a.GetRelationsByType(RelationType::DataPath).size() == 0U);
+  };
+
+  ut::test("component storage") = []
+  {
+    //up to two components are kept inside the relation, more move to the heap
+    Component a, b, c, d;
+    Relation *pair = new Relation(std::vector<Component *> {&a, &b});
+    ut::expect(ut::that % pair->GetComponents().capacity() == 2U);
+    ut::expect(ut::that % pair->GetComponents() == std::vector<Component *> {&a, &b});
+
+    Relation *r = new Relation(std::vector<Component *> {&a, &b, &c});
+    r->AddComponent(&d);
+    ut::expect(ut::that % r->GetComponents() == std::vector<Component *> {&a, &b, &c, &d});
+    ut::expect(ut::that % r->GetComponents().capacity() > 2U);
+    ut::expect(ut::that % r->GetComponent(3) == &d);
+    ut::expect(r->ContainsComponent(&c));
+    ut::expect(ut::that % r->RemoveComponent(1) == 0);
+    ut::expect(ut::that % r->RemoveComponent(0) == 0);
+    std::vector<Component *> remaining = r->GetComponents();
+    ut::expect(ut::that % remaining == std::vector<Component *> {&c, &d});
+    ut::expect(not r->ContainsComponent(&a));
+    ut::expect(ut::that % d.GetRelationsByType(RelationType::Relation) == std::vector<Relation *> {r});
+
+    //a copy gets its own storage
+    Relation *copy = r->_CloneWith(std::vector<Component *> {&a, &b});
+    ut::expect(ut::that % copy->GetComponents() == std::vector<Component *> {&a, &b});
+    ut::expect(ut::that % r->GetComponents() == std::vector<Component *> {&c, &d});
+
+    for(Relation *rel : {pair, r, copy})
+      rel->Delete();
+    ut::expect(ut::that % a.GetRelationsByType(RelationType::Relation).size() == 0U);
+  };
+
   ut::test("getters & setters") = []
   {
     std::vector<Component *> v;
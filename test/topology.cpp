@@ -1,8 +1,18 @@
 #include <boost/ut.hpp>
+#include <atomic>
+#include <cmath>
+#include <cstdio>
+#include <fstream>
+#include <ranges>
 #include <string_view>
+#include <thread>
 
 #include "sys-sage.hpp"
 
+#ifdef SYS_SAGE_TEST_ASAN
+#include <sanitizer/lsan_interface.h>
+#endif
+
 using namespace boost::ut;
 using namespace sys_sage;
 using namespace std::string_view_literals;
@@ -199,6 +209,705 @@ static suite<"topology"> _ = []
         expect(that % (std::find(a.GetChildren().begin(), a.GetChildren().end(), &d) != a.GetChildren().end()));
     };
 
+    "Index in parent and unordered children"_test = []
+    {
+        Node n;
+        std::vector<Thread *> threads;
+        for(int i = 0; i < 8; i++)
+            threads.push_back(new Thread(&n, i));
+        expect(that % 3 == threads[3]->GetIndexInParent());
+        expect(that % -1 == n.GetIndexInParent());
+
+        //stable order (default): the following children move forward
+        expect(that % 1 == n.RemoveChild(threads[1]));
+        expect(that % 0 == n.RemoveChild(threads[1]));
+        expect(that % std::vector<Component *>{threads[0], threads[2], threads[3], threads[4], threads[5], threads[6], threads[7]} == n.GetChildren());
+        for(int i = 0; i < 7; i++)
+            expect(that % i == n.GetChildren()[i]->GetIndexInParent());
+
+        //unordered: the last child takes the place of the removed one
+        n.SetStableChildrenOrder(false);
+        expect(that % !n.GetStableChildrenOrder());
+        expect(that % 1 == n.RemoveChild(threads[2]));
+        expect(that % std::vector<Component *>{threads[0], threads[7], threads[3], threads[4], threads[5], threads[6]} == n.GetChildren());
+        expect(that % 1 == threads[7]->GetIndexInParent());
+
+        Core core{10};
+        expect(that % 0 == core.InsertBetweenParentAndChildren(&n, {threads[0], threads[4], threads[6]}, false));
+        expect(that % std::vector<Component *>{threads[5], threads[7], threads[3], &core} == n.GetChildren());
+        expect(that % std::vector<Component *>{threads[0], threads[4], threads[6]} == core.GetChildren());
+        for(Component *c : n.GetChildren())
+            expect(that % &n == c->GetParent());
+
+        //stable order: moved children are removed in a single compaction, keeping the order
+        n.SetStableChildrenOrder(true);
+        Core core2{11};
+        expect(that % 0 == core2.InsertBetweenParentAndChildren(&n, {threads[3], threads[5]}, false));
+        expect(that % std::vector<Component *>{threads[7], &core, &core2} == n.GetChildren());
+        expect(that % 2 == core2.GetIndexInParent());
+        expect(that % 1 == threads[5]->GetIndexInParent());
+        expect(that % 1 == core2.InsertBetweenParentAndChildren(&n, {threads[0]}, true));
+
+        n.RemoveChild(&core);
+        n.RemoveChild(&core2);
+        n.DeleteSubtree();
+        for(Thread *t : {threads[0], threads[1], threads[2], threads[3], threads[4], threads[5], threads[6]})
+            delete t;
+
+        //the index lookups of traversals deeper than the inline path of the iterators do not modify the tree, so concurrent readers may traverse a tree with stale indices
+        Node chain;
+        std::vector<Component *> removed;
+        Component *last = &chain;
+        for(int i = 0; i < 40; i++)
+        {
+            Component *first = new Thread(last, 0);
+            Component *next = new Core(last, 1);
+            new Thread(last, 2);
+            last->RemoveChild(first);
+            removed.push_back(first);
+            last = next;
+        }
+        std::atomic<int> mismatches{0};
+        std::vector<std::thread> readers;
+        for(int r = 0; r < 4; r++)
+            readers.emplace_back([&chain, &mismatches]{
+                size_t visited = 0;
+                for([[maybe_unused]] Component *c : chain.TraversePreOrder())
+                    visited++;
+                if(visited != 81)
+                    mismatches++;
+            });
+        for(std::thread &t : readers)
+            t.join();
+        expect(that % 0 == mismatches.load());
+        expect(that % 1 == chain.GetChildren()[1]->GetIndexInParent());
+        chain.DeleteSubtree();
+        for(Component *c : removed)
+            delete c;
+    };
+
+    "Bulk construction"_test = []
+    {
+        Node n;
+        n.ReserveChildren(4);
+        std::vector<Core *> cores = n.CreateChildren<Core>(4, 10, "core");
+        expect(that % (4_u == cores.size()) >> fatal);
+        expect(that % 4_u == n.GetChildren().size());
+        for(int i = 0; i < 4; i++)
+        {
+            expect(that % cores[i] == n.GetChildren()[i]);
+            expect(that % &n == cores[i]->GetParent());
+            expect(that % (10 + i) == cores[i]->GetId());
+            expect(that % "core"sv == cores[i]->GetName());
+            expect(that % i == cores[i]->GetIndexInParent());
+        }
+
+        std::vector<Cache *> caches = cores[0]->CreateChildren<Cache>(2, 0, "L1", 32768);
+        expect(that % "L1"sv == caches[1]->GetCacheName());
+        expect(that % 32768 == caches[1]->GetCacheSize());
+
+        Thread t0{0}, t1{1}, t2{2};
+        cores[1]->InsertChildren({&t0, &t1, &t2});
+        expect(that % std::vector<Component *>{&t0, &t1, &t2} == cores[1]->GetChildren());
+        expect(that % cores[1] == t2.GetParent());
+
+        n.ReserveRelations(RelationType::DataPath, 8);
+        expect(that % 0_u == n.GetRelationsByType(RelationType::DataPath).size());
+        DataPath dp{&n, &t0, DataPathOrientation::Oriented};
+        expect(that % 1_u == n.GetRelationsByType(RelationType::DataPath).size());
+        expect(that % &dp == n.GetRelationsByType(RelationType::DataPath)[0]);
+
+        cores[1]->RemoveChild(&t0);
+        cores[1]->RemoveChild(&t1);
+        cores[1]->RemoveChild(&t2);
+        n.DeleteSubtree();
+    };
+
+    "Clone"_test = []
+    {
+        //2-socket node: 2 chips with an L3 and 8 cores each, a memory per chip and DataPaths among them
+        Node *node = new Node(0);
+        std::vector<Chip *> chips = node->CreateChildren<Chip>(2, 0);
+        std::vector<DataPath *> memoryPaths;
+        for(Chip *chip : chips)
+        {
+            Cache *l3 = new Cache(chip, 0, "L3", 32 << 20);
+            for(Core *core : l3->CreateChildren<Core>(8, 0))
+                new Thread(core, core->GetId());
+            memoryPaths.push_back(new DataPath(chip, new Memory(node, chip->GetId()), DataPathOrientation::Oriented, DataPathType::Physical, 100.0, 90.0));
+        }
+        DataPath *link = new DataPath(chips[0], chips[1], DataPathOrientation::Bidirectional, DataPathType::Physical, 20.0, 150.0);
+        Node outside{1};
+        DataPath *external = new DataPath(&outside, chips[0], DataPathOrientation::Oriented);
+
+        unsigned originalComponents = 0, originalRelations = 0;
+        node->CalcSubtreeSize(&originalComponents, &originalRelations);
+
+        //deep copy: everything but the DataPath to the outside
+        Component *deep = node->Clone(true);
+        expect(that % nullptr == deep->GetParent());
+        expect(that % nullptr == deep->GetCloneSource());
+        expect(that % 0 == deep->CheckSubtreeConsistency());
+        std::vector<Component *> originalDescendants, deepDescendants;
+        node->FindDescendantsByType(&originalDescendants, ComponentType::Any);
+        deep->FindDescendantsByType(&deepDescendants, ComponentType::Any);
+        expect(that % (originalDescendants.size() == deepDescendants.size()) >> fatal);
+        for(size_t i = 0; i < deepDescendants.size(); i++)
+        {
+            expect(that % originalDescendants[i] != deepDescendants[i]);
+            expect(that % originalDescendants[i]->GetComponentType() == deepDescendants[i]->GetComponentType());
+            expect(that % originalDescendants[i]->GetId() == deepDescendants[i]->GetId());
+        }
+        Chip *deepChip = static_cast<Chip *>(deep->GetChildren()[0]);
+        expect(that % 2_u == deepChip->GetRelationsByType(RelationType::DataPath).size());
+        DataPath *deepLink = static_cast<DataPath *>(deepChip->GetRelationsByType(RelationType::DataPath)[1]);
+        expect(that % deep->GetChildren()[1] == deepLink->GetTarget());
+        expect(that % 20.0 == deepLink->GetBandwidth());
+        expect(that % 3_u == chips[0]->GetRelationsByType(RelationType::DataPath).size());
+        MemoryFootprint originalFootprint, deepFootprint;
+        node->CalcFootprint(&originalFootprint);
+        deep->CalcFootprint(&deepFootprint);
+        expect(originalFootprint.componentTypes == deepFootprint.componentTypes);
+        expect(that % originalFootprint.relationTypes[RelationType::DataPath] == deepFootprint.relationTypes[RelationType::DataPath] + sizeof(DataPath));
+        deep->Delete();
+
+        //copy-on-write: only the root is copied ...
+        Component *cow = node->Clone(false);
+        expect(that % node == cow->GetCloneSource());
+        expect(that % node->GetChildren() == cow->GetChildren());
+        unsigned cowComponents = 0, cowRelations = 0;
+        cow->CalcSubtreeSize(&cowComponents, &cowRelations);
+        expect(that % sizeof(Node) + 4 * sizeof(Component *) == cowComponents);
+        expect(that % 0_u == cowRelations);
+        //the parallel traversal skips the shared subtrees as well (a threshold of 1 splits even this small tree into pieces)
+        WorkStealingPool pool{4};
+        ParallelTraversal parallel{&pool, 1};
+        unsigned parallelComponents = 0, parallelRelations = 0;
+        cow->CalcSubtreeSize(&parallelComponents, &parallelRelations, parallel);
+        expect(that % cowComponents == parallelComponents);
+        expect(that % cowRelations == parallelRelations);
+
+        //... and a modification copies only the path to the modified component
+        Component *core = chips[1]->GetChildren()[0]->GetChildren()[3];
+        Component *writableCore = cow->MakeWritable(core);
+        expect((that % writableCore != nullptr) >> fatal);
+        expect(that % core == writableCore->GetCloneSource());
+        expect(that % writableCore == cow->MakeWritable(core));
+        expect(that % writableCore == cow->MakeWritable(writableCore));
+        expect(that % nullptr == cow->MakeWritable(&outside));
+        writableCore->SetId(42);
+        expect(that % 3 == core->GetId());
+        expect(that % chips[1]->GetChildren()[0] == core->GetParent());
+        Component *writableChip = cow->GetChildren()[1];
+        expect(that % chips[1] == writableChip->GetCloneSource());
+        expect(that % chips[0] == cow->GetChildren()[0]);
+        expect(that % writableCore == writableChip->GetChildren()[0]->GetChildren()[3]);
+        expect(that % core->GetChildren() == writableCore->GetChildren());
+        cowComponents = 0;
+        cow->CalcSubtreeSize(&cowComponents, &cowRelations);
+        expect(that % sizeof(Node) + sizeof(Chip) + sizeof(Cache) + sizeof(Core) + 4 * sizeof(Component *) + 1 * sizeof(Component *) + 8 * sizeof(Component *) + 1 * sizeof(Component *) < cowComponents);
+        expect(that % cowComponents < originalComponents / 4);
+        parallelComponents = 0;
+        parallelRelations = 0;
+        cow->CalcSubtreeSize(&parallelComponents, &parallelRelations, parallel);
+        expect(that % cowComponents == parallelComponents);
+        expect(that % cowRelations == parallelRelations);
+
+        //a modified DataPath connects the private copies instead of the original chips
+        DataPath *writableLink = static_cast<DataPath *>(cow->MakeWritable(link));
+        expect((that % writableLink != nullptr && writableLink != link) >> fatal);
+        writableLink->SetBandwidth(10.0);
+        expect(that % 20.0 == link->GetBandwidth());
+        expect(that % cow->GetChildren()[0] == writableLink->GetSource());
+        expect(that % writableChip == writableLink->GetTarget());
+        expect(that % chips[1] == link->GetTarget());
+        expect(that % writableLink == cow->MakeWritable(writableLink));
+        expect(that % writableLink == writableChip->GetRelationsByType(RelationType::DataPath)[1]);
+        expect(that % memoryPaths[1] == writableChip->GetRelationsByType(RelationType::DataPath)[0]);
+        expect(that % nullptr == cow->MakeWritable(external));
+        cowComponents = cowRelations = parallelComponents = parallelRelations = 0;
+        cow->CalcSubtreeSize(&cowComponents, &cowRelations);
+        cow->CalcSubtreeSize(&parallelComponents, &parallelRelations, parallel);
+        expect(that % sizeof(DataPath) == cowRelations);
+        expect(that % cowComponents == parallelComponents);
+        expect(that % cowRelations == parallelRelations);
+
+        //deleting the copy frees only what it does not share
+        cow->Delete();
+        expect(that % 0 == node->CheckSubtreeConsistency());
+        expect(that % 4_u == node->GetChildren().size());
+        expect(that % 8_u == chips[1]->GetChildren()[0]->GetChildren().size());
+        expect(that % 1_u == core->GetChildren().size());
+        expect(that % std::vector<Relation *>{memoryPaths[1], link} == chips[1]->GetRelationsByType(RelationType::DataPath));
+        expect(that % 90.0 == memoryPaths[0]->GetLatency());
+        unsigned afterComponents = 0, afterRelations = 0;
+        node->CalcSubtreeSize(&afterComponents, &afterRelations);
+        expect(that % originalComponents == afterComponents);
+        expect(that % originalRelations == afterRelations);
+        node->Delete();
+    };
+
+    "Memory footprint"_test = []
+    {
+        Node *node = new Node(0);
+        std::string vendor(64, 'v');
+        Chip *chip = new Chip(node, 0, "Chip", ChipType::Gpu, vendor);
+        new Cache(chip, 0, "a cache name that does not fit into a short string", 1 << 20);
+        Memory *memory = new Memory(node, 0);
+        DataPath *dp = new DataPath(chip, memory, DataPathOrientation::Oriented, DataPathType::Physical, 100.0, 10.0);
+        dp->attrib["readBandwidth"] = new double{90.0};
+        std::string *uuid = new std::string("MIG-0123456789abcdef0123456789abcdef");
+        chip->attrib["mig_uuid"] = uuid;
+        chip->attrib["custom"] = new int{1};
+        QuantumBackend *backend = new QuantumBackend(node, 1);
+        backend->CreateChildren<Qubit>(5, 0);
+
+        MemoryFootprint footprint;
+        size_t total = node->CalcFootprint(&footprint);
+        expect(that % total == footprint.total);
+        unsigned componentSize = 0, relationSize = 0;
+        expect(that % total == static_cast<size_t>(node->CalcSubtreeSize(&componentSize, &relationSize)));
+
+        //per type: the objects and the heap memory of their members
+        expect(that % sizeof(Node) == footprint.componentTypes[ComponentType::Node]);
+        expect(that % sizeof(Chip) + vendor.size() + 1 <= footprint.componentTypes[ComponentType::Chip]);
+        expect(that % sizeof(Cache) + 50 < footprint.componentTypes[ComponentType::Cache]);
+        expect(that % 5 * sizeof(Qubit) == footprint.componentTypes[ComponentType::Qubit]);
+        expect(that % sizeof(QuantumBackend) == footprint.componentTypes[ComponentType::QuantumBackend]);
+        expect(that % sizeof(DataPath) == footprint.relationTypes[RelationType::DataPath]);
+        expect(that % 0_u == footprint.indexes);
+
+        //per attribute: map node, key and value (if known)
+        size_t attribNode = sizeof(std::pair<const std::string, void *>) + _mapNodeOverhead;
+        expect(that % attribNode + sizeof(double) == footprint.attributes["readBandwidth"]);
+        expect(that % attribNode + sizeof(std::string) + uuid->capacity() + 1 == footprint.attributes["mig_uuid"]);
+        expect(that % attribNode == footprint.attributes["custom"]);
+        expect(that % 1_u == footprint.numUnknownAttribs);
+
+        size_t sum = footprint.childrenContainers + footprint.relationContainers + footprint.attribContainers + footprint.indexes;
+        for(const auto &[componentType, size] : footprint.componentTypes)
+            sum += size;
+        for(const auto &[relationType, size] : footprint.relationTypes)
+            sum += size;
+        for(const auto &[key, size] : footprint.attributes)
+            sum += size;
+        expect(that % footprint.total == sum);
+        expect(that % (node->GetChildren().capacity() + chip->GetChildren().capacity() + backend->GetChildren().capacity()) * sizeof(Component *) == footprint.childrenContainers);
+
+        //custom attribute sizes and SubtreeIndexes
+        node->EnableSubtreeIndex();
+        MemoryFootprint withCustom;
+        node->CalcFootprint(&withCustom, [](const std::string &key, const void *){ return key == "custom" ? sizeof(int) : 0; });
+        expect(that % attribNode + sizeof(int) == withCustom.attributes["custom"]);
+        expect(that % 0_u == withCustom.numUnknownAttribs);
+        expect(that % withCustom.indexes > sizeof(SubtreeIndex));
+
+        delete static_cast<double *>(dp->attrib["readBandwidth"]);
+        delete uuid;
+        delete static_cast<int *>(chip->attrib["custom"]);
+        node->Delete();
+    };
+
+    "Typed attributes"_test = []
+    {
+        static int freed = 0;
+        Node node{0};
+        expect(that % nullptr == node.GetAttr<int>("cores"));
+        expect(!node.HasAttr("cores"));
+
+        node.SetAttr("cores", 64);
+        node.SetAttr("memory", int64_t{1} << 40);
+        node.SetAttr("freq", 2.1);
+        node.SetAttr("vendor", std::string("AMD"));
+        node.SetAttr("load", std::vector<double>{0.5, 0.25});
+        expect(that % 5u == node.GetAttribStore().Size());
+        expect(that % 64 == *node.GetAttr<int>("cores"));
+        expect(that % (int64_t{1} << 40) == *node.GetAttr<int64_t>("memory"));
+        expect(that % 2.1 == *node.GetAttr<double>("freq"));
+        expect(node.GetAttr<std::string>("vendor")->compare("AMD") == 0);
+        expect(that % 2u == node.GetAttr<std::vector<double>>("load")->size());
+        //typed values are only returned as their own type
+        expect(that % nullptr == node.GetAttr<double>("cores"));
+
+        //interned keys
+        AttribId cores = InternAttribKey("cores");
+        expect(that % cores == InternAttribKey("cores"));
+        expect(that % cores == FindAttribKey("cores"));
+        expect(GetAttribKeyName(cores).compare("cores") == 0);
+        expect(that % invalidAttribId == FindAttribKey("a key that was never used"));
+        node.SetAttr(cores, 128);
+        expect(that % 128 == *node.GetAttr<int>(cores));
+        *node.GetAttr<int>(cores) = 96;
+        expect(that % 96 == *node.GetAttr<int>("cores"));
+
+        //entries stay sorted by AttribId
+        const std::vector<AttribStore::Entry> &entries = node.GetAttribStore().GetEntries();
+        for(size_t i = 1; i < entries.size(); i++)
+            expect(entries[i - 1].first < entries[i].first);
+
+        //the attrib map is searched as well; typed attributes take precedence
+        int legacy = 7, shadowed = 1;
+        node.attrib["legacy"] = &legacy;
+        node.attrib["cores"] = &shadowed;
+        expect(that % 7 == *node.GetAttr<int>("legacy"));
+        expect(that % 7 == *node.GetAttr<int>(InternAttribKey("legacy")));
+        expect(that % 96 == *node.GetAttr<int>("cores"));
+        expect(node.HasAttr("legacy"));
+        expect(!node.EraseAttr("legacy"));
+        expect(node.EraseAttr("cores"));
+        expect(that % 1 == *node.GetAttr<int>("cores"));
+        node.attrib.clear();
+
+        //opaque values are freed when replaced, and shared by clones
+        freed = 0;
+        node.SetAttrPtr("opaque", new int{3}, [](void *p){ delete static_cast<int *>(p); freed++; });
+        expect(that % 3 == *node.GetAttr<int>("opaque"));
+        Component *copy = node.Clone();
+        expect(that % node.GetAttr<int>("opaque") == copy->GetAttr<int>("opaque"));
+        expect(that % 2.1 == *copy->GetAttr<double>("freq"));
+        node.SetAttrPtr("opaque", new int{4}, [](void *p){ delete static_cast<int *>(p); freed++; });
+        expect(that % 0 == freed);
+        copy->Delete();
+        expect(that % 1 == freed);
+        node.EraseAttr("opaque");
+        expect(that % 2 == freed);
+
+        //Relations
+        Node other{1};
+        DataPath *dp = new DataPath(&node, &other, DataPathOrientation::Oriented, DataPathType::Physical, 10.0, 1.0);
+        dp->SetAttr("hops", 2);
+        expect(that % 2 == *dp->GetAttr<int>("hops"));
+        expect(dp->HasAttr("hops"));
+        dp->Delete();
+
+        //footprint: entries and the heap memory of the values
+        MemoryFootprint footprint;
+        node.CalcFootprint(&footprint);
+        expect(that % sizeof(AttribStore::Entry) == footprint.attributes["freq"]);
+        expect(that % sizeof(AttribStore::Entry) + 2 * sizeof(double) <= footprint.attributes["load"]);
+    };
+
+    "Columnar attributes"_test = []
+    {
+        Node *node = new Node(0);
+        std::vector<Core *> cores = node->CreateChildren<Core>(8, 0);
+        new Memory(node, 0);
+        ColumnStore columns;
+        expect(that % 9u == columns.RegisterSubtree(node, ComponentType::Core) + columns.RegisterSubtree(node, ComponentType::Memory));
+        expect(that % 8u == columns.GetComponents(ComponentType::Core).size());
+        expect(that % 3 == columns.GetIndex(cores[3]));
+        expect(that % -1 == columns.GetIndex(node));
+
+        AttribId freq = InternAttribKey("freq");
+        expect(that % nullptr == columns.FindColumn(ComponentType::Core, freq));
+        expect(std::isnan(columns.Max(ComponentType::Core, freq)));
+        expect(that % nullptr == columns.ArgMax(ComponentType::Core, freq));
+        for(size_t i = 0; i < cores.size(); i++)
+            if(i != 5)
+                columns.Set(cores[i], freq, 1000.0 + 100 * i);
+        //unset values (cores[5]) are skipped
+        expect(std::isnan(columns.Get(cores[5], freq)));
+        expect(that % 1700.0 == columns.Max(ComponentType::Core, freq));
+        expect(that % 1000.0 == columns.Min(ComponentType::Core, freq));
+        expect(that % 7 * 1000.0 + 100 * (0 + 1 + 2 + 3 + 4 + 6 + 7) == columns.Sum(ComponentType::Core, freq));
+        expect(that % (7 * 1000.0 + 2300) / 7 == columns.Mean(ComponentType::Core, freq));
+        expect(that % cores[7] == columns.ArgMax(ComponentType::Core, freq));
+        expect(that % cores[0] == columns.ArgMin(ComponentType::Core, freq));
+
+        //bulk update, e.g. from a sampler
+        std::vector<Component *> sampled(cores.begin(), cores.begin() + 2);
+        expect(that % 0 == columns.Set(sampled, freq, {3000.0, 500.0}));
+        expect(that % 1 == columns.Set(sampled, freq, {1.0}));
+        expect(that % cores[0] == columns.ArgMax(ComponentType::Core, freq));
+        expect(that % cores[1] == columns.ArgMin(ComponentType::Core, freq));
+        double *column = columns.GetColumn(ComponentType::Core, freq);
+        column[5] = 4000.0;
+        expect(that % cores[5] == columns.ArgMax(ComponentType::Core, freq));
+
+        //removing moves the last component into the freed index
+        expect(columns.Remove(cores[1]));
+        expect(!columns.Remove(cores[1]));
+        expect(that % 1 == columns.GetIndex(cores[7]));
+        expect(that % 1700.0 == columns.Get(cores[7], freq));
+        expect(that % 500.0 < columns.Min(ComponentType::Core, freq));
+        expect(that % columns.GetFootprint() > sizeof(ColumnStore));
+
+        //Relations, by RelationType: e.g. the mig_size of the MIG DataPaths
+        RelationColumnStore relationColumns;
+        DataPath *mig0 = new DataPath(node, cores[0], DataPathOrientation::Bidirectional, DataPathType::MIG);
+        DataPath *mig1 = new DataPath(node, cores[2], DataPathOrientation::Bidirectional, DataPathType::MIG);
+        DataPath *link = new DataPath(cores[0], cores[2], DataPathOrientation::Oriented, DataPathType::Physical);
+        expect(that % 3u == relationColumns.RegisterSubtree(node, RelationType::DataPath));
+        expect(that % 0u == relationColumns.RegisterSubtree(node));
+        expect(that % 3u == relationColumns.GetComponents(RelationType::DataPath).size());
+        AttribId migSize = InternAttribKey("mig_size");
+        relationColumns.Set(mig0, migSize, 10.0);
+        relationColumns.Set(mig1, "mig_size", 20.0);
+        expect(that % 30.0 == relationColumns.Sum(RelationType::DataPath, migSize));
+        expect(that % static_cast<Relation *>(mig1) == relationColumns.ArgMax(RelationType::DataPath, migSize));
+        expect(std::isnan(relationColumns.Get(link, migSize)));
+        expect(that % nullptr == relationColumns.FindColumn(RelationType::QuantumGate, migSize));
+        expect(relationColumns.Remove(mig0));
+        expect(that % 20.0 == relationColumns.Min(RelationType::DataPath, migSize));
+        expect(that % -1 == relationColumns.GetIndex(mig0));
+
+        //parsers write into the store directly
+        {
+            std::ofstream json("iqm_columns.json");
+            json << R"({"backend_name": "test", "T1": ["30.0", "50.0", "40.0"], "T2": ["10.0", "20.0", "15.0"],
+                "1q_fidelity": ["0.99", "0.98", "0.995"], "readout_fidelity": ["0.9", "0.95", "0.92"], "two_q_fidelity": {"0,1": "0.97", "1,2": "0.96"}})";
+        }
+        QuantumBackend *backend = new QuantumBackend(node, 1);
+        expect(that % 0 == parseIQM(backend, "iqm_columns.json", 1, -1, true, &columns));
+        std::remove("iqm_columns.json");
+        expect(that % 3u == columns.GetComponents(ComponentType::Qubit).size());
+        expect(that % 50.0 == columns.Max(ComponentType::Qubit, InternAttribKey("T1")));
+        expect(that % backend->GetChild(1) == columns.ArgMax(ComponentType::Qubit, InternAttribKey("T1")));
+        expect(that % 0.98 == columns.Min(ComponentType::Qubit, InternAttribKey("q1_fidelity")));
+
+        node->Delete();
+    };
+
+    "Time series"_test = []
+    {
+        //ring buffer: only the newest samples are kept
+        TimeSeries ts({"frequency"}, {4, 0});
+        for(int64_t t = 0; t < 10; t++)
+            expect(that % 0 == ts.Append(t * 100, 1000.0 + t));
+        expect(that % 1 == ts.Append(0, 1.0));
+        expect(that % 1 == ts.Append(1000, {1.0, 2.0}));
+        expect(that % 4u == ts.Size());
+        expect(that % 600 == ts.GetTimestamp(0));
+        expect(that % 1009.0 == ts.GetValue(3));
+
+        //time-range queries
+        expect(that % 1u == ts.LowerBound(650));
+        expect(that % 4u == ts.LowerBound(1000));
+        auto [first, last] = ts.FindRange(700, 800);
+        expect(that % 1u == first && that % 3u == last);
+        auto [none, none_end] = ts.FindRange(800, 700);
+        expect(that % none == none_end);
+
+        //time window
+        TimeSeries window({"t1", "t2"}, {0, 250});
+        for(int64_t t = 0; t < 10; t++)
+            window.Append(t * 100, {1.0 * t, 2.0 * t});
+        expect(that % 3u == window.Size());
+        expect(that % 700 == window.GetTimestamp(0));
+        expect(that % 18.0 == window.GetValue(2, 1));
+
+        //downsampling tiers: aggregates per period, each tier with its own retention
+        TimeSeries tiered({"frequency"}, {8, 0});
+        size_t seconds = tiered.AddTier(1000);
+        size_t minutes = tiered.AddTier(60000, {2, 0});
+        expect(that % TimeSeries::invalidTier == tiered.AddTier(0));
+        expect(that % TimeSeries::invalidTier == tiered.AddTier(-1000));
+        expect(that % 2u == tiered.GetNumTiers());
+        for(int64_t t = 0; t < 200; t++)
+            tiered.Append(t * 500, static_cast<double>(t % 10));
+        expect(that % 8u == tiered.Size());
+        expect(that % 100u == tiered.GetTierSize(seconds));
+        TimeSeries::Aggregate a = tiered.GetAggregate(seconds, 3);
+        expect(that % 3000 == a.timestamp && that % 2u == a.count);
+        expect(that % 6.0 == a.min && that % 7.0 == a.max && that % 13.0 == a.sum);
+        expect(that % 6.5 == a.Mean());
+        expect(that % 2u == tiered.GetTierSize(minutes));
+        expect(that % 0 == tiered.GetAggregate(minutes, 0).timestamp);
+        expect(that % 120u == tiered.GetAggregate(minutes, 0).count);
+        expect(that % 80u == tiered.GetAggregate(minutes, 1).count);
+        auto [tfirst, tlast] = tiered.FindTierRange(seconds, 10000, 19999);
+        expect(that % 10u == tfirst && that % 20u == tlast);
+
+        //the memory is bounded by the retention
+        size_t heapSize = tiered.GetHeapSize();
+        for(int64_t t = 200; t < 2000; t++)
+            tiered.Append(t * 500, 1.0);
+        expect(that % 2u == tiered.GetTierSize(minutes));
+        expect(that % 1000u == tiered.GetTierSize(seconds));
+        expect(that % heapSize < tiered.GetHeapSize());
+        size_t boundedHeapSize = ts.GetHeapSize();
+        for(int64_t t = 10; t < 10000; t++)
+            ts.Append(t * 100, 1.0);
+        expect(that % boundedHeapSize == ts.GetHeapSize());
+    };
+
+    "Attribute ownership"_test = []
+    {
+        static int freed = 0;
+        void (*countingDeleter)(void *) = [](void *p){ delete static_cast<int *>(p); freed++; };
+        Node *node = new Node(0);
+        Core *core = new Core(node, 0);
+
+        //overwriting and erasing free the owned value
+        node->SetAttrib("a", new int(1), countingDeleter);
+        expect(node->OwnsAttrib("a"));
+        expect(that % 1 == *static_cast<int *>(node->attrib["a"]));
+        node->SetAttrib("a", new int(2), countingDeleter);
+        expect(that % 1 == freed);
+        node->SetAttrib("a", node->attrib["a"], countingDeleter);
+        expect(that % 1 == freed);
+        expect(that % 2 == *node->GetAttr<int>("a"));
+        expect(node->EraseAttrib("a"));
+        expect(that % 2 == freed);
+        expect(!node->EraseAttrib("a"));
+
+        //values written to attrib directly are not owned, and not freed
+        int unowned = 5;
+        node->attrib["b"] = &unowned;
+        expect(!node->OwnsAttrib("b"));
+        node->SetAttrib("b", new int(3), countingDeleter);
+        expect(that % 2 == freed);
+        expect(node->OwnsAttrib("b"));
+
+        //deleting frees the owned values of the components and Relations; copies share them
+        core->SetAttrib("c", new int(4), countingDeleter);
+        DataPath *dp = new DataPath(node, core, DataPathOrientation::Oriented);
+        dp->SetAttrib("d", new int(5), countingDeleter);
+        expect(dp->OwnsAttrib("d"));
+        Component *copy = core->Clone();
+        expect(copy->OwnsAttrib("c"));
+        copy->Delete();
+        expect(that % 2 == freed);
+        dp->Delete();
+        expect(that % 3 == freed);
+        node->Delete();
+        expect(that % 5 == freed);
+
+#ifdef SYS_SAGE_TEST_ASAN
+        //leak check: a subtree with owned attribute values (also set by the samplers and parsers) returns all its memory when deleted
+        auto build = []{
+            Node *n = new Node(0);
+            for(int i = 0; i < 64; i++)
+            {
+                Core *c = new Core(n, i);
+                c->SetAttrib("payload", new std::vector<double>(64));
+                c->SetAttrib("freq_history", new TimeSeries({"frequency"}, {16, 0}));
+                static_cast<TimeSeries *>(c->attrib["freq_history"])->Append(i, 1000.0);
+                DataPath *d = new DataPath(n, c, DataPathOrientation::Oriented);
+                d->SetAttrib("latency", new float(1.0f));
+                d->SetAttrib("latency", new float(2.0f));
+            }
+            return n;
+        };
+        build()->Delete();
+
+        //publishing over owned values (as set by the samplers, parsers and the XML import) frees each of them once
+        EpochManager epochs;
+        Node *published = build();
+        for(Component *c : published->GetChildren())
+        {
+            c->PublishAttrib("payload", new std::vector<double>(32), epochs);
+            c->PublishOwnedAttrib("payload", new std::vector<double>(16), epochs);
+            c->PublishAttrib("freq_history", new TimeSeries({"frequency"}, {16, 0}), epochs);
+        }
+        epochs.Synchronize();
+        for(Component *c : published->GetChildren())
+            delete static_cast<TimeSeries *>(c->ReadAttrib("freq_history"));
+        published->Delete();
+        expect(that % 0 == __lsan_do_recoverable_leak_check());
+#endif
+    };
+
+    "Attribute index"_test = []
+    {
+        Node *node = new Node(0);
+        std::vector<Core *> cores = node->CreateChildren<Core>(6, 0);
+        Memory *memory = new Memory(node, 0);
+
+        //values set before the index exists are added with AddSubtree(), later ones by SetAttr() and EraseAttr()
+        cores[0]->SetAttr("job", std::string("a"));
+        ComponentAttribIndex jobs("job");
+        expect(that % 0u == jobs.Size());
+        expect(that % 1u == jobs.AddSubtree(node));
+        expect(that % 0u == jobs.AddSubtree(node));
+        cores[1]->SetAttr("job", std::string("a"));
+        cores[2]->SetAttr("job", std::string("b"));
+        memory->SetAttr("job", 7);
+        cores[3]->SetAttr("job", std::vector<double>{1.0}); //not indexable
+        expect(that % 4u == jobs.Size());
+        expect(jobs.Find(std::string("a")) == std::vector<Component *>{cores[0], cores[1]});
+        expect(that % 1u == jobs.Count(7));
+        expect(that % 1u == jobs.Count(7.0));
+        expect(that % 0u == jobs.Count(std::string("c")));
+        cores[1]->SetAttr("job", std::string("b"));
+        expect(jobs.Find(std::string("a")) == std::vector<Component *>{cores[0]});
+        expect(jobs.Find(std::string("b")) == std::vector<Component *>{cores[2], cores[1]});
+        expect(cores[2]->EraseAttr("job"));
+        expect(jobs.Find(std::string("b")) == std::vector<Component *>{cores[1]});
+        cores[3]->SetAttr("job", std::string("a"));
+        expect(that % 4u == jobs.Size());
+
+        //range queries, e.g. all Cores with freq < 2000
+        ComponentAttribIndex freq(InternAttribKey("freq"));
+        expect(that % &freq == ComponentAttribIndex::Get(InternAttribKey("freq")));
+        for(size_t i = 0; i < cores.size(); i++)
+            cores[i]->SetAttr("freq", 1500.0 + 200 * i);
+        expect(freq.FindRange(-INFINITY, 2000.0) == std::vector<Component *>{cores[0], cores[1], cores[2]});
+        expect(freq.FindRange(1700, 2300.0) == std::vector<Component *>{cores[1], cores[2], cores[3]});
+        expect(freq.FindRange(2000.0, 1000.0).empty());
+        cores[0]->SetAttr("freq", 3000.0);
+        expect(freq.FindRange(-INFINITY, 2000.0) == std::vector<Component *>{cores[1], cores[2]});
+        cores[1]->SetAttr("freq", std::nan(""));
+        expect(that % 5u == freq.Size());
+
+        //integers are kept exact: int64_t values beyond 2^53 stay distinct, and compare with doubles by their value
+        ComponentAttribIndex device(InternAttribKey("device_id"));
+        int64_t large = (int64_t(1) << 53) + 1;
+        cores[0]->SetAttr("device_id", large);
+        cores[1]->SetAttr("device_id", large - 1);
+        cores[2]->SetAttr("device_id", static_cast<double>(large - 1));
+        cores[3]->SetAttr("device_id", 3);
+        expect(that % 1u == device.Count(large));
+        expect(that % 2u == device.Count(large - 1));
+        expect(that % 1u == device.Count(3.0));
+        expect(device.FindRange(large - 1, large) == std::vector<Component *>{cores[1], cores[2]});
+        expect(device.FindRange(2.5, INFINITY) == std::vector<Component *>{cores[3], cores[1], cores[2], cores[0]});
+        expect(device.FindRange(3, 3.5) == std::vector<Component *>{cores[3]});
+
+        //concurrent SetAttr() on different components updates the index under its lock
+        std::vector<std::thread> threads;
+        for(int t = 0; t < 4; t++)
+            threads.emplace_back([&cores, &device, t]{
+                for(int i = 0; i < 200; i++)
+                {
+                    cores[t]->SetAttr(device.GetKey(), static_cast<int64_t>(i % 10));
+                    device.Count(5);
+                }
+            });
+        for(std::thread& thread : threads)
+            thread.join();
+        expect(that % 4u == device.Count(9));
+        expect(that % 4u == device.Size());
+
+        //clones are indexed, deleted components are removed
+        Component *copy = cores[4]->Clone();
+        expect(that % 2u == freq.Count(2300.0));
+        copy->Delete();
+        cores[5]->Delete();
+        expect(that % 1u == freq.Count(2300.0));
+        expect(that % 0u == freq.Count(2500.0));
+        expect(that % 4u == freq.Size());
+
+        //Relations, e.g. the DataPaths of a MIG instance
+        RelationAttribIndex migs("mig_uuid");
+        DataPath *dp0 = new DataPath(node, cores[0], DataPathOrientation::Bidirectional, DataPathType::MIG);
+        DataPath *dp1 = new DataPath(node, cores[1], DataPathOrientation::Bidirectional, DataPathType::MIG);
+        DataPath *dp2 = new DataPath(node, memory, DataPathOrientation::Bidirectional, DataPathType::MIG);
+        dp0->SetAttr("mig_uuid", std::string("MIG-1"));
+        dp1->SetAttr("mig_uuid", std::string("MIG-2"));
+        dp2->SetAttr("mig_uuid", std::string("MIG-1"));
+        expect(migs.Find(std::string("MIG-1")) == std::vector<Relation *>{dp0, dp2});
+        dp2->Delete();
+        expect(migs.Find(std::string("MIG-1")) == std::vector<Relation *>{dp0});
+        expect(that % migs.GetFootprint() > sizeof(RelationAttribIndex));
+
+        node->Delete();
+        expect(that % 0u == migs.Size());
+        expect(that % 0u == jobs.Size());
+        expect(that % 0u == freq.Size());
+        expect(that % nullptr == RelationAttribIndex::Get(InternAttribKey("a key without an index")));
+    };
+
     "Get child"_test = []
     {
         Node a{1};
@@ -345,4 +1054,491 @@ static suite<"topology"> _ = []
 
         expect(that % 3 == a.CalcSubtreeDepth());
     };
+    "Arena allocation and release"_test = []
+    {
+        Topology* topo = new Topology();
+        Arena* arena = topo->CreateArena();
+        expect(that % arena == topo->GetArena());
+        expect(that % arena == topo->CreateArena());
+
+        Node* node = arena->New<Node>(topo, 1);
+        Chip* chip = arena->New<Chip>(node, 0);
+        std::vector<Core*> cores;
+        for(int i = 0; i < 100; i++)
+        {
+            Core* core = arena->New<Core>(chip, i);
+            arena->New<Thread>(core, i);
+            cores.push_back(core);
+        }
+        DataPath* dp = arena->New<DataPath>(cores[0], cores[1], DataPathOrientation::Oriented, DataPathType::Physical);
+        cores[0]->attrib["arena_value"] = arena->New<uint64_t>(42);
+
+        expect(that % 100 == topo->CountDescendantsByType(ComponentType::Thread));
+        expect(that % 0 == topo->CheckSubtreeConsistency());
+        expect(that % 204_u == arena->GetNumObjects());
+        expect(that % dp == cores[1]->GetDataPathByType(DataPathType::Physical, DataPathDirection::Incoming));
+
+        unsigned componentSize = 0, relationSize = 0, arenaSize = 0;
+        topo->CalcSubtreeSize(&componentSize, &relationSize, &arenaSize);
+        expect(that % arenaSize == arena->GetBytesReserved());
+        expect(that % arena->GetBytesUsed() <= arena->GetBytesReserved());
+
+        //individual deletion returns the slots to the arena
+        cores[99]->Delete(true);
+        dp->Delete();
+        expect(that % 201_u == arena->GetNumObjects());
+        expect(that % 99 == topo->CountDescendantsByType(ComponentType::Core));
+
+        expect(that % 201_u == topo->ReleaseArena());
+        expect(that % 0_u == arena->GetNumObjects());
+        expect(that % 0_u == topo->GetChildren().size());
+
+        //the SubtreeIndex and the DataPathIndex of the Topology and DataPathRouter caches drop the released objects
+        topo->EnableSubtreeIndex();
+        Node* kept = new Node(topo, 3);
+        Node* released = arena->New<Node>(topo, 2);
+        for(int i = 0; i < 40; i++)
+            arena->New<DataPath>(topo, arena->New<Thread>(released, i), DataPathOrientation::Oriented, DataPathType::Physical, 1.0, 1.0);
+        expect(that % 40 == topo->CountDescendantsByType(ComponentType::Thread));
+        expect(that % 40u == topo->FindDataPaths(DataPathType::Any, DataPathDirection::Outgoing).size());
+        Thread* releasedThread = static_cast<Thread*>(released->GetChild(0));
+        expect(that % nullptr != topo->FindDataPath(releasedThread));
+        DataPathRouter router;
+        router.ComputeAllPairs({topo, kept}, RouteMetric::MinLatency);
+        expect(router.IsCacheValid());
+
+        expect(that % 81_u == topo->ReleaseArena());
+        expect(that % 0 == topo->CountDescendantsByType(ComponentType::Thread));
+        expect(that % 1 == topo->CountDescendantsByType(ComponentType::Any));
+        expect(that % std::vector<Component*>{kept} == topo->GetChildren());
+        expect(topo->FindDataPaths(DataPathType::Any, DataPathDirection::Outgoing).empty());
+        expect(that % nullptr == topo->FindDataPath(releasedThread));
+        expect(!router.IsCacheValid());
+        expect(!router.FindRoute(topo, kept, RouteMetric::MinLatency).Found());
+        topo->Delete();
+    };
+    "Subtree index"_test = []
+    {
+        Node a{0};
+        Chip b{&a, 0};
+        Core c{&b, 0};
+        Thread d{&c, 0};
+        Thread e{&c, 1};
+
+        SubtreeIndex* index = a.EnableSubtreeIndex();
+        expect(that % index == a.GetSubtreeIndex());
+        expect(that % a.FindDescendantsByType(ComponentType::Any) == (std::vector<Component *>{&a, &b, &c, &d, &e}));
+        expect(that % index->IsValid());
+
+        //appending at the end of the pre-order keeps the index valid
+        Core f{&b, 1};
+        Thread g{&f, 2};
+        expect(that % index->IsValid());
+        expect(that % a.FindDescendantsByType(ComponentType::Thread) == (std::vector<Component *>{&d, &e, &g}));
+        expect(that % 3 == a.CountDescendantsByType(ComponentType::Thread));
+        expect(that % 6 == a.CountDescendantsByType(ComponentType::Any));
+
+        //insertion in the middle of the pre-order triggers a rebuild that keeps the pre-order
+        Thread h{&c, 3};
+        expect(that % !index->IsValid());
+        expect(that % a.FindDescendantsByType(ComponentType::Thread) == (std::vector<Component *>{&d, &e, &h, &g}));
+
+        Cache l2{0, 2};
+        expect(that % 0 == l2.InsertBetweenParentAndChild(&b, &f, false));
+        expect(that % a.FindDescendantsByType(ComponentType::Any) == (std::vector<Component *>{&a, &b, &c, &d, &e, &h, &l2, &f, &g}));
+
+        expect(that % 1 == c.RemoveChild(&e));
+        expect(that % 3 == a.CountDescendantsByType(ComponentType::Thread));
+        expect(that % 1 == a.CountDescendantsByType(ComponentType::Chip));
+        expect(that % 0 == a.CountDescendantsByType(ComponentType::Node));
+
+        a.DisableSubtreeIndex();
+        expect(that % nullptr == a.GetSubtreeIndex());
+        expect(that % 3 == a.CountDescendantsByType(ComponentType::Thread));
+    };
+    "Subtree index id lookup"_test = []
+    {
+        Node a{0};
+        Chip b{&a, 0};
+        Core c{&b, 0};
+        Thread d{&c, 0};
+        Thread e{&c, 1};
+        Core f{&b, 1};
+        Thread g{&f, 1}; //same id as e, comes later in pre-order
+
+        a.EnableSubtreeIndex();
+        expect(that % &e == a.GetDescendantById(1, ComponentType::Thread));
+        expect(that % &f == a.GetDescendantById(1, ComponentType::Core));
+        expect(that % &a == a.GetDescendantById(0, ComponentType::Node));
+        expect(that % nullptr == a.GetDescendantById(2, ComponentType::Thread));
+
+        Thread h{&f, 2};
+        expect(that % &h == a.GetDescendantById(2, ComponentType::Thread));
+
+        e.SetId(5);
+        expect(that % &g == a.GetDescendantById(1, ComponentType::Thread));
+        expect(that % &e == a.GetDescendantById(5, ComponentType::Thread));
+        h.SetId(7);
+        expect(that % nullptr == a.GetDescendantById(2, ComponentType::Thread));
+        expect(that % &h == a.GetDescendantById(7, ComponentType::Thread));
+
+        expect(that % 1 == f.RemoveChild(&g));
+        expect(that % nullptr == a.GetDescendantById(1, ComponentType::Thread));
+        c.InsertChild(&g);
+        expect(that % &g == a.GetDescendantById(1, ComponentType::Thread));
+    };
+    "Frozen topology"_test = []
+    {
+        Topology topo;
+        Node a{&topo, 0};
+        Chip b{&a, 0};
+        Core c{&b, 0};
+        Thread d{&c, 0};
+        Thread e{&c, 1};
+        Core f{&b, 1};
+        Thread g{&f, 2};
+        Memory m{&a};
+        DataPath dp1{&d, &m, DataPathOrientation::Oriented, DataPathType::Physical, 10, 100};
+        DataPath dp2{&g, &m, DataPathOrientation::Bidirectional, DataPathType::Logical};
+        Thread outside{3};
+        DataPath dp3{&g, &outside, DataPathOrientation::Oriented};
+
+        FrozenTopology frozen = topo.Freeze();
+        expect(that % 9 == frozen.GetNumComponents());
+        std::vector<Component *> preOrder;
+        for(uint32_t i = 0; i < frozen.GetNumComponents(); i++)
+        {
+            preOrder.push_back(frozen.GetComponent(i));
+            expect(that % i == frozen.GetIndex(frozen.GetComponent(i)));
+        }
+        expect(that % preOrder == topo.FindDescendantsByType(ComponentType::Any));
+        expect(that % FrozenTopology::None == frozen.GetIndex(&outside));
+
+        uint32_t ic = frozen.GetIndex(&c);
+        expect(that % ComponentType::Core == frozen.GetComponentType(ic));
+        expect(that % 0 == frozen.GetId(ic));
+        expect(that % c.GetName() == frozen.GetName(ic));
+        expect(that % 3 == frozen.GetDepth(ic));
+        expect(that % frozen.GetIndex(&b) == frozen.GetParent(ic));
+        expect(that % FrozenTopology::None == frozen.GetParent(0));
+        expect(that % frozen.GetIndex(&f) == frozen.GetSubtreeEnd(ic));
+
+        auto children = frozen.GetChildren(frozen.GetIndex(&b));
+        expect(that % std::vector<uint32_t>(children.begin(), children.end()) == (std::vector<uint32_t>{ic, frozen.GetIndex(&f)}));
+
+        auto threads = frozen.FindDescendantsByType(frozen.GetIndex(&b), ComponentType::Thread);
+        expect(that % std::vector<uint32_t>(threads.begin(), threads.end()) == (std::vector<uint32_t>{frozen.GetIndex(&d), frozen.GetIndex(&e), frozen.GetIndex(&g)}));
+        expect(that % 2 == frozen.FindDescendantsByType(ic, ComponentType::Thread).size());
+        expect(that % 0 == frozen.FindDescendantsByType(ic, ComponentType::Memory).size());
+        expect(that % 3 == frozen.FindDescendantsByType(ic, ComponentType::Any).size());
+        expect(that % 3 == frozen.GetComponentsByType(ComponentType::Thread).size());
+        expect(that % 7 == frozen.CountDescendantsByType(frozen.GetIndex(&a), ComponentType::Any));
+        expect(that % 2 == frozen.CountDescendantsByType(frozen.GetIndex(&a), ComponentType::Core));
+
+        uint32_t ig = frozen.GetIndex(&g);
+        expect(that % frozen.GetIndex(&b) == frozen.GetAncestorByType(ig, ComponentType::Chip));
+        expect(that % ig == frozen.GetAncestorByType(ig, ComponentType::Thread));
+        expect(that % FrozenTopology::None == frozen.GetAncestorByType(ig, ComponentType::Numa));
+        expect(that % frozen.GetIndex(&a) == frozen.GetNthAncestor(ig, 3));
+        expect(that % FrozenTopology::None == frozen.GetNthAncestor(ig, 5));
+        expect(that % frozen.IsAncestorOf(frozen.GetIndex(&b), ig));
+        expect(that % !frozen.IsAncestorOf(ic, ig));
+
+        //dp3 leaves the snapshot and is not included
+        expect(that % 2 == frozen.GetNumDataPaths());
+        uint32_t im = frozen.GetIndex(&m);
+        expect(that % 2 == frozen.GetDataPaths(im).size());
+        std::vector<uint32_t> dps;
+        frozen.FindDataPaths(im, &dps, DataPathType::Any, DataPathDirection::Outgoing);
+        expect(that % 1 == dps.size());
+        expect(that % &dp2 == frozen.GetDataPath(dps[0]).dataPath);
+        uint32_t idp1 = frozen.GetDataPathByType(frozen.GetIndex(&d), DataPathType::Physical, DataPathDirection::Outgoing);
+        expect(that % &dp1 == frozen.GetDataPath(idp1).dataPath);
+        expect(that % im == frozen.GetDataPath(idp1).target);
+        expect(that % 10.0 == frozen.GetDataPath(idp1).bw);
+        expect(that % FrozenTopology::None == frozen.GetDataPathByType(frozen.GetIndex(&d), DataPathType::Physical, DataPathDirection::Incoming));
+
+        //the snapshot does not follow later modifications
+        Thread h{&f, 3};
+        expect(that % 9 == frozen.GetNumComponents());
+        expect(that % FrozenTopology::None == frozen.GetIndex(&h));
+    };
+    "Subtree traversal"_test = []
+    {
+        Node a{0};
+        Chip b{&a, 0};
+        Core c{&b, 0};
+        Thread d{&c, 0};
+        Thread e{&c, 1};
+        Core f{&b, 1};
+        Thread g{&f, 2};
+        Memory m{&a};
+
+        std::vector<Component *> pre;
+        for(Component *x : a.TraversePreOrder())
+            pre.push_back(x);
+        expect(that % pre == (std::vector<Component *>{&a, &b, &c, &d, &e, &f, &g, &m}));
+
+        std::vector<Component *> post;
+        for(Component *x : a.TraversePostOrder())
+            post.push_back(x);
+        expect(that % post == (std::vector<Component *>{&d, &e, &c, &g, &f, &b, &m, &a}));
+
+        std::vector<Component *> cores;
+        for(Component *x : b.TraversePostOrder(ComponentType::Core))
+            cores.push_back(x);
+        expect(that % cores == (std::vector<Component *>{&c, &f}));
+
+        //ranges pipeline
+        static_assert(std::ranges::forward_range<SubtreeRange>);
+        static_assert(std::ranges::view<SubtreeRange>);
+        auto ids = a.TraversePreOrder(ComponentType::Thread) | std::views::transform([](Component *x){ return x->GetId(); }) | std::views::filter([](int id){ return id > 0; });
+        std::vector<int> idVector;
+        std::ranges::copy(ids, std::back_inserter(idVector));
+        expect(that % idVector == (std::vector<int>{1, 2}));
+        expect(that % 0 == std::ranges::distance(g.TraversePreOrder(ComponentType::Core)));
+        expect(that % &g == *g.TraversePreOrder().begin());
+
+        //pruning
+        std::vector<Component *> pruned;
+        SubtreeRange subtree = a.TraversePreOrder();
+        for(auto it = subtree.begin(); it != subtree.end(); ++it)
+        {
+            pruned.push_back(*it);
+            if(*it == &c)
+                it.SkipChildren();
+        }
+        expect(that % pruned == (std::vector<Component *>{&a, &b, &c, &f, &g, &m}));
+
+        //visitor with early exit
+        int visited = 0;
+        expect(that % !a.VisitDescendants([&visited](Component *x){ visited++; return x->GetId() != 1; }, ComponentType::Thread));
+        expect(that % 2 == visited);
+        visited = 0;
+        expect(that % a.VisitDescendants([&visited](Component *){ visited++; }));
+        expect(that % 8 == visited);
+
+        expect(that % a.FindNthDescendants(2) == (std::vector<Component *>{&c, &f}));
+        expect(that % a.FindNthDescendants(3) == (std::vector<Component *>{&d, &e, &g}));
+        expect(that % 3 == a.CountDescendantsByType(ComponentType::Thread));
+        expect(that % 0 == d.CountDescendantsByType(ComponentType::Any));
+
+        //deeper than the inline path of the iterator
+        std::vector<Component *> chain;
+        Component *parent = &g;
+        for(int i = 0; i < 2 * SubtreeIterator::inlineDepth; i++)
+        {
+            Component *x = new Component(parent, i);
+            new Component(parent, 1000 + i);
+            chain.push_back(x);
+            parent = x;
+        }
+        const long total = 4 * SubtreeIterator::inlineDepth + 8;
+        expect(that % total == std::ranges::distance(a.TraversePreOrder()));
+        expect(that % total == std::ranges::distance(a.TraversePostOrder()));
+        expect(that % chain.back() == *g.TraversePostOrder().begin());
+        expect(that % int(total - 8) == a.CountDescendantsByType(ComponentType::Generic));
+        for(Component *x : std::vector<Component *>(g.GetChildren()))
+            x->Delete(true);
+        expect(that % g.GetChildren().empty());
+    };
+    "Relation visitors"_test = []
+    {
+        Component a, b, c;
+        DataPath dp1{&a, &b, DataPathOrientation::Oriented, DataPathType::Physical};
+        DataPath dp2{&c, &a, DataPathOrientation::Oriented, DataPathType::Logical};
+        DataPath dp3{&a, &c, DataPathOrientation::Bidirectional, DataPathType::Physical};
+
+        std::vector<DataPath *> dps;
+        expect(that % a.ForEachDataPath([&dps](DataPath *dp){ dps.push_back(dp); }, DataPathType::Any, DataPathDirection::Outgoing));
+        expect(that % dps == (std::vector<DataPath *>{&dp1, &dp3}));
+        int visited = 0;
+        expect(that % !a.ForEachDataPath([&visited](DataPath *){ visited++; return false; }));
+        expect(that % 1 == visited);
+        expect(that % &dp3 == c.GetDataPathByType(DataPathType::Physical));
+        expect(that % nullptr == b.GetDataPathByType(DataPathType::Logical));
+
+        std::vector<Relation *> rs;
+        a.ForEachRelation([&rs](Relation *r){ rs.push_back(r); }, RelationType::DataPath, 1);
+        expect(that % rs == (std::vector<Relation *>{&dp2, &dp3}));
+        expect(that % a.FindRelations(RelationType::Any, 0) == (std::vector<Relation *>{&dp1, &dp3}));
+
+        Component lonely;
+        expect(that % lonely.FindRelations().empty());
+        expect(that % nullptr == lonely.GetDataPathByType(DataPathType::Physical));
+    };
+    "Deep subtree traversal"_test = []
+    {
+        //deep enough to overflow the call stack with one frame per level
+        constexpr int chainLength = 200000;
+        Component *root = new Component(0);
+        Component *leaf = root;
+        for(int i = 1; i <= chainLength; i++)
+            leaf = new Component(leaf, i);
+        new Thread(root, 0);
+
+        expect(that % chainLength == root->CalcSubtreeDepth());
+        expect(that % chainLength + 1 == root->CountDescendantsByType(ComponentType::Any));
+        expect(that % 0 == root->CheckSubtreeConsistency());
+        expect(that % root == leaf->GetNthAncestor(chainLength));
+        expect(that % nullptr == leaf->GetNthAncestor(chainLength + 1));
+        unsigned componentSize = 0, relationSize = 0;
+        expect(that % root->CalcSubtreeSize(&componentSize, &relationSize) > 0);
+        expect(that % componentSize >= (chainLength + 2) * sizeof(Component));
+
+        root->EnableSubtreeIndex();
+        expect(that % leaf == root->GetDescendantById(chainLength, ComponentType::Generic));
+        root->DeleteSubtree();
+        expect(that % root->GetChildren().empty());
+        expect(that % 0 == root->CountDescendantsByType(ComponentType::Any));
+        root->Delete();
+    };
+    "Interval labels and lowest common ancestor"_test = []
+    {
+        Node n{0};
+        Chip chip{&n, 0};
+        Cache l3{&chip, 0, 3};
+        Cache l2a{&l3, 0, 2};
+        Cache l2b{&l3, 1, 2};
+        Core c0{&l2a, 0};
+        Core c1{&l2a, 1};
+        Core c2{&l2b, 2};
+        Thread t0{&c0, 0};
+        Thread t1{&c0, 1};
+        Thread t2{&c1, 2};
+        Thread t3{&c2, 3};
+        std::vector<Component *> all { &n, &chip, &l3, &l2a, &l2b, &c0, &c1, &c2, &t0, &t1, &t2, &t3 };
+
+        //without labels, the same answers are found by walking the ancestors
+        expect(that % chip.IsAncestorOf(&t3));
+        expect(that % !t3.IsAncestorOf(&chip));
+        expect(that % &l2a == t0.FindLowestCommonAncestor(&t2));
+        expect(that % &l2a == t0.FindLowestCommonAncestor(&t2, ComponentType::Cache));
+        expect(that % &l3 == t0.FindLowestCommonAncestor(&t3, ComponentType::Cache));
+        std::vector<Component *> expectedLca;
+        for(Component *x : all)
+            for(Component *y : all)
+                expectedLca.push_back(x->FindLowestCommonAncestor(y));
+
+        SubtreeIndex *index = n.EnableSubtreeIndex();
+        expect(that % !index->AreIntervalLabelsValid());
+        expect(that % &c0 == t0.FindLowestCommonAncestor(&t1));
+        expect(that % index->AreIntervalLabelsValid());
+        std::vector<Component *> labelledLca;
+        for(Component *x : all)
+            for(Component *y : all)
+            {
+                labelledLca.push_back(x->FindLowestCommonAncestor(y));
+                bool walked = false;
+                for(Component *ancestor = y; ancestor != nullptr; ancestor = ancestor->GetParent())
+                    walked = walked || ancestor == x;
+                expect(that % walked == x->IsAncestorOf(y));
+            }
+        expect(that % labelledLca == expectedLca);
+        expect(that % &l3 == t0.FindLowestCommonAncestor(&t3, ComponentType::Cache));
+        expect(that % &chip == t0.FindLowestCommonAncestor(&t3, ComponentType::Chip));
+        expect(that % nullptr == t0.FindLowestCommonAncestor(&t3, ComponentType::Memory));
+
+        //appending at the end of the pre-order extends the labels
+        Thread t4{&c2, 4};
+        expect(that % index->AreIntervalLabelsValid());
+        expect(that % l2b.IsAncestorOf(&t4));
+        expect(that % !l2a.IsAncestorOf(&t4));
+        expect(that % &c2 == t3.FindLowestCommonAncestor(&t4));
+        expect(that % &l3 == t1.FindLowestCommonAncestor(&t4));
+
+        //other modifications relabel on the next query; removed components are no longer covered
+        Thread t5{&c0, 5};
+        expect(that % !index->AreIntervalLabelsValid());
+        expect(that % &c0 == t5.FindLowestCommonAncestor(&t0));
+        expect(that % &l2a == t5.FindLowestCommonAncestor(&t2));
+        expect(that % 1 == c0.RemoveChild(&t5));
+        t5.SetParent(nullptr);
+        expect(that % !n.IsAncestorOf(&t5));
+        expect(that % nullptr == t5.FindLowestCommonAncestor(&t0));
+        expect(that % n.IsAncestorOf(&t4));
+
+        //concurrent queries on stale labels: one of them relabels, the others wait for it
+        Thread t6{&c0, 6};
+        expect(that % 1 == c0.RemoveChild(&t6));
+        t6.SetParent(nullptr);
+        expect(that % !index->AreIntervalLabelsValid());
+        std::vector<std::vector<Component *>> concurrentLca(4);
+        std::vector<std::thread> threads;
+        for(std::vector<Component *>& lca : concurrentLca)
+            threads.emplace_back([&all, &lca]{
+                for(Component *x : all)
+                    for(Component *y : all)
+                        lca.push_back(x->IsAncestorOf(y) ? x : x->FindLowestCommonAncestor(y));
+            });
+        for(std::thread& thread : threads)
+            thread.join();
+        for(const std::vector<Component *>& lca : concurrentLca)
+            expect(that % lca == expectedLca);
+        expect(that % index->AreIntervalLabelsValid());
+
+        //components outside of the labelled subtree
+        Core other{0};
+        expect(that % !n.IsAncestorOf(&other));
+        expect(that % nullptr == other.FindLowestCommonAncestor(&t0));
+        n.DisableSubtreeIndex();
+        expect(that % &l3 == t1.FindLowestCommonAncestor(&t4));
+        expect(that % chip.IsAncestorOf(&t4));
+    };
+    "Parallel traversal"_test = []
+    {
+        Topology topo;
+        for(int n = 0; n < 16; n++)
+        {
+            Node *node = new Node(&topo, n);
+            for(int c = 0; c < 2; c++)
+            {
+                Chip *chip = new Chip(node, c);
+                for(int k = 0; k < 8; k++)
+                    new Thread(new Core(chip, k), k);
+            }
+        }
+        std::vector<Component *> nodes = topo.GetChildren();
+        for(size_t n = 1; n < nodes.size(); n++)
+            new DataPath(nodes[n - 1], nodes[n], DataPathOrientation::Oriented, DataPathType::Physical);
+
+        WorkStealingPool pool{4};
+        ParallelTraversal parallel{&pool, 100};
+        std::vector<ParallelTraversal::Piece> pieces = parallel.Partition(&topo);
+        expect(that % pieces.size() > 16);
+        expect(that % 1 == ParallelTraversal(&pool).Partition(&topo).size());
+        std::vector<Component *> fromPieces;
+        for(const ParallelTraversal::Piece &piece : pieces)
+        {
+            if(piece.wholeSubtree)
+                piece.root->FindDescendantsByType(&fromPieces, ComponentType::Any);
+            else
+                fromPieces.push_back(piece.root);
+        }
+
+        std::vector<Component *> serial, parallelResult;
+        topo.FindDescendantsByType(&serial, ComponentType::Any);
+        topo.FindDescendantsByType(&parallelResult, ComponentType::Any, parallel);
+        expect(that % serial == parallelResult);
+        expect(that % serial == fromPieces);
+        serial.clear();
+        parallelResult.clear();
+        topo.FindDescendantsByType(&serial, ComponentType::Thread);
+        topo.FindDescendantsByType(&parallelResult, ComponentType::Thread, parallel);
+        expect(that % 256 == parallelResult.size());
+        expect(that % serial == parallelResult);
+
+        unsigned componentSize = 0, relationSize = 0, parallelComponentSize = 0, parallelRelationSize = 0;
+        int total = topo.CalcSubtreeSize(&componentSize, &relationSize);
+        expect(that % total == topo.CalcSubtreeSize(&parallelComponentSize, &parallelRelationSize, parallel));
+        expect(that % componentSize == parallelComponentSize);
+        expect(that % relationSize == parallelRelationSize);
+        expect(that % 15 * sizeof(DataPath) == relationSize);
+
+        //nested batches run serially on the calling worker
+        std::atomic<int> visited { 0 };
+        pool.Run(8, [&pool, &visited](size_t){ pool.Run(4, [&visited](size_t){ visited++; }); });
+        expect(that % 32 == visited.load());
+        topo.DeleteSubtree();
+    };
 };